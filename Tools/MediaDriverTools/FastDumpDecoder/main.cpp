@@ -0,0 +1,75 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     main.cpp
+//! \brief    Restores raw dumps from compressed containers of MediaDebugFastDump
+//!
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "media_debug_fast_dump_compress.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2 && argc != 3)
+    {
+        fprintf(stderr, "Usage: FastDumpDecoder <input.fdz> [output]\n");
+        fprintf(stderr, "       Output defaults to the input path with .fdz replaced by .bin\n");
+        exit(-1);
+    }
+
+    string input  = argv[1];
+    string output = argc == 3 ? argv[2] : input;
+    if (argc == 2)
+    {
+        const string suffix = ".fdz";
+        if (output.size() > suffix.size() && output.compare(output.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            output.resize(output.size() - suffix.size());
+        }
+        output += ".bin";
+    }
+
+    vector<uint8_t> data;
+    string          error;
+    if (!MediaDebugFastDumpContainer::Load(input, data, error))
+    {
+        fprintf(stderr, "Decode %s failed: %s\n", input.c_str(), error.c_str());
+        exit(-1);
+    }
+
+    ofstream ofs(output, ios_base::out | ios_base::binary);
+    ofs.write(reinterpret_cast<const char *>(data.data()), data.size());
+    if (!ofs)
+    {
+        fprintf(stderr, "Write %s failed\n", output.c_str());
+        exit(-1);
+    }
+
+    printf("%s: %zu bytes\n", output.c_str(), data.size());
+    return 0;
+}
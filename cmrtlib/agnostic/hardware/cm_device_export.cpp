@@ -23,6 +23,11 @@
 #include "cm_event_base.h"
 #include "cm_queue_base_hw.h"
 #include "cm_timer.h"
+#include "cm_perf_statistics.h"
+
+#if MDF_PROFILER_ENABLED
+extern CmPerfStatistics gCmPerfStatistics;
+#endif
 
 //!
 //! \brief      Destroys CM Device
@@ -86,3 +91,54 @@ EXTERN_C CM_RT_API int32_t CMRT_Enqueue(CmQueue* queue, CmTask* task, CmEvent**
     return queue->Enqueue(task, *event, threadSpace);
 }
 
+//!
+//! \brief      Get statistics of CM API calls
+//! \details    Returns a snapshot of call count, total and longest duration and
+//!             duration histogram of each CM API called by the process, merged
+//!             across threads. It can be called at any time.
+//! \param      [out] statistics
+//!             Array to fill, can be nullptr to query the number of APIs
+//! \param      [in,out] count
+//!             Size of the array on input, number of APIs called on output.
+//!             Only the first *count entries are filled if the array is smaller.
+//! \retval     CM_SUCCESS            if statistics are returned
+//! \retval     CM_INVALID_ARG_VALUE  if count is nullptr
+//! \retval     CM_NOT_IMPLEMENTED    if the profiler is not built in
+//!
+EXTERN_C CM_RT_API int32_t GetCmApiPerfStatistics(CM_API_PERF_STATISTIC *statistics, uint32_t *count)
+{
+    if (count == nullptr)
+    {
+        return CM_INVALID_ARG_VALUE;
+    }
+
+#if MDF_PROFILER_ENABLED
+    static_assert(sizeof(CM_API_PERF_STATISTIC) == sizeof(ApiPerfStatistic), "CM_API_PERF_STATISTIC must match ApiPerfStatistic");
+
+    std::vector<ApiPerfStatistic> apiStatistics;
+    uint32_t apiCount = gCmPerfStatistics.GetPerfStatistics(apiStatistics);
+
+    if (statistics != nullptr)
+    {
+        uint32_t copyCount = (apiCount < *count) ? apiCount : *count;
+        for (uint32_t i = 0; i < copyCount; i++)
+        {
+            CM_API_PERF_STATISTIC &statistic = statistics[i];
+            CM_STRCPY(statistic.functionName, sizeof(statistic.functionName), apiStatistics[i].functionName);
+            statistic.time      = apiStatistics[i].time;
+            statistic.callTimes = apiStatistics[i].callTimes;
+            statistic.maxTime   = apiStatistics[i].maxTime;
+            for (uint32_t bucket = 0; bucket < CM_API_PERF_HISTOGRAM_BUCKETS; bucket++)
+            {
+                statistic.histogram[bucket] = apiStatistics[i].histogram[bucket];
+            }
+        }
+    }
+    *count = apiCount;
+
+    return CM_SUCCESS;
+#else
+    *count = 0;
+    return CM_NOT_IMPLEMENTED;
+#endif
+}
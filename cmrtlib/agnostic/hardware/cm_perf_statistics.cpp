@@ -22,17 +22,14 @@
 #include "cm_perf_statistics.h"
 #include "cm_mem.h"
 #include "cm_sdk_provider.h"
+#include <new>
 
 #if MDF_PROFILER_ENABLED
 
 CmPerfStatistics::CmPerfStatistics()
 {
 
-    m_apiCallRecordCount  = 0;
-    m_apiCallFile         = nullptr;
-
-    m_perfStatisticFile   = nullptr;
-    m_perfStatisticCount = 0;
+    m_threadRecords.store(nullptr);
 
     m_profilerOn      = false;
     m_profilerLevel    = CM_RT_PERF_LOG_LEVEL_DEFAULT;
@@ -51,6 +48,23 @@ CmPerfStatistics::~CmPerfStatistics()
     DumpApiCallRecords();
 
     DumpPerfStatisticRecords();
+
+    ThreadRecords *records = m_threadRecords.exchange(nullptr);
+    while (records != nullptr)
+    {
+        ThreadRecords *next = records->next;
+
+        ApiCallRecordChunk *chunk = records->firstChunk;
+        while (chunk != nullptr)
+        {
+            ApiCallRecordChunk *nextChunk = chunk->next.load();
+            CmSafeRelease(chunk);
+            chunk = nextChunk;
+        }
+        CmSafeRelease(records);
+
+        records = next;
+    }
 }
 
 void CmPerfStatistics::GetProfilerLevel()
@@ -60,65 +74,165 @@ void CmPerfStatistics::GetProfilerLevel()
     return;
 }
 
-//! Insert API Call Records Into m_apiCallRecords Array and Update Perf Statistic Array accordingly
-void CmPerfStatistics::InsertApiCallRecord(char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end)
+//! Get Buffers of Calling Thread, Register Them on the First Call
+CmPerfStatistics::ThreadRecords *CmPerfStatistics::GetThreadRecords()
 {
-    CLock locker(m_criticalSectionOnApiCallRecords);
-
-    ApiCallRecord *records = new ApiCallRecord ;
+    static thread_local CmPerfStatistics *owner   = nullptr;
+    static thread_local ThreadRecords    *records = nullptr;
 
-    records->startTime = start;
-    records->endTime   = end;
-    records->duration   = time;
-
-    CM_STRCPY(records->functionName, MSG_STRING_SIZE, functionName);
+    if (owner == this)
+    {
+        return records;
+    }
 
-    m_apiCallRecords.push_back(records);
-    m_apiCallRecordCount++;
+    // value-initialized, all counters are zero
+    ThreadRecords *newRecords = new (std::nothrow) ThreadRecords();
+    if (newRecords == nullptr)
+    {
+        return nullptr;
+    }
+    newRecords->firstChunk = new (std::nothrow) ApiCallRecordChunk();
+    newRecords->lastChunk  = newRecords->firstChunk;
+    if (newRecords->firstChunk == nullptr)
+    {
+        CmSafeRelease(newRecords);
+        return nullptr;
+    }
 
-    InsertPerfStatistic(records);
+    {
+        CLock locker(m_criticalSectionOnThreadRecords);
+        newRecords->next = m_threadRecords.load(std::memory_order_relaxed);
+        m_threadRecords.store(newRecords, std::memory_order_release);
+    }
 
+    owner   = this;
+    records = newRecords;
+    return records;
 }
 
-//Update Perf Statistic Array
-void CmPerfStatistics::InsertPerfStatistic(ApiCallRecord *record)
+//! Append API Call Record into Buffers of Calling Thread and Update Its Histogram of the API
+void CmPerfStatistics::InsertApiCallRecord(const char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end)
 {
-    uint32_t index = 0;
+    ThreadRecords *records = GetThreadRecords();
+    if (records == nullptr)
+    {
+        return;
+    }
 
-    for( index = 0 ; index < m_perfStatisticCount ; index ++)
+    if (m_profilerLevel >= CM_RT_PERF_LOG_LEVEL_RECORDS)
     {
-        ApiPerfStatistic *perfStatisticRecords = m_perfStatisticRecords[index];
-        if(perfStatisticRecords != nullptr)
+        uint32_t count = records->recordCount.load(std::memory_order_relaxed);
+        uint32_t index = count % INIT_ARRAY_ZIE;
+        ApiCallRecordChunk *chunk = records->lastChunk;
+        if (count > 0 && index == 0)
         {
-            if(!strcmp(record->functionName, perfStatisticRecords->functionName))
-            { // existing
-               perfStatisticRecords->callTimes ++ ;
-               perfStatisticRecords->time += record->duration;
-
-               //Update statistic records
-               m_perfStatisticRecords[index] = perfStatisticRecords;
-
-               break;
+            chunk = new (std::nothrow) ApiCallRecordChunk();
+            if (chunk != nullptr)
+            {
+                records->lastChunk->next.store(chunk, std::memory_order_release);
+                records->lastChunk = chunk;
             }
         }
+        if (chunk != nullptr)
+        {
+            ApiCallRecord *record = &chunk->records[index];
+            record->functionName  = functionName;
+            record->startTime     = start;
+            record->endTime       = end;
+            record->duration      = time;
+
+            // publish the record to dumper
+            records->recordCount.store(count + 1, std::memory_order_release);
+        }
     }
 
-    if(index == m_perfStatisticCount)
-    { // record does not exist, create new entry
-        ApiPerfStatistic *perfStatisticRecords = new ApiPerfStatistic;
-        CM_STRCPY(perfStatisticRecords->functionName, MSG_STRING_SIZE, record->functionName);
+    // APIs are identified by pointer here, and by name when merged
+    ApiHistogram *histogram = nullptr;
+    uint32_t histogramCount = records->histogramCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < histogramCount; i++)
+    {
+        if (records->histograms[i].functionName == functionName)
+        {
+            histogram = &records->histograms[i];
+            break;
+        }
+    }
+    if (histogram == nullptr)
+    {
+        if (histogramCount == MAX_RECORD_NUM)
+        {
+            return;
+        }
+        histogram = &records->histograms[histogramCount];
+        histogram->functionName = functionName;
+        records->histogramCount.store(histogramCount + 1, std::memory_order_release);
+    }
 
-        perfStatisticRecords->callTimes = 1;
-        perfStatisticRecords->time       = record->duration;
+    uint64_t timeNs = (time > 0) ? (uint64_t)((double)time * 1000000.0) : 0;
+    uint64_t timeUs = timeNs / 1000;
+    uint32_t bucket = 0;
+    while (timeUs != 0 && bucket < CM_PERF_HISTOGRAM_BUCKETS - 1)
+    {
+        timeUs >>= 1;
+        bucket++;
+    }
 
-        m_perfStatisticRecords.push_back(perfStatisticRecords);
-        m_perfStatisticCount ++;
+    // Only the owner thread writes, so plain load and store instead of read-modify-write
+    histogram->callTimes.store(histogram->callTimes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    histogram->timeNs.store(histogram->timeNs.load(std::memory_order_relaxed) + timeNs, std::memory_order_relaxed);
+    if (timeNs > histogram->maxTimeNs.load(std::memory_order_relaxed))
+    {
+        histogram->maxTimeNs.store(timeNs, std::memory_order_relaxed);
     }
+    histogram->buckets[bucket].store(histogram->buckets[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+//! Merge Histograms of All Threads into Perf Statistic Array
+uint32_t CmPerfStatistics::GetPerfStatistics(std::vector<ApiPerfStatistic> &statistics)
+{
+    statistics.clear();
+
+    for (ThreadRecords *records = m_threadRecords.load(std::memory_order_acquire);
+         records != nullptr;
+         records = records->next)
+    {
+        uint32_t histogramCount = records->histogramCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < histogramCount; i++)
+        {
+            ApiHistogram *histogram = &records->histograms[i];
+
+            uint32_t index = 0;
+            for (index = 0; index < statistics.size(); index++)
+            {
+                if (!strcmp(histogram->functionName, statistics[index].functionName))
+                {
+                    break;
+                }
+            }
+            if (index == statistics.size())
+            { // record does not exist, create new entry
+                ApiPerfStatistic statistic = {};
+                CM_STRCPY(statistic.functionName, MSG_STRING_SIZE, histogram->functionName);
+                statistics.push_back(statistic);
+            }
 
-    return ;
+            ApiPerfStatistic &statistic = statistics[index];
+            float maxTime = (float)histogram->maxTimeNs.load(std::memory_order_relaxed) / 1000000.0f;
+
+            statistic.callTimes += (uint32_t)histogram->callTimes.load(std::memory_order_relaxed);
+            statistic.time      += (float)histogram->timeNs.load(std::memory_order_relaxed) / 1000000.0f;
+            statistic.maxTime    = (maxTime > statistic.maxTime) ? maxTime : statistic.maxTime;
+            for (uint32_t bucket = 0; bucket < CM_PERF_HISTOGRAM_BUCKETS; bucket++)
+            {
+                statistic.histogram[bucket] += histogram->buckets[bucket].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    return (uint32_t)statistics.size();
 }
 
-//Dump APICall Records and Release m_apiCallRecords Array
+//Dump APICall Records of All Threads
 void CmPerfStatistics::DumpApiCallRecords()
 {
     if(!m_profilerOn)
@@ -126,31 +240,39 @@ void CmPerfStatistics::DumpApiCallRecords()
         return ;
     }
 
-    CM_FOPEN(m_apiCallFile, "CmPerfLog.csv", "wb");
-    if(! m_apiCallFile )
+    FILE *apiCallFile = nullptr;
+    CM_FOPEN(apiCallFile, "CmPerfLog.csv", "wb");
+    if(! apiCallFile )
     {
         fprintf(stdout, "Fail to create file CmPerfLog.csv \n ");
         return ;
     }
-    fprintf(m_apiCallFile,  "%-40s %s \t %s \t %s \n", "FunctionName", "StartTime", "EndTime", "Duration");
+    fprintf(apiCallFile,  "%-40s %s \t %s \t %s \n", "FunctionName", "StartTime", "EndTime", "Duration");
 
-    for(uint32_t i=0 ; i< m_apiCallRecordCount ; i++)
+    for (ThreadRecords *records = m_threadRecords.load(std::memory_order_acquire);
+         records != nullptr;
+         records = records->next)
     {
-        ApiCallRecord *records = m_apiCallRecords[i];
-
-        fprintf(m_apiCallFile,  "%-40s  %lld \t %lld \t %fms \n", records->functionName,
-           records->startTime.QuadPart, records->endTime.QuadPart, records->duration);
+        uint32_t            recordCount = records->recordCount.load(std::memory_order_acquire);
+        ApiCallRecordChunk *chunk       = records->firstChunk;
+        for (uint32_t i = 0; i < recordCount; i++)
+        {
+            if (i > 0 && i % INIT_ARRAY_ZIE == 0)
+            {
+                chunk = chunk->next.load(std::memory_order_acquire);
+            }
+            ApiCallRecord *record = &chunk->records[i % INIT_ARRAY_ZIE];
 
-        CmSafeRelease(records);
+            fprintf(apiCallFile,  "%-40s  %lld \t %lld \t %fms \n", record->functionName,
+               record->startTime.QuadPart, record->endTime.QuadPart, record->duration);
+        }
     }
 
-    m_apiCallRecords.clear();
-
-    fclose(m_apiCallFile);
+    fclose(apiCallFile);
 
 }
 
-//Dump Perf Statistic Records and Release m_perfStatisticRecords Array
+//Dump Snapshot of Perf Statistics
 void CmPerfStatistics::DumpPerfStatisticRecords()
 {
     if(!m_profilerOn)
@@ -158,27 +280,49 @@ void CmPerfStatistics::DumpPerfStatisticRecords()
         return ;
     }
 
-    CM_FOPEN(m_perfStatisticFile, "CmPerfStatistics.txt","wb");
-    if(!m_perfStatisticFile )
+    std::vector<ApiPerfStatistic> statistics;
+    GetPerfStatistics(statistics);
+
+    FILE *perfStatisticFile = nullptr;
+    CM_FOPEN(perfStatisticFile, "CmPerfStatistics.txt","wb");
+    if(!perfStatisticFile )
     {
         fprintf(stdout, "Fail to create file CmPerfStatistics.txt \n ");
         return ;
     }
-    fprintf(m_perfStatisticFile,  "%-40s %s \t %s \n", "FunctionName", "Total Time(ms)", "Called Times");
+    fprintf(perfStatisticFile,  "%-40s %s \t %s \t %s \t %s \n", "FunctionName", "Total Time(ms)", "Called Times",
+        "Max Time(ms)", "Histogram(us)");
 
-    for(uint32_t i=0 ; i< m_perfStatisticCount; i++)
+    for(uint32_t i=0 ; i< statistics.size(); i++)
     {
-        ApiPerfStatistic *perfStatisticRecords = m_perfStatisticRecords[i];
+        ApiPerfStatistic *perfStatisticRecords = &statistics[i];
 
-        fprintf(m_perfStatisticFile,  "%-40s %fms \t %d \n", perfStatisticRecords->functionName,
-           perfStatisticRecords->time, perfStatisticRecords->callTimes);
+        fprintf(perfStatisticFile,  "%-40s %fms \t %d \t %fms \t", perfStatisticRecords->functionName,
+           perfStatisticRecords->time, perfStatisticRecords->callTimes, perfStatisticRecords->maxTime);
 
-        CmSafeRelease(perfStatisticRecords);
+        for (uint32_t bucket = 0; bucket < CM_PERF_HISTOGRAM_BUCKETS; bucket++)
+        {
+            if (perfStatisticRecords->histogram[bucket] == 0)
+            {
+                continue;
+            }
+            if (bucket == 0)
+            {
+                fprintf(perfStatisticFile, " <1:%u", perfStatisticRecords->histogram[bucket]);
+            }
+            else if (bucket == CM_PERF_HISTOGRAM_BUCKETS - 1)
+            {
+                fprintf(perfStatisticFile, " >=%u:%u", 1u << (bucket - 1), perfStatisticRecords->histogram[bucket]);
+            }
+            else
+            {
+                fprintf(perfStatisticFile, " %u-%u:%u", 1u << (bucket - 1), 1u << bucket, perfStatisticRecords->histogram[bucket]);
+            }
+        }
+        fprintf(perfStatisticFile, " \n");
     }
 
-    m_perfStatisticRecords.clear();
-
-    fclose(m_perfStatisticFile);
+    fclose(perfStatisticFile);
 
 }
 
@@ -22,6 +22,7 @@
 #ifndef CMRTLIB_AGNOSTIC_HARDWARE_CM_PERF_STATISTICS_H_
 #define CMRTLIB_AGNOSTIC_HARDWARE_CM_PERF_STATISTICS_H_
 
+#include <atomic>
 #include <vector>
 #include <cstdio>
 #include "cm_def_hw.h"
@@ -33,16 +34,20 @@
 #define MSG_STRING_SIZE 256
 #define INIT_ARRAY_ZIE  256
 
+#define CM_PERF_HISTOGRAM_BUCKETS 24  // bucket 0: < 1us, bucket i: [2^(i-1), 2^i) us, last bucket: no upper bound
+
 struct ApiPerfStatistic
 {
     char  functionName[MSG_STRING_SIZE];       // function name
     float time;                                 // accumulative api duration
     uint32_t callTimes;                           // called times
+    float maxTime;                              // longest api duration
+    uint32_t histogram[CM_PERF_HISTOGRAM_BUCKETS]; // called times per duration bucket
 };
 
 struct ApiCallRecord
 {
-    char  functionName[MSG_STRING_SIZE];       // function name
+    const char    *functionName;               // function name, string literal
     LARGE_INTEGER  startTime;                  // start time
     LARGE_INTEGER  endTime;                    // end time
     float          duration;                    // duration
@@ -64,8 +69,10 @@ public:
     //!
     //! \brief    Insert API call record 
     //! \details  Insert API call record which contains function name, start time, end and duration.
+    //!           Records are appended into buffers of the calling thread without lock,
+    //!           only the first call of each thread takes a lock to register its buffer.
     //! \param    [in] functionName
-    //!           pointer to function name's string
+    //!           pointer to function name's string, which must outlive this object
     //! \param    [in] time
     //!           function's duration
     //! \param    [in] start
@@ -73,17 +80,53 @@ public:
     //! \param    [in] end
     //!           function's end time
     //!
-    void InsertApiCallRecord(char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end);
+    void InsertApiCallRecord(const char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end);
 
     //!
-    //! \brief    Insert API call record into performace statistic record
-    //! \details  Insert API call record into performace statistic record.
-    //! \param    [in] pRecords
-    //!           pointer to API call record
+    //! \brief    Get API call statistics
+    //! \details  Merge statistics of all threads into one record per API.
+    //!           It can be called at any time, calls in flight may be partially counted.
+    //! \param    [out] statistics
+    //!           API call statistics
+    //! \return   uint32_t
+    //!           Number of APIs in statistics
     //!
-    void InsertPerfStatistic(ApiCallRecord *records);
+    uint32_t GetPerfStatistics(std::vector<ApiPerfStatistic> &statistics);
+
+    //!
+    //! \brief    Dump API call statistic records into file
+    //! \details  Dump snapshot of API call statistics into file, 
+    //!           "CmPerfStatistics.txt" under app's location.
+    //!
+    void DumpPerfStatisticRecords();
 
 private:
+    // Statistic of one API, written by its owner thread only
+    struct ApiHistogram
+    {
+        const char            *functionName;
+        std::atomic<uint64_t>  callTimes;
+        std::atomic<uint64_t>  timeNs;
+        std::atomic<uint64_t>  maxTimeNs;
+        std::atomic<uint32_t>  buckets[CM_PERF_HISTOGRAM_BUCKETS];
+    };
+
+    struct ApiCallRecordChunk
+    {
+        ApiCallRecord                     records[INIT_ARRAY_ZIE];
+        std::atomic<ApiCallRecordChunk*>  next;
+    };
+
+    // Buffers of one thread, freed with this object
+    struct ThreadRecords
+    {
+        ApiHistogram           histograms[MAX_RECORD_NUM];
+        std::atomic<uint32_t>  histogramCount;
+        ApiCallRecordChunk    *firstChunk;
+        ApiCallRecordChunk    *lastChunk;      // used by owner thread only
+        std::atomic<uint32_t>  recordCount;
+        ThreadRecords         *next;
+    };
 
     //!
     //! \brief    Check the profiler level
@@ -91,6 +134,14 @@ private:
     //!
     void GetProfilerLevel();
 
+    //!
+    //! \brief    Get buffers of calling thread
+    //! \details  Buffers are created and registered on the first call of the thread.
+    //! \return   ThreadRecords*
+    //!           nullptr if out of memory
+    //!
+    ThreadRecords *GetThreadRecords();
+
     //!
     //! \brief    Dump API call records into file
     //! \details  Dump API call records into file, 
@@ -98,23 +149,8 @@ private:
     //!
     void DumpApiCallRecords();
 
-    //!
-    //! \brief    Dump API call statistic records into file
-    //! \details  Dump API call statistic records into file, 
-    //!           "CmPerfStatistics" under app's location.
-    //!
-    void DumpPerfStatisticRecords();
-
-    CSync           m_criticalSectionOnApiCallRecords;
-    uint32_t        m_apiCallRecordCount;
-    FILE           *m_apiCallFile;
-
-    CSync           m_criticalSectionOnPerfStatisticRecords;
-    FILE           *m_perfStatisticFile;
-    uint32_t        m_perfStatisticCount;
-
-    std::vector<ApiCallRecord*>      m_apiCallRecords;  // array to store api call records
-    std::vector<ApiPerfStatistic*>   m_perfStatisticRecords; // array to store perf statistic information
+    CSync                        m_criticalSectionOnThreadRecords;  // protect registration of thread buffers
+    std::atomic<ThreadRecords*>  m_threadRecords;                   // list of all thread buffers
 
     PerfLogLevel m_profilerLevel; // profiler level
     bool m_profilerOn;   // profiler on or off
@@ -63,6 +63,15 @@ struct CM_ENQUEUEHINTS_PARAM
     int32_t returnValue;  // [out]
 };
 
+struct CM_ENQUEUEBATCH_PARAM
+{
+    void *cmQueueHandle;    // [in]
+    void *batchTasks;       // [in] array of CM_BATCH_TASK
+    uint32_t taskCount;     // [in]
+    void *cmEventHandle;    // [in/out] event of the last task
+    int32_t returnValue;    // [out]
+};
+
 struct CM_DESTROYEVENT_PARAM
 {
     void *cmQueueHandle;  // [in]
@@ -876,6 +885,47 @@ CM_RT_API int32_t CmQueue_RT::SetResidentGroupAndParallelThreadNum(uint32_t resi
     return CM_NOT_IMPLEMENTED;
 }
 
+CM_RT_API int32_t CmQueue_RT::EnqueueBatch(const CM_BATCH_TASK *tasks,
+                                       uint32_t taskCount,
+                                       CmEvent *&event)
+{
+    INSERT_PROFILER_RECORD();
+    if (tasks == nullptr || taskCount == 0)
+    {
+        CmAssert(0);
+        CmDebugMessage(("Batch task array is empty."));
+        return CM_INVALID_ARG_VALUE;
+    }
+    m_criticalSection.Acquire();
+
+    // Task, thread space and event handles are driver pointers, so the array
+    // is passed through as is and marshalled in a single call.
+    CM_ENQUEUEBATCH_PARAM inParam;
+    CmSafeMemSet(&inParam, 0, sizeof(inParam));
+    inParam.cmQueueHandle = m_cmQueueHandle;
+    inParam.batchTasks = (void *)tasks;
+    inParam.taskCount = taskCount;
+    inParam.cmEventHandle = event;  // to support invisiable event, this field is used for input/output.
+
+    int32_t hr = m_cmDev->OSALExtensionExecute(CM_FN_CMQUEUE_ENQUEUEBATCH,
+                                                &inParam, sizeof(inParam));
+    if (FAILED(hr))
+    {
+        CmAssert(0);
+        m_criticalSection.Release();
+        return hr;
+    }
+    if (inParam.returnValue != CM_SUCCESS)
+    {
+        m_criticalSection.Release();
+        return inParam.returnValue;
+    }
+
+    event = static_cast<CmEvent *>(inParam.cmEventHandle);
+    m_criticalSection.Release();
+    return CM_SUCCESS;
+}
+
 
 CM_RT_API int32_t CmQueue_RT::EnqueueReadBuffer(CmBuffer* buffer,
                                                 size_t offset,
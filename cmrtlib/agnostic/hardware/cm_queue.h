@@ -174,6 +174,10 @@ public:
 
     CM_RT_API int32_t SetResidentGroupAndParallelThreadNum(uint32_t residentGroupNum, uint32_t parallelThreadNum);
 
+    CM_RT_API int32_t EnqueueBatch(const CM_BATCH_TASK *tasks,
+                                   uint32_t taskCount,
+                                   CmEvent *&event);
+
     CM_QUEUE_CREATE_OPTION GetQueueOption();
 
 
@@ -62,6 +62,16 @@ struct CM_QUEUE_CREATE_OPTION
 
 const CM_QUEUE_CREATE_OPTION CM_DEFAULT_QUEUE_CREATE_OPTION = { CM_QUEUE_TYPE_RENDER, false, 0, false, 0, CM_QUEUE_SSEU_USAGE_HINT_DEFAULT, 0, 0 };
 
+//!
+//! \brief One task of a batch submitted by CmQueue::EnqueueBatch.
+//!
+struct CM_BATCH_TASK
+{
+    CmTask              *task;         // [in] task to submit
+    const CmThreadSpace *threadSpace;  // [in] per task thread space, can be nullptr
+    CmEvent             *waitEvent;    // [in] event the task depends on, can be nullptr
+};
+
 //!
 //! \brief CM task queue management.
 //!
@@ -608,6 +618,31 @@ public:
     //!
     CM_RT_API virtual int32_t SetResidentGroupAndParallelThreadNum(uint32_t residentGroupNum, uint32_t parallelThreadNum) = 0;
 
+    //!
+    //! \brief   Enqueue an array of tasks with per-task thread space in one call.
+    //! \details Tasks are enqueued in array order as if Enqueue was called for each
+    //!          of them, but they are marshalled to the driver at once, only the last
+    //!          task generates an event and the queue is flushed once for the batch.
+    //!          Since the queue is in-order, the event of the last task also signals
+    //!          completion of the others. A wait event generated by this queue is
+    //!          honored by the queue order. For a wait event of another queue, the
+    //!          tasks before it are flushed and the driver waits for the event before
+    //!          enqueuing the dependent task.
+    //! \param   [in] tasks
+    //!          array of tasks to submit
+    //! \param   [in] taskCount
+    //!          number of tasks in the array
+    //! \param   [in,out] event
+    //!          reference to pointer of event generated for the last task. If it is
+    //!          set as CM_NO_EVENT, its value returned by runtime is NULL.
+    //! \retval  CM_SUCCESS if all tasks are successfully enqueued.
+    //! \retval  CM_INVALID_ARG_VALUE if the array or any task in it is not valid
+    //! \retval  CM_FAILURE otherwise, tasks before the failing one stay enqueued
+    //!
+    CM_RT_API virtual int32_t EnqueueBatch(const CM_BATCH_TASK *tasks,
+                                           uint32_t taskCount,
+                                           CmEvent *&event) = 0;
+
 protected:
     virtual ~CmQueue() = default;
 };
@@ -1494,6 +1494,26 @@ protected:
    ~CmVebox(){};
 };
 
+struct CM_BATCH_TASK
+{
+    CmTask              *task;         // task to submit
+    const CmThreadSpace *threadSpace;  // per task thread space, can be nullptr
+    CmEvent             *waitEvent;    // event the task depends on, can be nullptr.
+                                       // An event of another queue is waited for on the CPU
+                                       // by EnqueueBatch, which flushes and blocks mid-batch.
+};
+
+#define CM_API_PERF_HISTOGRAM_BUCKETS 24  // bucket 0: < 1us, bucket i: [2^(i-1), 2^i) us, last bucket: no upper bound
+
+struct CM_API_PERF_STATISTIC
+{
+    char     functionName[256];                          // API name
+    float    time;                                       // accumulative API duration in ms
+    uint32_t callTimes;                                  // called times
+    float    maxTime;                                    // longest API duration in ms
+    uint32_t histogram[CM_API_PERF_HISTOGRAM_BUCKETS];   // called times per duration bucket
+};
+
 class CmQueue
 {
 public:
@@ -1528,6 +1548,8 @@ public:
 
     CM_RT_API virtual INT SetResidentGroupAndParallelThreadNum(uint32_t residentGroupNum, uint32_t parallelThreadNum) = 0;
 
+    CM_RT_API virtual int32_t EnqueueBatch(const CM_BATCH_TASK *tasks, uint32_t taskCount, CmEvent *&event) = 0;
+
 protected:
     ~CmQueue(){};
 };
@@ -1549,6 +1571,7 @@ typedef void (*IMG_WALKER_FUNTYPE)(void* img, void* arg);
 EXTERN_C CM_RT_API INT DestroyCmDevice(CmDevice* &device);
 EXTERN_C CM_RT_API INT CMRT_Enqueue(CmQueue* queue, CmTask* task, CmEvent** event, const CmThreadSpace* threadSpace = nullptr);
 EXTERN_C CM_RT_API const char* GetCmErrorString(int errCode);
+EXTERN_C CM_RT_API INT GetCmApiPerfStatistics(CM_API_PERF_STATISTIC *statistics, uint32_t *count);
 
 //**********************************************************************
 // Platfom specific definitions
@@ -220,6 +220,10 @@ struct CodechalDecodeParams
     bool                    m_bitstreamLockingInUse = false;
     //! \brief [VP8] Indicates whether or not the bitstream buffer may be directly locked to perform header parsing.
     bool                    m_bitstreamLockable = false;
+    //! \brief [VP8] Host copy of the start of bitstream buffer to parse frame header without locking, may be nullptr
+    const uint8_t           *m_bitstreamHostData = nullptr;
+    //! \brief [VP8] Valid bytes in m_bitstreamHostData
+    uint32_t                m_bitstreamHostSize = 0;
 
     //! \brief [SetMarker] Indicates whether or not SetMarker is enabled
     bool                    m_setMarkerEnabled = false;
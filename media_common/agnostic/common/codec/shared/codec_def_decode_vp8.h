@@ -111,5 +111,30 @@ typedef struct _CODEC_VP8_IQ_MATRIX_PARAMS
     uint16_t              quantization_values[4][6];
 } CODEC_VP8_IQ_MATRIX_PARAMS, *PCODEC_VP8_IQ_MATRIX_PARAMS;
 
+//!
+//! \brief    Get bytes from the start of VP8 frame which are read to parse frame head
+//! \details  Uncompressed data chunk, first partition, token partition sizes and the
+//!           bytes which bool decoder may load beyond first partition
+//! \param    [in] frame
+//!           VP8 frame
+//! \param    [in] frameSize
+//!           Size of VP8 frame
+//! \return   uint32_t
+//!           Bytes to read, no more than frameSize
+//!
+inline uint32_t CodecVp8GetFrameHeadSize(const uint8_t *frame, uint32_t frameSize)
+{
+    if (frame == nullptr || frameSize < 3)
+    {
+        return frameSize;
+    }
+
+    uint32_t firstPartitionSize = ((uint32_t)frame[0] | ((uint32_t)frame[1] << 8) | ((uint32_t)frame[2] << 16)) >> 5;
+    uint32_t uncompSize         = (frame[0] & 1) ? 3 : 10;  // Key frame has start code and frame size
+    uint32_t headSize           = uncompSize + firstPartitionSize + (CODEC_VP8_MAX_PARTITION_NUMBER - 2) * 3 + sizeof(uint64_t);
+
+    return headSize < frameSize ? headSize : frameSize;
+}
+
 #endif
 
@@ -1018,6 +1018,11 @@ typedef struct _MOS_INTERFACE
         PMOS_INTERFACE              pOsInterface,
         PMOS_RESOURCE               pResource);
 
+    MOS_STATUS (* pfnDecompResourceBatch) (
+        PMOS_INTERFACE              pOsInterface,
+        PMOS_RESOURCE               *ppResources,
+        uint32_t                    count);
+
     MOS_STATUS (* pfnSetDecompSyncRes) (
         PMOS_INTERFACE              pOsInterface,
         PMOS_RESOURCE               syncResource);
@@ -2050,7 +2055,7 @@ typedef struct _MOS_INTERFACE
     MediaUserSettingSharedPtr (*pfnGetUserSettingInstance)(
         PMOS_INTERFACE              pOsInterface);
 
-    bool (*pfnInsertCacheSetting)(CACHE_COMPONENTS id, std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheTablesPtr);
+    bool (*pfnInsertCacheSetting)(CACHE_COMPONENTS id, const MOS_CACHE_TABLE *cacheTablesPtr);
 
     bool (*pfnGetCacheSetting)(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf);
 
@@ -2516,7 +2521,7 @@ void Mos_ResetMosResource(
     PMOS_RESOURCE           resource);
 
 
-bool Mos_InsertCacheSetting(CACHE_COMPONENTS id, std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheTablesPtr);
+bool Mos_InsertCacheSetting(CACHE_COMPONENTS id, const MOS_CACHE_TABLE *cacheTablesPtr);
 
 bool Mos_GetCacheSetting(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf);
 
@@ -360,6 +360,9 @@
 #define __MEDIA_USER_FEATURE_VALUE_MDF_FORCE_EXECUTION_PATH                 "MDF Execution Path Forced by User"
 #define __MEDIA_USER_FEATURE_VALUE_MDF_MAX_THREAD_NUM                       "CmMaxThreads"
 #define __MEDIA_USER_FEATURE_VALUE_MDF_FORCE_COHERENT_STATELESSBTI          "ForceCoherentStatelessBTI"
+#define __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_ENABLE                     "MDF JIT Cache Enable"
+#define __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_PATH                       "MDF JIT Cache Path"
+#define __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_MAX_SIZE                   "MDF JIT Cache Max Size"
 
 //User feature key for VP
 #define __MEDIA_USER_FEATURE_VALUE_VP_3P_DUMP_UFKEY_LOCATION                "Software\\Intel\\VPPDPI"
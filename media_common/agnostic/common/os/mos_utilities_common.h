@@ -378,6 +378,9 @@ typedef enum _MOS_USER_FEATURE_VALUE_ID
     __MEDIA_USER_FEATURE_VALUE_MDF_FORCE_EXECUTION_PATH_ID,
     __MEDIA_USER_FEATURE_VALUE_MDF_MAX_THREAD_NUM_ID,
     __MEDIA_USER_FEATURE_VALUE_MDF_FORCE_COHERENT_STATELESSBTI_ID,
+    __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_ENABLE_ID,
+    __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_PATH_ID,
+    __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_MAX_SIZE_ID,
     __MEDIA_USER_FEATURE_ENABLE_RENDER_ENGINE_MMC_ID,
     __MEDIA_USER_FEATURE_VALUE_DISABLE_MMC_ID,
     __MEDIA_USER_FEATURE_VALUE_FORCE_MMC_ON_ID,
@@ -198,7 +198,7 @@ typedef struct _DDI_CODEC_COM_BUFFER_MGR
     uint32_t                                     m_maxNumSliceData;
     uint32_t                                     dwNumSliceData;
     uint32_t                                     dwNumSliceControl;
-    uint32_t                                     dwMaxBsSize;
+    uint32_t                                     dwMaxBsSize;        // size of bitstream buffers, grows with the largest frame seen
 
     uint32_t                                     dwSizeOfRenderedSliceData; // Size of all the rendered slice data buffer
     uint32_t                                     dwNumOfRenderedSliceData; // how many slice data buffers will be rendered.
@@ -41,5 +41,13 @@
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_SOFTPIN       "Enable Softpin"
 #define __MEDIA_USER_FEATURE_VALUE_DISABLE_KMD_WATCHDOG "Disable KMD Watchdog"
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_VM_BIND       "Enable VM Bind"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_HUGE_PAGE_ENABLE     "CPU Memory Huge Page Enable"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_NUMA_LOCAL_ENABLE    "CPU Memory NUMA Local Enable"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_MIN_SIZE      "CPU Memory Policy Min Size"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_HUGE_PAGE_COUNT      "CPU Memory Huge Page Count"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_NUMA_LOCAL_COUNT     "CPU Memory NUMA Local Count"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_FALLBACK_COUNT "CPU Memory Policy Fallback Count"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_ALLOC_COUNT   "CPU Memory Policy Alloc Count"
+#define __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_MAP_COUNT     "CPU Memory Policy Map Count"
 
 #endif // __MOS_UTIL_USER_FEATURE_KEYS_SPECIFIC_H__
@@ -0,0 +1,324 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_jit_cache.cpp
+//! \brief     Contains Class CmJitCache definitions
+//!
+
+#include "cm_jit_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+namespace
+{
+// Layout of entry file: EntryHeader, key description, binary
+struct EntryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t keyDescSize;
+    uint32_t binarySize;
+    uint32_t isSpill;
+    int32_t  numGRFUsed;
+    int32_t  numAsmCount;
+    uint32_t spillMemUsed;
+    uint32_t numFlagSpillStore;
+    uint32_t numFlagSpillLoad;
+    uint32_t usesBarrier;
+    uint32_t numGRFSpillFill;
+    uint64_t checksum;  // of key description and binary
+};
+
+const uint64_t fnvOffsetBasis = 0xcbf29ce484222325ULL;
+const uint64_t fnvPrime       = 0x100000001b3ULL;
+
+uint64_t HashFnv1a(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+// MurmurHash64A, independent of FNV-1a so that the entry name is 128 bits
+uint64_t HashMurmur64(const void *data, size_t size, uint64_t seed)
+{
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int      r = 47;
+
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint64_t       hash  = seed ^ (size * m);
+
+    size_t blocks = size / 8;
+    for (size_t i = 0; i < blocks; i++)
+    {
+        uint64_t k;
+        memcpy(&k, bytes + i * 8, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        hash ^= k;
+        hash *= m;
+    }
+
+    const uint8_t *tail = bytes + blocks * 8;
+    switch (size & 7)
+    {
+    case 7: hash ^= (uint64_t)tail[6] << 48;  // fall through
+    case 6: hash ^= (uint64_t)tail[5] << 40;  // fall through
+    case 5: hash ^= (uint64_t)tail[4] << 32;  // fall through
+    case 4: hash ^= (uint64_t)tail[3] << 24;  // fall through
+    case 3: hash ^= (uint64_t)tail[2] << 16;  // fall through
+    case 2: hash ^= (uint64_t)tail[1] << 8;  // fall through
+    case 1: hash ^= (uint64_t)tail[0];
+            hash *= m;
+    }
+
+    hash ^= hash >> r;
+    hash *= m;
+    hash ^= hash >> r;
+    return hash;
+}
+}  // namespace
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Constructor of CmJitCache
+//*-----------------------------------------------------------------------------
+CmJitCache::CmJitCache(const std::string &directory, uint64_t maxSize) :
+    m_directory(directory),
+    m_maxSize(maxSize),
+    m_hitCount(0),
+    m_missCount(0)
+{
+    m_isValid = !m_directory.empty() && m_maxSize > 0 && CreateCacheDirectory(m_directory);
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Describe the key and get name of its entry file
+//| Returns:    Name of entry file
+//*-----------------------------------------------------------------------------
+std::string CmJitCache::GetEntryName(const KeyInfo &key, std::string &keyDesc) const
+{
+    char number[64];
+
+    // Key description is stored in the entry and compared on load, so entries
+    // are never mixed up even if the name collides.
+    keyDesc.clear();
+    keyDesc += key.kernelName ? key.kernelName : "";
+    keyDesc += '\n';
+    keyDesc += key.platform ? key.platform : "";
+    keyDesc += '\n';
+    for (int i = 0; i < key.numJitFlags; i++)
+    {
+        keyDesc += key.jitFlags[i] ? key.jitFlags[i] : "";
+        keyDesc += ' ';
+    }
+    snprintf(number, sizeof(number), "\n%u.%u\n%u\n%016llx",
+        key.jitMajor, key.jitMinor, key.cisaCodeSize,
+        (unsigned long long)HashMurmur64(key.cisaCode, key.cisaCodeSize, 0));
+    keyDesc += number;
+
+    uint64_t hashA = HashFnv1a(fnvOffsetBasis, keyDesc.data(), keyDesc.size());
+    hashA          = HashFnv1a(hashA, key.cisaCode, key.cisaCodeSize);
+    uint64_t hashB = HashMurmur64(keyDesc.data(), keyDesc.size(), hashA);
+
+    snprintf(number, sizeof(number), "%016llx%016llx.bin",
+        (unsigned long long)hashA, (unsigned long long)hashB);
+    return number;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Load jitted binary of the kernel
+//| Returns:    true if cache hits
+//*-----------------------------------------------------------------------------
+bool CmJitCache::Load(const KeyInfo &key, void *&binary, uint32_t &binarySize, FINALIZER_INFO *jitInfo)
+{
+    binary     = nullptr;
+    binarySize = 0;
+
+    if (!m_isValid || key.cisaCode == nullptr || jitInfo == nullptr)
+    {
+        return false;
+    }
+
+    std::string          keyDesc;
+    std::string          path = m_directory + "/" + GetEntryName(key, keyDesc);
+    std::vector<uint8_t> data;
+    EntryHeader          header;
+
+    bool valid = ReadEntryFile(path, data) && data.size() >= sizeof(header);
+    if (valid)
+    {
+        memcpy(&header, data.data(), sizeof(header));
+        valid = header.magic == m_entryMagic &&
+                header.version == m_entryVersion &&
+                header.keyDescSize == keyDesc.size() &&
+                header.binarySize > 0 &&
+                data.size() == sizeof(header) + (uint64_t)header.keyDescSize + header.binarySize;
+    }
+    if (valid)
+    {
+        const uint8_t *payload = data.data() + sizeof(header);
+        valid = memcmp(payload, keyDesc.data(), keyDesc.size()) == 0 &&
+                HashFnv1a(fnvOffsetBasis, payload, data.size() - sizeof(header)) == header.checksum;
+    }
+    if (!valid)
+    {
+        // Missing, truncated or stale entry, it is replaced by the next Store()
+        m_missCount++;
+        return false;
+    }
+
+    binary = malloc(header.binarySize);
+    if (binary == nullptr)
+    {
+        m_missCount++;
+        return false;
+    }
+    memcpy(binary, data.data() + sizeof(header) + header.keyDescSize, header.binarySize);
+    binarySize = header.binarySize;
+
+    memset(jitInfo, 0, sizeof(*jitInfo));
+    jitInfo->isSpill           = header.isSpill != 0;
+    jitInfo->numGRFUsed        = header.numGRFUsed;
+    jitInfo->numAsmCount       = header.numAsmCount;
+    jitInfo->spillMemUsed      = header.spillMemUsed;
+    jitInfo->numFlagSpillStore = header.numFlagSpillStore;
+    jitInfo->numFlagSpillLoad  = header.numFlagSpillLoad;
+    jitInfo->usesBarrier       = header.usesBarrier != 0;
+    jitInfo->numGRFSpillFill   = header.numGRFSpillFill;
+
+    // Modification time is the last use for LRU
+    TouchEntryFile(path);
+    m_hitCount++;
+    return true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Store jitted binary of the kernel
+//| Returns:    true if entry is written
+//*-----------------------------------------------------------------------------
+bool CmJitCache::Store(const KeyInfo &key, const void *binary, uint32_t binarySize, const FINALIZER_INFO *jitInfo)
+{
+    if (!m_isValid || key.cisaCode == nullptr || binary == nullptr || binarySize == 0 || jitInfo == nullptr)
+    {
+        return false;
+    }
+
+    std::string keyDesc;
+    std::string name = GetEntryName(key, keyDesc);
+
+    EntryHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic             = m_entryMagic;
+    header.version           = m_entryVersion;
+    header.keyDescSize       = (uint32_t)keyDesc.size();
+    header.binarySize        = binarySize;
+    header.isSpill           = jitInfo->isSpill ? 1 : 0;
+    header.numGRFUsed        = jitInfo->numGRFUsed;
+    header.numAsmCount       = jitInfo->numAsmCount;
+    header.spillMemUsed      = jitInfo->spillMemUsed;
+    header.numFlagSpillStore = jitInfo->numFlagSpillStore;
+    header.numFlagSpillLoad  = jitInfo->numFlagSpillLoad;
+    header.usesBarrier       = jitInfo->usesBarrier ? 1 : 0;
+    header.numGRFSpillFill   = jitInfo->numGRFSpillFill;
+
+    std::vector<uint8_t> data(sizeof(header) + keyDesc.size() + binarySize);
+    uint8_t *payload = data.data() + sizeof(header);
+    memcpy(payload, keyDesc.data(), keyDesc.size());
+    memcpy(payload + keyDesc.size(), binary, binarySize);
+    header.checksum = HashFnv1a(fnvOffsetBasis, payload, keyDesc.size() + binarySize);
+    memcpy(data.data(), &header, sizeof(header));
+
+    if (!WriteEntryFile(m_directory, name, data))
+    {
+        return false;
+    }
+
+    EvictIfNeeded(data.size());
+    return true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Remove least recently used entries if cache exceeds max size
+//*-----------------------------------------------------------------------------
+void CmJitCache::EvictIfNeeded(uint64_t addedSize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Directory is shared by processes, so the size is an estimate and it is
+    // only scanned for the first store and when the estimate exceeds limit.
+    if (m_sizeScanned)
+    {
+        m_usedSize += addedSize;
+        if (m_usedSize <= m_maxSize)
+        {
+            return;
+        }
+    }
+
+    std::vector<EntryFile> files;
+    if (!ListEntryFiles(m_directory, files))
+    {
+        return;
+    }
+
+    uint64_t usedSize = 0;
+    for (auto &file : files)
+    {
+        usedSize += file.size;
+    }
+
+    if (usedSize > m_maxSize)
+    {
+        // Evict to 3/4 of limit, so that following stores do not evict again
+        uint64_t targetSize = m_maxSize - m_maxSize / 4;
+        std::sort(files.begin(), files.end(),
+            [](const EntryFile &a, const EntryFile &b) { return a.lastUse < b.lastUse; });
+        for (auto &file : files)
+        {
+            if (usedSize <= targetSize)
+            {
+                break;
+            }
+            RemoveEntryFile(m_directory + "/" + file.name);
+            usedSize -= file.size;
+        }
+    }
+
+    m_usedSize    = usedSize;
+    m_sizeScanned = true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Free binary returned by Load()
+//*-----------------------------------------------------------------------------
+void CmJitCache::FreeBinary(void *binary)
+{
+    free(binary);
+}
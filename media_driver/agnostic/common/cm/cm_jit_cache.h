@@ -0,0 +1,155 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_jit_cache.h
+//! \brief     Contains Class CmJitCache definitions
+//! \details   CmJitCache keeps GenX binaries generated by the jitter on disk, so
+//!            programs loaded again by later processes skip JIT compilation.
+//!            An entry is named by the hash of everything the jitter output
+//!            depends on and is published by atomic rename. The least recently
+//!            used entries are removed once the cache exceeds its size limit.
+//!
+
+#ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMJITCACHE_H_
+#define MEDIADRIVER_AGNOSTIC_COMMON_CM_CMJITCACHE_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "cm_jitter_info.h"
+
+class CmJitCache
+{
+public:
+    //!
+    //! \brief    Everything the jitter output of one kernel depends on
+    //!
+    struct KeyInfo
+    {
+        const char  *kernelName;
+        const void  *cisaCode;      //!< Whole CISA program passed to jitter
+        uint32_t    cisaCodeSize;
+        const char  *platform;
+        int         numJitFlags;    //!< Including stepping flags
+        const char  **jitFlags;
+        uint32_t    jitMajor;       //!< Jitter version
+        uint32_t    jitMinor;
+    };
+
+    //!
+    //! \brief    Constructor of CmJitCache
+    //! \param    [in] directory
+    //!           Cache directory, created if it does not exist
+    //! \param    [in] maxSize
+    //!           Max bytes of all entries in the directory
+    //!
+    CmJitCache(const std::string &directory, uint64_t maxSize);
+
+    ~CmJitCache() {}
+
+    //!
+    //! \brief    Get default cache directory of current user
+    //! \return   std::string
+    //!           Empty if there is no place to keep the cache
+    //!
+    static std::string GetDefaultDirectory();
+
+    //!
+    //! \brief    Load jitted binary of the kernel
+    //! \param    [in] key
+    //!           Kernel to load
+    //! \param    [out] binary
+    //!           Binary allocated by cache, released by FreeBinary()
+    //! \param    [out] binarySize
+    //!           Size of binary
+    //! \param    [out] jitInfo
+    //!           Jitter info of the binary, pointer fields are set to nullptr
+    //! \return   bool
+    //!           true if cache hits
+    //!
+    bool Load(const KeyInfo &key, void *&binary, uint32_t &binarySize, FINALIZER_INFO *jitInfo);
+
+    //!
+    //! \brief    Store jitted binary of the kernel
+    //! \param    [in] key
+    //!           Kernel to store
+    //! \param    [in] binary
+    //!           Binary generated by jitter
+    //! \param    [in] binarySize
+    //!           Size of binary
+    //! \param    [in] jitInfo
+    //!           Jitter info of the binary, pointer fields are not stored
+    //! \return   bool
+    //!           true if entry is written
+    //!
+    bool Store(const KeyInfo &key, const void *binary, uint32_t binarySize, const FINALIZER_INFO *jitInfo);
+
+    //!
+    //! \brief    Free binary returned by Load()
+    //!
+    static void FreeBinary(void *binary);
+
+    //! \brief    Cache hits since construction
+    uint32_t GetHitCount() const { return m_hitCount; }
+    //! \brief    Cache misses since construction
+    uint32_t GetMissCount() const { return m_missCount; }
+
+protected:
+    struct EntryFile
+    {
+        std::string name;
+        uint64_t    size;
+        int64_t     lastUse;  //!< Modification time, refreshed on hit
+    };
+
+    static const uint32_t m_entryMagic   = 0x434a4d43;  //!< "CMJC"
+    static const uint32_t m_entryVersion = 1;
+
+    std::string GetEntryName(const KeyInfo &key, std::string &keyDesc) const;
+    void        EvictIfNeeded(uint64_t addedSize);
+
+    // Implemented by OS
+    static bool CreateCacheDirectory(const std::string &directory);
+    static bool ReadEntryFile(const std::string &path, std::vector<uint8_t> &data);
+    static bool WriteEntryFile(const std::string &directory, const std::string &name, const std::vector<uint8_t> &data);
+    static bool ListEntryFiles(const std::string &directory, std::vector<EntryFile> &files);
+    static void TouchEntryFile(const std::string &path);
+    static void RemoveEntryFile(const std::string &path);
+
+    std::string m_directory;
+    uint64_t    m_maxSize     = 0;
+    uint64_t    m_usedSize    = 0;      //!< Estimate of bytes in directory, refreshed on eviction
+    bool        m_sizeScanned = false;
+    bool        m_isValid     = false;  //!< Directory is available
+    std::mutex  m_mutex;                //!< Protect size accounting and eviction
+
+    std::atomic<uint32_t> m_hitCount;
+    std::atomic<uint32_t> m_missCount;
+
+private:
+    CmJitCache(const CmJitCache &);
+    CmJitCache &operator=(const CmJitCache &);
+};
+
+#endif  // #ifndef MEDIADRIVER_AGNOSTIC_COMMON_CM_CMJITCACHE_H_
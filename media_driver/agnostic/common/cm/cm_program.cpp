@@ -29,6 +29,7 @@
 #include "cm_device_rt.h"
 #include "cm_mem.h"
 #include "cm_hal.h"
+#include "cm_jit_cache.h"
 
 #if USE_EXTENSION_CODE
 #include "cm_hw_debugger.h"
@@ -36,6 +37,7 @@
 
 #include <string>
 #include <functional>
+#include <mutex>
 
 #define READ_FIELD_FROM_BUF( dst, type ) \
     dst = *((type *) &buf[bytePos]); \
@@ -50,6 +52,55 @@
 
 namespace CMRT_UMD
 {
+//*-----------------------------------------------------------------------------
+//| Purpose:    Get JIT cache shared by all programs in the process
+//| Returns:    Pointer to JIT cache, nullptr if it is disabled.
+//*-----------------------------------------------------------------------------
+static CmJitCache *GetJitCache(PMOS_CONTEXT osContext)
+{
+    static CmJitCache     *jitCache = nullptr;
+    static std::once_flag jitCacheOnce;
+
+    std::call_once(jitCacheOnce, [osContext]() {
+        MOS_USER_FEATURE_VALUE_DATA userFeatureData;
+        MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+        MOS_UserFeature_ReadValue_ID(
+            nullptr, __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_ENABLE_ID,
+            &userFeatureData, osContext);
+        if (userFeatureData.u32Data == 0)
+        {
+            return;
+        }
+
+        std::string directory;
+        char path[MOS_USER_CONTROL_MAX_DATA_SIZE] = {};
+        MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+        userFeatureData.StringData.pStringData = path;
+        if (MOS_UserFeature_ReadValue_ID(
+                nullptr, __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_PATH_ID,
+                &userFeatureData, osContext) == MOS_STATUS_SUCCESS &&
+            userFeatureData.StringData.uSize > 0)
+        {
+            directory = path;
+        }
+        else
+        {
+            directory = CmJitCache::GetDefaultDirectory();
+        }
+
+        MOS_ZeroMemory(&userFeatureData, sizeof(userFeatureData));
+        MOS_UserFeature_ReadValue_ID(
+            nullptr, __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_MAX_SIZE_ID,
+            &userFeatureData, osContext);
+        uint64_t maxSize = (uint64_t)userFeatureData.u32Data * 1024 * 1024;
+
+        // Kept until process exits, as kernels loaded from cache may outlive any device
+        jitCache = new (std::nothrow) CmJitCache(directory, maxSize);
+    });
+
+    return jitCache;
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:    Create Cm Program
 //| Arguments :
@@ -281,6 +332,9 @@ int32_t CmProgramRT::Initialize( void* cisaCode, const uint32_t cisaCodeSize, co
     }
 
     const char *platform = nullptr;
+    uint32_t jitMajor = 0;
+    uint32_t jitMinor = 0;
+    CmJitCache *jitCache = nullptr;
 
     PCM_HAL_STATE  cmHalState = \
         ((PCM_CONTEXT_DATA)m_device->GetAccelData())->cmHalState;
@@ -320,8 +374,6 @@ int32_t CmProgramRT::Initialize( void* cisaCode, const uint32_t cisaCodeSize, co
         m_device->GetFreeBlockFnt(m_fFreeBlock);
         m_device->GetJITVersionFnt(m_fJITVersion);
 
-        uint32_t jitMajor = 0;
-        uint32_t jitMinor = 0;
         m_fJITVersion(jitMajor, jitMinor);
         if((jitMajor < m_cisaMajorVersion) || (jitMajor == m_cisaMajorVersion && jitMinor < m_cisaMinorVersion))
             return CM_JITDLL_OLDER_THAN_ISA;
@@ -364,6 +416,16 @@ int32_t CmProgramRT::Initialize( void* cisaCode, const uint32_t cisaCodeSize, co
                 return CM_OUT_OF_HOST_MEMORY;
             }
         }
+
+        // Binaries for debugger or GTPin carry extra data which is not cached
+        bool isInstrumented = m_isHwDebugEnabled;
+#if USE_EXTENSION_CODE
+        isInstrumented = isInstrumented || m_device->CheckGTPinEnabled();
+#endif
+        if (!isInstrumented)
+        {
+            jitCache = GetJitCache(cmHalState->osInterface->pOsContext);
+        }
     }
 
     if (useVisaApi)
@@ -599,7 +661,17 @@ int32_t CmProgramRT::Initialize( void* cisaCode, const uint32_t cisaCodeSize, co
                 notifiers->NotifyCallingJitter(&extra_info);
             }
 
-            if (m_fJITCompile_v2)
+            CmJitCache::KeyInfo jitCacheKey = {kernInfo->kernelName, cisaCode, cisaCodeSize, platform,
+                                               numJitFlags, jitFlags, jitMajor, jitMinor};
+            bool useJitCache = (jitCache != nullptr) && (extra_info == nullptr);
+            kernInfo->jitBinaryCached = false;
+
+            if (useJitCache && jitCache->Load(jitCacheKey, jitBinary, jitBinarySize, jitProfInfo))
+            {
+                result = CM_SUCCESS;
+                kernInfo->jitBinaryCached = true;
+            }
+            else if (m_fJITCompile_v2)
             {
                 result = m_fJITCompile_v2( kernInfo->kernelName, (uint8_t*)cisaCode, cisaCodeSize,
                                     jitBinary, jitBinarySize, platform, m_cisaMajorVersion, m_cisaMinorVersion, numJitFlags, jitFlags, errorMsg, jitProfInfo, extra_info );
@@ -630,6 +702,11 @@ int32_t CmProgramRT::Initialize( void* cisaCode, const uint32_t cisaCodeSize, co
 
             free(errorMsg);
 
+            if (useJitCache && !kernInfo->jitBinaryCached)
+            {
+                jitCache->Store(jitCacheKey, jitBinary, jitBinarySize, jitProfInfo);
+            }
+
             kernInfo->jitBinaryCode = jitBinary;
             kernInfo->jitBinarySize = jitBinarySize;
             kernInfo->jitInfo = jitProfInfo;
@@ -861,7 +938,16 @@ uint32_t CmProgramRT::ReleaseKernelInfo(uint32_t index)
                 if(m_isJitterEnabled)
                 {
                     if(kernelInfo->jitBinaryCode)
-                        m_fFreeBlock(kernelInfo->jitBinaryCode);
+                    {
+                        if (kernelInfo->jitBinaryCached)
+                        {
+                            CmJitCache::FreeBinary(kernelInfo->jitBinaryCode);
+                        }
+                        else
+                        {
+                            m_fFreeBlock(kernelInfo->jitBinaryCode);
+                        }
+                    }
                     if(kernelInfo->jitInfo)
                     {
                         if (kernelInfo->jitInfo->freeGRFInfo)
@@ -100,6 +100,7 @@ struct CM_KERNEL_INFO
     bool blNoBarrier;       //Indicate if the barrier is used in kernel: true means no barrier used, false means barrier is used.
 
     FINALIZER_INFO *jitInfo;
+    bool jitBinaryCached;   //jitBinaryCode is loaded from jit cache instead of created by jitter
 
     uint32_t variableCount;
     gen_var_info_t *variables;
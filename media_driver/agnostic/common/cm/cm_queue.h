@@ -54,6 +54,16 @@ class CmVebox;
 class CmSurface2D;
 class CmBuffer;
 
+//!
+//! \brief      One task of a batch submitted by CmQueue::EnqueueBatch.
+//!
+struct CM_BATCH_TASK
+{
+    CmTask              *task;         // [in] task to submit
+    const CmThreadSpace *threadSpace;  // [in] per task thread space, can be nullptr
+    CmEvent             *waitEvent;    // [in] event the task depends on, can be nullptr
+};
+
 //!
 //! \brief      CmQueue class for task queue management.
 //! \details    The CmQueue object represents a CM task queue. Each task
@@ -455,6 +465,33 @@ public:
     CM_RT_API virtual int32_t EnqueueWithGroupFast(CmTask *task,
                                   CmEvent *&event,
                                   const CmThreadGroupSpace *threadGroupSpace = nullptr) = 0;
+
+    //!
+    //! \brief   Enqueue an array of tasks with per-task thread space in one call.
+    //! \details Tasks are enqueued in array order as if Enqueue was called for each
+    //!          of them, but only the last task generates an event and the queue is
+    //!          flushed once for the whole batch. Since the queue is in-order, the
+    //!          event of the last task also signals completion of the others.
+    //!          A wait event generated by this queue is honored by the queue order.
+    //!          For a wait event of another queue, the tasks before it are flushed
+    //!          and the calling thread blocks on the CPU in WaitForTaskFinished()
+    //!          until that event completes, then enqueues the dependent task. Such
+    //!          a batch is split into several submissions and stalls the caller.
+    //! \param   [in] tasks
+    //!          array of tasks to submit
+    //! \param   [in] taskCount
+    //!          number of tasks in the array
+    //! \param   [in,out] event
+    //!          reference to pointer of event generated for the last task. If it is
+    //!          set as CM_NO_EVENT, its value returned by runtime is NULL.
+    //! \retval  CM_SUCCESS if all tasks are successfully enqueued.
+    //! \retval  CM_INVALID_ARG_VALUE if the array or any task in it is not valid
+    //! \retval  CM_OUT_OF_HOST_MEMORY if out of host memory
+    //! \retval  CM_FAILURE otherwise, tasks before the failing one stay enqueued
+    //!
+    CM_RT_API virtual int32_t EnqueueBatch(const CM_BATCH_TASK *tasks,
+                                           uint32_t taskCount,
+                                           CmEvent *&event) = 0;
 };
 };//namespace
 
@@ -63,6 +63,8 @@ using namespace CMRT_UMD;
 
 namespace CMRT_UMD
 {
+    thread_local CmQueueRT *CmQueueRT::m_batchingQueue = nullptr;
+
     typedef struct _tdata
     {
         void* pCmQueueRT;
@@ -479,6 +481,12 @@ CM_RT_API int32_t CmQueueRT::Enqueue(
         cmHalState->advExecutor->SwitchToFastPath(kernelArray) &&
         cmHalState->cmHalInterface->IsFastPathByDefault())
     {
+        if (m_batchingQueue == this)
+        {
+            // Fast path submits at once, so flush tasks deferred by EnqueueBatch to keep the order
+            FlushTaskWithoutSync();
+        }
+
         auto gpu_context_name
                 = static_cast<MOS_GPU_CONTEXT>(m_queueOption.GPUContext);
         uint32_t old_stream_idx = cmHalState->pfnSetGpuContext(cmHalState,
@@ -564,6 +572,90 @@ CM_RT_API int32_t CmQueueRT::Enqueue(
     return result;
 }
 
+//*-----------------------------------------------------------------------------
+//| Purpose:    Enqueue an array of tasks and flush them once
+//| Arguments :
+//|               tasks            [in]       Array of tasks with thread space and wait event
+//|               taskCount        [in]       Number of tasks in the array
+//|               event            [in/out]   Reference to the pointer to Event of the last task
+//|
+//| Returns:    Result of the operation.
+//*-----------------------------------------------------------------------------
+CM_RT_API int32_t CmQueueRT::EnqueueBatch(
+           const CM_BATCH_TASK *tasks,
+           uint32_t taskCount,
+           CmEvent* & event)
+{
+    INSERT_API_CALL_LOG(GetHalState());
+
+    if (tasks == nullptr || taskCount == 0)
+    {
+        CM_ASSERTMESSAGE("Error: Batch task array is empty.");
+        return CM_INVALID_ARG_VALUE;
+    }
+
+    for (uint32_t i = 0; i < taskCount; i++)
+    {
+        if (tasks[i].task == nullptr)
+        {
+            CM_ASSERTMESSAGE("Error: Task %d of the batch is null.", i);
+            return CM_INVALID_ARG_VALUE;
+        }
+    }
+
+    CLock batchLocker(m_criticalSectionBatch);
+
+    m_batchingQueue = this;
+
+    int32_t result = CM_SUCCESS;
+    for (uint32_t i = 0; i < taskCount; i++)
+    {
+        CmEvent *waitEvent = tasks[i].waitEvent;
+        if (waitEvent != nullptr && waitEvent != CM_NO_EVENT)
+        {
+            CmEventRT *waitEventRT = dynamic_cast<CmEventRT *>(waitEvent);
+            CmQueueRT *waitQueue   = nullptr;
+            if (waitEventRT != nullptr)
+            {
+                waitEventRT->GetQueue(waitQueue);
+            }
+
+            // The queue is in-order, so only wait for events of other queues
+            if (waitQueue != this)
+            {
+                FlushTaskWithoutSync();
+                result = waitEvent->WaitForTaskFinished();
+                if (result != CM_SUCCESS)
+                {
+                    CM_ASSERTMESSAGE("Error: Wait event of task %d of the batch failure.", i);
+                    break;
+                }
+            }
+        }
+
+        // Only the last task generates the event visible to user
+        bool isLastTask = (i == taskCount - 1);
+        CmEvent *taskEvent = isLastTask ? event : CM_NO_EVENT;
+        result = Enqueue(tasks[i].task, taskEvent, tasks[i].threadSpace);
+        if (result != CM_SUCCESS)
+        {
+            CM_ASSERTMESSAGE("Error: Enqueue task %d of the batch failure.", i);
+            break;
+        }
+        if (isLastTask)
+        {
+            event = taskEvent;
+        }
+    }
+
+    m_batchingQueue = nullptr;
+
+    // Tasks enqueued before a failure are flushed as well
+    int32_t flushResult = FlushTaskWithoutSync();
+
+    return (result != CM_SUCCESS) ? result : flushResult;
+}
+
 //*-----------------------------------------------------------------------------
 //| Purpose:      Enqueue Task
 //| Arguments :
@@ -648,7 +740,10 @@ int32_t CmQueueRT::Enqueue_RT(
         return CM_FAILURE;
     }
 
-    result = FlushTaskWithoutSync();
+    if (m_batchingQueue != this)
+    {
+        result = FlushTaskWithoutSync();
+    }
 
     return result;
 }
@@ -728,7 +823,10 @@ int32_t CmQueueRT::Enqueue_RT(CmKernelRT* kernelArray[],
         return CM_FAILURE;
     }
 
-    result = FlushTaskWithoutSync();
+    if (m_batchingQueue != this)
+    {
+        result = FlushTaskWithoutSync();
+    }
 
     return result;
 }
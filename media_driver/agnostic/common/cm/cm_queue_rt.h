@@ -184,6 +184,10 @@ public:
                                       CmEvent *&event,
                                       const CmThreadGroupSpace *threadGroupSpace = nullptr);
 
+    CM_RT_API int32_t EnqueueBatch(const CM_BATCH_TASK *tasks,
+                                   uint32_t taskCount,
+                                   CmEvent *&event);
+
     int32_t EnqueueCopyInternal_1Plane(CmSurface2DRT *surface,
                                        unsigned char *sysMem,
                                        CM_SURFACE_FORMAT format,
@@ -346,6 +350,9 @@ protected:
     CSync m_criticalSectionHalExecute;   // Protect execution in HALCm, i.e HalCm_Execute
     CSync m_criticalSectionFlushedTask;  // Protect QueryFlushedTask
     CSync m_criticalSectionTaskInternal;
+    CSync m_criticalSectionBatch;        // Serialize EnqueueBatch
+    static thread_local CmQueueRT *m_batchingQueue;  // Queue whose EnqueueBatch runs on this thread, its tasks enqueued
+                                                     // by this thread are flushed by EnqueueBatch
 
     uint32_t m_eventCount;
     uint64_t m_CPUperformanceFrequency;
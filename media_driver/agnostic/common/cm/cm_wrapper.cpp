@@ -143,6 +143,7 @@ using CMRT_UMD::CmProgramRT;
 using CMRT_UMD::CmTask;
 using CMRT_UMD::CmTaskRT;
 using CMRT_UMD::CmQueue;
+using CMRT_UMD::CM_BATCH_TASK;
 using CMRT_UMD::CmQueueRT;
 using CMRT_UMD::CmThreadSpace;
 using CMRT_UMD::CmThreadGroupSpace;
@@ -553,6 +554,24 @@ int32_t CmThinExecuteInternal(CmDevice *device,
      }
         break;
 
+     case CM_FN_CMQUEUE_ENQUEUEBATCH:
+     {
+        PCM_ENQUEUEBATCH_PARAM cmEnqueueBatchParam;
+        cmEnqueueBatchParam = (PCM_ENQUEUEBATCH_PARAM)(cmPrivateInputData);
+        cmQueue             = (CmQueue *)cmEnqueueBatchParam->queueHandle;
+        cmEvent             = (CmEvent *)cmEnqueueBatchParam->eventHandle; // used as input
+
+        CM_ASSERT(cmQueue);
+
+        cmRet = cmQueue->EnqueueBatch((const CM_BATCH_TASK *)cmEnqueueBatchParam->batchTasks,
+                                      cmEnqueueBatchParam->taskCount,
+                                      cmEvent);
+
+        cmEnqueueBatchParam->eventHandle = cmEvent;
+        cmEnqueueBatchParam->returnValue = cmRet;
+     }
+        break;
+
      case CM_FN_CMQUEUE_ENQUEUEWITHHINTS:
         PCM_ENQUEUEHINTS_PARAM cmEnqueueHintsParam;
         cmEnqueueHintsParam = (PCM_ENQUEUEHINTS_PARAM)(cmPrivateInputData);
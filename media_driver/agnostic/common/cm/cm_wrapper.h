@@ -140,6 +140,15 @@ typedef struct _CM_ENQUEUEHINTS_PARAM
     int32_t              returnValue;          // [out]
 }CM_ENQUEUEHINTS_PARAM, *PCM_ENQUEUEHINTS_PARAM;
 
+typedef struct _CM_ENQUEUEBATCH_PARAM
+{
+    void                *queueHandle;         // [in]
+    void                *batchTasks;          // [in] array of CM_BATCH_TASK
+    uint32_t            taskCount;             // [in]
+    void                *eventHandle;         // [in/out] event of the last task
+    int32_t             returnValue;           // [out]
+}CM_ENQUEUEBATCH_PARAM, *PCM_ENQUEUEBATCH_PARAM;
+
 typedef struct _CM_DESTROYEVENT_PARAM
 {
     void                *queueHandle;         // [in]
@@ -537,6 +546,7 @@ enum CM_FUNCTION_ID
     CM_FN_CMQUEUE_DESTROYEVENTFAST  = 0x150b,
     CM_FN_CMQUEUE_ENQUEUEWITHGROUPFAST = 0x150c,
     CM_FN_CMQUEUE_ENQUEUECOPY_BUFFER   = 0x150d,
+    CM_FN_CMQUEUE_ENQUEUEBATCH         = 0x150e,
 };
 
 //*-----------------------------------------------------------------------------
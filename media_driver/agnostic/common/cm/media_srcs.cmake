@@ -29,6 +29,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/cm_hal_hashtable.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_hal_dump.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_hal_vebox.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/cm_jit_cache.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_kernel_rt.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_kernel_data.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cm_log.cpp
@@ -80,6 +81,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/cm_hal_generic.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_hal_hashtable.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_hal_vebox.h
+    ${CMAKE_CURRENT_LIST_DIR}/cm_jit_cache.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_kernel.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_kernel_rt.h
     ${CMAKE_CURRENT_LIST_DIR}/cm_kernel_data.h
@@ -2447,6 +2447,33 @@ MOS_USER_FEATURE_VALUE MosUtilities::m_mosUserFeatureDescFields[__MOS_USER_FEATU
         MOS_USER_FEATURE_VALUE_TYPE_UINT32,
         "0",
         "MDF coherent stateless BTI specified by user"),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_ENABLE_ID,
+        __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_ENABLE,
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "MDF",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_UINT32,
+        "0",
+        "Keep jitted kernel binaries on disk and reuse them in later processes"),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_PATH_ID,
+        __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_PATH,
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "MDF",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_STRING,
+        "",
+        "MDF JIT cache directory, XDG cache directory of the user if empty"),
+    MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_MAX_SIZE_ID,
+        __MEDIA_USER_FEATURE_VALUE_MDF_JIT_CACHE_MAX_SIZE,
+        __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
+        __MEDIA_USER_FEATURE_SUBKEY_REPORT,
+        "MDF",
+        MOS_USER_FEATURE_TYPE_USER,
+        MOS_USER_FEATURE_VALUE_TYPE_UINT32,
+        "256",
+        "Max size of MDF JIT cache in MB, least recently used binaries are removed beyond it"),
     MOS_DECLARE_UF_KEY(__MEDIA_USER_FEATURE_VALUE_MDF_EMU_MODE_ENABLE_ID,
         __MEDIA_USER_FEATURE_VALUE_MDF_EMU_MODE_ENABLE,
         __MEDIA_USER_FEATURE_SUBKEY_INTERNAL,
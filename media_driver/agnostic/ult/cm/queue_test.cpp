@@ -53,6 +53,22 @@ public:
         return CM_SUCCESS;
     }//===================
 
+    int32_t EnqueueBatchWithoutTask()
+    {
+        int32_t result = m_mockDevice->CreateQueue(m_queue);
+        EXPECT_EQ(CM_SUCCESS, result);
+        CMRT_UMD::CmEvent *event = nullptr;
+        result = m_queue->EnqueueBatch(nullptr, 1, event);
+        EXPECT_EQ(CM_INVALID_ARG_VALUE, result);
+        CMRT_UMD::CM_BATCH_TASK batch_tasks[2] = {};
+        result = m_queue->EnqueueBatch(batch_tasks, 0, event);
+        EXPECT_EQ(CM_INVALID_ARG_VALUE, result);
+        result = m_queue->EnqueueBatch(batch_tasks, 2, event);
+        EXPECT_EQ(CM_INVALID_ARG_VALUE, result);
+        EXPECT_EQ(nullptr, event);
+        return CM_SUCCESS;
+    }//===================
+
 private:
     CmQueue *m_queue;
 };//=================
@@ -70,3 +86,10 @@ TEST_F(QueueTest, EnqueueWithoutTask)
                      [this]() { return EnqueueWithoutTask(); });
     return;
 }//========
+
+TEST_F(QueueTest, EnqueueBatchWithoutTask)
+{
+    RunEach<int32_t>(CM_SUCCESS,
+                     [this]() { return EnqueueBatchWithoutTask(); });
+    return;
+}//========
@@ -0,0 +1,230 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file      cm_jit_cache_os.cpp
+//! \brief     Contains Linux-dependent file operations of CmJitCache
+//!
+
+#include "cm_jit_cache.h"
+
+#include <atomic>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CM_JIT_CACHE_SUB_DIRECTORY "intel-media-driver/cm_jit_cache"
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Get default cache directory of current user
+//| Returns:    $XDG_CACHE_HOME or $HOME/.cache based directory
+//*-----------------------------------------------------------------------------
+std::string CmJitCache::GetDefaultDirectory()
+{
+    const char *cacheHome = getenv("XDG_CACHE_HOME");
+    if (cacheHome != nullptr && cacheHome[0] == '/')
+    {
+        return std::string(cacheHome) + "/" + CM_JIT_CACHE_SUB_DIRECTORY;
+    }
+
+    const char *home = getenv("HOME");
+    if (home != nullptr && home[0] == '/')
+    {
+        return std::string(home) + "/.cache/" + CM_JIT_CACHE_SUB_DIRECTORY;
+    }
+
+    return std::string();
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Create directory and its parents
+//| Returns:    true if directory exists
+//*-----------------------------------------------------------------------------
+bool CmJitCache::CreateCacheDirectory(const std::string &directory)
+{
+    for (size_t pos = 1; pos <= directory.size(); pos++)
+    {
+        if (pos == directory.size() || directory[pos] == '/')
+        {
+            std::string parent = directory.substr(0, pos);
+            if (mkdir(parent.c_str(), S_IRWXU) != 0 && errno != EEXIST)
+            {
+                return false;
+            }
+        }
+    }
+
+    struct stat info;
+    return stat(directory.c_str(), &info) == 0 && S_ISDIR(info.st_mode) && access(directory.c_str(), R_OK | W_OK | X_OK) == 0;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Read whole entry file
+//| Returns:    true if file is read
+//*-----------------------------------------------------------------------------
+bool CmJitCache::ReadEntryFile(const std::string &path, std::vector<uint8_t> &data)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    bool        result = fstat(fd, &info) == 0 && info.st_size > 0;
+    if (result)
+    {
+        data.resize((size_t)info.st_size);
+        size_t done = 0;
+        while (done < data.size())
+        {
+            ssize_t bytes = read(fd, data.data() + done, data.size() - done);
+            if (bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (bytes <= 0)
+            {
+                result = false;
+                break;
+            }
+            done += (size_t)bytes;
+        }
+    }
+
+    close(fd);
+    return result;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Write entry file atomically
+//| Returns:    true if entry is published
+//| Notes:      Content is written into a file private to the writer, which is
+//|             then renamed to the entry name, so readers never see a partial
+//|             entry. Torn data after a system crash is rejected by checksum.
+//*-----------------------------------------------------------------------------
+bool CmJitCache::WriteEntryFile(const std::string &directory, const std::string &name, const std::vector<uint8_t> &data)
+{
+    static std::atomic<uint32_t> tempCount(0);
+
+    char suffix[48];
+    snprintf(suffix, sizeof(suffix), ".tmp.%d.%u", (int)getpid(), tempCount++);
+    std::string tempPath  = directory + "/" + name + suffix;
+    std::string entryPath = directory + "/" + name;
+
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    bool   result = true;
+    size_t done   = 0;
+    while (done < data.size())
+    {
+        ssize_t bytes = write(fd, data.data() + done, data.size() - done);
+        if (bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes <= 0)
+        {
+            result = false;
+            break;
+        }
+        done += (size_t)bytes;
+    }
+
+    if (close(fd) != 0)
+    {
+        result = false;
+    }
+
+    if (result && rename(tempPath.c_str(), entryPath.c_str()) != 0)
+    {
+        result = false;
+    }
+
+    if (!result)
+    {
+        unlink(tempPath.c_str());
+    }
+    return result;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    List files in cache directory
+//| Returns:    true if directory is read
+//| Notes:      Temporary files left by killed writers are listed as well, so
+//|             they are removed as the oldest entries.
+//*-----------------------------------------------------------------------------
+bool CmJitCache::ListEntryFiles(const std::string &directory, std::vector<EntryFile> &files)
+{
+    DIR *dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        return false;
+    }
+
+    struct dirent *entry = nullptr;
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+
+        struct stat info;
+        if (fstatat(dirfd(dir), entry->d_name, &info, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISREG(info.st_mode))
+        {
+            continue;
+        }
+
+        EntryFile file;
+        file.name    = entry->d_name;
+        file.size    = (uint64_t)info.st_size;
+        file.lastUse = (int64_t)info.st_mtim.tv_sec * 1000000000 + info.st_mtim.tv_nsec;
+        files.push_back(file);
+    }
+
+    closedir(dir);
+    return true;
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Mark entry file as used now
+//*-----------------------------------------------------------------------------
+void CmJitCache::TouchEntryFile(const std::string &path)
+{
+    utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+}
+
+//*-----------------------------------------------------------------------------
+//| Purpose:    Remove entry file
+//*-----------------------------------------------------------------------------
+void CmJitCache::RemoveEntryFile(const std::string &path)
+{
+    unlink(path.c_str());
+}
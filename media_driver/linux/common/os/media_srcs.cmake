@@ -31,6 +31,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_specific_ext.cpp
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager_specific.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager_cpu_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_decompression.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_mediacopy.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_utilities_specific_usersetting.cpp
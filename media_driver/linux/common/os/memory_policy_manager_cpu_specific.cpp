@@ -0,0 +1,211 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     memory_policy_manager_cpu_specific.cpp
+//! \brief    Implements huge page and NUMA placement of CPU memory for media memory policy manager.
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#include "memory_policy_manager.h"
+
+namespace
+{
+const size_t cpuMemHugePageSize = 0x200000;
+
+//! \brief  Placed before memory returned by AllocCpuMemory
+struct CpuMemoryHeader
+{
+    size_t mapSize;  //!< Size of anonymous mapping, 0 if allocated from heap
+};
+// Keeps memory returned from mappings cache line aligned
+const size_t cpuMemHeaderSize = 64;
+}
+
+std::atomic<bool>     MemoryPolicyManager::m_hugePageEnabled(false);
+std::atomic<bool>     MemoryPolicyManager::m_numaLocalEnabled(false);
+std::atomic<size_t>   MemoryPolicyManager::m_minSize(cpuMemHugePageSize);
+std::atomic<uint64_t> MemoryPolicyManager::m_allocCount(0);
+std::atomic<uint64_t> MemoryPolicyManager::m_hugePageCount(0);
+std::atomic<uint64_t> MemoryPolicyManager::m_numaLocalCount(0);
+std::atomic<uint64_t> MemoryPolicyManager::m_fallbackCount(0);
+std::atomic<uint64_t> MemoryPolicyManager::m_mapCount(0);
+
+void MemoryPolicyManager::SetCpuMemoryPolicy(const CpuMemoryPolicy &policy)
+{
+    m_minSize          = policy.minSize;
+    m_hugePageEnabled  = policy.hugePageEnabled;
+    m_numaLocalEnabled = policy.numaLocalEnabled;
+}
+
+CpuMemoryPolicy MemoryPolicyManager::GetCpuMemoryPolicy()
+{
+    CpuMemoryPolicy policy;
+    policy.hugePageEnabled  = m_hugePageEnabled;
+    policy.numaLocalEnabled = m_numaLocalEnabled;
+    policy.minSize          = m_minSize;
+    return policy;
+}
+
+void MemoryPolicyManager::GetCpuMemoryPolicyCounters(CpuMemoryPolicyCounters &counters)
+{
+    counters.allocCount     = m_allocCount;
+    counters.hugePageCount  = m_hugePageCount;
+    counters.numaLocalCount = m_numaLocalCount;
+    counters.fallbackCount  = m_fallbackCount;
+    counters.mapCount       = m_mapCount;
+}
+
+void MemoryPolicyManager::AdviseCpuMemory(const CpuMemoryPolicy &policy, void *addr, size_t size)
+{
+    if (policy.hugePageEnabled)
+    {
+        // Only huge pages fully inside the range could be used
+        uintptr_t start = MOS_ALIGN_CEIL((uintptr_t)addr, cpuMemHugePageSize);
+        uintptr_t end   = MOS_ALIGN_FLOOR((uintptr_t)addr + size, cpuMemHugePageSize);
+        if (end > start && madvise((void *)start, end - start, MADV_HUGEPAGE) == 0)
+        {
+            m_hugePageCount++;
+        }
+        else
+        {
+            m_fallbackCount++;
+        }
+    }
+
+    if (policy.numaLocalEnabled)
+    {
+        unsigned int  cpu      = 0;
+        unsigned int  node     = 0;
+        unsigned long nodeMask = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 && node < sizeof(nodeMask) * 8)
+        {
+            nodeMask = 1UL << node;
+        }
+
+        // Preferred instead of bind, so pages still come from other nodes when local node is full
+        uintptr_t start = MOS_ALIGN_FLOOR((uintptr_t)addr, MOS_PAGE_SIZE);
+        size_t    len   = (uintptr_t)addr + size - start;
+        if (nodeMask != 0 &&
+            syscall(SYS_mbind, start, len, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8 + 1, 0) == 0)
+        {
+            m_numaLocalCount++;
+        }
+        else
+        {
+            m_fallbackCount++;
+        }
+    }
+}
+
+void *MemoryPolicyManager::AllocCpuMemory(size_t size, bool zero)
+{
+    if (size == 0 || size > SIZE_MAX - cpuMemHeaderSize - 2 * cpuMemHugePageSize)
+    {
+        return nullptr;
+    }
+
+    CpuMemoryPolicy policy    = GetCpuMemoryPolicy();
+    size_t          allocSize = size + cpuMemHeaderSize;
+    size_t          mapSize   = 0;
+    uint8_t        *base      = nullptr;
+
+    if ((policy.hugePageEnabled || policy.numaLocalEnabled) && size >= policy.minSize)
+    {
+        size_t alignment = policy.hugePageEnabled ? cpuMemHugePageSize : MOS_PAGE_SIZE;
+        mapSize          = MOS_ALIGN_CEIL(allocSize, alignment);
+
+        // Mapping is page aligned, reserve more to start on huge page boundary
+        size_t reserveSize = mapSize + alignment - MOS_PAGE_SIZE;
+        void  *reserved    = mmap(nullptr, reserveSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved == MAP_FAILED)
+        {
+            MOS_OS_NORMALMESSAGE("Failed to map %zu bytes, fall back to heap", reserveSize);
+            m_fallbackCount++;
+            mapSize = 0;
+        }
+        else
+        {
+            base        = (uint8_t *)MOS_ALIGN_CEIL((uintptr_t)reserved, alignment);
+            size_t head = base - (uint8_t *)reserved;
+            size_t tail = reserveSize - head - mapSize;
+            if (head)
+            {
+                munmap(reserved, head);
+            }
+            if (tail)
+            {
+                munmap(base + mapSize, tail);
+            }
+
+            // Advise before first touch, so the first fault already follows the policy.
+            // Anonymous mapping is zero filled.
+            AdviseCpuMemory(policy, base, mapSize);
+            m_allocCount++;
+        }
+    }
+
+    if (base == nullptr)
+    {
+        base = (uint8_t *)(zero ? MOS_AllocAndZeroMemory(allocSize) : MOS_AllocMemory(allocSize));
+        if (base == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    ((CpuMemoryHeader *)base)->mapSize = mapSize;
+    return base + cpuMemHeaderSize;
+}
+
+void MemoryPolicyManager::FreeCpuMemory(void *ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    uint8_t *base    = (uint8_t *)ptr - cpuMemHeaderSize;
+    size_t   mapSize = ((CpuMemoryHeader *)base)->mapSize;
+    if (mapSize)
+    {
+        munmap(base, mapSize);
+    }
+    else
+    {
+        MOS_FreeMemory(base);
+    }
+}
+
+void MemoryPolicyManager::ApplyCpuMappingPolicy(void *addr, size_t size)
+{
+    CpuMemoryPolicy policy = GetCpuMemoryPolicy();
+    if (addr == nullptr || size < policy.minSize ||
+        !(policy.hugePageEnabled || policy.numaLocalEnabled))
+    {
+        return;
+    }
+
+    AdviseCpuMemory(policy, addr, size);
+    m_mapCount++;
+}
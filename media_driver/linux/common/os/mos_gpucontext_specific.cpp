@@ -880,6 +880,18 @@ MOS_STATUS GpuContextSpecific::MapResourcesToAuxTable(mos_linux_bo *cmd_bo)
     return MOS_STATUS_SUCCESS;
 }
 
+void GpuContextSpecific::UpdateWriteEpochs()
+{
+    for (uint32_t i = 0; i < m_numAllocations; i++)
+    {
+        auto res = (PMOS_RESOURCE)m_allocationList[i].hAllocation;
+        if (m_writeModeList[i] && res && res->bo)
+        {
+            res->bo->write_epoch++;
+        }
+    }
+}
+
 MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
     PMOS_INTERFACE      osInterface,
     PMOS_COMMAND_BUFFER cmdBuffer,
@@ -1321,6 +1333,10 @@ MOS_STATUS GpuContextSpecific::SubmitCommandBuffer(
     {
         MOS_OS_ASSERTMESSAGE("Command buffer submission failed!");
     }
+    else
+    {
+        UpdateWriteEpochs();
+    }
 
     MOS_DEVULT_FuncCall(pfnUltGetCmdBuf, cmdBuffer);
 
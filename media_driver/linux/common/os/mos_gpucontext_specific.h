@@ -211,6 +211,12 @@ protected:
     //!
     MOS_STATUS MapResourcesToAuxTable(mos_linux_bo *cmd_bo);
 
+    //!
+    //! \brief    Increase write epoch of the resources written by the submitted command buffer
+    //! \details  Resource is decompressed again on CPU access only if its write epoch changed
+    //!
+    void UpdateWriteEpochs();
+
     //!
     //! \brief    Submit command buffer for single pipe in scalability mode
     //! \return   int32_t
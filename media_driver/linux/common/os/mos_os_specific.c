@@ -3226,6 +3226,39 @@ finish:
     return eStatus;
 }
 
+//!
+//! \brief    Decompress Resources
+//! \details  Decompress Resources with one submission when APO MOS is enabled
+//! \param    PMOS_INTERFACE pOsInterface
+//!           [in] pointer to OS Interface structure
+//! \param    PMOS_RESOURCE *ppOsResources
+//!           [in/out] Resource objects
+//! \param    uint32_t count
+//!           [in] Number of resource objects
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if successful
+//!
+MOS_STATUS Mos_Specific_DecompResourceBatch(
+    PMOS_INTERFACE        pOsInterface,
+    PMOS_RESOURCE         *ppOsResources,
+    uint32_t              count)
+{
+    MOS_OS_CHK_NULL_RETURN(pOsInterface);
+    MOS_OS_CHK_NULL_RETURN(ppOsResources);
+
+    if (pOsInterface->apoMosEnabled)
+    {
+        return MosInterface::DecompResourceBatch(pOsInterface->osStreamState, ppOsResources, count);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        MOS_OS_CHK_STATUS_RETURN(Mos_Specific_DecompResource(pOsInterface, ppOsResources[i]));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 //!
 //! \brief    Set auxiliary sync resource
 //! \details  Set auxiliary resource to sync with decompression
@@ -7149,6 +7182,7 @@ MOS_STATUS Mos_Specific_InitInterface(
     pOsInterface->pfnLockResource                           = Mos_Specific_LockResource;
     pOsInterface->pfnUnlockResource                         = Mos_Specific_UnlockResource;
     pOsInterface->pfnDecompResource                         = Mos_Specific_DecompResource;
+    pOsInterface->pfnDecompResourceBatch                    = Mos_Specific_DecompResourceBatch;
     pOsInterface->pfnSetDecompSyncRes                       = Mos_Specific_SetDecompSyncRes;
     pOsInterface->pfnDoubleBufferCopyResource               = Mos_Specific_DoubleBufferCopyResource;
     pOsInterface->pfnMediaCopyResource2D                    = Mos_Specific_MediaCopyResource2D;
@@ -0,0 +1,286 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "codec_av1_default_cdf.h"
+
+using namespace std;
+
+class Av1DefaultCdfTest : public testing::Test
+{
+protected:
+    static const uint32_t m_tableEntries = CodecAv1DefaultCdfTable::m_tableBytes / sizeof(uint16_t);
+
+    //! \brief  Os interface of one codec context, buffers are host memory
+    struct FakeContext
+    {
+        MOS_INTERFACE  osInterface = {};
+        MosStreamState streamState;
+
+        FakeContext(void *device)
+        {
+            streamState.osDeviceContext = (OsDeviceContext *)device;
+            osInterface.osStreamState   = &streamState;
+            osInterface.pfnAllocateResource = Allocate;
+            osInterface.pfnFreeResource     = Free;
+            osInterface.pfnLockResource     = Lock;
+            osInterface.pfnUnlockResource   = Unlock;
+        }
+    };
+
+#if MOS_MESSAGES_ENABLED
+    static MOS_STATUS Allocate(PMOS_INTERFACE, PMOS_ALLOC_GFXRES_PARAMS params, const char *, const char *, int32_t, PMOS_RESOURCE resource)
+#else
+    static MOS_STATUS Allocate(PMOS_INTERFACE, PMOS_ALLOC_GFXRES_PARAMS params, PMOS_RESOURCE resource)
+#endif
+    {
+        resource->pData = new uint8_t[params->dwBytes];
+        m_allocCount++;
+        return MOS_STATUS_SUCCESS;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void Free(PMOS_INTERFACE, const char *, const char *, int32_t, PMOS_RESOURCE resource)
+#else
+    static void Free(PMOS_INTERFACE, PMOS_RESOURCE resource)
+#endif
+    {
+        delete[] resource->pData;
+        resource->pData = nullptr;
+        m_freeCount++;
+    }
+
+    static void *Lock(PMOS_INTERFACE, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS)
+    {
+        return resource->pData;
+    }
+
+    static MOS_STATUS Unlock(PMOS_INTERFACE, PMOS_RESOURCE)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    void SetUp() override
+    {
+        m_allocCount = 0;
+        m_freeCount  = 0;
+    }
+
+    static CodecAv1DefaultCdfCache::Params GetParams(uint8_t tableNum, uint32_t tableStride)
+    {
+        CodecAv1DefaultCdfCache::Params params = {};
+        params.firstIndex   = 0;
+        params.tableNum     = tableNum;
+        params.tableStride  = tableStride;
+        params.resUsageType = MOS_HW_RESOURCE_USAGE_ENCODE_INTERNAL_READ;
+        params.bufName      = "Av1CdfTablesBuffer";
+        return params;
+    }
+
+    static uint32_t m_allocCount;
+    static uint32_t m_freeCount;
+};
+
+uint32_t Av1DefaultCdfTest::m_allocCount = 0;
+uint32_t Av1DefaultCdfTest::m_freeCount  = 0;
+
+TEST_F(Av1DefaultCdfTest, CoeffCdfQCtx)
+{
+    EXPECT_EQ(0, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(0));
+    EXPECT_EQ(0, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(20));
+    EXPECT_EQ(1, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(21));
+    EXPECT_EQ(1, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(60));
+    EXPECT_EQ(2, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(61));
+    EXPECT_EQ(2, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(120));
+    EXPECT_EQ(3, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(121));
+    EXPECT_EQ(3, CodecAv1DefaultCdfTable::GetCoeffCdfQCtx(255));
+}
+
+TEST_F(Av1DefaultCdfTest, CopyMatchesInit)
+{
+    vector<uint16_t> initTable(m_tableEntries);
+    vector<uint16_t> copyTable(m_tableEntries);
+
+    for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+    {
+        fill(initTable.begin(), initTable.end(), 0);
+        ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Init(initTable.data(), index));
+        ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Copy(copyTable.data(), index));
+        EXPECT_EQ(0, memcmp(initTable.data(), copyTable.data(), CodecAv1DefaultCdfTable::m_tableBytes)) << "index " << (uint32_t)index;
+    }
+
+    // Coeff cdf of each q context is different
+    vector<uint16_t> otherTable(m_tableEntries);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Copy(otherTable.data(), 0));
+    EXPECT_NE(0, memcmp(otherTable.data(), copyTable.data(), CodecAv1DefaultCdfTable::m_tableBytes));
+}
+
+TEST_F(Av1DefaultCdfTest, PartialInit)
+{
+    const uint16_t   pattern = 0xa5a5;
+    vector<uint16_t> fullTable(m_tableEntries);
+    vector<uint16_t> partTable(m_tableEntries, pattern);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Copy(fullTable.data(), 0));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Init(partTable.data(), 0, mvJointType, interintra));
+
+    // mv_joint_type starts at CL 205 and mv_class0_hp ends at CL 213
+    for (uint32_t i = 0; i < m_tableEntries; i++)
+    {
+        uint32_t cl = i / 32;
+        if (cl >= 205 && cl <= 213 && partTable[i] != pattern)
+        {
+            EXPECT_EQ(fullTable[i], partTable[i]) << "entry " << i;
+        }
+        else if (cl < 205 || cl > 213)
+        {
+            EXPECT_EQ(pattern, partTable[i]) << "entry " << i;
+        }
+    }
+}
+
+TEST_F(Av1DefaultCdfTest, InvalidParams)
+{
+    vector<uint16_t> table(m_tableEntries);
+
+    EXPECT_EQ(MOS_STATUS_NULL_POINTER, CodecAv1DefaultCdfTable::Copy(nullptr, 0));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, CodecAv1DefaultCdfTable::Copy(table.data(), CodecAv1DefaultCdfTable::m_tableNum));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, CodecAv1DefaultCdfTable::Init(table.data(), CodecAv1DefaultCdfTable::m_tableNum));
+
+    FakeContext  context((void *)0x1000);
+    MOS_RESOURCE resource = {};
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, CodecAv1DefaultCdfCache::Acquire(&context.osInterface, GetParams(0, CodecAv1DefaultCdfTable::m_tableBytes), resource));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, CodecAv1DefaultCdfCache::Acquire(&context.osInterface, GetParams(5, CodecAv1DefaultCdfTable::m_tableBytes), resource));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, CodecAv1DefaultCdfCache::Acquire(&context.osInterface, GetParams(4, CodecAv1DefaultCdfTable::m_tableBytes - 64), resource));
+    EXPECT_EQ(0u, m_allocCount);
+}
+
+TEST_F(Av1DefaultCdfTest, SharedPerDevice)
+{
+    const uint32_t stride = CodecAv1DefaultCdfTable::m_tableBytes;
+    auto           params = GetParams(CodecAv1DefaultCdfTable::m_tableNum, stride);
+
+    FakeContext decoder((void *)0x1000);
+    FakeContext encoder((void *)0x1000);
+    FakeContext otherDevice((void *)0x2000);
+
+    MOS_RESOURCE resource0 = {};
+    MOS_RESOURCE resource1 = {};
+    MOS_RESOURCE resource2 = {};
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&decoder.osInterface, params, resource0));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&encoder.osInterface, params, resource1));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&otherDevice.osInterface, params, resource2));
+    EXPECT_EQ(2u, m_allocCount);
+    EXPECT_EQ(resource0.pData, resource1.pData);
+    EXPECT_NE(resource0.pData, resource2.pData);
+
+    vector<uint16_t> table(m_tableEntries);
+    for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Copy(table.data(), index));
+        EXPECT_EQ(0, memcmp(table.data(), resource0.pData + stride * index, CodecAv1DefaultCdfTable::m_tableBytes));
+    }
+
+    // Different layout on the same device is a different buffer
+    auto         singleParams = GetParams(1, stride);
+    MOS_RESOURCE resource3    = {};
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&decoder.osInterface, singleParams, resource3));
+    EXPECT_EQ(3u, m_allocCount);
+    CodecAv1DefaultCdfCache::Release(&decoder.osInterface, singleParams);
+    EXPECT_EQ(1u, m_freeCount);
+
+    CodecAv1DefaultCdfCache::Release(&decoder.osInterface, params);
+    EXPECT_EQ(1u, m_freeCount);
+    CodecAv1DefaultCdfCache::Release(&encoder.osInterface, params);
+    EXPECT_EQ(2u, m_freeCount);
+    CodecAv1DefaultCdfCache::Release(&otherDevice.osInterface, params);
+    EXPECT_EQ(3u, m_freeCount);
+
+    // The next context allocates again
+    ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&encoder.osInterface, params, resource1));
+    EXPECT_EQ(4u, m_allocCount);
+    CodecAv1DefaultCdfCache::Release(&encoder.osInterface, params);
+    EXPECT_EQ(4u, m_freeCount);
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(Av1DefaultCdfTest, DISABLED_ContextCreationBenchmark)
+{
+    const uint32_t loops  = 2000;
+    const uint32_t stride = MOS_ALIGN_CEIL(CodecAv1DefaultCdfTable::m_tableBytes, CODECHAL_PAGE_SIZE);
+    auto           params = GetParams(1, stride);
+
+    FakeContext first((void *)0x1000);
+    FakeContext context((void *)0x1000);
+    MOS_RESOURCE resource = {};
+
+    // Per context buffers laid out by each new context
+    auto start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+        {
+            MOS_ALLOC_GFXRES_PARAMS allocParams = {};
+            allocParams.dwBytes = stride;
+            MOS_RESOURCE privateResource = {};
+            context.osInterface.pfnAllocateResource(&context.osInterface, &allocParams, &privateResource);
+            ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfTable::Init((uint16_t *)privateResource.pData, index));
+            context.osInterface.pfnFreeResource(&context.osInterface, &privateResource);
+        }
+    }
+    auto middle = chrono::steady_clock::now();
+
+    // Shared buffers already created by the first context of the device
+    for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+    {
+        params.firstIndex = index;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&first.osInterface, params, resource));
+    }
+    auto sharedStart = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < loops; i++)
+    {
+        for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+        {
+            params.firstIndex = index;
+            ASSERT_EQ(MOS_STATUS_SUCCESS, CodecAv1DefaultCdfCache::Acquire(&context.osInterface, params, resource));
+        }
+        for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+        {
+            params.firstIndex = index;
+            CodecAv1DefaultCdfCache::Release(&context.osInterface, params);
+        }
+    }
+    auto end = chrono::steady_clock::now();
+
+    for (uint8_t index = 0; index < CodecAv1DefaultCdfTable::m_tableNum; index++)
+    {
+        params.firstIndex = index;
+        CodecAv1DefaultCdfCache::Release(&first.osInterface, params);
+    }
+    EXPECT_EQ(m_allocCount, m_freeCount);
+
+    double privateUs = chrono::duration<double, micro>(middle - start).count() / loops;
+    double sharedUs  = chrono::duration<double, micro>(end - sharedStart).count() / loops;
+    printf("[ BENCH    ] AV1 default cdf per context: private tables %.2f us, shared tables %.2f us\n", privateUs, sharedUs);
+}
@@ -0,0 +1,430 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "cm_jit_cache.h"
+
+using namespace std;
+
+class CmJitCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char pattern[] = "/tmp/cm_jit_cache_test.XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(pattern));
+        m_directory = string(pattern) + "/cache";
+        m_cisa.resize(4096);
+        for (size_t i = 0; i < m_cisa.size(); i++)
+        {
+            m_cisa[i] = (uint8_t)(i * 7 + 3);
+        }
+        m_jitCount = 0;
+        m_jitCostUs = 0;
+    }
+
+    void TearDown() override
+    {
+        for (auto &name : ListFiles())
+        {
+            unlink((m_directory + "/" + name).c_str());
+        }
+        rmdir(m_directory.c_str());
+        rmdir(m_directory.substr(0, m_directory.rfind('/')).c_str());
+    }
+
+    vector<string> ListFiles()
+    {
+        vector<string> names;
+        DIR *dir = opendir(m_directory.c_str());
+        if (dir == nullptr)
+        {
+            return names;
+        }
+        struct dirent *entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            if (entry->d_name[0] != '.')
+            {
+                names.push_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+        return names;
+    }
+
+    CmJitCache::KeyInfo GetKey(const char *kernelName)
+    {
+        CmJitCache::KeyInfo key = {};
+        key.kernelName   = kernelName;
+        key.cisaCode     = m_cisa.data();
+        key.cisaCodeSize = (uint32_t)m_cisa.size();
+        key.platform     = "TGLLP";
+        key.numJitFlags  = (int)m_flags.size();
+        key.jitFlags     = m_flags.data();
+        key.jitMajor     = 3;
+        key.jitMinor     = 6;
+        return key;
+    }
+
+    //! \brief  Jitter stub, binary is derived from kernel name and CISA
+    static int StubJitCompile(
+        const char     *kernelName,
+        const void     *kernelIsa,
+        uint32_t       kernelIsaSize,
+        void           *&genBinary,
+        uint32_t       &genBinarySize,
+        FINALIZER_INFO *jitInfo)
+    {
+        auto start = chrono::steady_clock::now();
+        while (chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() < m_jitCostUs)
+        {
+        }
+
+        uint32_t nameLen = (uint32_t)strlen(kernelName);
+        genBinarySize    = kernelIsaSize / 2 + nameLen;
+        uint8_t *binary  = (uint8_t *)malloc(genBinarySize);
+        for (uint32_t i = 0; i < genBinarySize; i++)
+        {
+            binary[i] = ((const uint8_t *)kernelIsa)[i % kernelIsaSize] ^ (uint8_t)kernelName[i % nameLen];
+        }
+        genBinary = binary;
+
+        memset(jitInfo, 0, sizeof(*jitInfo));
+        jitInfo->isSpill      = true;
+        jitInfo->numGRFUsed   = 128;
+        jitInfo->numAsmCount  = (int)genBinarySize / 16;
+        jitInfo->spillMemUsed = 256;
+        jitInfo->usesBarrier  = true;
+        m_jitCount++;
+        return 0;
+    }
+
+    //! \brief  Load kernel the way CmProgramRT does
+    void LoadKernel(CmJitCache &cache, const CmJitCache::KeyInfo &key, vector<uint8_t> &binary, FINALIZER_INFO &jitInfo, bool &cached)
+    {
+        void     *jitBinary     = nullptr;
+        uint32_t jitBinarySize = 0;
+
+        cached = cache.Load(key, jitBinary, jitBinarySize, &jitInfo);
+        if (!cached)
+        {
+            ASSERT_EQ(0, StubJitCompile(key.kernelName, key.cisaCode, key.cisaCodeSize, jitBinary, jitBinarySize, &jitInfo));
+            cache.Store(key, jitBinary, jitBinarySize, &jitInfo);
+        }
+        binary.assign((uint8_t *)jitBinary, (uint8_t *)jitBinary + jitBinarySize);
+        if (cached)
+        {
+            CmJitCache::FreeBinary(jitBinary);
+        }
+        else
+        {
+            free(jitBinary);
+        }
+    }
+
+    static const uint64_t m_maxSize = 64 * 1024 * 1024;
+
+    string              m_directory;
+    vector<uint8_t>     m_cisa;
+    vector<const char*> m_flags = {"-stepping", "B0"};
+
+    static uint32_t m_jitCount;
+    static double   m_jitCostUs;
+};
+
+uint32_t CmJitCacheTest::m_jitCount  = 0;
+double   CmJitCacheTest::m_jitCostUs = 0;
+
+TEST_F(CmJitCacheTest, MissThenHit)
+{
+    vector<uint8_t> jitted, loaded;
+    FINALIZER_INFO  jittedInfo = {}, loadedInfo = {};
+    bool            cached = true;
+
+    {
+        CmJitCache cache(m_directory, m_maxSize);
+        LoadKernel(cache, GetKey("kernel_a"), jitted, jittedInfo, cached);
+        EXPECT_FALSE(cached);
+        EXPECT_EQ(1u, cache.GetMissCount());
+    }
+    EXPECT_EQ(1u, ListFiles().size());
+
+    // Another process with the same program
+    CmJitCache cache(m_directory, m_maxSize);
+    LoadKernel(cache, GetKey("kernel_a"), loaded, loadedInfo, cached);
+    EXPECT_TRUE(cached);
+    EXPECT_EQ(1u, cache.GetHitCount());
+    EXPECT_EQ(1u, m_jitCount);
+    EXPECT_EQ(jitted, loaded);
+    EXPECT_EQ(jittedInfo.isSpill, loadedInfo.isSpill);
+    EXPECT_EQ(jittedInfo.numGRFUsed, loadedInfo.numGRFUsed);
+    EXPECT_EQ(jittedInfo.numAsmCount, loadedInfo.numAsmCount);
+    EXPECT_EQ(jittedInfo.spillMemUsed, loadedInfo.spillMemUsed);
+    EXPECT_EQ(jittedInfo.usesBarrier, loadedInfo.usesBarrier);
+    EXPECT_EQ(nullptr, loadedInfo.genDebugInfo);
+    EXPECT_EQ(nullptr, loadedInfo.freeGRFInfo);
+}
+
+TEST_F(CmJitCacheTest, KeyChanges)
+{
+    CmJitCache      cache(m_directory, m_maxSize);
+    vector<uint8_t> binary;
+    FINALIZER_INFO  jitInfo = {};
+    bool            cached  = true;
+
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    auto key = GetKey("kernel_b");
+    LoadKernel(cache, key, binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    key = GetKey("kernel_a");
+    key.platform = "DG2";
+    LoadKernel(cache, key, binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    key = GetKey("kernel_a");
+    key.jitMinor = 7;
+    LoadKernel(cache, key, binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    m_flags[1] = "C0";
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    m_cisa[m_cisa.size() / 2] ^= 1;
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_TRUE(cached);
+    EXPECT_EQ(6u, m_jitCount);
+    EXPECT_EQ(6u, ListFiles().size());
+}
+
+TEST_F(CmJitCacheTest, CorruptEntry)
+{
+    CmJitCache      cache(m_directory, m_maxSize);
+    vector<uint8_t> binary;
+    FINALIZER_INFO  jitInfo = {};
+    bool            cached  = true;
+
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    auto names = ListFiles();
+    ASSERT_EQ(1u, names.size());
+    string path = m_directory + "/" + names[0];
+
+    // Flip the last byte of binary
+    FILE *file = fopen(path.c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    fseek(file, -1, SEEK_END);
+    int last = fgetc(file);
+    fseek(file, -1, SEEK_END);
+    fputc(last ^ 0xff, file);
+    fclose(file);
+
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    // Truncated entry
+    ASSERT_EQ(0, truncate(path.c_str(), 16));
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_TRUE(cached);
+    EXPECT_EQ(3u, m_jitCount);
+}
+
+TEST_F(CmJitCacheTest, LruEviction)
+{
+    vector<uint8_t> binary;
+    FINALIZER_INFO  jitInfo = {};
+    bool            cached  = true;
+
+    // Room for 4 entries, evicted down to 3
+    uint64_t entrySize = 0;
+    {
+        CmJitCache cache(m_directory, m_maxSize);
+        LoadKernel(cache, GetKey("kernel_0"), binary, jitInfo, cached);
+        struct stat info;
+        ASSERT_EQ(0, stat((m_directory + "/" + ListFiles()[0]).c_str(), &info));
+        entrySize = info.st_size;
+    }
+
+    CmJitCache cache(m_directory, entrySize * 4 + entrySize / 2);
+    const char *names[] = {"kernel_1", "kernel_2", "kernel_3"};
+    for (auto name : names)
+    {
+        // File times are not finer than scheduler tick
+        this_thread::sleep_for(chrono::milliseconds(20));
+        LoadKernel(cache, GetKey(name), binary, jitInfo, cached);
+        EXPECT_FALSE(cached);
+    }
+    EXPECT_EQ(4u, ListFiles().size());
+
+    // Use kernel_0 again, so kernel_1 is the least recently used
+    this_thread::sleep_for(chrono::milliseconds(20));
+    LoadKernel(cache, GetKey("kernel_0"), binary, jitInfo, cached);
+    EXPECT_TRUE(cached);
+
+    this_thread::sleep_for(chrono::milliseconds(20));
+    LoadKernel(cache, GetKey("kernel_4"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+    EXPECT_EQ(3u, ListFiles().size());
+
+    uint32_t jitCount = m_jitCount;
+    const char *kept[] = {"kernel_0", "kernel_3", "kernel_4"};
+    for (auto name : kept)
+    {
+        LoadKernel(cache, GetKey(name), binary, jitInfo, cached);
+        EXPECT_TRUE(cached) << name;
+    }
+    EXPECT_EQ(jitCount, m_jitCount);
+
+    LoadKernel(cache, GetKey("kernel_1"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+}
+
+TEST_F(CmJitCacheTest, ConcurrentStore)
+{
+    CmJitCache      cache(m_directory, m_maxSize);
+    vector<uint8_t> expected;
+    FINALIZER_INFO  jitInfo = {};
+    bool            cached  = true;
+    LoadKernel(cache, GetKey("kernel_a"), expected, jitInfo, cached);
+
+    // Writers and readers of the same entry never see a partial file
+    vector<thread> threads;
+    atomic<bool>   allValid(true);
+    for (int t = 0; t < 8; t++)
+    {
+        threads.emplace_back([&, t]() {
+            auto key = GetKey("kernel_a");
+            for (int i = 0; i < 50; i++)
+            {
+                if (t % 2)
+                {
+                    cache.Store(key, expected.data(), (uint32_t)expected.size(), &jitInfo);
+                }
+                else
+                {
+                    void          *binary = nullptr;
+                    uint32_t       size   = 0;
+                    FINALIZER_INFO info   = {};
+                    if (cache.Load(key, binary, size, &info))
+                    {
+                        if (size != expected.size() || memcmp(binary, expected.data(), size) != 0)
+                        {
+                            allValid = false;
+                        }
+                        CmJitCache::FreeBinary(binary);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_TRUE(allValid);
+    EXPECT_EQ(1u, cache.GetMissCount());
+    EXPECT_EQ(1u, ListFiles().size());
+}
+
+TEST_F(CmJitCacheTest, Disabled)
+{
+    CmJitCache      cache("", m_maxSize);
+    vector<uint8_t> binary;
+    FINALIZER_INFO  jitInfo = {};
+    bool            cached  = true;
+
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+    LoadKernel(cache, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+
+    CmJitCache noSpace(m_directory, 0);
+    LoadKernel(noSpace, GetKey("kernel_a"), binary, jitInfo, cached);
+    EXPECT_FALSE(cached);
+    EXPECT_EQ(0u, ListFiles().size());
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(CmJitCacheTest, DISABLED_StartupBenchmark)
+{
+    const uint32_t kernelCount = 32;
+    vector<string> names;
+    for (uint32_t i = 0; i < kernelCount; i++)
+    {
+        names.push_back("analytics_kernel_" + to_string(i));
+    }
+    m_cisa.resize(256 * 1024);
+
+    // Jitter takes 2 ms per kernel
+    m_jitCostUs = 2000;
+
+    vector<uint8_t> binary;
+    FINALIZER_INFO  jitInfo = {};
+    bool            cached  = true;
+
+    auto start = chrono::steady_clock::now();
+    {
+        CmJitCache cache(m_directory, m_maxSize);
+        for (auto &name : names)
+        {
+            LoadKernel(cache, GetKey(name.c_str()), binary, jitInfo, cached);
+            ASSERT_FALSE(cached);
+        }
+    }
+    auto middle = chrono::steady_clock::now();
+    {
+        CmJitCache cache(m_directory, m_maxSize);
+        for (auto &name : names)
+        {
+            LoadKernel(cache, GetKey(name.c_str()), binary, jitInfo, cached);
+            ASSERT_TRUE(cached);
+        }
+    }
+    auto end = chrono::steady_clock::now();
+
+    // Warm start loads every kernel from the cache without calling the jitter
+    EXPECT_EQ(kernelCount, m_jitCount);
+
+    double coldMs = chrono::duration<double, milli>(middle - start).count();
+    double warmMs = chrono::duration<double, milli>(end - middle).count();
+    printf("[ BENCH    ] CM program load of %u kernels: jitter %.2f ms, jit cache %.2f ms\n", kernelCount, coldMs, warmMs);
+}
@@ -0,0 +1,266 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "ddi_decode_slice_translator.h"
+
+using namespace std;
+using namespace decode;
+
+class DdiDecodeSliceTranslatorTest : public testing::Test
+{
+protected:
+    //! \brief  Same shape as VA HEVC slice parameters
+    struct VaSlice
+    {
+        uint32_t sliceDataSize;
+        uint32_t sliceDataOffset;
+        uint32_t sliceDataFlag;
+        uint32_t sliceDataByteOffset;
+        uint32_t sliceSegmentAddress;
+        uint8_t  refPicList[2][15];
+        uint32_t longSliceFlags;
+        uint8_t  collocatedRefIdx;
+        int8_t   sliceQpDelta;
+        int8_t   deltaLumaWeight[2][15];
+        int8_t   lumaOffset[2][15];
+        int8_t   deltaChromaWeight[2][15][2];
+        int8_t   chromaOffset[2][15][2];
+        uint16_t numEntryPointOffsets;
+        uint16_t entryOffsetToSubsetArray;
+    };
+
+    //! \brief  Same shape as codec HEVC slice parameters
+    struct CodecSlice
+    {
+        uint32_t sliceDataSize;
+        uint32_t sliceDataOffset;
+        uint16_t numEntryPointOffsets;
+        uint16_t entryOffsetToSubsetArray;
+        uint32_t byteOffsetToSliceData;
+        uint32_t sliceSegmentAddress;
+        uint8_t  refPicList[2][15];
+        uint32_t longSliceFlags;
+        uint8_t  collocatedRefIdx;
+        int8_t   sliceQpDelta;
+        int8_t   deltaLumaWeight[2][15];
+        int8_t   lumaOffset[2][15];
+        int8_t   deltaChromaWeight[2][15][2];
+        int8_t   chromaOffset[2][15][2];
+    };
+
+    static void MakeSlices(vector<VaSlice> &slices, uint32_t sliceSize)
+    {
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < slices.size(); i++)
+        {
+            VaSlice &slc = slices[i];
+            memset(&slc, 0, sizeof(slc));
+            slc.sliceDataSize       = sliceSize + (i & 15);
+            slc.sliceDataOffset     = offset;
+            slc.sliceDataByteOffset = 5 + (i & 3);
+            slc.sliceSegmentAddress = i * 8;
+            for (uint32_t j = 0; j < 15; j++)
+            {
+                slc.refPicList[0][j]      = (j < 4) ? (uint8_t)((i + j) & 7) : 0xff;
+                slc.refPicList[1][j]      = (j < 2) ? (uint8_t)((i + j + 1) & 7) : 0xff;
+                slc.deltaLumaWeight[0][j] = (int8_t)(i + j);
+                slc.lumaOffset[1][j]      = (int8_t)(i - j);
+            }
+            slc.sliceQpDelta = (int8_t)(i % 13) - 6;
+            offset += slc.sliceDataSize;
+        }
+    }
+
+    //! \brief  Per-slice work of DdiDecodeHevc::ParseSliceParams
+    static VAStatus TranslateSlices(const VaSlice *vaSlices, CodecSlice *codecSlices, uint32_t baseOffset, uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            const VaSlice *slc      = vaSlices + i;
+            CodecSlice    *codecSlc = codecSlices + i;
+
+            codecSlc->sliceDataSize         = slc->sliceDataSize;
+            codecSlc->sliceDataOffset       = baseOffset + slc->sliceDataOffset;
+            codecSlc->byteOffsetToSliceData = slc->sliceDataByteOffset;
+            codecSlc->sliceSegmentAddress   = slc->sliceSegmentAddress;
+            for (uint32_t l = 0; l < 2; l++)
+            {
+                for (uint32_t j = 0; j < 15; j++)
+                {
+                    codecSlc->refPicList[l][j] = (slc->refPicList[l][j] == 0xff) ? 0x7f : slc->refPicList[l][j];
+                }
+            }
+            codecSlc->longSliceFlags   = slc->longSliceFlags;
+            codecSlc->collocatedRefIdx = slc->collocatedRefIdx;
+            codecSlc->sliceQpDelta     = slc->sliceQpDelta;
+            memcpy(codecSlc->deltaLumaWeight, slc->deltaLumaWeight, sizeof(slc->deltaLumaWeight));
+            memcpy(codecSlc->lumaOffset, slc->lumaOffset, sizeof(slc->lumaOffset));
+            memcpy(codecSlc->deltaChromaWeight, slc->deltaChromaWeight, sizeof(slc->deltaChromaWeight));
+            memcpy(codecSlc->chromaOffset, slc->chromaOffset, sizeof(slc->chromaOffset));
+            codecSlc->numEntryPointOffsets     = slc->numEntryPointOffsets;
+            codecSlc->entryOffsetToSubsetArray = slc->entryOffsetToSubsetArray;
+        }
+        return VA_STATUS_SUCCESS;
+    }
+};
+
+TEST_F(DdiDecodeSliceTranslatorTest, RangeNum)
+{
+    const uint32_t threshold = DdiDecodeSliceTranslator::m_parallelSliceNum;
+
+    EXPECT_EQ(1u, DdiDecodeSliceTranslator::GetRangeNum(0, 4));
+    EXPECT_EQ(1u, DdiDecodeSliceTranslator::GetRangeNum(threshold, 4));
+    EXPECT_EQ(1u, DdiDecodeSliceTranslator::GetRangeNum(1000, 1));
+    EXPECT_EQ(3u, DdiDecodeSliceTranslator::GetRangeNum(threshold + 1, 4));
+    EXPECT_EQ(4u, DdiDecodeSliceTranslator::GetRangeNum(600, 4));
+    EXPECT_EQ(2u, DdiDecodeSliceTranslator::GetRangeNum(600, 2));
+}
+
+TEST_F(DdiDecodeSliceTranslatorTest, SmallBufferOnCallingThread)
+{
+    thread::id caller = this_thread::get_id();
+    uint32_t   ranges = 0;
+
+    VAStatus status = DdiDecodeSliceTranslator::Translate(DdiDecodeSliceTranslator::m_parallelSliceNum,
+        [&](uint32_t begin, uint32_t end) -> VAStatus {
+            EXPECT_EQ(caller, this_thread::get_id());
+            EXPECT_EQ(0u, begin);
+            EXPECT_EQ(DdiDecodeSliceTranslator::m_parallelSliceNum, end);
+            ranges++;
+            return VA_STATUS_SUCCESS;
+        });
+    EXPECT_EQ(VA_STATUS_SUCCESS, status);
+    EXPECT_EQ(1u, ranges);
+}
+
+TEST_F(DdiDecodeSliceTranslatorTest, EverySliceOnce)
+{
+    const uint32_t sliceNums[] = {65, 97, 256, 600, 1000};
+
+    for (uint32_t numSlices : sliceNums)
+    {
+        vector<atomic<uint32_t>> visits(numSlices);
+        for (auto &visit : visits)
+        {
+            visit = 0;
+        }
+
+        VAStatus status = DdiDecodeSliceTranslator::Translate(numSlices, [&](uint32_t begin, uint32_t end) -> VAStatus {
+            EXPECT_LT(begin, end);
+            EXPECT_LE(end, numSlices);
+            for (uint32_t i = begin; i < end; i++)
+            {
+                visits[i]++;
+            }
+            return VA_STATUS_SUCCESS;
+        });
+        EXPECT_EQ(VA_STATUS_SUCCESS, status);
+
+        for (uint32_t i = 0; i < numSlices; i++)
+        {
+            ASSERT_EQ(1u, visits[i].load()) << "slice " << i << " of " << numSlices;
+        }
+    }
+}
+
+TEST_F(DdiDecodeSliceTranslatorTest, FailedRange)
+{
+    const uint32_t numSlices = 600;
+    const uint32_t badSlice  = 590;
+
+    VAStatus status = DdiDecodeSliceTranslator::Translate(numSlices, [&](uint32_t begin, uint32_t end) -> VAStatus {
+        return (badSlice >= begin && badSlice < end) ? VA_STATUS_ERROR_INVALID_PARAMETER : VA_STATUS_SUCCESS;
+    });
+    EXPECT_EQ(VA_STATUS_ERROR_INVALID_PARAMETER, status);
+}
+
+TEST_F(DdiDecodeSliceTranslatorTest, ConcurrentBuffers)
+{
+    // Buffers of other contexts run on their calling threads while workers are busy
+    const uint32_t numSlices = 512;
+    vector<VaSlice> vaSlices(numSlices);
+    MakeSlices(vaSlices, 300);
+
+    auto decode = [&](vector<CodecSlice> &codecSlices, VAStatus &status) {
+        for (uint32_t frame = 0; frame < 50 && status == VA_STATUS_SUCCESS; frame++)
+        {
+            status = DdiDecodeSliceTranslator::Translate(numSlices, [&](uint32_t begin, uint32_t end) {
+                return TranslateSlices(vaSlices.data(), codecSlices.data(), 64, begin, end);
+            });
+        }
+    };
+
+    vector<CodecSlice> codecSlices[2] = {vector<CodecSlice>(numSlices), vector<CodecSlice>(numSlices)};
+    VAStatus           status[2]      = {VA_STATUS_SUCCESS, VA_STATUS_SUCCESS};
+    thread             other(decode, ref(codecSlices[1]), ref(status[1]));
+    decode(codecSlices[0], status[0]);
+    other.join();
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        EXPECT_EQ(VA_STATUS_SUCCESS, status[i]);
+        EXPECT_EQ(0, memcmp(codecSlices[0].data(), codecSlices[i].data(), numSlices * sizeof(CodecSlice)));
+    }
+    EXPECT_EQ(64 + vaSlices[numSlices - 1].sliceDataOffset, codecSlices[0][numSlices - 1].sliceDataOffset);
+    EXPECT_EQ(0x7f, codecSlices[0][7].refPicList[0][14]);
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(DdiDecodeSliceTranslatorTest, DISABLED_Benchmark)
+{
+    // Slices per frame of broadcast HEVC/AVC and VVC with many subpictures
+    const uint32_t sliceNums[] = {16, 68, 136, 272, 600};
+    const uint32_t frames      = 200;
+
+    for (uint32_t numSlices : sliceNums)
+    {
+        vector<VaSlice>    vaSlices(numSlices);
+        vector<CodecSlice> serialSlices(numSlices);
+        vector<CodecSlice> codecSlices(numSlices);
+        MakeSlices(vaSlices, 1000);
+
+        auto start = chrono::steady_clock::now();
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            TranslateSlices(vaSlices.data(), serialSlices.data(), frame, 0, numSlices);
+        }
+        auto middle = chrono::steady_clock::now();
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            DdiDecodeSliceTranslator::Translate(numSlices, [&](uint32_t begin, uint32_t end) {
+                return TranslateSlices(vaSlices.data(), codecSlices.data(), frame, begin, end);
+            });
+        }
+        auto end = chrono::steady_clock::now();
+
+        ASSERT_EQ(0, memcmp(serialSlices.data(), codecSlices.data(), numSlices * sizeof(CodecSlice)));
+        double serialUs = chrono::duration<double, micro>(middle - start).count() / frames;
+        double us       = chrono::duration<double, micro>(end - middle).count() / frames;
+        printf("[ BENCH    ] Slice parameter translation %u slices: calling thread %.2f us/frame, translator %.2f us/frame\n",
+            numSlices, serialUs, us);
+    }
+}
@@ -0,0 +1,155 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include "gtest/gtest.h"
+#include "ddi_encode_frame_arena.h"
+
+using namespace std;
+using namespace encode;
+
+// Counted by MosAllocMemory of mos_stub.cpp
+extern int32_t g_mosStubAllocCount;
+
+class DdiEncodeFrameArenaTest : public testing::Test
+{
+protected:
+    // DdiEncodeAvc between RenderPicture and EndPicture: delta QP array of
+    // ParsePicParams and slice headers rewritten by AddNALUnit
+    void RenderAvcFrame(DdiEncodeFrameArena &arena, uint8_t numPasses, uint32_t numSlices)
+    {
+        DdiEncodeFrameArena::ScopedReset endPicture(arena);
+
+        uint8_t *deltaQp = arena.AllocateArray<uint8_t>(numPasses);
+        ASSERT_NE(nullptr, deltaQp);
+        memset(deltaQp, 1, numPasses);
+
+        for (uint32_t i = 0; i < numSlices; i++)
+        {
+            uint32_t outBitSize = 40 + (i * 13) % 257;
+            void    *slcHdr     = arena.Allocate((outBitSize + 7) / 8);
+            ASSERT_NE(nullptr, slcHdr);
+            memset(slcHdr, 0xff, (outBitSize + 7) / 8);
+        }
+    }
+
+    // DdiEncodeJpeg between RenderPicture and EndPicture: ParseAppData grows
+    // app data by copying previous buffers into a new allocation
+    void RenderJpegFrame(DdiEncodeFrameArena &arena, uint32_t numAppBuffers, uint32_t appBufferSize)
+    {
+        DdiEncodeFrameArena::ScopedReset endPicture(arena);
+
+        uint8_t *appData          = nullptr;
+        uint32_t appDataTotalSize = 0;
+        for (uint32_t i = 0; i < numAppBuffers; i++)
+        {
+            uint8_t *tempAppData = (uint8_t *)arena.Allocate((size_t)appBufferSize + appDataTotalSize);
+            ASSERT_NE(nullptr, tempAppData);
+            if (appDataTotalSize > 0)
+            {
+                memcpy(tempAppData, appData, appDataTotalSize);
+            }
+            memset(tempAppData + appDataTotalSize, (int)i, appBufferSize);
+            appData = tempAppData;
+            appDataTotalSize += appBufferSize;
+        }
+        EXPECT_EQ((int)numAppBuffers - 1, appData[appDataTotalSize - 1]);
+    }
+};
+
+TEST_F(DdiEncodeFrameArenaTest, SteadyStateNoHeapAllocation)
+{
+    DdiEncodeFrameArena avcArena;
+    DdiEncodeFrameArena jpegArena;
+
+    // Warm up with the largest frames, the arena grows block by block and
+    // merges them into one block of high-water mark on the first frame after
+    RenderAvcFrame(avcArena, 8, 64);
+    RenderJpegFrame(jpegArena, 64, 64);
+    RenderAvcFrame(avcArena, 8, 64);
+    RenderJpegFrame(jpegArena, 64, 64);
+    EXPECT_GT(avcArena.GetHeapAllocCount(), 0u);
+    EXPECT_GT(jpegArena.GetHeapAllocCount(), 1u);
+
+    int32_t  mosAllocCount  = g_mosStubAllocCount;
+    uint32_t avcAllocCount  = avcArena.GetHeapAllocCount();
+    uint32_t jpegAllocCount = jpegArena.GetHeapAllocCount();
+
+    for (uint32_t frame = 0; frame < 1000; frame++)
+    {
+        RenderAvcFrame(avcArena, 1 + frame % 8, 1 + frame % 64);
+        RenderJpegFrame(jpegArena, 1 + (frame * 7) % 64, 1 + (frame * 97) % 64);
+    }
+
+    EXPECT_EQ(mosAllocCount, g_mosStubAllocCount);
+    EXPECT_EQ(avcAllocCount, avcArena.GetHeapAllocCount());
+    EXPECT_EQ(jpegAllocCount, jpegArena.GetHeapAllocCount());
+}
+
+TEST_F(DdiEncodeFrameArenaTest, AlignedAndZeroed)
+{
+    DdiEncodeFrameArena arena;
+
+    for (uint32_t frame = 0; frame < 2; frame++)
+    {
+        for (size_t size = 1; size < 200; size += 7)
+        {
+            uint8_t *data = (uint8_t *)arena.Allocate(size);
+            ASSERT_NE(nullptr, data);
+            EXPECT_EQ(0u, (uintptr_t)data % 16);
+            for (size_t i = 0; i < size; i++)
+            {
+                EXPECT_EQ(0, data[i]);
+            }
+            memset(data, 0xa5, size);
+        }
+        arena.Reset();
+    }
+
+    EXPECT_EQ(nullptr, arena.Allocate(0));
+    EXPECT_EQ(nullptr, arena.AllocateArray<uint64_t>(SIZE_MAX / 4));
+}
+
+TEST_F(DdiEncodeFrameArenaTest, LargeAllocation)
+{
+    DdiEncodeFrameArena arena;
+
+    uint8_t *small = (uint8_t *)arena.Allocate(16);
+    uint8_t *large = (uint8_t *)arena.Allocate(1024 * 1024);
+    ASSERT_NE(nullptr, small);
+    ASSERT_NE(nullptr, large);
+    memset(small, 1, 16);
+    memset(large, 2, 1024 * 1024);
+    EXPECT_EQ(1, small[15]);
+    EXPECT_EQ(2u, arena.GetHeapAllocCount());
+
+    arena.Reset();
+    EXPECT_GE(arena.GetHighWaterMark(), 1024u * 1024u + 16u);
+
+    // Blocks are merged into one for following frames
+    for (uint32_t frame = 0; frame < 4; frame++)
+    {
+        EXPECT_NE(nullptr, arena.Allocate(16));
+        EXPECT_NE(nullptr, arena.Allocate(1024 * 1024));
+        arena.Reset();
+    }
+    EXPECT_EQ(3u, arena.GetHeapAllocCount());
+}
@@ -0,0 +1,297 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_hevc_header_packer.h"
+
+using namespace std;
+
+class BitstreamWriterTest : public testing::Test
+{
+protected:
+    // Writes bits one by one, used as reference of BitstreamWriter
+    class RefWriter
+    {
+    public:
+        void PutBits(uint32_t n, uint32_t b)
+        {
+            for (int32_t i = n - 1; i >= 0; i--)
+            {
+                PutBit((b >> i) & 1);
+            }
+        }
+
+        void PutBit(uint32_t bit)
+        {
+            if ((m_bitLen & 7) == 0)
+            {
+                m_data.push_back(0);
+            }
+            m_data.back() |= (uint8_t)((bit & 1) << (7 - (m_bitLen & 7)));
+            m_bitLen++;
+        }
+
+        void PutUE(uint32_t b)
+        {
+            uint32_t codeNum = b + 1;
+            uint32_t n       = 0;
+            while ((codeNum >> n) > 1)
+            {
+                n++;
+            }
+            PutBits(n, 0);
+            PutBits(n + 1, codeNum);
+        }
+
+        void PutSE(int32_t b)
+        {
+            PutUE(b > 0 ? (2 * b - 1) : (-2 * b));
+        }
+
+        vector<uint8_t> m_data;
+        uint32_t        m_bitLen = 0;
+    };
+
+    void CheckEqual(BitstreamWriter &bs, RefWriter &ref)
+    {
+        ASSERT_EQ(bs.GetOffset(), ref.m_bitLen);
+        uint32_t bytes = (ref.m_bitLen + 7) / 8;
+        for (uint32_t i = 0; i < bytes; i++)
+        {
+            ASSERT_EQ(bs.GetStart()[i], ref.m_data[i]) << "byte " << i;
+        }
+    }
+};
+
+TEST_F(BitstreamWriterTest, PutBitsMatchReference)
+{
+    vector<uint8_t> buffer(32 * 1024, 0xff);
+    BitstreamWriter bs(buffer.data(), (mfxU32)buffer.size());
+    RefWriter       ref;
+    mt19937         rng(1);
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        uint32_t value = rng();
+        switch (rng() % 4)
+        {
+        case 0:
+        {
+            uint32_t n = 1 + rng() % 32;
+            bs.PutBits(n, value);
+            ref.PutBits(n, value);
+            break;
+        }
+        case 1:
+            bs.PutBit(value & 1);
+            ref.PutBit(value & 1);
+            break;
+        case 2:
+            // Mix short and long codes, ue(v) is limited to 32 bits codeNum
+            value = (value & 1) ? (value & 0xff) : value >> (1 + value % 31);
+            bs.PutUE(value);
+            ref.PutUE(value);
+            break;
+        default:
+            bs.PutSE((int32_t)(value & 0xffff) - 0x8000);
+            ref.PutSE((int32_t)(value & 0xffff) - 0x8000);
+            break;
+        }
+    }
+
+    CheckEqual(bs, ref);
+}
+
+TEST_F(BitstreamWriterTest, PutBitsBufferMatchReference)
+{
+    vector<uint8_t> src(64);
+    mt19937         rng(2);
+    for (auto &b : src)
+    {
+        b = (uint8_t)rng();
+    }
+
+    vector<uint8_t> buffer(8192, 0xff);
+    BitstreamWriter bs(buffer.data(), (mfxU32)buffer.size());
+    RefWriter       ref;
+
+    // Cover all alignments of source and destination
+    for (uint32_t dstBit = 0; dstBit < 8; dstBit++)
+    {
+        for (uint32_t srcBit = 0; srcBit < 8; srcBit++)
+        {
+            bs.PutBits(dstBit + 1, 1);
+            ref.PutBits(dstBit + 1, 1);
+
+            uint32_t n = rng() % (src.size() * 8 - srcBit);
+            bs.PutBitsBuffer(n, src.data(), srcBit);
+            for (uint32_t i = srcBit; i < srcBit + n; i++)
+            {
+                ref.PutBit(src[i >> 3] >> (7 - (i & 7)));
+            }
+        }
+    }
+
+    CheckEqual(bs, ref);
+}
+
+class HevcHeaderPackerTest : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        MOS_ZeroMemory(&m_seqParams, sizeof(m_seqParams));
+        MOS_ZeroMemory(&m_picParams, sizeof(m_picParams));
+        MOS_ZeroMemory(&m_sliceHeaderParams, sizeof(m_sliceHeaderParams));
+        MOS_ZeroMemory(m_sliceParams, sizeof(m_sliceParams));
+
+        // 1920x1080, 8x8 min CB, 64x64 CTB
+        m_seqParams.wFrameWidthInMinCbMinus1          = 239;
+        m_seqParams.wFrameHeightInMinCbMinus1         = 134;
+        m_seqParams.log2_min_coding_block_size_minus3 = 0;
+        m_seqParams.log2_max_coding_block_size_minus3 = 3;
+        m_seqParams.chroma_format_idc                 = 1;
+        m_seqParams.sps_temporal_mvp_enable_flag      = 1;
+        m_seqParams.SAO_enabled_flag                  = 1;
+
+        m_picParams.nal_unit_type                         = TRAIL_R;
+        m_picParams.CurrPicOrderCnt                       = 21;
+        m_picParams.loop_filter_across_slices_flag        = 1;
+        m_picParams.dependent_slice_segments_enabled_flag = 1;
+
+        m_sliceHeaderParams.log2_max_pic_order_cnt_lsb_minus4 = 4;
+        m_sliceHeaderParams.num_negative_pics                 = 2;
+        m_sliceHeaderParams.num_positive_pics                 = 1;
+        m_sliceHeaderParams.delta_poc_minus1[0][0]            = 0;
+        m_sliceHeaderParams.delta_poc_minus1[0][1]            = 3;
+        m_sliceHeaderParams.delta_poc_minus1[1][0]            = 1;
+        m_sliceHeaderParams.used_by_curr_pic_flag[0][0]       = true;
+        m_sliceHeaderParams.used_by_curr_pic_flag[0][1]       = true;
+        m_sliceHeaderParams.used_by_curr_pic_flag[1][0]       = true;
+
+        for (uint32_t i = 0; i < m_numSlices; i++)
+        {
+            CODEC_HEVC_ENCODE_SLICE_PARAMS &slc = m_sliceParams[i];
+            slc.slice_segment_address           = i * 17;
+            slc.slice_type                      = 0;  // B
+            slc.num_ref_idx_l0_active_minus1    = 1;
+            slc.num_ref_idx_l1_active_minus1    = 0;
+            slc.slice_temporal_mvp_enable_flag  = 1;
+            slc.slice_sao_luma_flag             = 1;
+            slc.collocated_from_l0_flag         = 1;
+            slc.MaxNumMergeCand                 = 5;
+            slc.slice_qp_delta                  = (char)(i * 3 - 10);
+            slc.slice_cb_qp_offset              = 1;
+            slc.slice_cr_qp_offset              = -1;
+            slc.bLastSliceOfPic                 = (i == m_numSlices - 1);
+        }
+    }
+
+    virtual void TearDown() {}
+
+    //! \brief  Pack slice headers of the frame, returns the packed bytes
+    vector<uint8_t> Pack(bool templateEnabled, vector<CODEC_ENCODER_SLCDATA> &slcData)
+    {
+        vector<uint8_t> bitstream(16 * 1024, 0);
+        BSBuffer        bsBuffer = {};
+        bsBuffer.pBase           = bitstream.data();
+        bsBuffer.pCurrent        = bitstream.data();
+        bsBuffer.BufferSize      = (uint32_t)bitstream.size();
+
+        slcData.assign(m_numSlices, CODEC_ENCODER_SLCDATA());
+
+        EncoderParams encodeParams      = {};
+        encodeParams.pSeqParams         = &m_seqParams;
+        encodeParams.pPicParams         = &m_picParams;
+        encodeParams.pSliceParams       = m_sliceParams;
+        encodeParams.pSliceHeaderParams = &m_sliceHeaderParams;
+        encodeParams.pBSBuffer          = &bsBuffer;
+        encodeParams.pSlcHeaderData     = slcData.data();
+        encodeParams.dwNumSlices        = m_numSlices;
+
+        HevcHeaderPacker packer;
+        packer.m_sliceTemplateEnabled = templateEnabled;
+        EXPECT_EQ(packer.SliceHeaderPacker(&encodeParams), MOS_STATUS_SUCCESS);
+
+        return bitstream;
+    }
+
+    void CheckTemplateMatchesFullPacking()
+    {
+        vector<CODEC_ENCODER_SLCDATA> refSlcData, slcData;
+        vector<uint8_t>               ref = Pack(false, refSlcData);
+        vector<uint8_t>               out = Pack(true, slcData);
+
+        EXPECT_EQ(ref, out);
+        for (uint32_t i = 0; i < m_numSlices; i++)
+        {
+            EXPECT_EQ(refSlcData[i].SliceOffset, slcData[i].SliceOffset) << "slice " << i;
+            EXPECT_EQ(refSlcData[i].BitSize, slcData[i].BitSize) << "slice " << i;
+            EXPECT_EQ(refSlcData[i].SkipEmulationByteCount, slcData[i].SkipEmulationByteCount) << "slice " << i;
+        }
+    }
+
+    static const uint32_t                 m_numSlices = 8;
+    CODEC_HEVC_ENCODE_SEQUENCE_PARAMS     m_seqParams;
+    CODEC_HEVC_ENCODE_PICTURE_PARAMS      m_picParams;
+    CODEC_HEVC_ENCODE_SLICE_PARAMS        m_sliceParams[m_numSlices];
+    CodecEncodeHevcSliceHeaderParams      m_sliceHeaderParams;
+};
+
+TEST_F(HevcHeaderPackerTest, TemplateBSlices)
+{
+    CheckTemplateMatchesFullPacking();
+}
+
+TEST_F(HevcHeaderPackerTest, TemplateSliceParamsChange)
+{
+    // Template is rebuilt when slice params other than address and qp delta change
+    m_sliceParams[3].cabac_init_flag               = 1;
+    m_sliceParams[5].slice_deblocking_filter_disable_flag = 1;
+    m_sliceParams[6].beta_offset_div2              = 2;
+    CheckTemplateMatchesFullPacking();
+}
+
+TEST_F(HevcHeaderPackerTest, TemplateDependentSlices)
+{
+    m_sliceParams[2].dependent_slice_segment_flag = 1;
+    m_sliceParams[3].dependent_slice_segment_flag = 1;
+    m_sliceParams[6].dependent_slice_segment_flag = 1;
+    CheckTemplateMatchesFullPacking();
+}
+
+TEST_F(HevcHeaderPackerTest, TemplateIdrTilesDss)
+{
+    m_picParams.nal_unit_type      = IDR_W_RADL;
+    m_picParams.tiles_enabled_flag = 1;
+    for (uint32_t i = 0; i < m_numSlices; i++)
+    {
+        m_sliceParams[i].slice_type = 2;  // I
+    }
+    CheckTemplateMatchesFullPacking();
+
+    // No slice address and trailing bits for dynamic slice size
+    m_seqParams.SliceSizeControl = 1;
+    CheckTemplateMatchesFullPacking();
+}
@@ -0,0 +1,449 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "decode_hevc_slice_header_parser.h"
+
+using namespace std;
+using namespace decode;
+
+class HevcSliceHeaderParserTest : public testing::Test
+{
+protected:
+    // Writes slice segment header RBSP, emulation prevention is added by Finish()
+    class BitWriter
+    {
+    public:
+        void PutBits(uint32_t value, uint32_t numBits)
+        {
+            for (int32_t i = numBits - 1; i >= 0; i--)
+            {
+                PutBit((value >> i) & 1);
+            }
+        }
+
+        void PutUe(uint32_t value)
+        {
+            uint32_t codeNum = value + 1;
+            uint32_t numBits = 0;
+            while ((codeNum >> numBits) > 1)
+            {
+                numBits++;
+            }
+            PutBits(0, numBits);
+            PutBits(codeNum, numBits + 1);
+        }
+
+        void PutSe(int32_t value)
+        {
+            PutUe(value > 0 ? (2 * value - 1) : (-2 * value));
+        }
+
+        void ByteAlignment()
+        {
+            PutBit(1);
+            while (m_bitPos != 0)
+            {
+                PutBit(0);
+            }
+        }
+
+        //! \brief  Append slice data after header and convert RBSP to NAL unit payload
+        vector<uint8_t> Finish(uint32_t sliceDataBytes, uint32_t &headerBytes, uint32_t &headerEmuBytes)
+        {
+            headerBytes = (uint32_t)m_rbsp.size();
+            for (uint32_t i = 0; i < sliceDataBytes; i++)
+            {
+                m_rbsp.push_back(0xa5);
+            }
+
+            vector<uint8_t> nal;
+            uint32_t        zeroCount = 0;
+            headerEmuBytes            = 0;
+            for (uint32_t i = 0; i < m_rbsp.size(); i++)
+            {
+                if (zeroCount >= 2 && m_rbsp[i] <= 3)
+                {
+                    nal.push_back(0x03);
+                    zeroCount = 0;
+                    if (i < headerBytes)
+                    {
+                        headerEmuBytes++;
+                    }
+                }
+                nal.push_back(m_rbsp[i]);
+                zeroCount = (m_rbsp[i] == 0) ? zeroCount + 1 : 0;
+            }
+            return nal;
+        }
+
+    protected:
+        void PutBit(uint32_t bit)
+        {
+            if (m_bitPos == 0)
+            {
+                m_rbsp.push_back(0);
+            }
+            m_rbsp.back() |= (uint8_t)(bit << (7 - m_bitPos));
+            m_bitPos = (m_bitPos + 1) & 7;
+        }
+
+        vector<uint8_t> m_rbsp;
+        uint32_t        m_bitPos = 0;
+    };
+
+    virtual void SetUp()
+    {
+        MOS_ZeroMemory(&m_picParams, sizeof(m_picParams));
+        MOS_ZeroMemory(&m_subsetParams, sizeof(m_subsetParams));
+
+        // 1920x1080, 8x8 min CB, 64x64 CTB, 30x17 CTBs
+        m_picParams.PicWidthInMinCbsY                        = 240;
+        m_picParams.PicHeightInMinCbsY                       = 135;
+        m_picParams.chroma_format_idc                        = 1;
+        m_picParams.log2_max_pic_order_cnt_lsb_minus4        = 4;
+        m_picParams.log2_min_luma_coding_block_size_minus3   = 0;
+        m_picParams.log2_diff_max_min_luma_coding_block_size = 3;
+        m_picParams.num_short_term_ref_pic_sets              = 1;
+        m_picParams.pps_beta_offset_div2                     = 2;
+        m_picParams.pps_tc_offset_div2                       = -2;
+        m_picParams.pps_loop_filter_across_slices_enabled_flag = 1;
+        m_picParams.CurrPicOrderCntVal                       = 8;
+
+        memset(m_picParams.RefPicSetStCurrBefore, 0xff, sizeof(m_picParams.RefPicSetStCurrBefore));
+        memset(m_picParams.RefPicSetStCurrAfter, 0xff, sizeof(m_picParams.RefPicSetStCurrAfter));
+        memset(m_picParams.RefPicSetLtCurr, 0xff, sizeof(m_picParams.RefPicSetLtCurr));
+    }
+
+    virtual void TearDown() {}
+
+    void SetReferences()
+    {
+        // RefFrameList order differs from the RPS order on purpose
+        m_picParams.PicOrderCntValList[0]    = 4;
+        m_picParams.PicOrderCntValList[1]    = 7;
+        m_picParams.PicOrderCntValList[2]    = 12;
+        m_picParams.RefPicSetStCurrBefore[0] = 0;
+        m_picParams.RefPicSetStCurrBefore[1] = 1;
+        m_picParams.RefPicSetStCurrAfter[0]  = 2;
+    }
+
+    void AddSlice(const vector<uint8_t> &nal, bool withStartCode)
+    {
+        CODEC_HEVC_SLICE_PARAMS slc;
+        MOS_ZeroMemory(&slc, sizeof(slc));
+        slc.slice_data_offset = (uint32_t)m_bitstream.size();
+        if (withStartCode)
+        {
+            m_bitstream.insert(m_bitstream.end(), {0x00, 0x00, 0x00, 0x01});
+        }
+        m_bitstream.insert(m_bitstream.end(), nal.begin(), nal.end());
+        slc.slice_data_size = (uint32_t)m_bitstream.size() - slc.slice_data_offset;
+        m_sliceParams.push_back(slc);
+    }
+
+    MOS_STATUS Parse(PCODEC_HEVC_EXT_PIC_PARAMS extPicParams = nullptr, PCODEC_HEVC_EXT_SLICE_PARAMS extSliceParams = nullptr)
+    {
+        return m_parser.ParsePicture(
+            m_bitstream.data(),
+            (uint32_t)m_bitstream.size(),
+            m_picParams,
+            extPicParams,
+            m_sliceParams.data(),
+            extSliceParams,
+            m_subsetParams,
+            (uint32_t)m_sliceParams.size());
+    }
+
+    HevcSliceHeaderParser            m_parser;
+    CODEC_HEVC_PIC_PARAMS            m_picParams;
+    CODEC_HEVC_SUBSET_PARAMS         m_subsetParams;
+    vector<CODEC_HEVC_SLICE_PARAMS>  m_sliceParams;
+    vector<uint8_t>                  m_bitstream;
+};
+
+TEST_F(HevcSliceHeaderParserTest, BitReaderRemovesEmulationPrevention)
+{
+    const uint8_t data[] = {0x00, 0x00, 0x03, 0x01, 0x80};
+    HevcSliceHeaderParser::BitReader reader(data, sizeof(data));
+
+    uint32_t value = 0xffffffff;
+    EXPECT_EQ(MOS_STATUS_SUCCESS, reader.ReadBits(24, value));
+    EXPECT_EQ(1u, value);
+    EXPECT_EQ(1u, reader.GetEmuPrevnBytes());
+    EXPECT_EQ(4u, reader.GetRawBytePos());
+
+    EXPECT_EQ(MOS_STATUS_SUCCESS, reader.ReadUe(value));
+    EXPECT_EQ(0u, value);
+    EXPECT_NE(MOS_STATUS_SUCCESS, reader.ReadBits(8, value));
+}
+
+TEST_F(HevcSliceHeaderParserTest, IdrIntraSlice)
+{
+    BitWriter bw;
+    bw.PutBits((19 << 9) | 1, 16);  // IDR_W_RADL
+    bw.PutBits(1, 1);               // first_slice_segment_in_pic_flag
+    bw.PutBits(0, 1);               // no_output_of_prior_pics_flag
+    bw.PutUe(0);                    // slice_pic_parameter_set_id
+    bw.PutUe(decodeHevcISlice);
+    bw.PutSe(-3);                   // slice_qp_delta
+    bw.PutBits(0, 1);               // slice_loop_filter_across_slices_enabled_flag
+    bw.ByteAlignment();
+
+    uint32_t headerBytes = 0, emuBytes = 0;
+    AddSlice(bw.Finish(64, headerBytes, emuBytes), false);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Parse());
+
+    auto &slc = m_sliceParams[0];
+    EXPECT_EQ(decodeHevcISlice, slc.LongSliceFlags.fields.slice_type);
+    EXPECT_EQ(-3, slc.slice_qp_delta);
+    EXPECT_EQ(headerBytes, slc.ByteOffsetToSliceData);
+    EXPECT_EQ(emuBytes, slc.NumEmuPrevnBytesInSliceHdr);
+    EXPECT_EQ(0u, slc.slice_segment_address);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.LastSliceOfPic);
+    EXPECT_EQ(0u, slc.LongSliceFlags.fields.slice_loop_filter_across_slices_enabled_flag);
+    EXPECT_EQ(2, slc.slice_beta_offset_div2);
+    EXPECT_EQ(-2, slc.slice_tc_offset_div2);
+    EXPECT_EQ(0x7f, slc.RefPicList[0][0].FrameIdx);
+    EXPECT_EQ(64u + headerBytes + emuBytes, slc.slice_data_size);
+}
+
+TEST_F(HevcSliceHeaderParserTest, PredictedSliceWithStartCode)
+{
+    SetReferences();
+    m_picParams.wNumBitsForShortTermRPSInSlice          = 16;
+    m_picParams.sps_temporal_mvp_enabled_flag           = 1;
+    m_picParams.sample_adaptive_offset_enabled_flag     = 1;
+    m_picParams.deblocking_filter_override_enabled_flag = 1;
+
+    BitWriter bw;
+    bw.PutBits((1 << 9) | 1, 16);   // TRAIL_R
+    bw.PutBits(1, 1);               // first_slice_segment_in_pic_flag
+    bw.PutUe(0);                    // slice_pic_parameter_set_id
+    bw.PutUe(decodeHevcPSlice);
+    bw.PutBits(0, 8);               // slice_pic_order_cnt_lsb
+    bw.PutBits(0, 1);               // short_term_ref_pic_set_sps_flag
+    bw.PutBits(0, 16);              // st_ref_pic_set()
+    bw.PutBits(1, 1);               // slice_temporal_mvp_enabled_flag
+    bw.PutBits(1, 1);               // slice_sao_luma_flag
+    bw.PutBits(0, 1);               // slice_sao_chroma_flag
+    bw.PutBits(1, 1);               // num_ref_idx_active_override_flag
+    bw.PutUe(1);                    // num_ref_idx_l0_active_minus1
+    bw.PutUe(1);                    // collocated_ref_idx
+    bw.PutUe(2);                    // five_minus_max_num_merge_cand
+    bw.PutSe(2);                    // slice_qp_delta
+    bw.PutBits(1, 1);               // deblocking_filter_override_flag
+    bw.PutBits(0, 1);               // slice_deblocking_filter_disabled_flag
+    bw.PutSe(1);                    // slice_beta_offset_div2
+    bw.PutSe(-1);                   // slice_tc_offset_div2
+    bw.PutBits(1, 1);               // slice_loop_filter_across_slices_enabled_flag
+    bw.ByteAlignment();
+
+    m_bitstream.assign(16, 0);      // Slice not at the beginning of bitstream buffer
+    uint32_t headerBytes = 0, emuBytes = 0;
+    AddSlice(bw.Finish(32, headerBytes, emuBytes), true);
+    EXPECT_GT(emuBytes, 0u);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Parse());
+
+    auto &slc = m_sliceParams[0];
+    EXPECT_EQ(16u, slc.slice_data_offset);
+    EXPECT_EQ(4u + headerBytes, slc.ByteOffsetToSliceData);
+    EXPECT_EQ(emuBytes, slc.NumEmuPrevnBytesInSliceHdr);
+    EXPECT_EQ(decodeHevcPSlice, slc.LongSliceFlags.fields.slice_type);
+    EXPECT_EQ(1u, slc.num_ref_idx_l0_active_minus1);
+    // Nearest POC first: POC 7 (index 1), then POC 4 (index 0)
+    EXPECT_EQ(1, slc.RefPicList[0][0].FrameIdx);
+    EXPECT_EQ(0, slc.RefPicList[0][1].FrameIdx);
+    EXPECT_EQ(0x7f, slc.RefPicList[0][2].FrameIdx);
+    EXPECT_EQ(0x7f, slc.RefPicList[1][0].FrameIdx);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.slice_temporal_mvp_enabled_flag);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.collocated_from_l0_flag);
+    EXPECT_EQ(1, slc.collocated_ref_idx);
+    EXPECT_EQ(2, slc.five_minus_max_num_merge_cand);
+    EXPECT_EQ(2, slc.slice_qp_delta);
+    EXPECT_EQ(1, slc.slice_beta_offset_div2);
+    EXPECT_EQ(-1, slc.slice_tc_offset_div2);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.slice_sao_luma_flag);
+    EXPECT_EQ(0u, slc.LongSliceFlags.fields.slice_sao_chroma_flag);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.slice_loop_filter_across_slices_enabled_flag);
+}
+
+TEST_F(HevcSliceHeaderParserTest, BiPredSlicesWithListModificationAndEntryPoints)
+{
+    SetReferences();
+    m_picParams.lists_modification_present_flag       = 1;
+    m_picParams.dependent_slice_segments_enabled_flag = 1;
+    m_picParams.pps_deblocking_filter_disabled_flag   = 1;
+    m_picParams.tiles_enabled_flag                    = 1;
+    m_picParams.num_tile_columns_minus1               = 1;
+
+    BitWriter bw;
+    bw.PutBits((1 << 9) | 1, 16);   // TRAIL_R
+    bw.PutBits(1, 1);               // first_slice_segment_in_pic_flag
+    bw.PutUe(0);                    // slice_pic_parameter_set_id
+    bw.PutUe(decodeHevcBSlice);
+    bw.PutBits(0x5a, 8);            // slice_pic_order_cnt_lsb
+    bw.PutBits(1, 1);               // short_term_ref_pic_set_sps_flag
+    bw.PutBits(1, 1);               // num_ref_idx_active_override_flag
+    bw.PutUe(1);                    // num_ref_idx_l0_active_minus1
+    bw.PutUe(0);                    // num_ref_idx_l1_active_minus1
+    bw.PutBits(1, 1);               // ref_pic_list_modification_flag_l0
+    bw.PutBits(2, 2);               // list_entry_l0[0]
+    bw.PutBits(0, 2);               // list_entry_l0[1]
+    bw.PutBits(0, 1);               // ref_pic_list_modification_flag_l1
+    bw.PutBits(1, 1);               // mvd_l1_zero_flag
+    bw.PutUe(0);                    // five_minus_max_num_merge_cand
+    bw.PutSe(0);                    // slice_qp_delta
+    bw.PutUe(1);                    // num_entry_point_offsets
+    bw.PutUe(9);                    // offset_len_minus1
+    bw.PutBits(300, 10);            // entry_point_offset_minus1[0]
+    bw.ByteAlignment();
+
+    uint32_t headerBytes = 0, emuBytes = 0;
+    AddSlice(bw.Finish(400, headerBytes, emuBytes), false);
+
+    BitWriter bwDep;
+    bwDep.PutBits((1 << 9) | 1, 16);
+    bwDep.PutBits(0, 1);            // first_slice_segment_in_pic_flag
+    bwDep.PutUe(0);                 // slice_pic_parameter_set_id
+    bwDep.PutBits(1, 1);            // dependent_slice_segment_flag
+    bwDep.PutBits(15, 9);           // slice_segment_address
+    bwDep.PutUe(0);                 // num_entry_point_offsets
+    bwDep.ByteAlignment();
+
+    uint32_t depHeaderBytes = 0;
+    AddSlice(bwDep.Finish(100, depHeaderBytes, emuBytes), false);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Parse());
+
+    auto &slc = m_sliceParams[0];
+    EXPECT_EQ(decodeHevcBSlice, slc.LongSliceFlags.fields.slice_type);
+    EXPECT_EQ(headerBytes, slc.ByteOffsetToSliceData);
+    // RefPicListTemp0 is {1, 0, 2}, list_entry_l0 picks {2, 1}
+    EXPECT_EQ(2, slc.RefPicList[0][0].FrameIdx);
+    EXPECT_EQ(1, slc.RefPicList[0][1].FrameIdx);
+    // RefPicListTemp1 is {2, 1, 0}
+    EXPECT_EQ(2, slc.RefPicList[1][0].FrameIdx);
+    EXPECT_EQ(0x7f, slc.RefPicList[1][1].FrameIdx);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.mvd_l1_zero_flag);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.slice_deblocking_filter_disabled_flag);
+    EXPECT_EQ(1u, slc.LongSliceFlags.fields.slice_loop_filter_across_slices_enabled_flag);
+    EXPECT_EQ(1u, slc.num_entry_point_offsets);
+    EXPECT_EQ(0u, slc.EntryOffsetToSubsetArray);
+    EXPECT_EQ(300u, m_subsetParams.entry_point_offset_minus1[0]);
+    EXPECT_EQ(0u, slc.LongSliceFlags.fields.LastSliceOfPic);
+
+    auto &dep = m_sliceParams[1];
+    EXPECT_EQ(1u, dep.LongSliceFlags.fields.dependent_slice_segment_flag);
+    EXPECT_EQ(15u, dep.slice_segment_address);
+    EXPECT_EQ(decodeHevcBSlice, dep.LongSliceFlags.fields.slice_type);
+    EXPECT_EQ(2, dep.RefPicList[0][0].FrameIdx);
+    EXPECT_EQ(0u, dep.num_entry_point_offsets);
+    EXPECT_EQ(1u, dep.EntryOffsetToSubsetArray);
+    EXPECT_EQ(depHeaderBytes, dep.ByteOffsetToSliceData);
+    EXPECT_EQ(m_sliceParams[0].slice_data_size, dep.slice_data_offset);
+    EXPECT_EQ(1u, dep.LongSliceFlags.fields.LastSliceOfPic);
+}
+
+TEST_F(HevcSliceHeaderParserTest, WeightedPrediction)
+{
+    SetReferences();
+    m_picParams.weighted_pred_flag = 1;
+
+    BitWriter bw;
+    bw.PutBits((1 << 9) | 1, 16);   // TRAIL_R
+    bw.PutBits(1, 1);               // first_slice_segment_in_pic_flag
+    bw.PutUe(0);                    // slice_pic_parameter_set_id
+    bw.PutUe(decodeHevcPSlice);
+    bw.PutBits(3, 8);               // slice_pic_order_cnt_lsb
+    bw.PutBits(1, 1);               // short_term_ref_pic_set_sps_flag
+    bw.PutBits(0, 1);               // num_ref_idx_active_override_flag
+    bw.PutUe(6);                    // luma_log2_weight_denom
+    bw.PutSe(-1);                   // delta_chroma_log2_weight_denom
+    bw.PutBits(1, 1);               // luma_weight_l0_flag[0]
+    bw.PutBits(1, 1);               // chroma_weight_l0_flag[0]
+    bw.PutSe(3);                    // delta_luma_weight_l0[0]
+    bw.PutSe(-5);                   // luma_offset_l0[0]
+    bw.PutSe(2);                    // delta_chroma_weight_l0[0][0]
+    bw.PutSe(10);                   // delta_chroma_offset_l0[0][0]
+    bw.PutSe(0);                    // delta_chroma_weight_l0[0][1]
+    bw.PutSe(-4);                   // delta_chroma_offset_l0[0][1]
+    bw.PutUe(0);                    // five_minus_max_num_merge_cand
+    bw.PutSe(0);                    // slice_qp_delta
+    bw.PutBits(1, 1);               // slice_loop_filter_across_slices_enabled_flag
+    bw.ByteAlignment();
+
+    uint32_t headerBytes = 0, emuBytes = 0;
+    AddSlice(bw.Finish(16, headerBytes, emuBytes), false);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, Parse());
+
+    auto &slc = m_sliceParams[0];
+    EXPECT_EQ(headerBytes, slc.ByteOffsetToSliceData);
+    EXPECT_EQ(0u, slc.num_ref_idx_l0_active_minus1);
+    EXPECT_EQ(1, slc.RefPicList[0][0].FrameIdx);
+    EXPECT_EQ(6, slc.luma_log2_weight_denom);
+    EXPECT_EQ(-1, (int8_t)slc.delta_chroma_log2_weight_denom);
+    EXPECT_EQ(3, slc.delta_luma_weight_l0[0]);
+    EXPECT_EQ(-5, slc.luma_offset_l0[0]);
+    EXPECT_EQ(2, slc.delta_chroma_weight_l0[0][0]);
+    EXPECT_EQ(0, slc.delta_chroma_weight_l0[0][1]);
+    // ChromaOffset = (128 - ((128 * ChromaWeight) >> ChromaLog2WeightDenom)) + delta_chroma_offset
+    EXPECT_EQ(2, slc.ChromaOffsetL0[0][0]);
+    EXPECT_EQ(-4, slc.ChromaOffsetL0[0][1]);
+}
+
+TEST_F(HevcSliceHeaderParserTest, FallbackCases)
+{
+    BitWriter bw;
+    bw.PutBits((19 << 9) | 1, 16);
+    bw.PutBits(1, 1);
+    bw.PutBits(0, 1);
+    bw.PutUe(0);
+    bw.PutUe(decodeHevcISlice);
+    bw.ByteAlignment();
+
+    uint32_t headerBytes = 0, emuBytes = 0;
+    vector<uint8_t> nal = bw.Finish(0, headerBytes, emuBytes);
+    nal.resize(3);
+    AddSlice(nal, false);
+
+    // Truncated slice header
+    EXPECT_NE(MOS_STATUS_SUCCESS, Parse());
+
+    // Slice data out of bitstream buffer
+    m_sliceParams[0].slice_data_size = 64;
+    EXPECT_NE(MOS_STATUS_SUCCESS, Parse());
+
+    EXPECT_TRUE(HevcSliceHeaderParser::IsSupported(m_picParams, nullptr));
+
+    CODEC_HEVC_SCC_PIC_PARAMS sccPicParams;
+    MOS_ZeroMemory(&sccPicParams, sizeof(sccPicParams));
+    EXPECT_FALSE(HevcSliceHeaderParser::IsSupported(m_picParams, &sccPicParams));
+
+    m_picParams.RefPicSetLtCurr[0] = 3;
+    m_picParams.RefPicSetLtCurr[1] = 4;
+    EXPECT_FALSE(HevcSliceHeaderParser::IsSupported(m_picParams, nullptr));
+}
@@ -0,0 +1,157 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "media_debug_fast_dump_compress.h"
+
+using namespace std;
+
+class MediaDebugFastDumpCompressTest : public testing::Test
+{
+protected:
+    //! \brief  Surface like data, smooth gradient with noise and a flat area
+    vector<uint8_t> MakeFrame(size_t size, uint32_t frame)
+    {
+        vector<uint8_t> data(size);
+        mt19937         rng(frame);
+        for (size_t i = 0; i < size; i++)
+        {
+            data[i] = (i % 4096 < 1024) ? 0x80 : (uint8_t)((i + frame) / 64 + (rng() & 3));
+        }
+        return data;
+    }
+
+    void CheckRoundTrip(const vector<uint8_t> &src)
+    {
+        vector<uint8_t> compressed(MediaDebugFastDumpLz::CompressBound(src.size()));
+        size_t          size = MediaDebugFastDumpLz::Compress(src.data(), src.size(), compressed.data(), compressed.size());
+        ASSERT_GT(size, 0u);
+
+        vector<uint8_t> out(src.size());
+        ASSERT_TRUE(MediaDebugFastDumpLz::Decompress(compressed.data(), size, out.data(), out.size()));
+        EXPECT_EQ(src, out);
+    }
+
+    //! \brief  Write one container the same way as the fast dump writer
+    void WriteContainer(const string &path, const vector<uint8_t> &src, const vector<uint8_t> *ref, const string &refName)
+    {
+        MediaDebugFastDumpContainer::Header header;
+        header.rawSize    = src.size();
+        header.blockCount = (uint32_t)((src.size() + header.blockSize - 1) / header.blockSize);
+        header.flags      = ref ? MediaDebugFastDumpContainer::m_flagDelta : 0;
+        header.refNameLen = ref ? (uint32_t)refName.size() : 0;
+
+        vector<vector<uint8_t>> blocks(header.blockCount);
+        vector<uint32_t>        blockSizes(header.blockCount);
+        for (uint32_t i = 0; i < header.blockCount; i++)
+        {
+            size_t   offset = (size_t)i * header.blockSize;
+            uint32_t size   = (uint32_t)min<size_t>(header.blockSize, src.size() - offset);
+            blockSizes[i]   = MediaDebugFastDumpContainer::CompressBlock(
+                src.data() + offset, size, ref ? ref->data() + offset : nullptr, blocks[i]);
+        }
+
+        ofstream ofs(path, ios_base::out | ios_base::binary);
+        ofs.write((const char *)&header, sizeof(header));
+        ofs.write(refName.data(), header.refNameLen);
+        ofs.write((const char *)blockSizes.data(), blockSizes.size() * sizeof(uint32_t));
+        for (const auto &b : blocks)
+        {
+            ofs.write((const char *)b.data(), b.size());
+        }
+    }
+};
+
+TEST_F(MediaDebugFastDumpCompressTest, LzRoundTrip)
+{
+    CheckRoundTrip(vector<uint8_t>());
+    CheckRoundTrip(vector<uint8_t>(7, 1));
+    CheckRoundTrip(vector<uint8_t>(100000, 0));  // long overlapped matches
+    CheckRoundTrip(MakeFrame(300000, 1));
+
+    vector<uint8_t> random(70000);
+    mt19937         rng(5);
+    for (auto &b : random)
+    {
+        b = (uint8_t)rng();  // long literal runs
+    }
+    CheckRoundTrip(random);
+}
+
+TEST_F(MediaDebugFastDumpCompressTest, LzRejectsCorruptedData)
+{
+    vector<uint8_t> src = MakeFrame(50000, 2);
+    vector<uint8_t> compressed(MediaDebugFastDumpLz::CompressBound(src.size()));
+    size_t          size = MediaDebugFastDumpLz::Compress(src.data(), src.size(), compressed.data(), compressed.size());
+    vector<uint8_t> out(src.size());
+
+    EXPECT_FALSE(MediaDebugFastDumpLz::Decompress(compressed.data(), size / 2, out.data(), out.size()));
+    EXPECT_FALSE(MediaDebugFastDumpLz::Decompress(compressed.data(), size, out.data(), out.size() - 1));
+
+    // Output buffer is too small
+    EXPECT_EQ(MediaDebugFastDumpLz::Compress(src.data(), src.size(), compressed.data(), 16), 0u);
+}
+
+TEST_F(MediaDebugFastDumpCompressTest, ContainerDeltaChain)
+{
+    char dirTemplate[] = "/tmp/fast_dump_ultXXXXXX";
+    ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+    string dir = string(dirTemplate) + "/";
+
+    // 2.5 blocks, the last block is partial
+    size_t                  size = MediaDebugFastDumpContainer::m_blockSize * 5 / 2;
+    vector<vector<uint8_t>> frames;
+    vector<string>          names;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        frames.push_back(MakeFrame(size, i == 2 ? 1 : 0));
+        if (i == 1)
+        {
+            frames[i][12345] ^= 0x5a;  // sparse change
+        }
+        names.push_back("surface_" + to_string(i) + ".fdz");
+        WriteContainer(dir + names[i], frames[i], i ? &frames[i - 1] : nullptr, i ? names[i - 1] : "");
+    }
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        vector<uint8_t> data;
+        string          error;
+        ASSERT_TRUE(MediaDebugFastDumpContainer::Load(dir + names[i], data, error)) << error;
+        EXPECT_EQ(data, frames[i]) << names[i];
+    }
+
+    // Delta dump is not decodable without its reference
+    vector<uint8_t> data;
+    string          error;
+    remove((dir + names[0]).c_str());
+    EXPECT_FALSE(MediaDebugFastDumpContainer::Load(dir + names[2], data, error));
+
+    remove((dir + names[1]).c_str());
+    remove((dir + names[2]).c_str());
+    rmdir(dirTemplate);
+}
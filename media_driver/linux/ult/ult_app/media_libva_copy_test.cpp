@@ -0,0 +1,261 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_libva_copy_next.h"
+
+using namespace std;
+
+class MediaLibvaCopyTest : public testing::Test
+{
+protected:
+    //! \brief  Planes of a surface or image, chroma planes follow the luma plane
+    struct TestLayout
+    {
+        TestLayout(uint32_t w, uint32_t h, uint32_t planeNum, const uint32_t *pitches, const uint32_t *heights)
+        {
+            size_t size = 0;
+            for (uint32_t i = 0; i < planeNum; i++)
+            {
+                offsets[i] = size;
+                size += (size_t)pitches[i] * heights[i];
+            }
+            data.resize(size);
+
+            layout = {};
+            for (uint32_t i = 0; i < planeNum; i++)
+            {
+                layout.planes[i]  = data.data() + offsets[i];
+                layout.pitches[i] = pitches[i];
+            }
+            layout.width  = w;
+            layout.height = h;
+        }
+
+        void Fill(uint8_t seed)
+        {
+            for (size_t i = 0; i < data.size(); i++)
+            {
+                data[i] = (uint8_t)(i * 13 + seed);
+            }
+        }
+
+        MEDIA_COPY_LAYOUT layout;
+        size_t            offsets[3] = {};
+        vector<uint8_t>   data;
+    };
+
+    //! \brief  NV12/P010 layout, bpp is bytes of one luma sample
+    TestLayout Nv12Layout(uint32_t w, uint32_t h, uint32_t bpp, uint32_t pitchAlign)
+    {
+        uint32_t pitch      = (w * bpp + pitchAlign - 1) / pitchAlign * pitchAlign;
+        uint32_t pitches[2] = {pitch, pitch};
+        uint32_t heights[2] = {h, (h + 1) / 2};
+        return TestLayout(w, h, 2, pitches, heights);
+    }
+
+    void CheckPlanes(const MEDIA_COPY_PLANE *planes, uint32_t planeNum)
+    {
+        for (uint32_t i = 0; i < planeNum; i++)
+        {
+            for (uint32_t row = 0; row < planes[i].height; row++)
+            {
+                ASSERT_EQ(memcmp(planes[i].dst + (size_t)row * planes[i].dstPitch,
+                              planes[i].src + (size_t)row * planes[i].srcPitch,
+                              planes[i].widthInBytes), 0) << "plane " << i << " row " << row;
+            }
+        }
+    }
+
+    void CheckPlane(const MEDIA_COPY_PLANE &plane, const uint8_t *src, const uint8_t *dst, uint32_t widthInBytes, uint32_t height)
+    {
+        EXPECT_EQ(plane.src, src);
+        EXPECT_EQ(plane.dst, dst);
+        EXPECT_EQ(plane.widthInBytes, widthInBytes);
+        EXPECT_EQ(plane.height, height);
+    }
+
+    //! \brief  Copy the full surface for several times and report the average time
+    void Benchmark(const char *name, uint32_t fourcc, uint32_t w, uint32_t h, uint32_t bpp, bool srcIsWC)
+    {
+        TestLayout       src = Nv12Layout(w, h, bpp, 128);
+        TestLayout       dst = Nv12Layout(w, h, bpp, 64);
+        MEDIA_COPY_PLANE planes[2] = {};
+        src.Fill(1);
+        ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(fourcc, 2, src.layout, dst.layout, 0, 0, 0, 0, w, h, true, planes), VA_STATUS_SUCCESS);
+
+        const uint32_t loops = 10;
+        auto start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < loops; i++)
+        {
+            MediaLibvaCopyNext::CopyPlanes(planes, 2, srcIsWC);
+        }
+        auto end = chrono::steady_clock::now();
+
+        CheckPlanes(planes, 2);
+
+        double us = chrono::duration<double, micro>(end - start).count() / loops;
+        printf("[ BENCH    ] %s %ux%u %s: %.1f us/frame, %.2f GB/s\n", name, w, h,
+            srcIsWC ? "streaming load" : "memcpy", us, src.data.size() / us / 1000.0);
+    }
+};
+
+TEST_F(MediaLibvaCopyTest, CopyFromWCUnaligned)
+{
+    vector<uint8_t> src(512), dst(512);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    // Cover unaligned head, 64 bytes loop, 16 bytes loop and tail
+    for (uint32_t offset = 0; offset < 16; offset++)
+    {
+        for (uint32_t bytes = 0; bytes < 300; bytes += 7)
+        {
+            fill(dst.begin(), dst.end(), 0);
+            MediaLibvaCopyNext::CopyFromWC_SSE4(dst.data() + 1, src.data() + offset, bytes);
+            ASSERT_EQ(memcmp(dst.data() + 1, src.data() + offset, bytes), 0) << "offset " << offset << " bytes " << bytes;
+            ASSERT_EQ(dst[0], 0);
+            ASSERT_EQ(dst[bytes + 1], 0);
+        }
+    }
+}
+
+TEST_F(MediaLibvaCopyTest, RegionNV12OddStart)
+{
+    TestLayout       surf = Nv12Layout(1920, 1080, 1, 128);
+    TestLayout       img  = Nv12Layout(1280, 720, 1, 64);
+    MEDIA_COPY_PLANE planes[2] = {};
+    surf.Fill(2);
+    img.Fill(0);
+
+    // Odd start touches one more chroma sample and row than the region size
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_NV12, 2, surf.layout, img.layout,
+                  101, 37, 0, 0, 640, 360, true, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[0], surf.layout.planes[0] + 37 * 1920 + 101, img.layout.planes[0], 640, 360);
+    CheckPlane(planes[1], surf.layout.planes[1] + 18 * 1920 + 50 * 2, img.layout.planes[1], 321 * 2, 181);
+
+    MediaLibvaCopyNext::CopyPlanes(planes, 2, true);
+    CheckPlanes(planes, 2);
+}
+
+TEST_F(MediaLibvaCopyTest, RegionNV12ClippedToImage)
+{
+    TestLayout       surf = Nv12Layout(1920, 1080, 1, 128);
+    TestLayout       img  = Nv12Layout(640, 360, 1, 64);
+    MEDIA_COPY_PLANE planes[2] = {};
+
+    // Image has only 320x180 chroma samples, rounding at odd start must not write past them
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_NV12, 2, surf.layout, img.layout,
+                  101, 37, 0, 0, 640, 360, true, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[1], surf.layout.planes[1] + 18 * 1920 + 50 * 2, img.layout.planes[1], 320 * 2, 180);
+
+    // Image to surface clips the same way
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_NV12, 2, surf.layout, img.layout,
+                  101, 37, 0, 0, 640, 360, false, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[1], img.layout.planes[1], surf.layout.planes[1] + 18 * 1920 + 50 * 2, 320 * 2, 180);
+
+    EXPECT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_NV12, 2, surf.layout, img.layout,
+                  0, 0, 640, 0, 16, 16, true, planes), VA_STATUS_ERROR_INVALID_PARAMETER);
+}
+
+TEST_F(MediaLibvaCopyTest, RegionPacked422)
+{
+    uint32_t         pitch[1]  = {1024};
+    uint32_t         height[1] = {64};
+    TestLayout       surf(256, 64, 1, pitch, height);
+    TestLayout       img(256, 64, 1, pitch, height);
+    MEDIA_COPY_PLANE planes[1] = {};
+
+    // YUY2 copies whole 2 pixel groups of 4 bytes
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_YUY2, 1, surf.layout, img.layout,
+                  3, 5, 8, 2, 10, 4, true, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[0], surf.layout.planes[0] + 5 * 1024 + 1 * 4, img.layout.planes[0] + 2 * 1024 + 4 * 4, 6 * 4, 4);
+
+    // Y210 groups are 8 bytes
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_Y210, 1, surf.layout, img.layout,
+                  3, 5, 8, 2, 10, 4, true, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[0], surf.layout.planes[0] + 5 * 1024 + 1 * 8, img.layout.planes[0] + 2 * 1024 + 4 * 8, 6 * 8, 4);
+
+    surf.Fill(4);
+    MediaLibvaCopyNext::CopyPlanes(planes, 1, false);
+    CheckPlanes(planes, 1);
+}
+
+TEST_F(MediaLibvaCopyTest, RegionI420)
+{
+    uint32_t         surfPitch[3]  = {256, 128, 128};
+    uint32_t         imgPitch[3]   = {64, 32, 32};
+    uint32_t         surfHeight[3] = {128, 64, 64};
+    uint32_t         imgHeight[3]  = {32, 16, 16};
+    TestLayout       surf(256, 128, 3, surfPitch, surfHeight);
+    TestLayout       img(64, 32, 3, imgPitch, imgHeight);
+    MEDIA_COPY_PLANE planes[3] = {};
+    surf.Fill(5);
+
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_I420, 3, surf.layout, img.layout,
+                  16, 8, 0, 0, 64, 32, true, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[0], surf.layout.planes[0] + 8 * 256 + 16, img.layout.planes[0], 64, 32);
+    CheckPlane(planes[1], surf.layout.planes[1] + 4 * 128 + 8, img.layout.planes[1], 32, 16);
+    CheckPlane(planes[2], surf.layout.planes[2] + 4 * 128 + 8, img.layout.planes[2], 32, 16);
+
+    MediaLibvaCopyNext::CopyPlanes(planes, 3, true);
+    CheckPlanes(planes, 3);
+
+    EXPECT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_NV12, 3, surf.layout, img.layout,
+                  0, 0, 0, 0, 64, 32, true, planes), VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT);
+}
+
+TEST_F(MediaLibvaCopyTest, RegionP010Multithread)
+{
+    // Large enough to be split across the worker pool
+    TestLayout       surf = Nv12Layout(3840, 2160, 2, 128);
+    TestLayout       img  = Nv12Layout(3000, 2000, 2, 64);
+    MEDIA_COPY_PLANE planes[2] = {};
+    surf.Fill(3);
+    img.Fill(0);
+
+    ASSERT_EQ(MediaLibvaCopyNext::GetRegionPlanes(VA_FOURCC_P010, 2, surf.layout, img.layout,
+                  418, 100, 0, 0, 3000, 2000, true, planes), VA_STATUS_SUCCESS);
+    CheckPlane(planes[1], surf.layout.planes[1] + 50 * surf.layout.pitches[1] + 209 * 4, img.layout.planes[1], 1500 * 4, 1000);
+
+    MediaLibvaCopyNext::CopyPlanes(planes, 2, true);
+    CheckPlanes(planes, 2);
+
+    img.Fill(0);
+    MediaLibvaCopyNext::CopyPlanes(planes, 2, false);
+    CheckPlanes(planes, 2);
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(MediaLibvaCopyTest, DISABLED_Benchmark)
+{
+    Benchmark("NV12", VA_FOURCC_NV12, 1920, 1080, 1, false);
+    Benchmark("NV12", VA_FOURCC_NV12, 1920, 1080, 1, true);
+    Benchmark("NV12", VA_FOURCC_NV12, 3840, 2160, 1, true);
+    Benchmark("P010", VA_FOURCC_P010, 1920, 1080, 2, true);
+    Benchmark("P010", VA_FOURCC_P010, 3840, 2160, 2, false);
+    Benchmark("P010", VA_FOURCC_P010, 3840, 2160, 2, true);
+}
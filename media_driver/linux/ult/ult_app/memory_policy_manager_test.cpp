@@ -0,0 +1,157 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include "gtest/gtest.h"
+#include "memory_policy_manager.h"
+
+using namespace std;
+
+// Counted by MosAllocMemory of mos_stub.cpp
+extern int32_t g_mosStubAllocCount;
+
+class MemoryPolicyManagerTest : public testing::Test
+{
+protected:
+    // Layout used by AllocCpuMemory: size of anonymous mapping in front of returned memory
+    static const size_t m_headerSize   = 64;
+    static const size_t m_hugePageSize = 0x200000;
+
+    void TearDown() override
+    {
+        MemoryPolicyManager::SetCpuMemoryPolicy(CpuMemoryPolicy());
+    }
+
+    static void SetPolicy(bool hugePage, bool numaLocal)
+    {
+        CpuMemoryPolicy policy;
+        policy.hugePageEnabled  = hugePage;
+        policy.numaLocalEnabled = numaLocal;
+        policy.minSize          = m_hugePageSize;
+        MemoryPolicyManager::SetCpuMemoryPolicy(policy);
+    }
+
+    static size_t GetMapSize(void *ptr)
+    {
+        return *(size_t *)((uint8_t *)ptr - m_headerSize);
+    }
+
+    static bool IsMapped(void *addr)
+    {
+        return msync(addr, MOS_PAGE_SIZE, MS_ASYNC) == 0 || errno != ENOMEM;
+    }
+
+    static uint64_t GetAllocCount()
+    {
+        CpuMemoryPolicyCounters counters = {};
+        MemoryPolicyManager::GetCpuMemoryPolicyCounters(counters);
+        return counters.allocCount;
+    }
+};
+
+const size_t MemoryPolicyManagerTest::m_headerSize;
+const size_t MemoryPolicyManagerTest::m_hugePageSize;
+
+TEST_F(MemoryPolicyManagerTest, HeapFallback)
+{
+    EXPECT_EQ(nullptr, MemoryPolicyManager::AllocCpuMemory(0));
+    MemoryPolicyManager::FreeCpuMemory(nullptr);
+
+    // Policy disabled
+    uint64_t allocCount    = GetAllocCount();
+    int32_t  mosAllocCount = g_mosStubAllocCount;
+    uint8_t *data          = (uint8_t *)MemoryPolicyManager::AllocCpuMemory(3 * m_hugePageSize, true);
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(mosAllocCount + 1, g_mosStubAllocCount);
+    EXPECT_EQ(allocCount, GetAllocCount());
+    EXPECT_EQ(0u, GetMapSize(data));
+    EXPECT_EQ(0u, (uintptr_t)data % 16);
+    for (size_t i = 0; i < 3 * m_hugePageSize; i += 4099)
+    {
+        EXPECT_EQ(0, data[i]);
+    }
+    memset(data, 0xa5, 3 * m_hugePageSize);
+    MemoryPolicyManager::FreeCpuMemory(data);
+
+    // Policy enabled, allocation smaller than min size
+    SetPolicy(true, true);
+    data = (uint8_t *)MemoryPolicyManager::AllocCpuMemory(m_hugePageSize - 1);
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(mosAllocCount + 2, g_mosStubAllocCount);
+    EXPECT_EQ(allocCount, GetAllocCount());
+    EXPECT_EQ(0u, GetMapSize(data));
+    memset(data, 0x5a, m_hugePageSize - 1);
+    MemoryPolicyManager::FreeCpuMemory(data);
+}
+
+TEST_F(MemoryPolicyManagerTest, HugePageAlignment)
+{
+    SetPolicy(true, false);
+
+    const size_t size          = 3 * m_hugePageSize;
+    uint64_t     allocCount    = GetAllocCount();
+    int32_t      mosAllocCount = g_mosStubAllocCount;
+    uint8_t     *data          = (uint8_t *)MemoryPolicyManager::AllocCpuMemory(size, true);
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(mosAllocCount, g_mosStubAllocCount);
+    EXPECT_EQ(allocCount + 1, GetAllocCount());
+
+    // Header is in front of returned memory, mapping starts on huge page boundary
+    uint8_t *base    = data - m_headerSize;
+    size_t   mapSize = GetMapSize(data);
+    EXPECT_EQ(0u, (uintptr_t)base % m_hugePageSize);
+    EXPECT_EQ(4 * m_hugePageSize, mapSize);
+
+    // Reserved space behind the mapping is trimmed
+    EXPECT_TRUE(IsMapped(base + mapSize - MOS_PAGE_SIZE));
+    EXPECT_FALSE(IsMapped(base + mapSize));
+
+    EXPECT_EQ(0, data[0]);
+    EXPECT_EQ(0, data[size - 1]);
+    memset(data, 0xa5, size);
+
+    MemoryPolicyManager::FreeCpuMemory(data);
+    EXPECT_FALSE(IsMapped(base));
+    EXPECT_EQ(mosAllocCount, g_mosStubAllocCount);
+}
+
+TEST_F(MemoryPolicyManagerTest, NumaLocalPageAlignment)
+{
+    SetPolicy(false, true);
+
+    const size_t size       = m_hugePageSize + 1;
+    uint64_t     allocCount = GetAllocCount();
+    uint8_t     *data       = (uint8_t *)MemoryPolicyManager::AllocCpuMemory(size);
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(allocCount + 1, GetAllocCount());
+
+    // Without huge pages the mapping is only rounded up to pages, nothing is reserved to trim
+    uint8_t *base    = data - m_headerSize;
+    size_t   mapSize = GetMapSize(data);
+    EXPECT_EQ(0u, (uintptr_t)base % MOS_PAGE_SIZE);
+    EXPECT_EQ(MOS_ALIGN_CEIL(size + m_headerSize, MOS_PAGE_SIZE), mapSize);
+
+    memset(data, 0xa5, size);
+    MemoryPolicyManager::FreeCpuMemory(data);
+    EXPECT_FALSE(IsMapped(base));
+}
@@ -0,0 +1,169 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <map>
+#include "gtest/gtest.h"
+#include "vp_common_cache_settings.h"
+#include "surface_type.h"
+
+using namespace std;
+
+// The same rows in the map used before dense tables, as reference
+static const map<uint64_t, MOS_CACHE_ELEMENT> s_referenceSettings =
+{
+#include "vp_surface_cache_settings.h"
+};
+
+class MosCacheManagerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(RegisterCacheSettings(CACHE_COMPONENT_VP, &g_vp_cacheSettings));
+    }
+
+    static bool ReferenceLookup(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf)
+    {
+        auto it = s_referenceSettings.find(MOS_CACHE_OBJECT(id, feature, isHeapSurf, bOut, engineType).value);
+        if (it == s_referenceSettings.end())
+        {
+            return false;
+        }
+        element = it->second;
+        return true;
+    }
+};
+
+TEST_F(MosCacheManagerTest, SameAsReference)
+{
+    const uint32_t surfaceTypeNum = SUFACE_TYPE_ASSIGNED(vp::NumberOfSurfaceType) + 8;
+
+    uint32_t found = 0;
+    for (uint32_t id = COMPONENT_UNKNOWN; id <= COMPONENT_OCA; id++)
+    {
+        for (uint32_t feature = 0; feature < surfaceTypeNum; feature++)
+        {
+            for (uint32_t engine = RENDER_ENGINE; engine <= VDBOX_ENGINE; engine++)
+            {
+                for (uint32_t flags = 0; flags < 4; flags++)
+                {
+                    bool              bOut   = (flags & 1) != 0;
+                    bool              isHeap = (flags & 2) != 0;
+                    MOS_CACHE_ELEMENT expected(MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC, MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC);
+                    MOS_CACHE_ELEMENT element(MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC, MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC);
+
+                    bool res = LoadCacheSettings((MOS_COMPONENT)id, feature, bOut, (ENGINE_TYPE)engine, element, isHeap);
+                    EXPECT_EQ(ReferenceLookup((MOS_COMPONENT)id, feature, bOut, (ENGINE_TYPE)engine, expected, isHeap), res);
+                    EXPECT_EQ(expected.mocsUsageType, element.mocsUsageType);
+                    EXPECT_EQ(expected.patIndex, element.patIndex);
+                    found += res ? 1 : 0;
+                }
+            }
+        }
+    }
+    // Heap types alias surface keys of surface types in cache objects
+    EXPECT_GE(found, s_referenceSettings.size());
+
+    // Out of table range
+    MOS_CACHE_ELEMENT element(MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC, MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC);
+    EXPECT_FALSE(LoadCacheSettings(COMPONENT_VPCommon, 0xffffffff, false, RENDER_ENGINE, element, false));
+    EXPECT_FALSE(LoadCacheSettings(COMPONENT_VPCommon, 0, false, (ENGINE_TYPE)(VDBOX_ENGINE + 1), element, true));
+}
+
+TEST_F(MosCacheManagerTest, ValidateSettings)
+{
+    static constexpr MOS_CACHE_SETTING valid[] =
+    {
+        {MOS_CACHE_OBJECT(COMPONENT_VPCommon, 1, false, true, RENDER_ENGINE).value, MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER, MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER)},
+        {MOS_CACHE_OBJECT(COMPONENT_VPCommon, 1, false, true, RENDER_ENGINE).value, MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER, MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER)},
+        {MOS_CACHE_OBJECT(COMPONENT_VPCommon, GSH_HEAP, true, false, VEBOX_ENGINE).value, MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_USAGE_VP_INPUT_PICTURE_RENDER, MOS_HW_RESOURCE_USAGE_VP_INPUT_PICTURE_RENDER)},
+    };
+    static constexpr MOS_CACHE_SETTING conflict[] =
+    {
+        {MOS_CACHE_OBJECT(COMPONENT_VPCommon, 1, false, true, RENDER_ENGINE).value, MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER, MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER)},
+        {MOS_CACHE_OBJECT(COMPONENT_VPCommon, 1, false, true, RENDER_ENGINE).value, MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_USAGE_VP_INPUT_PICTURE_RENDER, MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER)},
+    };
+    static constexpr MOS_CACHE_SETTING outOfRange[] =
+    {
+        {MOS_CACHE_OBJECT(COMPONENT_VPCommon, 8, false, false, RENDER_ENGINE).value, MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_USAGE_VP_INPUT_PICTURE_RENDER, MOS_HW_RESOURCE_USAGE_VP_INPUT_PICTURE_RENDER)},
+    };
+
+    static_assert(MosValidateCacheSettings(valid, COMPONENT_VPCommon, 1, HEAP_MAX + 2), "");
+    static_assert(!MosValidateCacheSettings(valid, COMPONENT_VPreP, 1, HEAP_MAX + 2), "");
+    static_assert(!MosValidateCacheSettings(conflict, COMPONENT_VPCommon, 1, HEAP_MAX + 2), "");
+    static_assert(!MosValidateCacheSettings(outOfRange, COMPONENT_VPCommon, 1, HEAP_MAX + 8), "");
+    static_assert(MosValidateCacheSettings(outOfRange, COMPONENT_VPCommon, 1, HEAP_MAX + 9), "");
+
+    static constexpr auto table = MosBuildCacheTable<1, HEAP_MAX + 2>(valid, COMPONENT_VPCommon);
+    static_assert(table.elements[MosCacheTableIndex(0, HEAP_MAX + 1, 1, RENDER_ENGINE, HEAP_MAX + 2)].mocsUsageType == MOS_HW_RESOURCE_USAGE_VP_INTERNAL_READ_WRITE_RENDER, "");
+    static_assert(table.elements[MosCacheTableIndex(0, GSH_HEAP, 0, VEBOX_ENGINE, HEAP_MAX + 2)].mocsUsageType == MOS_HW_RESOURCE_USAGE_VP_INPUT_PICTURE_RENDER, "");
+    static_assert(table.elements[MosCacheTableIndex(0, GSH_HEAP, 0, RENDER_ENGINE, HEAP_MAX + 2)].mocsUsageType == MOS_HW_RESOURCE_DEF_MAX, "");
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(MosCacheManagerTest, DISABLED_SurfaceStateSetupBenchmark)
+{
+    // Cache settings of surfaces bound by a typical render kernel
+    struct SurfaceParams
+    {
+        uint32_t surfaceType;
+        bool     isOutput;
+        bool     isHeap;
+    };
+    const SurfaceParams surfaces[] =
+    {
+        {SUFACE_TYPE_ASSIGNED(vp::SurfaceTypeRenderOutput), false, false},
+        {SUFACE_TYPE_ASSIGNED(vp::SurfaceTypeRenderOutput), true, false},
+        {ISH_HEAP, false, true},
+        {GSH_HEAP, false, true},
+    };
+    const uint32_t iterations = 1000000;
+
+    // Surface state setup calls through MOS_INTERFACE::pfnGetCacheSetting
+    typedef bool (*GetCacheSetting)(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf);
+    volatile GetCacheSetting mapLookup   = ReferenceLookup;
+    volatile GetCacheSetting tableLookup = LoadCacheSettings;
+
+    MOS_CACHE_ELEMENT element(MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC, MOS_CODEC_RESOURCE_USAGE_BEGIN_CODEC);
+    uint64_t          checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        auto &surface = surfaces[i & 3];
+        mapLookup(COMPONENT_VPCommon, surface.surfaceType, surface.isOutput, RENDER_ENGINE, element, surface.isHeap);
+        checksum += element.mocsUsageType;
+    }
+    auto middle = chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        auto &surface = surfaces[i & 3];
+        tableLookup(COMPONENT_VPCommon, surface.surfaceType, surface.isOutput, RENDER_ENGINE, element, surface.isHeap);
+        checksum -= element.mocsUsageType;
+    }
+    auto end = chrono::steady_clock::now();
+
+    EXPECT_EQ(0u, checksum);
+    double mapNs   = chrono::duration<double, nano>(middle - start).count() / iterations;
+    double tableNs = chrono::duration<double, nano>(end - middle).count() / iterations;
+    printf("[ BENCH    ] Cache setting lookup per surface state: std::map %.2f ns, dense table %.2f ns\n", mapNs, tableNs);
+}
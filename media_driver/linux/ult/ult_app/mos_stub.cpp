@@ -19,10 +19,14 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <cstdlib>
 #include <cstring>
 #include "mos_utilities.h"
 using namespace std;
 
+// Number of MosAllocMemory calls, for tests checking steady state heap usage
+int32_t g_mosStubAllocCount = 0;
+
 void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
 {
     if(pDestination != nullptr)
@@ -31,3 +35,99 @@ void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
     }
 }
 
+MOS_STATUS MosUtilities::MosSecureMemcpy(
+    void       *pDestination,
+    size_t     dstLength,
+    const void *pSource,
+    size_t     srcLength)
+{
+    if (pDestination == nullptr || pSource == nullptr)
+    {
+        return MOS_STATUS_NULL_POINTER;
+    }
+    if (dstLength < srcLength)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    memcpy(pDestination, pSource, srcLength);
+    return MOS_STATUS_SUCCESS;
+}
+
+#if MOS_MESSAGES_ENABLED
+void *MosUtilities::MosAllocMemoryUtils(
+    size_t     size,
+    const char *functionName,
+    const char *filename,
+    int32_t    line)
+{
+    g_mosStubAllocCount++;
+    return malloc(size);
+}
+
+void *MosUtilities::MosAllocAndZeroMemoryUtils(
+    size_t     size,
+    const char *functionName,
+    const char *filename,
+    int32_t    line)
+{
+    g_mosStubAllocCount++;
+    return calloc(1, size);
+}
+
+void MosUtilities::MosFreeMemoryUtils(
+    void       *ptr,
+    const char *functionName,
+    const char *filename,
+    int32_t    line)
+{
+    free(ptr);
+}
+#else
+void *MosUtilities::MosAllocMemory(size_t size)
+{
+    g_mosStubAllocCount++;
+    return malloc(size);
+}
+
+void *MosUtilities::MosAllocAndZeroMemory(size_t size)
+{
+    g_mosStubAllocCount++;
+    return calloc(1, size);
+}
+
+void MosUtilities::MosFreeMemory(void *ptr)
+{
+    free(ptr);
+}
+#endif
+
+#if MOS_MESSAGES_ENABLED
+void MosUtilDebug::MosMessage(
+    MOS_MESSAGE_LEVEL level,
+    MOS_COMPONENT_ID  compID,
+    uint8_t           subCompID,
+    const PCCHAR      functionName,
+    int32_t           lineNum,
+    const PCCHAR      message,
+    ...)
+{
+}
+
+void MosUtilities::MosTraceEvent(
+    uint16_t    usId,
+    uint8_t     ucType,
+    const void *pArg1,
+    uint32_t    dwSize1,
+    const void *pArg2,
+    uint32_t    dwSize2)
+{
+}
+#endif
+
+#if MOS_ASSERT_ENABLED
+void MosUtilDebug::MosAssert(
+    MOS_COMPONENT_ID compID,
+    uint8_t          subCompID)
+{
+}
+#endif
@@ -0,0 +1,159 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_tile_row_shadow.h"
+
+using namespace std;
+
+class MosTileRowShadowTest : public testing::Test
+{
+protected:
+    static const uint32_t m_pitch  = 256;
+    static const uint32_t m_height = 192;  // NV12, 128 luma rows and 64 chroma rows
+
+    void SetUp() override
+    {
+        m_linear.resize((size_t)m_pitch * m_height);
+        for (size_t i = 0; i < m_linear.size(); i++)
+        {
+            m_linear[i] = (uint8_t)(i * 7 + i / m_pitch);
+        }
+
+        // Reference Tile-Y layout: 128 bytes x 32 rows tiles of 16 bytes columns
+        m_tiled.resize(m_linear.size());
+        for (uint32_t y = 0; y < m_height; y++)
+        {
+            for (uint32_t x = 0; x < m_pitch; x++)
+            {
+                m_tiled[TiledOffset(x, y)] = m_linear[(size_t)y * m_pitch + x];
+            }
+        }
+    }
+
+    static size_t TiledOffset(uint32_t x, uint32_t y)
+    {
+        size_t tile = (size_t)(y / 32) * (m_pitch / 128) + x / 128;
+        return tile * 4096 + (x % 128) / 16 * 512 + (y % 32) * 16 + x % 16;
+    }
+
+    bool RowsEqual(const vector<uint8_t> &shadow, uint32_t startRow, uint32_t endRow)
+    {
+        return memcmp(shadow.data() + (size_t)startRow * m_pitch,
+                   m_linear.data() + (size_t)startRow * m_pitch,
+                   (size_t)(endRow - startRow) * m_pitch) == 0;
+    }
+
+    vector<uint8_t> m_linear;
+    vector<uint8_t> m_tiled;
+};
+
+const uint32_t MosTileRowShadowTest::m_pitch;
+const uint32_t MosTileRowShadowTest::m_height;
+
+TEST_F(MosTileRowShadowTest, InitRejectsNonTileRowSurface)
+{
+    MosTileRowShadow shadow;
+
+    EXPECT_FALSE(shadow.Init(m_tiled.size(), 0));
+    EXPECT_FALSE(shadow.Init(m_tiled.size(), 100));
+    EXPECT_FALSE(shadow.Init(m_tiled.size() - m_pitch, m_pitch));
+    EXPECT_FALSE(shadow.IsActive());
+
+    EXPECT_TRUE(shadow.Init(m_tiled.size(), m_pitch));
+    EXPECT_TRUE(shadow.IsActive());
+    EXPECT_EQ(shadow.GetRowNum(), m_height);
+}
+
+TEST_F(MosTileRowShadowTest, LockRectDetilesCoveredRows)
+{
+    MosTileRowShadow shadow;
+    vector<uint8_t>  linear(m_tiled.size(), 0xcd);
+    ASSERT_TRUE(shadow.Init(m_tiled.size(), m_pitch));
+
+    // Rect at rows [40, 50) of luma and its chroma rows [128 + 20, 128 + 25)
+    EXPECT_EQ(shadow.Detile(m_tiled.data(), linear.data(), 40, 50, false), 1u);
+    EXPECT_EQ(shadow.Detile(m_tiled.data(), linear.data(), 148, 153, false), 1u);
+
+    EXPECT_TRUE(RowsEqual(linear, 32, 64));
+    EXPECT_TRUE(RowsEqual(linear, 128, 160));
+    for (size_t i = 0; i < (size_t)32 * m_pitch; i++)
+    {
+        ASSERT_EQ(linear[i], 0xcd);
+        ASSERT_EQ(linear[(size_t)64 * m_pitch + i], 0xcd);
+        ASSERT_EQ(linear[(size_t)96 * m_pitch + i], 0xcd);
+        ASSERT_EQ(linear[(size_t)160 * m_pitch + i], 0xcd);
+    }
+
+    // Rows already detiled are not converted again, full lock detiles the rest
+    EXPECT_EQ(shadow.Detile(m_tiled.data(), linear.data(), 32, 64, false), 0u);
+    EXPECT_EQ(shadow.Detile(m_tiled.data(), linear.data(), 0, shadow.GetRowNum(), false), 4u);
+    EXPECT_TRUE(RowsEqual(linear, 0, m_height));
+}
+
+TEST_F(MosTileRowShadowTest, DetileClampsToSurface)
+{
+    MosTileRowShadow shadow;
+    vector<uint8_t>  linear(m_tiled.size());
+    ASSERT_TRUE(shadow.Init(m_tiled.size(), m_pitch));
+
+    EXPECT_EQ(shadow.Detile(m_tiled.data(), linear.data(), 180, 0xffffffff, false), 1u);
+    EXPECT_EQ(shadow.Detile(m_tiled.data(), linear.data(), m_height, m_height + 64, false), 0u);
+    EXPECT_TRUE(RowsEqual(linear, 160, m_height));
+}
+
+TEST_F(MosTileRowShadowTest, WriteBackOnlyDirtyRows)
+{
+    MosTileRowShadow shadow;
+    vector<uint8_t>  linear(m_tiled.size());
+    vector<uint8_t>  tiled(m_tiled.size(), 0);
+    ASSERT_TRUE(shadow.Init(m_tiled.size(), m_pitch));
+
+    shadow.Detile(m_tiled.data(), linear.data(), 0, 10, false);
+    shadow.Detile(m_tiled.data(), linear.data(), 70, 80, true);
+
+    EXPECT_EQ(shadow.WriteBack(linear.data(), tiled.data()), 1u);
+    for (uint32_t y = 0; y < m_height; y++)
+    {
+        for (uint32_t x = 0; x < m_pitch; x++)
+        {
+            uint8_t expected = (y >= 64 && y < 96) ? m_linear[(size_t)y * m_pitch + x] : 0;
+            ASSERT_EQ(tiled[TiledOffset(x, y)], expected) << "x " << x << " y " << y;
+        }
+    }
+
+    // Dirty state is cleared by write back
+    EXPECT_EQ(shadow.WriteBack(linear.data(), tiled.data()), 0u);
+}
+
+TEST_F(MosTileRowShadowTest, ConvertTileRowRoundTrip)
+{
+    vector<uint8_t> linear((size_t)m_pitch * 32);
+    vector<uint8_t> tiled((size_t)m_pitch * 32);
+
+    MosTileRowShadow::ConvertTileRow(m_tiled.data() + (size_t)m_pitch * 32, linear.data(), m_pitch, true);
+    EXPECT_EQ(memcmp(linear.data(), m_linear.data() + (size_t)m_pitch * 32, linear.size()), 0);
+
+    MosTileRowShadow::ConvertTileRow(linear.data(), tiled.data(), m_pitch, false);
+    EXPECT_EQ(memcmp(tiled.data(), m_tiled.data() + (size_t)m_pitch * 32, tiled.size()), 0);
+}
@@ -0,0 +1,458 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <chrono>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "decode_vp8_bool_decoder.h"
+#include "codec_def_decode_vp8.h"
+
+using namespace std;
+using namespace decode;
+
+class Vp8BoolDecoderTest : public testing::Test
+{
+protected:
+    //! \brief  Bool encoder of libvpx
+    class BoolEncoder
+    {
+    public:
+        void Encode(uint32_t bit, uint32_t probability)
+        {
+            uint32_t split = 1 + (((m_range - 1) * probability) >> 8);
+            if (bit)
+            {
+                m_lowValue += split;
+                m_range -= split;
+            }
+            else
+            {
+                m_range = split;
+            }
+
+            int32_t shift = Norm[m_range];
+            m_range <<= shift;
+            m_count += shift;
+
+            if (m_count >= 0)
+            {
+                int32_t offset = shift - m_count;
+                if ((m_lowValue << (offset - 1)) & 0x80000000)
+                {
+                    int32_t x = (int32_t)m_data.size() - 1;
+                    while (x >= 0 && m_data[x] == 0xff)
+                    {
+                        m_data[x--] = 0;
+                    }
+                    m_data[x]++;
+                }
+                m_data.push_back((uint8_t)(m_lowValue >> (24 - offset)));
+                m_lowValue <<= offset;
+                shift = m_count;
+                m_lowValue &= 0xffffff;
+                m_count -= 8;
+            }
+            m_lowValue <<= shift;
+        }
+
+        void EncodeLiteral(uint32_t value, uint32_t bits)
+        {
+            while (bits-- > 0)
+            {
+                Encode((value >> bits) & 1, 128);
+            }
+        }
+
+        vector<uint8_t> &Finish()
+        {
+            for (uint32_t i = 0; i < 32; i++)
+            {
+                Encode(0, 128);
+            }
+            return m_data;
+        }
+
+    protected:
+        vector<uint8_t> m_data;
+        uint32_t        m_lowValue = 0;
+        uint32_t        m_range    = 255;
+        int32_t         m_count    = -24;
+    };
+
+    //! \brief  Byte based 32 bits bool decoder which the frame head parser used before
+    class ByteBoolDecoder
+    {
+    public:
+        ByteBoolDecoder(const uint8_t *data, uint32_t size) : m_start(data), m_buffer(data), m_bufferEnd(data + size)
+        {
+            Fill();
+        }
+
+        uint32_t DecodeBool(uint32_t probability)
+        {
+            uint32_t split    = 1 + (((m_range - 1) * probability) >> 8);
+            uint32_t bigSplit = split << 24;
+            uint32_t bit      = 0;
+            if (m_value >= bigSplit)
+            {
+                m_range = m_range - split;
+                m_value = m_value - bigSplit;
+                bit     = 1;
+            }
+            else
+            {
+                m_range = split;
+            }
+
+            int32_t shift = Norm[m_range];
+            m_range <<= shift;
+            m_value <<= shift;
+            m_count -= shift;
+            if (m_count < 0)
+            {
+                Fill();
+            }
+            return bit;
+        }
+
+        uint32_t DecodeLiteral(uint32_t bits)
+        {
+            uint32_t value = 0;
+            while (bits-- > 0)
+            {
+                value = (value << 1) | DecodeBool(128);
+            }
+            return value;
+        }
+
+        uint8_t  GetBitCount() const { return 8 - (m_count & 0x07); }
+        uint8_t  GetValue() const { return (uint8_t)(m_value >> 24); }
+        uint32_t GetRange() const { return m_range; }
+        uint32_t GetByteOffset() const
+        {
+            uint32_t offsetCounter = ((m_count & 0x18) >> 3) + (((m_count & 0x07) != 0) ? 1 : 0);
+            return (uint32_t)(m_buffer - m_start) - offsetCounter;
+        }
+
+    protected:
+        void Fill()
+        {
+            int32_t  shift    = 32 - 8 - (m_count + 8);
+            uint32_t bitsLeft = (uint32_t)(m_bufferEnd - m_buffer) * 8;
+            int32_t  num      = (int32_t)(shift + 8 - bitsLeft);
+            int32_t  loopEnd  = 0;
+
+            if (num >= 0)
+            {
+                m_count += 0x40000000;
+                loopEnd = num;
+            }
+
+            if (num < 0 || bitsLeft)
+            {
+                while (shift >= loopEnd)
+                {
+                    m_count += 8;
+                    m_value |= (uint32_t)*m_buffer << shift;
+                    ++m_buffer;
+                    shift -= 8;
+                }
+            }
+        }
+
+        const uint8_t *m_start;
+        const uint8_t *m_buffer;
+        const uint8_t *m_bufferEnd;
+        uint32_t       m_value = 0;
+        int32_t        m_count = -8;
+        uint32_t       m_range = 255;
+    };
+
+    //! \brief  Coef prob updates of the key frame head
+    static uint32_t CoefUpdate(uint32_t i, uint32_t j, uint32_t k, uint32_t l)
+    {
+        return ((i + j + k + l) % 29 == 0) ? 1 : 0;
+    }
+
+    //! \brief  Parse the key frame head written by KeyFrameHead test in the order of Vp8EntropyState::ParseFrameHead()
+    template <class Decoder>
+    void ParseKeyFrameHead(Decoder &decoder, uint32_t &updates)
+    {
+        EXPECT_EQ(decoder.DecodeLiteral(2), 0u);
+        EXPECT_EQ(decoder.DecodeLiteral(3), 6u);
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            EXPECT_EQ(decoder.DecodeBool(128), 1u);
+            EXPECT_EQ(decoder.DecodeLiteral(8), 100 + i * 30);
+        }
+        EXPECT_EQ(decoder.DecodeLiteral(1), 0u);
+        EXPECT_EQ(decoder.DecodeLiteral(6), 32u);
+        EXPECT_EQ(decoder.DecodeLiteral(3), 3u);
+        EXPECT_EQ(decoder.DecodeLiteral(1), 0u);
+        EXPECT_EQ(decoder.DecodeLiteral(2), 2u);
+        EXPECT_EQ(decoder.DecodeLiteral(7), 60u);
+        EXPECT_EQ(decoder.DecodeLiteral(5), 0u);
+        EXPECT_EQ(decoder.DecodeLiteral(1), 1u);
+
+        updates = 0;
+        for (uint32_t i = 0; i < 4; i++)
+            for (uint32_t j = 0; j < 8; j++)
+                for (uint32_t k = 0; k < 3; k++)
+                    for (uint32_t l = 0; l < 11; l++)
+                    {
+                        if (decoder.DecodeBool(CoefUpdateProbs[i][j][k][l]))
+                        {
+                            EXPECT_EQ(decoder.DecodeLiteral(8), (i * 7 + j * 5 + l) & 0xff);
+                            updates++;
+                        }
+                    }
+
+        EXPECT_EQ(decoder.DecodeLiteral(1), 1u);
+        EXPECT_EQ(decoder.DecodeLiteral(8), 200u);
+    }
+
+    struct Symbol
+    {
+        uint32_t bit;
+        uint32_t probability;
+    };
+
+    //! \brief  Symbols with random probability, skewed to the high probabilities of frame head
+    vector<Symbol> RandomSymbols(uint32_t num, uint32_t seed)
+    {
+        mt19937        rng(seed);
+        vector<Symbol> symbols(num);
+        for (auto &symbol : symbols)
+        {
+            symbol.probability = (rng() & 1) ? 1 + rng() % 255 : 224 + rng() % 32;
+            symbol.bit         = (rng() & 0xff) >= symbol.probability ? 1 : 0;
+        }
+        return symbols;
+    }
+
+    vector<uint8_t> Encode(const vector<Symbol> &symbols, uint32_t trailingBytes)
+    {
+        BoolEncoder encoder;
+        for (auto &symbol : symbols)
+        {
+            encoder.Encode(symbol.bit, symbol.probability);
+        }
+
+        // Following partitions, loaded into window beyond the end of this one
+        vector<uint8_t> data = encoder.Finish();
+        for (uint32_t i = 0; i < trailingBytes; i++)
+        {
+            data.push_back((uint8_t)(i * 37 + 11));
+        }
+        return data;
+    }
+
+    void CheckState(const Vp8BoolDecoder &decoder, const ByteBoolDecoder &reference, uint32_t index)
+    {
+        ASSERT_EQ(decoder.GetValue(), reference.GetValue()) << "symbol " << index;
+        ASSERT_EQ(decoder.GetRange(), reference.GetRange()) << "symbol " << index;
+        ASSERT_EQ(decoder.GetBitCount(), reference.GetBitCount()) << "symbol " << index;
+        ASSERT_EQ(decoder.GetByteOffset(), reference.GetByteOffset()) << "symbol " << index;
+    }
+};
+
+TEST_F(Vp8BoolDecoderTest, RoundTrip)
+{
+    for (uint32_t seed = 0; seed < 8; seed++)
+    {
+        vector<Symbol>  symbols = RandomSymbols(4096, seed);
+        vector<uint8_t> data    = Encode(symbols, 0);
+
+        Vp8BoolDecoder decoder;
+        decoder.Init(data.data(), (uint32_t)data.size());
+        for (uint32_t i = 0; i < symbols.size(); i++)
+        {
+            ASSERT_EQ(decoder.DecodeBool(symbols[i].probability), symbols[i].bit) << "seed " << seed << " symbol " << i;
+        }
+    }
+}
+
+TEST_F(Vp8BoolDecoderTest, MatchByteDecoderState)
+{
+    // The state after any symbol may be the end of first partition which is sent to HW
+    for (uint32_t seed = 0; seed < 8; seed++)
+    {
+        vector<Symbol>  symbols = RandomSymbols(2048, seed + 100);
+        vector<uint8_t> data    = Encode(symbols, 64);
+
+        Vp8BoolDecoder decoder;
+        decoder.Init(data.data(), (uint32_t)data.size());
+        ByteBoolDecoder reference(data.data(), (uint32_t)data.size());
+        CheckState(decoder, reference, 0);
+
+        for (uint32_t i = 0; i < symbols.size(); i++)
+        {
+            ASSERT_EQ(decoder.DecodeBool(symbols[i].probability), reference.DecodeBool(symbols[i].probability));
+            CheckState(decoder, reference, i + 1);
+        }
+    }
+}
+
+TEST_F(Vp8BoolDecoderTest, DataExhausted)
+{
+    // Window is padded with 0 once the data runs out, the same as byte decoder
+    for (uint32_t size = 0; size < 24; size++)
+    {
+        vector<uint8_t> data(size);
+        for (uint32_t i = 0; i < size; i++)
+        {
+            data[i] = (uint8_t)(i * 91 + 7);
+        }
+
+        Vp8BoolDecoder decoder;
+        decoder.Init(data.data(), size);
+        ByteBoolDecoder reference(data.data(), size);
+
+        for (uint32_t i = 0; i < 512; i++)
+        {
+            uint32_t probability = 1 + (i * 53) % 255;
+            ASSERT_EQ(decoder.DecodeBool(probability), reference.DecodeBool(probability)) << "size " << size << " symbol " << i;
+            ASSERT_EQ(decoder.GetValue(), reference.GetValue());
+            ASSERT_EQ(decoder.GetRange(), reference.GetRange());
+            ASSERT_EQ(decoder.GetBitCount(), reference.GetBitCount());
+        }
+    }
+}
+
+TEST_F(Vp8BoolDecoderTest, KeyFrameHead)
+{
+    // Key frame head in the order of Vp8EntropyState::ParseFrameHead()
+    BoolEncoder encoder;
+    encoder.Encode(0, 128);          // Color space
+    encoder.Encode(0, 128);          // Clamp type
+    encoder.Encode(1, 128);          // Segmentation enabled
+    encoder.Encode(1, 128);          // Update segmentation map
+    encoder.Encode(0, 128);          // Update segmentation data
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        encoder.Encode(1, 128);
+        encoder.EncodeLiteral(100 + i * 30, 8);
+    }
+    encoder.Encode(0, 128);          // Filter type
+    encoder.EncodeLiteral(32, 6);    // Filter level
+    encoder.EncodeLiteral(3, 3);     // Sharpness
+    encoder.Encode(0, 128);          // Mode ref lf delta
+    encoder.EncodeLiteral(2, 2);     // Four token partitions
+    encoder.EncodeLiteral(60, 7);    // Base qindex
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        encoder.Encode(0, 128);
+    }
+    encoder.Encode(1, 128);          // Refresh entropy probs
+    uint32_t updates = 0;
+    for (uint32_t i = 0; i < 4; i++)
+        for (uint32_t j = 0; j < 8; j++)
+            for (uint32_t k = 0; k < 3; k++)
+                for (uint32_t l = 0; l < 11; l++)
+                {
+                    uint32_t update = CoefUpdate(i, j, k, l);
+                    encoder.Encode(update, CoefUpdateProbs[i][j][k][l]);
+                    if (update)
+                    {
+                        encoder.EncodeLiteral((i * 7 + j * 5 + l) & 0xff, 8);
+                        updates++;
+                    }
+                }
+    encoder.Encode(1, 128);          // Mb no coeff skip
+    encoder.EncodeLiteral(200, 8);   // Prob skip false
+
+    vector<uint8_t> data = encoder.Finish();
+    // Token partition sizes and token partitions
+    for (uint32_t i = 0; i < 3 * 3 + 100; i++)
+    {
+        data.push_back((uint8_t)(0xa5 ^ i));
+    }
+
+    Vp8BoolDecoder decoder;
+    decoder.Init(data.data(), (uint32_t)data.size());
+    uint32_t decodedUpdates = 0;
+    ParseKeyFrameHead(decoder, decodedUpdates);
+    EXPECT_EQ(decodedUpdates, updates);
+
+    ByteBoolDecoder reference(data.data(), (uint32_t)data.size());
+    ParseKeyFrameHead(reference, decodedUpdates);
+    EXPECT_EQ(decodedUpdates, updates);
+
+    // Entropy state and first MB offset sent to HW
+    CheckState(decoder, reference, 0);
+}
+
+TEST_F(Vp8BoolDecoderTest, FrameHeadSize)
+{
+    vector<uint8_t> frame(4096, 0);
+
+    // Key frame, first partition 1000 bytes
+    uint32_t tag = (1000 << 5) | (1 << 4);
+    frame[0]     = (uint8_t)tag;
+    frame[1]     = (uint8_t)(tag >> 8);
+    frame[2]     = (uint8_t)(tag >> 16);
+    EXPECT_EQ(CodecVp8GetFrameHeadSize(frame.data(), (uint32_t)frame.size()), 10u + 1000 + 21 + 8);
+
+    // Inter frame
+    frame[0] |= 1;
+    EXPECT_EQ(CodecVp8GetFrameHeadSize(frame.data(), (uint32_t)frame.size()), 3u + 1000 + 21 + 8);
+
+    // Frame shorter than head
+    EXPECT_EQ(CodecVp8GetFrameHeadSize(frame.data(), 500), 500u);
+    EXPECT_EQ(CodecVp8GetFrameHeadSize(frame.data(), 2), 2u);
+}
+
+// Timing only, run with --gtest_also_run_disabled_tests
+TEST_F(Vp8BoolDecoderTest, DISABLED_Benchmark)
+{
+    vector<Symbol>  symbols = RandomSymbols(1 << 20, 7);
+    vector<uint8_t> data    = Encode(symbols, 0);
+
+    const uint32_t loops  = 10;
+    uint32_t       sum    = 0;
+    auto           start  = chrono::steady_clock::now();
+    for (uint32_t loop = 0; loop < loops; loop++)
+    {
+        ByteBoolDecoder reference(data.data(), (uint32_t)data.size());
+        for (auto &symbol : symbols)
+        {
+            sum += reference.DecodeBool(symbol.probability);
+        }
+    }
+    auto   middle      = chrono::steady_clock::now();
+    for (uint32_t loop = 0; loop < loops; loop++)
+    {
+        Vp8BoolDecoder decoder;
+        decoder.Init(data.data(), (uint32_t)data.size());
+        for (auto &symbol : symbols)
+        {
+            sum -= decoder.DecodeBool(symbol.probability);
+        }
+    }
+    auto end = chrono::steady_clock::now();
+
+    EXPECT_EQ(sum, 0u);
+
+    double byteNs   = chrono::duration<double, nano>(middle - start).count() / loops / symbols.size();
+    double windowNs = chrono::duration<double, nano>(end - middle).count() / loops / symbols.size();
+    printf("[ BENCH    ] VP8 bool decode: byte refill %.2f ns/bool, 64 bits window %.2f ns/bool\n", byteNs, windowNs);
+}
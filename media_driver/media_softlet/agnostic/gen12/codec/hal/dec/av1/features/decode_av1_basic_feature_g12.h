@@ -34,6 +34,7 @@
 #include "mhw_vdbox_avp_interface.h"
 #include "decode_internal_target.h"
 #include "codechal_hw.h"
+#include "codec_av1_default_cdf.h"
 
 namespace decode
 {
@@ -79,33 +80,6 @@ namespace decode
         //!
         MOS_STATUS ErrorDetectAndConceal();
 
-        //!
-        //! \brief    Initialize one of AV1 Decode frame context buffers with default values
-        //! \param    [in] ctxBuffer
-        //!           Pointer to frame context buffer
-        //! \param    [in] index
-        //!           flag to indicate the coeff CDF table index
-        //! \return   MOS_STATUS
-        //!           MOS_STATUS_SUCCESS if success, else fail reason
-        //!
-        MOS_STATUS InitDefaultFrameContextBuffer(
-            uint16_t              *ctxBuffer,
-            uint8_t               index);
-
-        //!
-        //! \brief    Initialize CDF tables for one Syntax Element
-        //! \details  Initialize CDF tables for one Syntax Element according to its CDF table layout and the initialization buffer
-        //! \param    [in] ctxBuffer
-        //!           Pointer to frame context buffer
-        //! \param    [in] SyntaxElement
-        //!           CDF table layout info and the initialization buffer for this syntax element
-        //! \return   MOS_STATUS
-        //!           MOS_STATUS_SUCCESS if success, else fail reason
-        //!
-        MOS_STATUS SyntaxElementCdfTableInit(
-            uint16_t                    *ctxBuffer,
-            SyntaxElementCdfTableLayout SyntaxElement);
-
         //!
         //! \brief    Update default cdfTable buffers
         //! \details  Update default cdfTable buffers for AV1 decoder
@@ -124,6 +98,7 @@ namespace decode
         CodecAv1SegmentsParams          *m_segmentParams           = nullptr;      //!< Pointer to AV1 segments parameter
         CodecAv1TileParams              *m_av1TileParams           = nullptr;      //!< Pointer to AV1 tiles parameter
 
+        MOS_BUFFER                      m_sharedCdfBuffers[4]      = {};           //!< Copies of read-only default cdf tables shared by contexts of the device
         PMOS_BUFFER                     m_defaultCdfBuffers[4]     = {};           //!< 4 default frame contexts per base_qindex
         PMOS_BUFFER                     m_defaultCdfBufferInUse    = nullptr;      //!< default cdf table used base on current base_qindex
         uint8_t                         m_curCoeffCdfQCtx          = 0;            //!< Coeff CDF Q context ID for current frame
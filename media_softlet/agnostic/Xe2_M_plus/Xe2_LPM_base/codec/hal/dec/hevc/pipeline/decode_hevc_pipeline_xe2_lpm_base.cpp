@@ -184,11 +184,13 @@ MOS_STATUS HevcPipelineXe2_Lpm_Base::AllocateResources(HevcBasicFeature &basicFe
 
     // In hevc short format decode, second level command buffer is programmed by Huc, so not need lock it.
     // In against hevc long format decode driver have to program second level command buffer, so it should
-    // be lockable.
+    // be lockable. Host slice header parsing switches pictures between the two formats, so keep it lockable.
+    ResourceAccessReq bbAccessReq =
+        (basicFeature.m_shortFormatInUse && !basicFeature.m_hostSliceParseEnabled) ? notLockableVideoMem : lockableVideoMem;
     if (m_secondLevelBBArray == nullptr)
     {
         m_secondLevelBBArray = m_allocator->AllocateBatchBufferArray(
-            size, count, m_secondLevelBBNum, true, basicFeature.m_shortFormatInUse ? notLockableVideoMem : lockableVideoMem);
+            size, count, m_secondLevelBBNum, true, bbAccessReq);
         DECODE_CHK_NULL(m_secondLevelBBArray);
         PMHW_BATCH_BUFFER &batchBuf = m_secondLevelBBArray->Fetch();
         DECODE_CHK_NULL(batchBuf);
@@ -198,7 +200,7 @@ MOS_STATUS HevcPipelineXe2_Lpm_Base::AllocateResources(HevcBasicFeature &basicFe
         PMHW_BATCH_BUFFER &batchBuf = m_secondLevelBBArray->Fetch();
         DECODE_CHK_NULL(batchBuf);
         DECODE_CHK_STATUS(m_allocator->Resize(
-            batchBuf, size, count, basicFeature.m_shortFormatInUse ? notLockableVideoMem : lockableVideoMem));
+            batchBuf, size, count, bbAccessReq));
     }
 
     return MOS_STATUS_SUCCESS;
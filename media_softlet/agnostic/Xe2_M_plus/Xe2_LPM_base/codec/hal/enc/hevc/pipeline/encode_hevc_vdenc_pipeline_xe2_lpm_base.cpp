@@ -252,6 +252,7 @@ MOS_STATUS HevcVdencPipelineXe2_Lpm_Base::Execute()
 MOS_STATUS HevcVdencPipelineXe2_Lpm_Base::GetStatusReport(void *status, uint16_t numStatus)
 {
     ENCODE_FUNC_CALL();
+    ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
     m_statusReport->GetReport(numStatus, status);
 
     return MOS_STATUS_SUCCESS;
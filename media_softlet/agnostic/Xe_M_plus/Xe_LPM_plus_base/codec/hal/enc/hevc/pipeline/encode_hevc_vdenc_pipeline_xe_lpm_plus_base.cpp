@@ -307,6 +307,7 @@ MOS_STATUS HevcVdencPipelineXe_Lpm_Plus_Base::Execute()
 MOS_STATUS HevcVdencPipelineXe_Lpm_Plus_Base::GetStatusReport(void *status, uint16_t numStatus)
 {
     ENCODE_FUNC_CALL();
+    ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
     m_statusReport->GetReport(numStatus, status);
 
     return MOS_STATUS_SUCCESS;
@@ -38,12 +38,17 @@ MediaMemDeCompNext_Xe_Lpm_Plus_Base::MediaMemDeCompNext_Xe_Lpm_Plus_Base() :
 }
 
 MOS_STATUS MediaMemDeCompNext_Xe_Lpm_Plus_Base::RenderDecompCMD(PMOS_SURFACE surface)
+{
+    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(surface);
+
+    return RenderDecompBatchCMD(surface, 1);
+}
+
+MOS_STATUS MediaMemDeCompNext_Xe_Lpm_Plus_Base::RenderDecompBatchCMD(PMOS_SURFACE surfaces, uint32_t count)
 {
     MOS_STATUS                          eStatus = MOS_STATUS_SUCCESS;
-    MHW_VEBOX_STATE_CMD_PARAMS          veboxStateCmdParams;
     MOS_COMMAND_BUFFER                  cmdBuffer;
     MHW_VEBOX_SURFACE_STATE_CMD_PARAMS  mhwVeboxSurfaceStateCmdParams;
-    MHW_MI_FLUSH_DW_PARAMS              flushDwParams;
     uint32_t                            streamID = 0;
     const MHW_VEBOX_HEAP*               veboxHeap = nullptr;
     MOS_CONTEXT*                        pOsContext = nullptr;
@@ -51,25 +56,38 @@ MOS_STATUS MediaMemDeCompNext_Xe_Lpm_Plus_Base::RenderDecompCMD(PMOS_SURFACE sur
     bool                                isPerfCollected = false;
     MediaPerfProfiler*                  perfProfiler = nullptr;
     uint32_t                            perfTag = 0;
+    std::vector<PMOS_SURFACE>           targets;
 
-    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(surface);
+    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(surfaces);
     VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_osInterface);
     VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(pOsContext = m_osInterface->pOsContext);
     VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_miItf);
     VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_veboxItf);
     VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(pMmioRegisters = m_miItf->GetMmioRegisters());
 
-    if (surface->CompressionMode &&
-        surface->CompressionMode != MOS_MMC_MC &&
-        surface->CompressionMode != MOS_MMC_RC)
+    for (uint32_t i = 0; i < count; i++)
     {
-        VPHAL_MEMORY_DECOMP_NORMALMESSAGE("Input surface is uncompressed, In_Place resolve is not needed");
-        return eStatus;
+        PMOS_SURFACE surface = &surfaces[i];
+
+        if (surface->CompressionMode &&
+            surface->CompressionMode != MOS_MMC_MC &&
+            surface->CompressionMode != MOS_MMC_RC)
+        {
+            VPHAL_MEMORY_DECOMP_NORMALMESSAGE("Input surface is uncompressed, In_Place resolve is not needed");
+            continue;
+        }
+
+        if (!IsFormatSupported(surface))
+        {
+            VPHAL_MEMORY_DECOMP_NORMALMESSAGE("Input surface is not supported by Vebox, In_Place resolve can't be done");
+            continue;
+        }
+
+        targets.push_back(surface);
     }
 
-    if (!IsFormatSupported(surface))
+    if (targets.empty())
     {
-        VPHAL_MEMORY_DECOMP_NORMALMESSAGE("Input surface is not supported by Vebox, In_Place resolve can't be done");
         return eStatus;
     }
 
@@ -83,18 +101,20 @@ MOS_STATUS MediaMemDeCompNext_Xe_Lpm_Plus_Base::RenderDecompCMD(PMOS_SURFACE sur
     m_osInterface->pfnResetOsStates(m_osInterface);
 
     VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_veboxItf->GetVeboxHeapInfo(&veboxHeap));
-    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(&surface->OsResource);
     VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_osInterface->osCpInterface);
 
-    // Check whether surface is ready for write
-    m_osInterface->pfnSyncOnResource(
-        m_osInterface,
-        &surface->OsResource,
-        MOS_GPU_CONTEXT_VEBOX,
-        true);
+    for (auto surface : targets)
+    {
+        // Check whether surface is ready for write
+        m_osInterface->pfnSyncOnResource(
+            m_osInterface,
+            &surface->OsResource,
+            MOS_GPU_CONTEXT_VEBOX,
+            true);
+    }
 
     // preprocess in cp first
-    m_osInterface->osCpInterface->PrepareResources((void**)&surface, 1, nullptr, 0);
+    m_osInterface->osCpInterface->PrepareResources((void**)targets.data(), (uint32_t)targets.size(), nullptr, 0);
 
     // initialize the command buffer struct
     MOS_ZeroMemory(&cmdBuffer, sizeof(MOS_COMMAND_BUFFER));
@@ -127,32 +147,35 @@ MOS_STATUS MediaMemDeCompNext_Xe_Lpm_Plus_Base::RenderDecompCMD(PMOS_SURFACE sur
         }
     }
 
-    // Prepare Vebox_Surface_State, surface input/and output are the same but the compressed status.
-    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(SetupVeboxSurfaceState(&mhwVeboxSurfaceStateCmdParams, surface, nullptr));
-
     //---------------------------------
     // Send Pvt MMCD CMD
     //---------------------------------
     VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_miItf->AddVeboxMMIOPrologCmd(&cmdBuffer));
 
+    // All surfaces are resolved in place one after another in the same command buffer
+    for (auto surface : targets)
+    {
+        // Prepare Vebox_Surface_State, surface input/and output are the same but the compressed status.
+        VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(SetupVeboxSurfaceState(&mhwVeboxSurfaceStateCmdParams, surface, nullptr));
 
-    //---------------------------------
-    // Send CMD: Vebox_Surface_State
-    //---------------------------------
-    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_veboxItf->AddVeboxSurfaces(
-        &cmdBuffer,
-        &mhwVeboxSurfaceStateCmdParams));
+        //---------------------------------
+        // Send CMD: Vebox_Surface_State
+        //---------------------------------
+        VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_veboxItf->AddVeboxSurfaces(
+            &cmdBuffer,
+            &mhwVeboxSurfaceStateCmdParams));
 
-    HalOcaInterfaceNext::OnDispatch(cmdBuffer, *m_osInterface, m_miItf, *pMmioRegisters);
+        HalOcaInterfaceNext::OnDispatch(cmdBuffer, *m_osInterface, m_miItf, *pMmioRegisters);
 
-    //---------------------------------
-    // Send CMD: Vebox_Tiling_Convert
-    //---------------------------------
-    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(VeboxSendVeboxTileConvertCMD(&cmdBuffer, surface, nullptr, streamID));
+        //---------------------------------
+        // Send CMD: Vebox_Tiling_Convert
+        //---------------------------------
+        VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(VeboxSendVeboxTileConvertCMD(&cmdBuffer, surface, nullptr, streamID));
 
-    auto& par = m_miItf->GETPAR_MI_FLUSH_DW();
-    par = {};
-    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_miItf->ADDCMD_MI_FLUSH_DW(&cmdBuffer));
+        auto& par = m_miItf->GETPAR_MI_FLUSH_DW();
+        par = {};
+        VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(m_miItf->ADDCMD_MI_FLUSH_DW(&cmdBuffer));
+    }
 
     if (!m_osInterface->bEnableKmdMediaFrameTracking && veboxHeap)
     {
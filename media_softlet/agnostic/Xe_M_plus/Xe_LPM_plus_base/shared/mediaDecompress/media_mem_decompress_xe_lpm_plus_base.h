@@ -68,6 +68,18 @@ public:
     virtual MOS_STATUS RenderDecompCMD(
         PMOS_SURFACE surface);
 
+    //!
+    //! \brief    Decompress surfaces in place with one submission
+    //! \param    [in] surfaces
+    //!           Array of surfaces
+    //! \param    [in] count
+    //!           Number of surfaces
+    //! \return   MOS_STATUS_SUCCESS if succeeded, else error code.
+    //!
+    virtual MOS_STATUS RenderDecompBatchCMD(
+        PMOS_SURFACE surfaces,
+        uint32_t     count);
+
     //!
     //! \brief    Media memory decompression Enabled or not
     //! \details  Media memory decompression Enabled or not
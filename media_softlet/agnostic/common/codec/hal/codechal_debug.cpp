@@ -3460,6 +3460,7 @@ MOS_STATUS CodechalDebugInterface::SetFastDumpConfig(MediaCopyWrapper *mediaCopy
         cfg.informOnError       = c.informOnError;
 
         auto suffix = cfg.writeMode == 0 ? ".bin" : cfg.writeMode == 1 ? ".txt"
+                                                  : cfg.writeMode == 3 ? ".fdz"
                                                                       : "";
 
         class DumpEnabled
@@ -28,6 +28,7 @@
 #include "decode_hevc_basic_feature.h"
 #include "decode_utils.h"
 #include "decode_allocator.h"
+#include "decode_resource_auto_lock.h"
 
 namespace decode
 {
@@ -38,10 +39,25 @@ MOS_STATUS HevcBasicFeature::Init(void *setting)
     DECODE_CHK_NULL(setting);
     DECODE_CHK_NULL(m_hwInterface);
 
-    m_shortFormatInUse = ((CodechalSetting*)setting)->shortFormatInUse;
+    m_shortFormatInUse     = ((CodechalSetting*)setting)->shortFormatInUse;
+    m_shortFormatRequested = m_shortFormatInUse;
 
     DECODE_CHK_STATUS(DecodeBasicFeature::Init(setting));
 
+    if (m_shortFormatRequested)
+    {
+        DECODE_CHK_NULL(m_osInterface);
+        m_userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+        m_hostSliceParseEnabled =
+            ReadUserFeature(m_userSettingPtr, "HEVC Decode Host Slice Parse Enable", MediaUserSetting::Group::Sequence).Get<bool>();
+        m_hostSliceParseMaxSlices =
+            ReadUserFeature(m_userSettingPtr, "HEVC Decode Host Slice Parse Max Slices", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+        if (m_hostSliceParseMaxSlices == 0)
+        {
+            m_hostSliceParseEnabled = false;
+        }
+    }
+
     DECODE_CHK_STATUS(m_refFrames.Init(this, *m_allocator));
     DECODE_CHK_STATUS(m_mvBuffers.Init(m_hwInterface, *m_allocator, *this,
                                        CODEC_NUM_HEVC_INITIAL_MV_BUFFERS));
@@ -82,12 +98,81 @@ MOS_STATUS HevcBasicFeature::Update(void *params)
     m_hevcSccPicParams   = static_cast<PCODEC_HEVC_SCC_PIC_PARAMS>(decodeParams->m_advPicParams);
     m_hevcSubsetParams   = static_cast<PCODEC_HEVC_SUBSET_PARAMS>(decodeParams->m_subsetParams);
 
+    // Short format may be switched to long format per picture by host slice header parsing
+    m_shortFormatInUse = m_shortFormatRequested;
+
     DECODE_CHK_STATUS(SetPictureStructs());
+    if (m_hostSliceParseEnabled)
+    {
+        DECODE_CHK_STATUS(ParseSliceHeaderOnHost(decodeParams->m_bitstreamLockable));
+    }
     DECODE_CHK_STATUS(SetSliceStructs());
 
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS HevcBasicFeature::ParseSliceHeaderOnHost(bool bitstreamLockable)
+{
+    DECODE_FUNC_CALL();
+
+    // Pictures with many slices are still handled by HuC, host parsing cost grows with
+    // slice number while HuC S2L cost is almost fixed.
+    if (!bitstreamLockable || m_numSlices == 0 || m_numSlices > m_hostSliceParseMaxSlices)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (m_osInterface->osCpInterface != nullptr && m_osInterface->osCpInterface->IsCpEnabled())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (!HevcSliceHeaderParser::IsSupported(*m_hevcPicParams, m_hevcSccPicParams))
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    ResourceAutoLock resLock(m_allocator, &m_resDataBuffer.OsResource);
+    auto             bitstream = (uint8_t *)resLock.LockResourceForRead();
+    if (bitstream == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Parse into local copies, application parameters are kept untouched if fall back to HuC
+    m_hostSliceParams.assign(m_hevcSliceParams, m_hevcSliceParams + m_numSlices);
+    if (m_hevcRextSliceParams != nullptr)
+    {
+        m_hostRextSliceParams.resize(m_numSlices);
+    }
+
+    MOS_STATUS status = m_sliceHeaderParser.ParsePicture(
+        bitstream + m_dataOffset,
+        m_dataSize,
+        *m_hevcPicParams,
+        m_hevcRextPicParams,
+        m_hostSliceParams.data(),
+        (m_hevcRextSliceParams != nullptr) ? m_hostRextSliceParams.data() : nullptr,
+        m_hostSubsetParams,
+        m_numSlices);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        DECODE_NORMALMESSAGE("Host slice header parsing failed, fall back to HuC S2L.");
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // Slice params buffer from DDI is allocated in long format size for short format too
+    DECODE_CHK_STATUS(MOS_SecureMemcpy(m_hevcSliceParams, sizeof(CODEC_HEVC_SLICE_PARAMS) * m_numSlices,
+        m_hostSliceParams.data(), sizeof(CODEC_HEVC_SLICE_PARAMS) * m_numSlices));
+    if (m_hevcRextSliceParams != nullptr)
+    {
+        DECODE_CHK_STATUS(MOS_SecureMemcpy(m_hevcRextSliceParams, sizeof(CODEC_HEVC_EXT_SLICE_PARAMS) * m_numSlices,
+            m_hostRextSliceParams.data(), sizeof(CODEC_HEVC_EXT_SLICE_PARAMS) * m_numSlices));
+    }
+    m_hevcSubsetParams = &m_hostSubsetParams;
+    m_shortFormatInUse = false;
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS HevcBasicFeature::ErrorDetectAndConceal()
 {
 
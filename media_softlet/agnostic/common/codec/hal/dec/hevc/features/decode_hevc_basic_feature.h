@@ -32,6 +32,7 @@
 #include "decode_hevc_reference_frames.h"
 #include "decode_hevc_mv_buffers.h"
 #include "decode_hevc_tile_coding.h"
+#include "decode_hevc_slice_header_parser.h"
 
 namespace decode
 {
@@ -91,6 +92,7 @@ public:
 
     bool                            m_dummyReferenceSlot[CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC];
     bool                            m_shortFormatInUse = false;     //!< Indicate if short format
+    bool                            m_hostSliceParseEnabled = false;//!< Indicate if short format slice header can be parsed on host
 
 protected:
     virtual MOS_STATUS SetRequiredBitstreamSize(uint32_t requiredSize) override;
@@ -105,8 +107,24 @@ protected:
     MOS_STATUS ReferenceParamCheck(uint32_t sliceIdx);
     MOS_STATUS CollocatedRefIdxCheck(uint32_t sliceIdx);
 
+    //!
+    //! \brief  Parse short format slice headers on host to skip HuC S2L for current picture
+    //! \param  [in] bitstreamLockable
+    //!         Indicate if bitstream buffer can be locked
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ParseSliceHeaderOnHost(bool bitstreamLockable);
+
     PMOS_INTERFACE        m_osInterface  = nullptr;
 
+    bool                                  m_shortFormatRequested    = false;  //!< Short format requested by application
+    uint32_t                              m_hostSliceParseMaxSlices = 0;      //!< Max slice number of picture parsed on host
+    HevcSliceHeaderParser                 m_sliceHeaderParser;                //!< Host side slice header parser
+    std::vector<CODEC_HEVC_SLICE_PARAMS>  m_hostSliceParams;                  //!< Long format slice params from host parser
+    std::vector<CODEC_HEVC_EXT_SLICE_PARAMS> m_hostRextSliceParams;           //!< Rext slice params from host parser
+    CODEC_HEVC_SUBSET_PARAMS              m_hostSubsetParams = {};            //!< Entry point offsets from host parser
+
 MEDIA_CLASS_DEFINE_END(decode__HevcBasicFeature)
 };
 
@@ -0,0 +1,816 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_hevc_slice_header_parser.cpp
+//! \brief    Defines the host side slice segment header parser for hevc short format decode
+//!
+
+#include "decode_hevc_slice_header_parser.h"
+#include "decode_utils.h"
+
+// Malformed or unsupported slice headers are expected, caller falls back to HuC S2L
+// for them, so failures are reported as normal messages instead of assertions.
+#define HOST_PARSE_CHK_COND(_expr, _message, ...)                              \
+{                                                                              \
+    if (_expr)                                                                 \
+    {                                                                          \
+        DECODE_NORMALMESSAGE(_message, ##__VA_ARGS__);                         \
+        return MOS_STATUS_INVALID_PARAMETER;                                   \
+    }                                                                          \
+}
+
+#define HOST_PARSE_CHK_STATUS(_stmt)                                           \
+{                                                                              \
+    MOS_STATUS stmtStatus = (MOS_STATUS)(_stmt);                               \
+    if (stmtStatus != MOS_STATUS_SUCCESS)                                      \
+    {                                                                          \
+        return stmtStatus;                                                     \
+    }                                                                          \
+}
+
+namespace decode
+{
+
+// NAL unit types referred by slice segment header syntax, H.265 Table 7-1
+static constexpr uint8_t m_nalBlaWLp       = 16;
+static constexpr uint8_t m_nalIdrWRadl     = 19;
+static constexpr uint8_t m_nalIdrNLp       = 20;
+static constexpr uint8_t m_nalRsvIrapVcl23 = 23;
+
+static constexpr uint8_t m_invalidRefIdx   = 0xff;
+static constexpr uint8_t m_invalidFrameIdx = 0x7f;
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::LoadByte()
+{
+    HOST_PARSE_CHK_COND(m_pos >= m_size, "Slice header exceeds slice data size!");
+
+    uint8_t byte = m_data[m_pos];
+    if (m_zeroCount >= 2 && byte == 0x03)
+    {
+        // Emulation prevention byte, drop it
+        m_emuPrevnBytes++;
+        m_zeroCount = 0;
+        m_pos++;
+        HOST_PARSE_CHK_COND(m_pos >= m_size, "Slice header exceeds slice data size!");
+        byte = m_data[m_pos];
+    }
+
+    m_zeroCount = (byte == 0) ? (m_zeroCount + 1) : 0;
+    m_curByte   = byte;
+    m_bitsLeft  = 8;
+    m_pos++;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::ReadBits(uint32_t numBits, uint32_t &value)
+{
+    HOST_PARSE_CHK_COND(numBits > 32, "Invalid bit count!");
+
+    value = 0;
+    while (numBits > 0)
+    {
+        if (m_bitsLeft == 0)
+        {
+            HOST_PARSE_CHK_STATUS(LoadByte());
+        }
+
+        uint32_t bits  = MOS_MIN(numBits, m_bitsLeft);
+        uint32_t shift = m_bitsLeft - bits;
+        value = (uint32_t)(((uint64_t)value << bits) | ((m_curByte >> shift) & ((1u << bits) - 1)));
+
+        m_bitsLeft -= (uint8_t)bits;
+        numBits    -= bits;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::ReadFlag(bool &flag)
+{
+    uint32_t value = 0;
+    HOST_PARSE_CHK_STATUS(ReadBits(1, value));
+    flag = (value != 0);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::ReadUe(uint32_t &value)
+{
+    uint32_t leadingZeros = 0;
+    bool     bit          = false;
+
+    HOST_PARSE_CHK_STATUS(ReadFlag(bit));
+    while (!bit)
+    {
+        HOST_PARSE_CHK_COND(++leadingZeros > 31, "Invalid exp-golomb code!");
+        HOST_PARSE_CHK_STATUS(ReadFlag(bit));
+    }
+
+    uint32_t suffix = 0;
+    HOST_PARSE_CHK_STATUS(ReadBits(leadingZeros, suffix));
+    value = (uint32_t)(((uint64_t)1 << leadingZeros) - 1 + suffix);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::ReadSe(int32_t &value)
+{
+    uint32_t codeNum = 0;
+    HOST_PARSE_CHK_STATUS(ReadUe(codeNum));
+    value = (codeNum & 1) ? (int32_t)((codeNum + 1) >> 1) : -(int32_t)(codeNum >> 1);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::SkipBits(uint32_t numBits)
+{
+    uint32_t value = 0;
+    while (numBits > 0)
+    {
+        uint32_t bits = MOS_MIN(numBits, 32);
+        HOST_PARSE_CHK_STATUS(ReadBits(bits, value));
+        numBits -= bits;
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::BitReader::ByteAlignment()
+{
+    bool alignmentBitEqualToOne = false;
+    HOST_PARSE_CHK_STATUS(ReadFlag(alignmentBitEqualToOne));
+    HOST_PARSE_CHK_COND(!alignmentBitEqualToOne, "Invalid slice header byte alignment!");
+
+    // Remaining alignment_bit_equal_to_zero in current byte
+    m_bitsLeft = 0;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+uint8_t HevcSliceHeaderParser::CeilLog2(uint32_t value)
+{
+    uint8_t bits = 0;
+    while ((1u << bits) < value)
+    {
+        bits++;
+    }
+    return bits;
+}
+
+bool HevcSliceHeaderParser::IsSupported(
+    const CODEC_HEVC_PIC_PARAMS      &picParams,
+    const CODEC_HEVC_SCC_PIC_PARAMS  *sccPicParams)
+{
+    // SCC slice header carries current picture reference and ACT/integer MV syntax,
+    // which stays with HuC.
+    if (sccPicParams != nullptr)
+    {
+        return false;
+    }
+
+    // Long term reference order in RefPicSetLtCurr comes from slice header which
+    // is not recoverable from picture parameters when more than one is in use.
+    uint32_t numLtCurr = 0;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        if (picParams.RefPicSetLtCurr[i] != m_invalidRefIdx)
+        {
+            numLtCurr++;
+        }
+    }
+
+    return numLtCurr <= 1;
+}
+
+MOS_STATUS HevcSliceHeaderParser::InitPicContext(
+    const CODEC_HEVC_PIC_PARAMS     &picParams,
+    const CODEC_HEVC_EXT_PIC_PARAMS *extPicParams,
+    PicContext                      &ctx)
+{
+    DECODE_FUNC_CALL();
+
+    ctx.picParams    = &picParams;
+    ctx.extPicParams = extPicParams;
+
+    uint32_t minCbSize     = 1 << (picParams.log2_min_luma_coding_block_size_minus3 + 3);
+    uint32_t ctbSize       = minCbSize << picParams.log2_diff_max_min_luma_coding_block_size;
+    uint32_t widthInCtb    = MOS_ROUNDUP_DIVIDE(picParams.PicWidthInMinCbsY * minCbSize, ctbSize);
+    uint32_t heightInCtb   = MOS_ROUNDUP_DIVIDE(picParams.PicHeightInMinCbsY * minCbSize, ctbSize);
+    ctx.sliceAddrBits      = CeilLog2(widthInCtb * heightInCtb);
+    ctx.chromaArrayType    = picParams.separate_colour_plane_flag ? 0 : picParams.chroma_format_idc;
+
+    // RefPicSetStCurrBefore/After from DDI are in RefFrameList order, while the reference picture
+    // list initialization needs them in the RPS order, i.e. nearest POC first.
+    auto collect = [&](const uint8_t *src, uint8_t *dst, uint8_t &num) {
+        num = 0;
+        for (uint32_t i = 0; i < 8 && src[i] != m_invalidRefIdx; i++)
+        {
+            HOST_PARSE_CHK_COND(src[i] >= CODEC_MAX_NUM_REF_FRAME_HEVC, "Invalid reference index in RPS!");
+            dst[num++] = src[i];
+        }
+        return MOS_STATUS_SUCCESS;
+    };
+    HOST_PARSE_CHK_STATUS(collect(picParams.RefPicSetStCurrBefore, ctx.stCurrBefore, ctx.numPocStCurrBefore));
+    HOST_PARSE_CHK_STATUS(collect(picParams.RefPicSetStCurrAfter, ctx.stCurrAfter, ctx.numPocStCurrAfter));
+    HOST_PARSE_CHK_STATUS(collect(picParams.RefPicSetLtCurr, ctx.ltCurr, ctx.numPocLtCurr));
+
+    auto sortByDistance = [&](uint8_t *list, uint8_t num) {
+        for (uint8_t i = 1; i < num; i++)
+        {
+            uint8_t idx  = list[i];
+            int32_t dist = MOS_ABS(picParams.PicOrderCntValList[idx] - picParams.CurrPicOrderCntVal);
+            int32_t j    = i - 1;
+            while (j >= 0 &&
+                   MOS_ABS(picParams.PicOrderCntValList[list[j]] - picParams.CurrPicOrderCntVal) > dist)
+            {
+                list[j + 1] = list[j];
+                j--;
+            }
+            list[j + 1] = idx;
+        }
+    };
+    sortByDistance(ctx.stCurrBefore, ctx.numPocStCurrBefore);
+    sortByDistance(ctx.stCurrAfter, ctx.numPocStCurrAfter);
+
+    ctx.numPicTotalCurr = ctx.numPocStCurrBefore + ctx.numPocStCurrAfter + ctx.numPocLtCurr;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::ParsePicture(
+    const uint8_t                    *bitstream,
+    uint32_t                          bitstreamSize,
+    const CODEC_HEVC_PIC_PARAMS      &picParams,
+    const CODEC_HEVC_EXT_PIC_PARAMS  *extPicParams,
+    PCODEC_HEVC_SLICE_PARAMS          sliceParams,
+    PCODEC_HEVC_EXT_SLICE_PARAMS      extSliceParams,
+    CODEC_HEVC_SUBSET_PARAMS         &subsetParams,
+    uint32_t                          numSlices)
+{
+    DECODE_FUNC_CALL();
+
+    DECODE_CHK_NULL(bitstream);
+    DECODE_CHK_NULL(sliceParams);
+
+    PicContext ctx;
+    HOST_PARSE_CHK_STATUS(InitPicContext(picParams, extPicParams, ctx));
+
+    uint32_t                       subsetOffset = 0;
+    const CODEC_HEVC_SLICE_PARAMS *indepSlc     = nullptr;
+    PCODEC_HEVC_EXT_SLICE_PARAMS   indepExtSlc  = nullptr;
+
+    for (uint32_t slcIdx = 0; slcIdx < numSlices; slcIdx++)
+    {
+        CODEC_HEVC_SLICE_PARAMS     &slc    = sliceParams[slcIdx];
+        PCODEC_HEVC_EXT_SLICE_PARAMS extSlc = (extSliceParams != nullptr) ? &extSliceParams[slcIdx] : nullptr;
+
+        HOST_PARSE_CHK_COND(slc.slice_data_offset > bitstreamSize ||
+                            slc.slice_data_size > bitstreamSize - slc.slice_data_offset,
+                            "Slice %d data exceeds bitstream!", slcIdx);
+
+        const uint8_t *data = bitstream + slc.slice_data_offset;
+        uint32_t       size = slc.slice_data_size;
+
+        // Start code prefix is optional in the slice data buffer
+        uint32_t prefixSize = 0;
+        if (size >= 3 && data[0] == 0 && data[1] == 0 && data[2] == 1)
+        {
+            prefixSize = 3;
+        }
+        else if (size >= 4 && data[0] == 0 && data[1] == 0 && data[2] == 0 && data[3] == 1)
+        {
+            prefixSize = 4;
+        }
+
+        BitReader reader(data + prefixSize, size - prefixSize);
+        HOST_PARSE_CHK_STATUS(ParseSlice(reader, ctx, slc, extSlc, indepSlc, subsetParams, subsetOffset));
+
+        slc.ByteOffsetToSliceData      = prefixSize + reader.GetRawBytePos() - reader.GetEmuPrevnBytes();
+        slc.NumEmuPrevnBytesInSliceHdr = (uint16_t)reader.GetEmuPrevnBytes();
+        slc.LongSliceFlags.fields.LastSliceOfPic = (slcIdx == numSlices - 1);
+
+        if (!slc.LongSliceFlags.fields.dependent_slice_segment_flag)
+        {
+            indepSlc    = &slc;
+            indepExtSlc = extSlc;
+        }
+        else if (extSlc != nullptr && indepExtSlc != nullptr)
+        {
+            *extSlc = *indepExtSlc;
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::ParseSlice(
+    BitReader                      &reader,
+    const PicContext               &ctx,
+    CODEC_HEVC_SLICE_PARAMS        &slc,
+    PCODEC_HEVC_EXT_SLICE_PARAMS    extSlc,
+    const CODEC_HEVC_SLICE_PARAMS  *indepSlc,
+    CODEC_HEVC_SUBSET_PARAMS       &subsetParams,
+    uint32_t                       &subsetOffset)
+{
+    DECODE_FUNC_CALL();
+
+    const CODEC_HEVC_PIC_PARAMS &pic = *ctx.picParams;
+    uint32_t value = 0;
+    int32_t  sValue = 0;
+    bool     flag  = false;
+
+    // nal_unit_header()
+    uint32_t nalHeader = 0;
+    HOST_PARSE_CHK_STATUS(reader.ReadBits(16, nalHeader));
+    uint8_t nalUnitType = (nalHeader >> 9) & 0x3f;
+    HOST_PARSE_CHK_COND(nalUnitType > m_nalRsvIrapVcl23 || (nalHeader & 0x8000), "Not a slice segment NAL unit!");
+
+    bool firstSliceSegmentInPic = false;
+    HOST_PARSE_CHK_STATUS(reader.ReadFlag(firstSliceSegmentInPic));
+    if (nalUnitType >= m_nalBlaWLp && nalUnitType <= m_nalRsvIrapVcl23)
+    {
+        HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));    // no_output_of_prior_pics_flag
+    }
+    HOST_PARSE_CHK_STATUS(reader.ReadUe(value));         // slice_pic_parameter_set_id
+
+    bool     dependentSliceSegment = false;
+    uint32_t sliceSegmentAddress   = 0;
+    if (!firstSliceSegmentInPic)
+    {
+        if (pic.dependent_slice_segments_enabled_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(dependentSliceSegment));
+        }
+        HOST_PARSE_CHK_STATUS(reader.ReadBits(ctx.sliceAddrBits, sliceSegmentAddress));
+    }
+
+    // Save slice data location which come from short format parameters
+    uint32_t sliceDataSize   = slc.slice_data_size;
+    uint32_t sliceDataOffset = slc.slice_data_offset;
+    uint16_t sliceChopping   = slc.slice_chopping;
+
+    if (dependentSliceSegment)
+    {
+        // Dependent slice segment inherits slice header from the preceding independent one
+        HOST_PARSE_CHK_COND(indepSlc == nullptr, "Dependent slice segment without independent slice segment!");
+        slc = *indepSlc;
+        slc.LongSliceFlags.fields.dependent_slice_segment_flag = 1;
+    }
+    else
+    {
+        MOS_ZeroMemory(&slc, sizeof(slc));
+        if (extSlc != nullptr)
+        {
+            MOS_ZeroMemory(extSlc, sizeof(*extSlc));
+        }
+
+        HOST_PARSE_CHK_STATUS(reader.SkipBits(pic.num_extra_slice_header_bits));   // slice_reserved_flag[]
+
+        uint32_t sliceType = 0;
+        HOST_PARSE_CHK_STATUS(reader.ReadUe(sliceType));
+        HOST_PARSE_CHK_COND(sliceType >= decodeHevcNumSliceTypes, "Invalid slice type!");
+        slc.LongSliceFlags.fields.slice_type = sliceType;
+
+        bool isBSlice = (sliceType == decodeHevcBSlice);
+        bool isPSlice = (sliceType == decodeHevcPSlice);
+
+        if (pic.output_flag_present_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));    // pic_output_flag
+        }
+        if (pic.separate_colour_plane_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadBits(2, value));
+            slc.LongSliceFlags.fields.color_plane_id = value;
+        }
+
+        if (nalUnitType != m_nalIdrWRadl && nalUnitType != m_nalIdrNLp)
+        {
+            HOST_PARSE_CHK_STATUS(reader.SkipBits(pic.log2_max_pic_order_cnt_lsb_minus4 + 4));  // slice_pic_order_cnt_lsb
+
+            bool shortTermRefPicSetSpsFlag = false;
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(shortTermRefPicSetSpsFlag));
+            if (!shortTermRefPicSetSpsFlag)
+            {
+                // st_ref_pic_set(num_short_term_ref_pic_sets), size is provided by application
+                HOST_PARSE_CHK_STATUS(reader.SkipBits(pic.wNumBitsForShortTermRPSInSlice));
+            }
+            else if (pic.num_short_term_ref_pic_sets > 1)
+            {
+                HOST_PARSE_CHK_STATUS(reader.SkipBits(CeilLog2(pic.num_short_term_ref_pic_sets)));  // short_term_ref_pic_set_idx
+            }
+
+            if (pic.long_term_ref_pics_present_flag)
+            {
+                HOST_PARSE_CHK_STATUS(SkipLongTermRefPics(reader, pic));
+            }
+
+            if (pic.sps_temporal_mvp_enabled_flag)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+                slc.LongSliceFlags.fields.slice_temporal_mvp_enabled_flag = flag;
+            }
+        }
+
+        if (pic.sample_adaptive_offset_enabled_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+            slc.LongSliceFlags.fields.slice_sao_luma_flag = flag;
+            if (ctx.chromaArrayType != 0)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+                slc.LongSliceFlags.fields.slice_sao_chroma_flag = flag;
+            }
+        }
+
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            for (uint32_t j = 0; j < CODEC_MAX_NUM_REF_FRAME_HEVC; j++)
+            {
+                slc.RefPicList[i][j].FrameIdx = m_invalidFrameIdx;
+            }
+        }
+
+        slc.collocated_ref_idx = 0;
+        slc.LongSliceFlags.fields.collocated_from_l0_flag = 1;
+
+        if (isPSlice || isBSlice)
+        {
+            slc.num_ref_idx_l0_active_minus1 = pic.num_ref_idx_l0_default_active_minus1;
+            slc.num_ref_idx_l1_active_minus1 = isBSlice ? pic.num_ref_idx_l1_default_active_minus1 : 0;
+
+            bool numRefIdxActiveOverride = false;
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(numRefIdxActiveOverride));
+            if (numRefIdxActiveOverride)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadUe(value));
+                HOST_PARSE_CHK_COND(value >= CODEC_MAX_NUM_REF_FRAME_HEVC, "num_ref_idx_l0_active_minus1 out of range!");
+                slc.num_ref_idx_l0_active_minus1 = (uint8_t)value;
+                if (isBSlice)
+                {
+                    HOST_PARSE_CHK_STATUS(reader.ReadUe(value));
+                    HOST_PARSE_CHK_COND(value >= CODEC_MAX_NUM_REF_FRAME_HEVC, "num_ref_idx_l1_active_minus1 out of range!");
+                    slc.num_ref_idx_l1_active_minus1 = (uint8_t)value;
+                }
+            }
+
+            HOST_PARSE_CHK_STATUS(ParseRefPicLists(reader, ctx, slc, isBSlice));
+
+            if (isBSlice)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+                slc.LongSliceFlags.fields.mvd_l1_zero_flag = flag;
+            }
+            if (pic.cabac_init_present_flag)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+                slc.LongSliceFlags.fields.cabac_init_flag = flag;
+            }
+            if (slc.LongSliceFlags.fields.slice_temporal_mvp_enabled_flag)
+            {
+                if (isBSlice)
+                {
+                    HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+                    slc.LongSliceFlags.fields.collocated_from_l0_flag = flag;
+                }
+                if (( slc.LongSliceFlags.fields.collocated_from_l0_flag && slc.num_ref_idx_l0_active_minus1 > 0) ||
+                    (!slc.LongSliceFlags.fields.collocated_from_l0_flag && slc.num_ref_idx_l1_active_minus1 > 0))
+                {
+                    HOST_PARSE_CHK_STATUS(reader.ReadUe(value));
+                    HOST_PARSE_CHK_COND(value >= CODEC_MAX_NUM_REF_FRAME_HEVC, "collocated_ref_idx out of range!");
+                    slc.collocated_ref_idx = (uint8_t)value;
+                }
+            }
+
+            if ((pic.weighted_pred_flag && isPSlice) || (pic.weighted_bipred_flag && isBSlice))
+            {
+                HOST_PARSE_CHK_STATUS(ParsePredWeightTable(reader, ctx, slc, extSlc, isBSlice));
+            }
+
+            HOST_PARSE_CHK_STATUS(reader.ReadUe(value));
+            HOST_PARSE_CHK_COND(value > 4, "five_minus_max_num_merge_cand out of range!");
+            slc.five_minus_max_num_merge_cand = (uint8_t)value;
+        }
+
+        HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+        slc.slice_qp_delta = (char)sValue;
+
+        if (pic.pps_slice_chroma_qp_offsets_present_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+            slc.slice_cb_qp_offset = (char)sValue;
+            HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+            slc.slice_cr_qp_offset = (char)sValue;
+        }
+
+        if (ctx.extPicParams != nullptr &&
+            ctx.extPicParams->PicRangeExtensionFlags.fields.chroma_qp_offset_list_enabled_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+            if (extSlc != nullptr)
+            {
+                extSlc->cu_chroma_qp_offset_enabled_flag = flag;
+            }
+        }
+
+        bool deblockingFilterOverride = false;
+        if (pic.deblocking_filter_override_enabled_flag)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(deblockingFilterOverride));
+        }
+        if (deblockingFilterOverride)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+            slc.LongSliceFlags.fields.slice_deblocking_filter_disabled_flag = flag;
+            if (!flag)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+                slc.slice_beta_offset_div2 = (char)sValue;
+                HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+                slc.slice_tc_offset_div2 = (char)sValue;
+            }
+        }
+        else
+        {
+            slc.LongSliceFlags.fields.slice_deblocking_filter_disabled_flag = pic.pps_deblocking_filter_disabled_flag;
+            slc.slice_beta_offset_div2 = pic.pps_beta_offset_div2;
+            slc.slice_tc_offset_div2   = pic.pps_tc_offset_div2;
+        }
+
+        slc.LongSliceFlags.fields.slice_loop_filter_across_slices_enabled_flag = pic.pps_loop_filter_across_slices_enabled_flag;
+        if (pic.pps_loop_filter_across_slices_enabled_flag &&
+            (slc.LongSliceFlags.fields.slice_sao_luma_flag || slc.LongSliceFlags.fields.slice_sao_chroma_flag ||
+             !slc.LongSliceFlags.fields.slice_deblocking_filter_disabled_flag))
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(flag));
+            slc.LongSliceFlags.fields.slice_loop_filter_across_slices_enabled_flag = flag;
+        }
+    }
+
+    slc.slice_data_size       = sliceDataSize;
+    slc.slice_data_offset     = sliceDataOffset;
+    slc.slice_chopping        = sliceChopping;
+    slc.slice_segment_address = sliceSegmentAddress;
+
+    slc.num_entry_point_offsets  = 0;
+    slc.EntryOffsetToSubsetArray = 0;
+    if (pic.tiles_enabled_flag || pic.entropy_coding_sync_enabled_flag)
+    {
+        uint32_t numEntryPointOffsets = 0;
+        HOST_PARSE_CHK_STATUS(reader.ReadUe(numEntryPointOffsets));
+        HOST_PARSE_CHK_COND(subsetOffset + numEntryPointOffsets > sizeof(subsetParams.entry_point_offset_minus1) / sizeof(uint32_t),
+                            "Entry points exceed subset array!");
+
+        slc.num_entry_point_offsets  = (uint16_t)numEntryPointOffsets;
+        slc.EntryOffsetToSubsetArray = (uint16_t)subsetOffset;
+
+        if (numEntryPointOffsets > 0)
+        {
+            uint32_t offsetLenMinus1 = 0;
+            HOST_PARSE_CHK_STATUS(reader.ReadUe(offsetLenMinus1));
+            HOST_PARSE_CHK_COND(offsetLenMinus1 > 31, "offset_len_minus1 out of range!");
+            for (uint32_t i = 0; i < numEntryPointOffsets; i++)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadBits(offsetLenMinus1 + 1, subsetParams.entry_point_offset_minus1[subsetOffset++]));
+            }
+        }
+    }
+
+    if (pic.slice_segment_header_extension_present_flag)
+    {
+        uint32_t extLength = 0;
+        HOST_PARSE_CHK_STATUS(reader.ReadUe(extLength));
+        HOST_PARSE_CHK_COND(extLength > 256, "slice_segment_header_extension_length out of range!");
+        HOST_PARSE_CHK_STATUS(reader.SkipBits(extLength * 8));
+    }
+
+    HOST_PARSE_CHK_STATUS(reader.ByteAlignment());
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::SkipLongTermRefPics(BitReader &reader, const CODEC_HEVC_PIC_PARAMS &pic)
+{
+    DECODE_FUNC_CALL();
+
+    uint32_t numLongTermSps  = 0;
+    uint32_t numLongTermPics = 0;
+    if (pic.num_long_term_ref_pic_sps > 0)
+    {
+        HOST_PARSE_CHK_STATUS(reader.ReadUe(numLongTermSps));
+        HOST_PARSE_CHK_COND(numLongTermSps > pic.num_long_term_ref_pic_sps, "num_long_term_sps out of range!");
+    }
+    HOST_PARSE_CHK_STATUS(reader.ReadUe(numLongTermPics));
+    HOST_PARSE_CHK_COND(numLongTermSps + numLongTermPics > 32, "Long term pictures out of range!");
+
+    uint8_t ltIdxSpsBits = CeilLog2(pic.num_long_term_ref_pic_sps);
+    uint8_t pocLsbBits   = pic.log2_max_pic_order_cnt_lsb_minus4 + 4;
+
+    for (uint32_t i = 0; i < numLongTermSps + numLongTermPics; i++)
+    {
+        if (i < numLongTermSps)
+        {
+            if (pic.num_long_term_ref_pic_sps > 1)
+            {
+                HOST_PARSE_CHK_STATUS(reader.SkipBits(ltIdxSpsBits));  // lt_idx_sps
+            }
+        }
+        else
+        {
+            HOST_PARSE_CHK_STATUS(reader.SkipBits(pocLsbBits + 1));    // poc_lsb_lt, used_by_curr_pic_lt_flag
+        }
+
+        bool deltaPocMsbPresent = false;
+        HOST_PARSE_CHK_STATUS(reader.ReadFlag(deltaPocMsbPresent));
+        if (deltaPocMsbPresent)
+        {
+            uint32_t deltaPocMsbCycleLt = 0;
+            HOST_PARSE_CHK_STATUS(reader.ReadUe(deltaPocMsbCycleLt));
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::ParseRefPicLists(
+    BitReader               &reader,
+    const PicContext        &ctx,
+    CODEC_HEVC_SLICE_PARAMS &slc,
+    bool                     isBSlice)
+{
+    DECODE_FUNC_CALL();
+
+    HOST_PARSE_CHK_COND(ctx.numPicTotalCurr == 0, "No reference picture for inter slice!");
+
+    bool    listModification[2] = {false, false};
+    uint8_t listEntry[2][CODEC_MAX_NUM_REF_FRAME_HEVC] = {};
+
+    // ref_pic_lists_modification()
+    if (ctx.picParams->lists_modification_present_flag && ctx.numPicTotalCurr > 1)
+    {
+        uint8_t  entryBits = CeilLog2(ctx.numPicTotalCurr);
+        uint32_t value     = 0;
+        for (uint32_t list = 0; list < (isBSlice ? 2u : 1u); list++)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadFlag(listModification[list]));
+            if (listModification[list])
+            {
+                uint32_t numActive = (list == 0 ? slc.num_ref_idx_l0_active_minus1 : slc.num_ref_idx_l1_active_minus1) + 1;
+                for (uint32_t i = 0; i < numActive; i++)
+                {
+                    HOST_PARSE_CHK_STATUS(reader.ReadBits(entryBits, value));
+                    HOST_PARSE_CHK_COND(value >= ctx.numPicTotalCurr, "list_entry out of range!");
+                    listEntry[list][i] = (uint8_t)value;
+                }
+            }
+        }
+    }
+
+    // Reference picture list construction, H.265 8.3.4
+    for (uint32_t list = 0; list < (isBSlice ? 2u : 1u); list++)
+    {
+        uint32_t numActive  = (list == 0 ? slc.num_ref_idx_l0_active_minus1 : slc.num_ref_idx_l1_active_minus1) + 1;
+        uint32_t numRpsTemp = MOS_MAX(numActive, ctx.numPicTotalCurr);
+
+        const uint8_t *first     = (list == 0) ? ctx.stCurrBefore : ctx.stCurrAfter;
+        const uint8_t *second    = (list == 0) ? ctx.stCurrAfter : ctx.stCurrBefore;
+        uint8_t        numFirst  = (list == 0) ? ctx.numPocStCurrBefore : ctx.numPocStCurrAfter;
+        uint8_t        numSecond = (list == 0) ? ctx.numPocStCurrAfter : ctx.numPocStCurrBefore;
+
+        uint8_t  listTemp[CODEC_MAX_NUM_REF_FRAME_HEVC * 2] = {};
+        uint32_t rIdx = 0;
+        HOST_PARSE_CHK_COND(numRpsTemp > sizeof(listTemp), "Reference list out of range!");
+        while (rIdx < numRpsTemp)
+        {
+            for (uint32_t i = 0; i < numFirst && rIdx < numRpsTemp; i++)
+            {
+                listTemp[rIdx++] = first[i];
+            }
+            for (uint32_t i = 0; i < numSecond && rIdx < numRpsTemp; i++)
+            {
+                listTemp[rIdx++] = second[i];
+            }
+            for (uint32_t i = 0; i < ctx.numPocLtCurr && rIdx < numRpsTemp; i++)
+            {
+                listTemp[rIdx++] = ctx.ltCurr[i];
+            }
+        }
+
+        for (uint32_t i = 0; i < numActive; i++)
+        {
+            slc.RefPicList[list][i].FrameIdx = listModification[list] ? listTemp[listEntry[list][i]] : listTemp[i];
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS HevcSliceHeaderParser::ParsePredWeightTable(
+    BitReader                    &reader,
+    const PicContext             &ctx,
+    CODEC_HEVC_SLICE_PARAMS      &slc,
+    PCODEC_HEVC_EXT_SLICE_PARAMS  extSlc,
+    bool                          isBSlice)
+{
+    DECODE_FUNC_CALL();
+
+    uint32_t value  = 0;
+    int32_t  sValue = 0;
+
+    HOST_PARSE_CHK_STATUS(reader.ReadUe(value));
+    HOST_PARSE_CHK_COND(value > 7, "luma_log2_weight_denom out of range!");
+    slc.luma_log2_weight_denom = (uint8_t)value;
+
+    int32_t chromaLog2WeightDenom = 0;
+    if (ctx.chromaArrayType != 0)
+    {
+        HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+        chromaLog2WeightDenom = slc.luma_log2_weight_denom + sValue;
+        HOST_PARSE_CHK_COND(chromaLog2WeightDenom < 0 || chromaLog2WeightDenom > 7, "ChromaLog2WeightDenom out of range!");
+        slc.delta_chroma_log2_weight_denom = (uint8_t)sValue;
+    }
+
+    bool highPrecisionOffsets = ctx.extPicParams != nullptr &&
+                                ctx.extPicParams->PicRangeExtensionFlags.fields.high_precision_offsets_enabled_flag;
+    int32_t wpOffsetHalfRangeC = 1 << (highPrecisionOffsets ? (ctx.picParams->bit_depth_chroma_minus8 + 7) : 7);
+
+    for (uint32_t list = 0; list < (isBSlice ? 2u : 1u); list++)
+    {
+        uint32_t numActive = (list == 0 ? slc.num_ref_idx_l0_active_minus1 : slc.num_ref_idx_l1_active_minus1) + 1;
+
+        char (&deltaLumaWeight)[15]      = (list == 0) ? slc.delta_luma_weight_l0 : slc.delta_luma_weight_l1;
+        char (&lumaOffset)[15]           = (list == 0) ? slc.luma_offset_l0 : slc.luma_offset_l1;
+        char (&deltaChromaWeight)[15][2] = (list == 0) ? slc.delta_chroma_weight_l0 : slc.delta_chroma_weight_l1;
+        char (&chromaOffset)[15][2]      = (list == 0) ? slc.ChromaOffsetL0 : slc.ChromaOffsetL1;
+
+        uint32_t lumaWeightFlags   = 0;
+        uint32_t chromaWeightFlags = 0;
+        // Current picture is never a reference for non-SCC, so all flags are present
+        HOST_PARSE_CHK_STATUS(reader.ReadBits(numActive, lumaWeightFlags));
+        if (ctx.chromaArrayType != 0)
+        {
+            HOST_PARSE_CHK_STATUS(reader.ReadBits(numActive, chromaWeightFlags));
+        }
+
+        for (uint32_t i = 0; i < numActive; i++)
+        {
+            uint32_t bit = 1u << (numActive - 1 - i);
+            if (lumaWeightFlags & bit)
+            {
+                HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+                deltaLumaWeight[i] = (char)sValue;
+                HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+                if (extSlc != nullptr)
+                {
+                    (list == 0 ? extSlc->luma_offset_l0 : extSlc->luma_offset_l1)[i] = (int16_t)sValue;
+                }
+                else
+                {
+                    lumaOffset[i] = (char)sValue;
+                }
+            }
+            if (chromaWeightFlags & bit)
+            {
+                for (uint32_t j = 0; j < 2; j++)
+                {
+                    HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+                    deltaChromaWeight[i][j] = (char)sValue;
+                    int32_t chromaWeight = (1 << chromaLog2WeightDenom) + sValue;
+
+                    HOST_PARSE_CHK_STATUS(reader.ReadSe(sValue));
+                    int32_t offset = (wpOffsetHalfRangeC - ((wpOffsetHalfRangeC * chromaWeight) >> chromaLog2WeightDenom)) + sValue;
+                    offset = MOS_CLAMP_MIN_MAX(offset, -wpOffsetHalfRangeC, wpOffsetHalfRangeC - 1);
+                    if (extSlc != nullptr)
+                    {
+                        (list == 0 ? extSlc->ChromaOffsetL0 : extSlc->ChromaOffsetL1)[i][j] = (int16_t)offset;
+                    }
+                    else
+                    {
+                        chromaOffset[i][j] = (char)offset;
+                    }
+                }
+            }
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+}  // namespace decode
@@ -0,0 +1,181 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_hevc_slice_header_parser.h
+//! \brief    Defines the host side slice segment header parser for hevc short format decode
+//! \details  The parser converts short format slice data into the same long format slice
+//!           parameters which HuC S2L generates, so that low slice count pictures can skip
+//!           the HuC pass and go through the long format HCP path directly.
+//!
+#ifndef __DECODE_HEVC_SLICE_HEADER_PARSER_H__
+#define __DECODE_HEVC_SLICE_HEADER_PARSER_H__
+
+#include "codec_def_decode_hevc.h"
+#include "media_class_trace.h"
+
+namespace decode
+{
+
+class HevcSliceHeaderParser
+{
+public:
+    //!
+    //! \brief  Bit reader for slice segment header, removes emulation prevention bytes on the fly
+    //!
+    class BitReader
+    {
+    public:
+        BitReader(const uint8_t *data, uint32_t size) : m_data(data), m_size(size) {}
+
+        MOS_STATUS ReadBits(uint32_t numBits, uint32_t &value);
+        MOS_STATUS ReadFlag(bool &flag);
+        MOS_STATUS ReadUe(uint32_t &value);
+        MOS_STATUS ReadSe(int32_t &value);
+        MOS_STATUS SkipBits(uint32_t numBits);
+        MOS_STATUS ByteAlignment();
+
+        //! \brief  Bytes consumed from the raw buffer, emulation prevention bytes included
+        uint32_t GetRawBytePos() const { return m_pos; }
+        //! \brief  Number of emulation prevention bytes removed so far
+        uint32_t GetEmuPrevnBytes() const { return m_emuPrevnBytes; }
+        bool     IsByteAligned() const { return m_bitsLeft == 0; }
+
+    protected:
+        MOS_STATUS LoadByte();
+
+        const uint8_t *m_data          = nullptr;
+        uint32_t       m_size          = 0;
+        uint32_t       m_pos           = 0;   //!< Next raw byte to load
+        uint32_t       m_zeroCount     = 0;   //!< Consecutive zero bytes before m_pos
+        uint32_t       m_emuPrevnBytes = 0;
+        uint8_t        m_curByte       = 0;
+        uint8_t        m_bitsLeft      = 0;   //!< Unread bits in m_curByte
+    };
+
+    //!
+    //! \brief  HevcSliceHeaderParser constructor
+    //!
+    HevcSliceHeaderParser() {}
+
+    //!
+    //! \brief  HevcSliceHeaderParser deconstructor
+    //!
+    virtual ~HevcSliceHeaderParser() {}
+
+    //!
+    //! \brief  Check if the picture can be parsed on host
+    //! \param  [in] picParams
+    //!         Picture parameters
+    //! \param  [in] sccPicParams
+    //!         SCC picture parameters, nullptr if not SCC
+    //! \return bool
+    //!         true if supported, else false
+    //!
+    static bool IsSupported(const CODEC_HEVC_PIC_PARAMS &picParams, const CODEC_HEVC_SCC_PIC_PARAMS *sccPicParams);
+
+    //!
+    //! \brief  Parse slice segment headers of one picture into long format parameters
+    //! \param  [in] bitstream
+    //!         CPU view of the picture bitstream, slice_data_offset is relative to it
+    //! \param  [in] bitstreamSize
+    //!         Size of bitstream in bytes
+    //! \param  [in] picParams
+    //!         Picture parameters
+    //! \param  [in] extPicParams
+    //!         Range extension picture parameters, can be nullptr
+    //! \param  [in,out] sliceParams
+    //!         Slice parameters, slice_data_offset and slice_data_size are input, long format fields are output
+    //! \param  [out] extSliceParams
+    //!         Range extension slice parameters, can be nullptr
+    //! \param  [out] subsetParams
+    //!         Entry point offsets for all slices
+    //! \param  [in] numSlices
+    //!         Number of slices
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ParsePicture(
+        const uint8_t                    *bitstream,
+        uint32_t                          bitstreamSize,
+        const CODEC_HEVC_PIC_PARAMS      &picParams,
+        const CODEC_HEVC_EXT_PIC_PARAMS  *extPicParams,
+        PCODEC_HEVC_SLICE_PARAMS          sliceParams,
+        PCODEC_HEVC_EXT_SLICE_PARAMS      extSliceParams,
+        CODEC_HEVC_SUBSET_PARAMS         &subsetParams,
+        uint32_t                          numSlices);
+
+protected:
+    //!
+    //! \brief  Per picture values derived from picture parameters
+    //!
+    struct PicContext
+    {
+        const CODEC_HEVC_PIC_PARAMS     *picParams          = nullptr;
+        const CODEC_HEVC_EXT_PIC_PARAMS *extPicParams       = nullptr;
+        uint8_t                          sliceAddrBits      = 0;
+        uint8_t                          chromaArrayType    = 0;
+        uint8_t                          numPocStCurrBefore = 0;
+        uint8_t                          numPocStCurrAfter  = 0;
+        uint8_t                          numPocLtCurr       = 0;
+        uint8_t                          numPicTotalCurr    = 0;
+        uint8_t                          stCurrBefore[8]    = {};   //!< Index to RefFrameList, nearest first
+        uint8_t                          stCurrAfter[8]     = {};   //!< Index to RefFrameList, nearest first
+        uint8_t                          ltCurr[8]          = {};   //!< Index to RefFrameList
+    };
+
+    MOS_STATUS InitPicContext(
+        const CODEC_HEVC_PIC_PARAMS     &picParams,
+        const CODEC_HEVC_EXT_PIC_PARAMS *extPicParams,
+        PicContext                      &ctx);
+
+    MOS_STATUS ParseSlice(
+        BitReader                    &reader,
+        const PicContext             &ctx,
+        CODEC_HEVC_SLICE_PARAMS      &slc,
+        PCODEC_HEVC_EXT_SLICE_PARAMS  extSlc,
+        const CODEC_HEVC_SLICE_PARAMS *indepSlc,
+        CODEC_HEVC_SUBSET_PARAMS     &subsetParams,
+        uint32_t                     &subsetOffset);
+
+    MOS_STATUS SkipLongTermRefPics(BitReader &reader, const CODEC_HEVC_PIC_PARAMS &picParams);
+
+    MOS_STATUS ParseRefPicLists(
+        BitReader               &reader,
+        const PicContext        &ctx,
+        CODEC_HEVC_SLICE_PARAMS &slc,
+        bool                     isBSlice);
+
+    MOS_STATUS ParsePredWeightTable(
+        BitReader                    &reader,
+        const PicContext             &ctx,
+        CODEC_HEVC_SLICE_PARAMS      &slc,
+        PCODEC_HEVC_EXT_SLICE_PARAMS  extSlc,
+        bool                          isBSlice);
+
+    static uint8_t CeilLog2(uint32_t value);
+
+MEDIA_CLASS_DEFINE_END(decode__HevcSliceHeaderParser)
+};
+
+}  // namespace decode
+
+#endif  // !__DECODE_HEVC_SLICE_HEADER_PARSER_H__
@@ -27,6 +27,7 @@ set(SOFTLET_DECODE_HEVC_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_mv_buffers.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_tile_coding.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_downsampling_feature.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_slice_header_parser.cpp
 )
 
 set(SOFTLET_DECODE_HEVC_HEADERS_
@@ -37,6 +38,7 @@ set(SOFTLET_DECODE_HEVC_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_mv_buffers.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_tile_coding.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_downsampling_feature.h
+    ${CMAKE_CURRENT_LIST_DIR}/decode_hevc_slice_header_parser.h
 )
 
 source_group( CodecHalNext\\Shared\\Decode FILES ${SOFTLET_DECODE_HEVC_SOURCES_} ${SOFTLET_DECODE_HEVC_HEADERS_} )
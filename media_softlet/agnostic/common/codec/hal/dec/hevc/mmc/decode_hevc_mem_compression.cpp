@@ -186,6 +186,9 @@ MOS_STATUS HevcDecodeMemComp::CheckReferenceList(HevcBasicFeature &hevcBasicFeat
 
     if(!sameMmcStatus)
     {
+        // Decompress all compressed references of the frame with one submission
+        PMOS_RESOURCE decompResources[CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC] = {};
+        uint32_t      decompCount = 0;
         for (uint8_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_HEVC; i++)
         {
             if (presReferences[i] != nullptr)
@@ -195,10 +198,14 @@ MOS_STATUS HevcDecodeMemComp::CheckReferenceList(HevcBasicFeature &hevcBasicFeat
                     m_osInterface, presReferences[i], &mmcMode));
                 if(mmcMode != MOS_MEMCOMP_DISABLED)
                 {
-                    m_osInterface->pfnDecompResource(m_osInterface, presReferences[i]);
+                    decompResources[decompCount++] = presReferences[i];
                 }
             }
         }
+        if (decompCount > 0)
+        {
+            m_osInterface->pfnDecompResourceBatch(m_osInterface, decompResources, decompCount);
+        }
     }
 
     return MOS_STATUS_SUCCESS;
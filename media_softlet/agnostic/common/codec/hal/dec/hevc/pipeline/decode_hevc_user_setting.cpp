@@ -67,6 +67,18 @@ MOS_STATUS HevcPipeline::InitUserSetting(MediaUserSettingSharedPtr userSettingPt
         MediaUserSetting::Group::Sequence,
         int32_t(0),
         true);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "HEVC Decode Host Slice Parse Enable",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        true);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "HEVC Decode Host Slice Parse Max Slices",
+        MediaUserSetting::Group::Sequence,
+        int32_t(8),
+        true);
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
@@ -43,8 +43,13 @@ DecodeAllocator::DecodeAllocator(PMOS_INTERFACE osInterface, bool limitedLMemBar
     m_osInterface(osInterface), m_limitedLMemBar(limitedLMemBar)
 {
     m_allocator = MOS_New(Allocator, m_osInterface);
+
+    auto userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+    m_lazyCommit        = ReadUserFeature(userSettingPtr, "Decode Lazy Commit", MediaUserSetting::Group::Sequence).Get<bool>();
+    uint32_t budgetInMB = ReadUserFeature(userSettingPtr, "Media Memory Budget", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+    Allocator::SetMemoryBudget((uint64_t)budgetInMB << 20);
 #if (_DEBUG || _RELEASE_INTERNAL)
-    m_forceLockable = ReadUserFeature(m_osInterface->pfnGetUserSettingInstance(m_osInterface), "ForceDecodeResourceLockable", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+    m_forceLockable = ReadUserFeature(userSettingPtr, "ForceDecodeResourceLockable", MediaUserSetting::Group::Sequence).Get<uint32_t>();
 #endif
 }
 
@@ -536,6 +536,20 @@ public:
     //!
     ResourceUsage ConvertGmmResourceUsage(const GMM_RESOURCE_USAGE_TYPE gmmResUsage);
 
+    //!
+    //! \brief    Check if reference associated buffers are committed on first use
+    //! \details  When enabled, buffer pools skip the initial allocation and release
+    //!           buffers which stay idle, see RefrenceAssociatedBuffer
+    //! \return   bool
+    //!
+    bool IsLazyCommitEnabled() { return m_lazyCommit; }
+
+    //!
+    //! \brief    Check if media memory of the process exceeds the budget
+    //! \return   bool
+    //!
+    bool IsOverBudget() { return Allocator::IsOverBudget(); }
+
 protected:
     //!
     //! \brief    Apply resource access requirement to allocate parameters
@@ -551,6 +565,7 @@ protected:
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
     Allocator *m_allocator = nullptr;
     bool m_limitedLMemBar = false; //!< Indicate if running with limited LMem bar config
+    bool m_lazyCommit = false;     //!< Indicate if reference associated buffers are committed on first use
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     bool m_forceLockable = false;
@@ -29,6 +29,7 @@
 #ifndef __DECODE_REFRENCE_ASSOCIATED_BUFFER_H__
 #define __DECODE_REFRENCE_ASSOCIATED_BUFFER_H__
 
+#include <algorithm>
 #include "decode_allocator.h"
 #include "decode_utils.h"
 #include "codec_hw_next.h"
@@ -89,6 +90,7 @@ public:
             m_bufferOp.Destroy(buf);
         }
         m_availableBuffers.clear();
+        m_idleFrames.clear();
     }
 
     //!
@@ -100,7 +102,8 @@ public:
     //! \param  [in] basicFeature
     //!         Basic feature
     //! \param  [in] initialAllocNum
-    //!         The number of buffers allocated when initialize
+    //!         The number of buffers allocated when initialize, ignored if lazy commit
+    //!         is enabled, the buffers are allocated on first use instead
     //! \return  MOS_STATUS
     //!         MOS_STATUS_SUCCESS if success, else fail reason
     //!
@@ -114,6 +117,12 @@ public:
         DECODE_ASSERT(m_availableBuffers.empty());
         DECODE_ASSERT(m_activeBuffers.empty());
 
+        m_lazyCommit = allocator.IsLazyCommitEnabled();
+        if (m_lazyCommit)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+
         for (uint32_t i = 0; i < initialAllocNum; i++)
         {
             BufferType *buffer = m_bufferOp.Allocate();
@@ -142,6 +151,10 @@ public:
 
         DECODE_CHK_STATUS(UpdateRefList(curFrameIdx, refFrameList, fixedFrameIdx));
         DECODE_CHK_STATUS(ActiveCurBuffer(curFrameIdx));
+        if (m_lazyCommit)
+        {
+            DECODE_CHK_STATUS(ReleaseIdleBuffers());
+        }
 
         return MOS_STATUS_SUCCESS;
     }
@@ -224,6 +237,9 @@ public:
             }
         }
 
+        // Buffer is used by current frame, it is not idle
+        m_idleFrames.erase(buffer);
+
         return buffer;
     }
 
@@ -257,6 +273,7 @@ public:
             if (m_bufferOp.IsAvailable(*iter))
             {
                 m_currentBuffer = *iter;
+                m_idleFrames.erase(m_currentBuffer);
                 m_availableBuffers.erase((++iter).base());
                 break;
             }
@@ -278,6 +295,61 @@ public:
     }
 
 protected:
+    //!
+    //! \brief  Release available buffers which are idle for a while, or all the idle
+    //!         buffers if media memory of the process exceeds the budget
+    //! \return  MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReleaseIdleBuffers()
+    {
+        DECODE_FUNC_CALL();
+
+        DECODE_CHK_NULL(m_bufferOp.m_allocator);
+        bool overBudget = m_bufferOp.m_allocator->IsOverBudget();
+
+        // Drop counters of buffers which left the available list, so that a freed
+        // buffer never leaves a key another allocation could reuse
+        auto idle = m_idleFrames.begin();
+        while (idle != m_idleFrames.end())
+        {
+            if (std::find(m_availableBuffers.begin(), m_availableBuffers.end(), idle->first) == m_availableBuffers.end())
+            {
+                idle = m_idleFrames.erase(idle);
+            }
+            else
+            {
+                ++idle;
+            }
+        }
+
+        uint32_t releaseNum = 0;
+        auto     iter       = m_availableBuffers.begin();
+        while (iter != m_availableBuffers.end())
+        {
+            uint32_t idleFrames = ++m_idleFrames[*iter];
+            if ((overBudget || idleFrames > m_maxIdleFrames) && m_bufferOp.IsAvailable(*iter))
+            {
+                m_idleFrames.erase(*iter);
+                m_bufferOp.Destroy(*iter);
+                iter = m_availableBuffers.erase(iter);
+                releaseNum++;
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        if (releaseNum > 0)
+        {
+            DECODE_VERBOSEMESSAGE("Released %d idle reference associated buffers, %d buffers in pool",
+                releaseNum, (uint32_t)(m_activeBuffers.size() + m_availableBuffers.size()));
+        }
+
+        return MOS_STATUS_SUCCESS;
+    }
+
     //!
     //! \brief  Update buffers corresponding to reference list
     //! \param  [in] curFrameIdx
@@ -354,6 +426,10 @@ protected:
     std::map<uint32_t, BufferType*> m_activeBuffers;           //!< Active buffers corresponding to current reference frame list
     std::vector<BufferType*>        m_availableBuffers;        //!< Buffers in idle
     BufferType*                     m_currentBuffer = nullptr; //!< Point to buffer of current picture
+    std::map<BufferType*, uint32_t> m_idleFrames;              //!< Number of frames the available buffers stay idle
+    bool                            m_lazyCommit = false;      //!< Allocate buffers on first use and release idle ones
+
+    static constexpr uint32_t       m_maxIdleFrames = 32;      //!< Idle buffers are released after this number of frames
 
 MEDIA_CLASS_DEFINE_END(decode__RefrenceAssociatedBuffer)
 };
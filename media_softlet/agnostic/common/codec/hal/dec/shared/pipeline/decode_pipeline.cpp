@@ -202,6 +202,18 @@ MOS_STATUS DecodePipeline::Initialize(void *settings)
     mhw::HwcmdParser::InitInstance(m_osInterface, mhw::HwcmdParser::AddOnMode::NoAddOn);
 #endif
 
+    // Decoded frames can share one submission with the encode frames pending on the device
+    bool submitBatchingEnabled = ReadUserFeature(m_userSettingPtr, "Decode Submit Batching Enable", MediaUserSetting::Group::Sequence).Get<bool>();
+    if (submitBatchingEnabled && m_decodecp == nullptr)
+    {
+        uint32_t maxBatchFrames = ReadUserFeature(m_userSettingPtr, "Decode Submit Batching Max Frames", MediaUserSetting::Group::Sequence).Get<uint32_t>();
+        if (maxBatchFrames > 1)
+        {
+            m_submitBatcher = MediaSubmitBatcher::Attach(m_osInterface, MOS_GPU_NODE_VIDEO, maxBatchFrames);
+            DECODE_NORMALMESSAGE("Submit batching %s", m_submitBatcher ? "enabled" : "disabled");
+        }
+    }
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -209,6 +221,10 @@ MOS_STATUS DecodePipeline::Uninitialize()
 {
     DECODE_FUNC_CALL();
 
+    // Pending frames of other streams are flushed with the scalability of this stream, detach before media context is deleted
+    MediaSubmitBatcher::Detach(m_submitBatcher, m_osInterface, m_scalability);
+    m_submitBatcher = nullptr;
+
     // Wait all cmd completion before delete resource.
     m_osInterface->pfnWaitAllCmdCompletion(m_osInterface);
 
@@ -308,6 +324,18 @@ MOS_STATUS DecodePipeline::Prepare(void *params)
     return MOS_STATUS_SUCCESS;
 }
 
+bool DecodePipeline::IsSubmitBatchingActive()
+{
+    if (m_submitBatcher == nullptr || m_scalability == nullptr)
+    {
+        return false;
+    }
+
+    // Decode frame completion is reported by the status update commands in the frame,
+    // virtual engine frames are split into several command buffers.
+    return m_scalability->GetPipeNumber() == 1;
+}
+
 MOS_STATUS DecodePipeline::ExecuteActivePackets()
 {
     DECODE_FUNC_CALL();
@@ -316,16 +344,25 @@ MOS_STATUS DecodePipeline::ExecuteActivePackets()
     // Last element in m_activePacketList must be immediately submitted
     m_activePacketList.back().immediateSubmit = true;
 
+    bool submitBatched = IsSubmitBatchingActive();
+
     for (PacketProperty prop : m_activePacketList)
     {
         prop.stateProperty.singleTaskPhaseSupported = m_singleTaskPhaseSupported;
         prop.stateProperty.statusReport = m_statusReport;
+        if (submitBatched)
+        {
+            prop.frameTrackingRequested = false;
+        }
         MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_INFO, &prop.packetId, sizeof(uint32_t), nullptr, 0);
 
         MediaTask *task = prop.packet->GetActiveTask();
         DECODE_CHK_STATUS(task->AddPacket(&prop));
         if (prop.immediateSubmit)
         {
+            // The decoded surface can be synced right after the frame, so the decoded frame
+            // closes the batch with the frames pending before it.
+            task->SetSubmitBatcher(submitBatched ? m_submitBatcher : nullptr, true);
             DECODE_CHK_STATUS(task->Submit(true, m_scalability, m_debugInterface));
         }
     }
@@ -42,6 +42,7 @@
 #include "decode_mem_compression.h"
 #include "decode_downsampling_feature.h"
 #include "codechal_oca_debug.h"
+#include "media_submit_batcher.h"
 
 namespace decode {
 
@@ -357,6 +358,13 @@ protected:
     //!
     virtual MOS_STATUS CreateStatusReport();
 
+    //!
+    //! \brief  Check if the frames of current pipeline can go through submit batcher
+    //! \return bool
+    //!         true if submit batching is active, else false
+    //!
+    bool IsSubmitBatchingActive();
+
     //!
     //! \brief  Finish the active packets execution
     //! \return MOS_STATUS
@@ -529,6 +537,8 @@ protected:
 
     PMOS_SURFACE            m_tempOutputSurf = nullptr;
 
+    MediaSubmitBatcher     *m_submitBatcher = nullptr;  //!< Submit batcher shared with encode streams on the device
+
 MEDIA_CLASS_DEFINE_END(decode__DecodePipeline)
 };
 
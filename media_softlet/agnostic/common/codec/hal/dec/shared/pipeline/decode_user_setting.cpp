@@ -38,6 +38,24 @@ MOS_STATUS DecodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         MediaUserSetting::Group::Sequence,
         int32_t(0),
         false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Lazy Commit",
+        MediaUserSetting::Group::Sequence,
+        false,
+        false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Submit Batching Enable",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Submit Batching Max Frames",
+        MediaUserSetting::Group::Sequence,
+        int32_t(4),
+        false);
     DeclareUserSettingKey(
         userSettingPtr,
         "DisableAv1BtdlRowstoreCache",
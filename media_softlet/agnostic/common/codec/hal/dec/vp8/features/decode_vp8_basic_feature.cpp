@@ -116,7 +116,16 @@ MOS_STATUS Vp8BasicFeature::SetPictureStructs(CodechalDecodeParams *decodeParams
     if (decodeParams->m_bitstreamLockingInUse)
     {
         DECODE_CHK_STATUS(AllocateCoefProbBuffer());
-        if (decodeParams->m_bitstreamLockable)
+
+        // Host copy avoids read locking bitstream buffer which may wait for GPU and read from uncached memory
+        const uint8_t *hostData = decodeParams->m_bitstreamHostData;
+        uint32_t       hostSize = decodeParams->m_bitstreamHostSize;
+        if (hostData != nullptr && hostSize >= m_dataOffset + 3 &&
+            hostSize - m_dataOffset >= CodecVp8GetFrameHeadSize(hostData + m_dataOffset, m_dataSize))
+        {
+            DECODE_CHK_STATUS(ParseFrameHead(const_cast<uint8_t *>(hostData) + m_dataOffset, hostSize - m_dataOffset));
+        }
+        else if (decodeParams->m_bitstreamLockable)
         {
             ResourceAutoLock resLock(m_allocator, &m_resDataBuffer.OsResource);
             auto             bitstreamBuffer = (uint8_t *)resLock.LockResourceForRead();
@@ -170,7 +179,7 @@ MOS_STATUS Vp8BasicFeature::ParseFrameHead(uint8_t *bitstreamBuffer, uint32_t bi
 
     DECODE_CHK_NULL(bitstreamBuffer);
 
-    m_vp8EntropyState.Initialize(&m_vp8FrameHead, bitstreamBuffer, bitstreamBufferSize);
+    m_vp8EntropyState.Initialize(&m_vp8FrameHead, bitstreamBuffer, bitstreamBufferSize, m_dataSize);
 
     eStatus = m_vp8EntropyState.ParseFrameHead(m_vp8PicParams);
 
@@ -0,0 +1,81 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_vp8_bool_decoder.cpp
+//! \brief    Implements the boolean entropy decoder used to parse vp8 frame head
+//!
+
+#include "decode_vp8_bool_decoder.h"
+
+namespace decode
+{
+
+void Vp8BoolDecoder::Init(const uint8_t *data, uint32_t size)
+{
+    m_buffer    = data;
+    m_bufferEnd = data + size;
+    m_value     = 0;
+    m_count     = -CHAR_BIT;
+    m_range     = 255;
+    m_bitPos    = 0;
+
+    Fill();
+}
+
+void Vp8BoolDecoder::Fill()
+{
+    // Bit position in window for next byte
+    int32_t  shift     = m_windowBits - CHAR_BIT - (m_count + CHAR_BIT);
+    uint32_t bytesLeft = (uint32_t)(m_bufferEnd - m_buffer);
+
+    if (bytesLeft >= sizeof(uint64_t))
+    {
+        uint64_t bigEndian = 0;
+        for (uint32_t i = 0; i < sizeof(uint64_t); i++)
+        {
+            bigEndian = (bigEndian << CHAR_BIT) | m_buffer[i];
+        }
+
+        // Whole bytes which fit into the free bits of window
+        int32_t bits = (shift & ~(CHAR_BIT - 1)) + CHAR_BIT;
+        m_value |= (bigEndian >> (m_windowBits - bits)) << (shift & (CHAR_BIT - 1));
+        m_count += bits;
+        m_buffer += bits / CHAR_BIT;
+        return;
+    }
+
+    while (shift >= 0 && m_buffer < m_bufferEnd)
+    {
+        m_value |= (uint64_t)*m_buffer << shift;
+        m_count += CHAR_BIT;
+        shift -= CHAR_BIT;
+        ++m_buffer;
+    }
+
+    if (shift >= 0)
+    {
+        // Data is exhausted, the window is padded with 0
+        m_count += m_lotsOfBits;
+    }
+}
+
+}  // namespace decode
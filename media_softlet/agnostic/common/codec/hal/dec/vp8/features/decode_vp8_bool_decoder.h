@@ -0,0 +1,160 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     decode_vp8_bool_decoder.h
+//! \brief    Defines the boolean entropy decoder used to parse vp8 frame head
+//! \details  The decoder keeps a 64 bits window of the bitstream which is refilled
+//!           7 bytes at a time. The entropy state reported to HW is derived from the
+//!           number of consumed bits, so it is the same as the one of the byte based
+//!           32 bits decoder ported from libvpx.
+//!
+#ifndef __DECODE_VP8_BOOL_DECODER_H__
+#define __DECODE_VP8_BOOL_DECODER_H__
+
+#include <limits.h>
+#include <stdint.h>
+#include "codec_def_vp8_probs.h"
+#include "media_class_trace.h"
+
+namespace decode
+{
+
+class Vp8BoolDecoder
+{
+public:
+    //!
+    //! \brief  Vp8BoolDecoder constructor
+    //!
+    Vp8BoolDecoder() {}
+
+    //!
+    //! \brief  Vp8BoolDecoder deconstructor
+    //!
+    ~Vp8BoolDecoder() {}
+
+    //!
+    //! \brief  Start decoding the partition
+    //! \param  [in] data
+    //!         Start of the partition, may be nullptr if size is 0
+    //! \param  [in] size
+    //!         Bytes which can be read from data, bits beyond are decoded as 0
+    //!
+    void Init(const uint8_t *data, uint32_t size);
+
+    //!
+    //! \brief  Decode one bool
+    //! \param  [in] probability
+    //!         Probability of 0 in 1/256
+    //! \return uint32_t
+    //!         Decoded bool, 0 or 1
+    //!
+    uint32_t DecodeBool(uint32_t probability)
+    {
+        uint32_t split    = 1 + (((m_range - 1) * probability) >> 8);
+        uint64_t bigSplit = (uint64_t)split << (m_windowBits - 8);
+        uint32_t bit      = m_value >= bigSplit ? 1 : 0;
+
+        // The bool is hard to predict, so select the new range and value by mask
+        uint64_t mask = 0 - (uint64_t)bit;
+        m_range       = split + ((m_range - 2 * split) & (uint32_t)mask);
+        m_value      -= bigSplit & mask;
+
+        uint32_t shift = Norm[m_range];
+        m_range <<= shift;
+        m_value <<= shift;
+        m_count  -= shift;
+        m_bitPos += shift;
+
+        if (m_count < 0)
+        {
+            Fill();
+        }
+
+        return bit;
+    }
+
+    //!
+    //! \brief  Decode unsigned literal with probability 1/2, MSB first
+    //! \param  [in] bits
+    //!         Number of bits of the literal
+    //! \return uint32_t
+    //!
+    uint32_t DecodeLiteral(uint32_t bits)
+    {
+        uint32_t value = 0;
+        while (bits-- > 0)
+        {
+            value = (value << 1) | DecodeBool(m_probHalf);
+        }
+        return value;
+    }
+
+    //! \brief  Bits consumed by renormalization since Init()
+    uint32_t GetBitPos() const { return m_bitPos; }
+    //! \brief  Current range, in [128, 255]
+    uint32_t GetRange() const { return m_range; }
+    //! \brief  Top byte of the value window
+    uint8_t  GetValue() const { return (uint8_t)(m_value >> (m_windowBits - 8)); }
+
+    //!
+    //! \brief  Get number of bits HW still has to shift into the current value byte
+    //! \return uint8_t
+    //!         In [1, 8]
+    //!
+    uint8_t GetBitCount() const
+    {
+        return (uint8_t)(CHAR_BIT - ((0 - m_bitPos) & 7));
+    }
+
+    //!
+    //! \brief  Get offset of the first byte which is not fully loaded into the value byte
+    //! \return uint32_t
+    //!         Offset relative to the data passed to Init()
+    //!
+    uint32_t GetByteOffset() const
+    {
+        return (m_bitPos + CHAR_BIT) >> 3;
+    }
+
+protected:
+    //!
+    //! \brief  Load whole bytes into the free bits of the window
+    //!
+    void Fill();
+
+    static const int32_t  m_windowBits = 64;
+    static const uint32_t m_probHalf   = 128;
+    static const int32_t  m_lotsOfBits = 0x40000000;  //!< Added to count once data is exhausted to stop refilling
+
+    const uint8_t *m_buffer    = nullptr;  //!< Next byte to load
+    const uint8_t *m_bufferEnd = nullptr;
+    uint64_t       m_value     = 0;        //!< Window of bitstream, MSB aligned
+    int32_t        m_count     = 0;        //!< Valid bits in window minus 8
+    uint32_t       m_range     = 0;
+    uint32_t       m_bitPos    = 0;
+
+MEDIA_CLASS_DEFINE_END(decode__Vp8BoolDecoder)
+};
+
+}  // namespace decode
+
+#endif  // !__DECODE_VP8_BOOL_DECODER_H__
@@ -31,60 +31,6 @@
 
 namespace decode
 {
-    void Vp8EntropyState::DecodeFill()
-    {
-        int32_t        shift       = m_bdValueSize - 8 - (m_count + 8);
-        uint32_t       bytesLeft   = (uint32_t)(m_bufferEnd - m_buffer);
-        uint32_t       bitsLeft   = bytesLeft * CHAR_BIT;
-        int32_t        num         = (int32_t)(shift + CHAR_BIT - bitsLeft);
-        int32_t        loopEnd     = 0;
-
-        if (num >= 0)
-        {
-            m_count += m_lotsOfBits;
-            loopEnd = num;
-        }
-
-        if (num < 0 || bitsLeft)
-        {
-            while (shift >= loopEnd)
-            {
-                m_count += CHAR_BIT;
-                m_value |= (uint32_t)*m_buffer << shift;
-                ++m_buffer;
-                shift -= CHAR_BIT;
-            }
-        }
-    }
-
-    uint32_t Vp8EntropyState::DecodeBool(int32_t probability)
-    {
-        uint32_t split     = 1 + (((m_range - 1) * probability) >> 8);
-        uint32_t bigSplit  = (uint32_t)split << (m_bdValueSize - 8);
-        uint32_t origRange = m_range;
-        m_range            = split;
-
-        uint32_t bit = 0;
-        if (m_value >= bigSplit)
-        {
-            m_range = origRange - split;
-            m_value = m_value - bigSplit;
-            bit = 1;
-        }
-
-        int32_t shift = Norm[m_range];
-        m_range <<= shift;
-        m_value <<= shift;
-        m_count -= shift;
-
-        if (m_count < 0)
-        {
-            DecodeFill();
-        }
-
-        return bit;
-    }
-
     int32_t Vp8EntropyState::DecodeValue(int32_t bits)
     {
         int32_t retValue = 0;
@@ -133,18 +79,12 @@ namespace decode
 
     int32_t Vp8EntropyState::StartEntropyDecode()
     {
-        m_bufferEnd = m_dataBufferEnd;
-        m_buffer    = m_dataBuffer;
-        m_value     = 0;
-        m_count     = -8;
-        m_range     = 255;
-
-        if ((m_bufferEnd - m_buffer) > 0 && m_buffer == nullptr)
+        if (m_dataBufferEnd > m_dataBuffer && m_dataBuffer == nullptr)
         {
             return 1;
         }
 
-        DecodeFill();
+        m_boolDecoder.Init(m_dataBuffer, (uint32_t)(m_dataBufferEnd - m_dataBuffer));
 
         return 0;
     }
@@ -606,9 +546,10 @@ namespace decode
             ReadMvContexts(MVContext);
         }
 
-        vp8PicParams->ucP0EntropyCount = 8 - (m_count & 0x07);
-        vp8PicParams->ucP0EntropyValue = (uint8_t)(m_value >> 24);
-        vp8PicParams->uiP0EntropyRange = m_range;
+        vp8PicParams->ucP0EntropyCount = m_boolDecoder.GetBitCount();
+        vp8PicParams->ucP0EntropyValue = m_boolDecoder.GetValue();
+        vp8PicParams->uiP0EntropyRange = m_boolDecoder.GetRange();
+        uint32_t firstMbByteOffset     = (uint32_t)(m_dataBuffer - m_bitstreamBuffer) + m_boolDecoder.GetByteOffset();
 
         uint32_t firstPartitionAndUncompSize;
         if (m_frameHead->iFrameType == m_keyFrame)
@@ -634,10 +575,9 @@ namespace decode
             }
         }
 
-        uint32_t offsetCounter                      = ((m_count & 0x18) >> 3) + (((m_count & 0x07) != 0) ? 1 : 0);
-        vp8PicParams->uiFirstMbByteOffset           = (uint32_t)(m_buffer - m_bitstreamBuffer) - offsetCounter;
-        vp8PicParams->uiPartitionSize[0]            = firstPartitionAndUncompSize - (uint32_t)(m_buffer - m_bitstreamBuffer) + offsetCounter;
-        vp8PicParams->uiPartitionSize[partitionNum] = m_bitstreamBufferSize - firstPartitionAndUncompSize - (partitionNum - 1) * 3 - partitionSizeSum;
+        vp8PicParams->uiFirstMbByteOffset           = firstMbByteOffset;
+        vp8PicParams->uiPartitionSize[0]            = firstPartitionAndUncompSize - firstMbByteOffset;
+        vp8PicParams->uiPartitionSize[partitionNum] = m_bitstreamDataSize - firstPartitionAndUncompSize - (partitionNum - 1) * 3 - partitionSizeSum;
 
         return eStatus;
     }
@@ -660,13 +600,15 @@ namespace decode
     void Vp8EntropyState::Initialize(
         PCODECHAL_DECODE_VP8_FRAME_HEAD vp8FrameHeadIn,
         uint8_t*        bitstreamBufferIn,
-        uint32_t        bitstreamBufferSizeIn)
+        uint32_t        bitstreamBufferSizeIn,
+        uint32_t        bitstreamDataSizeIn)
         {
         m_frameHead           = vp8FrameHeadIn;
         m_dataBuffer          = bitstreamBufferIn;
         m_dataBufferEnd       = bitstreamBufferIn + bitstreamBufferSizeIn;
         m_bitstreamBuffer     = bitstreamBufferIn;
         m_bitstreamBufferSize = bitstreamBufferSizeIn;
+        m_bitstreamDataSize   = bitstreamDataSizeIn;
 
         m_frameHead->iFrameType                    = m_dataBuffer[0] & 1;
         m_frameHead->iVersion                      = (m_dataBuffer[0] >> 1) & 7;
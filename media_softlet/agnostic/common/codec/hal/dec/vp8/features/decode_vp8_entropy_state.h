@@ -30,6 +30,7 @@
 #include "mhw_vdbox.h"
 #include "decode_allocator.h"
 #include "codec_def_vp8_probs.h"
+#include "decode_vp8_bool_decoder.h"
 
 
 namespace decode
@@ -277,8 +278,6 @@ class Vp8EntropyState
 public:
     const uint8_t  m_keyFrame    = 0;                                        //!< VP8 Key Frame Flag
     const uint8_t  m_interFrame  = 1;                                        //!< VP8 Inter Frame Flag
-    const uint32_t m_bdValueSize = ((uint32_t)sizeof(uint32_t) * CHAR_BIT);  // VP8 BD Value Size
-    const uint32_t m_lotsOfBits  = 0x40000000;                               //!< Offset for parsing frame head
     const uint8_t  m_probHalf    = 128;                                      //!< VP8 Half Probability
 
     //!
@@ -298,13 +297,17 @@ public:
     //! \param    [in] bitstreamBufferIn
     //!           Pointer to VP8 bitstream buffer
     //! \param    [in] bitstreamBufferSizeIn
-    //!           VP8 bitstream buffer size
+    //!           Bytes which can be read from VP8 bitstream buffer, at least the
+    //!           uncompressed data chunk, first partition and partition sizes
+    //! \param    [in] bitstreamDataSizeIn
+    //!           VP8 frame size, used to calculate the last partition size
     //! \return   void
     //!
     void Initialize(
         PCODECHAL_DECODE_VP8_FRAME_HEAD vp8FrameHeadIn,
         uint8_t*        bitstreamBufferIn,
-        uint32_t        bitstreamBufferSizeIn);
+        uint32_t        bitstreamBufferSizeIn,
+        uint32_t        bitstreamDataSizeIn);
 
     //!
     //! \brief    Parse VP8 Frame Head
@@ -339,7 +342,7 @@ protected:
     //!
     //! \brief    Start Entropy Decode
     //! \return   int32_t
-    //!           1 if Buffer is empty or pointer is nullptr, else call DecodeFill and return 0
+    //!           1 if Buffer is empty or pointer is nullptr, else start bool decoder and return 0
     //!
     int32_t StartEntropyDecode();
 
@@ -362,17 +365,11 @@ protected:
     PCODECHAL_DECODE_VP8_FRAME_HEAD m_frameHead           = nullptr;  //!< Pointer to VP8 Frame Head
     uint8_t *                       m_bitstreamBuffer     = nullptr;  //!< Pointer to Bitstream Buffer
     uint32_t                        m_bitstreamBufferSize = 0;        //!< Size of Bitstream Buffer
+    uint32_t                        m_bitstreamDataSize   = 0;        //!< Size of VP8 frame
     uint8_t *                       m_dataBuffer          = nullptr;  //!< Pointer to Data Buffer
     uint8_t *                       m_dataBufferEnd       = nullptr;  //<! Pointer to Data Buffer End
 
 private:
-    //!
-    //! \brief    Update Entropy Decode State Info
-    //! \details  Calculate left bitstream size to update pointer info
-    //! \return   void
-    //!
-    void DecodeFill();
-
     //!
     //! \brief    Update Entropy Decode State according to probability
     //! \param    [in] probability
@@ -380,7 +377,10 @@ private:
     //! \return   uint32_t
     //!           return 1 if entropy decode value meets the requirement of probability, else 0
     //!
-    uint32_t DecodeBool(int32_t probability);
+    uint32_t DecodeBool(int32_t probability)
+    {
+        return m_boolDecoder.DecodeBool((uint32_t)probability);
+    }
 
     //!
     //! \brief    Update Entropy Decode State according to Bits Number
@@ -497,11 +497,7 @@ private:
     //!
     void QuantSetup();
 
-    const uint8_t *m_bufferEnd = nullptr;  //!< Pointer to Data Buffer End
-    const uint8_t *m_buffer = nullptr;     //!< Pointer to Data Buffer
-    int32_t        m_count = 0;      //!< Bits Count for Bitstream Buffer
-    uint32_t       m_value = 0;      //!< Entropy Value
-    uint32_t       m_range = 0;      //!< Entropy Range
+    Vp8BoolDecoder m_boolDecoder;  //!< Bool decoder of first partition
 
 MEDIA_CLASS_DEFINE_END(decode__Vp8EntropyState)
 };
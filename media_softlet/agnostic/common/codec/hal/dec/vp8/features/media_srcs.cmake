@@ -25,6 +25,7 @@ set(SOFTLET_DECODE_VP8_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_feature_manager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_basic_feature.cpp
     ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_entropy_state.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_bool_decoder.cpp
 )
 
 set(SOFTLET_DECODE_VP8_HEADERS_
@@ -33,6 +34,7 @@ set(SOFTLET_DECODE_VP8_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_feature_manager.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_basic_feature.h
     ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_entropy_state.h
+    ${CMAKE_CURRENT_LIST_DIR}/decode_vp8_bool_decoder.h
 )
 
 source_group( CodecHalNext\\Shared\\Decode FILES ${SOFTLET_DECODE_VP8_SOURCES_} ${SOFTLET_DECODE_VP8_HEADERS_} )
@@ -110,6 +110,9 @@ MOS_STATUS Vp9DecodeMemComp::CheckReferenceList(Vp9BasicFeature &vp9BasicFeature
 
     if (!sameMmcStatus)
     {
+        // Decompress all compressed references of the frame with one submission
+        PMOS_RESOURCE decompResources[CODECHAL_MAX_CUR_NUM_REF_FRAME_VP9] = {};
+        uint32_t      decompCount = 0;
         for (uint8_t i = 0; i < CODECHAL_MAX_CUR_NUM_REF_FRAME_VP9; i++)
         {
             if (presReferences[i])
@@ -120,12 +123,17 @@ MOS_STATUS Vp9DecodeMemComp::CheckReferenceList(Vp9BasicFeature &vp9BasicFeature
                     &mmcMode));
                 if (mmcMode != MOS_MEMCOMP_DISABLED)
                 {
-                    m_osInterface->pfnDecompResource(
-                        m_osInterface,
-                        presReferences[i]);
+                    decompResources[decompCount++] = presReferences[i];
                 }
             }
         }
+        if (decompCount > 0)
+        {
+            m_osInterface->pfnDecompResourceBatch(
+                m_osInterface,
+                decompResources,
+                decompCount);
+        }
     }
     return MOS_STATUS_SUCCESS;
 }
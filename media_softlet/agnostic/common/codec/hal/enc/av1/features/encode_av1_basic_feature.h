@@ -35,6 +35,7 @@
 #include "mhw_vdbox_avp_itf.h"
 #include "mhw_vdbox_huc_itf.h"
 #include "encode_mem_compression.h"
+#include "codec_av1_default_cdf.h"
 #if _MEDIA_RESERVED
 #include "codec_def_encode_av1_ext.h"
 #endif
@@ -54,16 +55,6 @@ inline bool IsFrameLossless(CODEC_AV1_ENCODE_PICTURE_PARAMS const &picPar)
     return (picPar.base_qindex == 0) && DeltaQIsZero(picPar);
 }
 
-MOS_STATUS InitDefaultFrameContextBuffer(
-    uint16_t                 *ctxBuffer,
-    uint8_t                  index,
-    Av1CdfTableSyntaxElement begin = partition8x8,
-    Av1CdfTableSyntaxElement end   = syntaxElementMax);
-
-MOS_STATUS SyntaxElementCdfTableInit(
-    uint16_t                    *ctxBuffer,
-    SyntaxElementCdfTableLayout SyntaxElement);
-
 class Av1BasicFeature : public EncodeBasicFeature, public mhw::vdbox::vdenc::Itf::ParSetting, public mhw::vdbox::avp::Itf::ParSetting, public mhw::vdbox::huc::Itf::ParSetting, public mhw::mi::Itf::ParSetting
 {
 public:
@@ -74,7 +65,7 @@ public:
                      void *constSettings) :
                      EncodeBasicFeature(allocator, hwInterface, trackedBuf, recycleBuf){m_constSettings = constSettings;};
 
-    virtual ~Av1BasicFeature() {};
+    virtual ~Av1BasicFeature();
 
     virtual MOS_STATUS Init(void *setting) override;
 
@@ -153,6 +144,7 @@ public:
     int32_t                            m_picHeightInSb = 0;
     bool                               m_isSb128x128 = false;
     static const uint32_t              m_cdfMaxNumBytes = 15104;                                //!< Max number of bytes for CDF tables buffer, which equals to 236*64 (236 Cache Lines)
+    MOS_RESOURCE                       m_sharedCdfBuffers   = {};                               //!< Copy of read-only default cdf tables shared by contexts of the device
     PMOS_RESOURCE                      m_defaultCdfBuffers  = nullptr;                          //!< 4 default frame contexts per base_qindex
     PMOS_RESOURCE                      m_defaultCdfBufferInUse = nullptr;                       //!< default cdf table used base on current base_qindex
     uint32_t                           m_defaultCdfBufferInUseOffset = 0;
@@ -105,7 +105,7 @@ namespace encode
 
         auto data = (uint16_t *)m_allocator->LockResourceForWrite(cdfTrackedBuf);
         ENCODE_CHK_NULL_RETURN(data);
-        ENCODE_CHK_STATUS_RETURN(InitDefaultFrameContextBuffer(data, 0, mvJointType, interintra));
+        ENCODE_CHK_STATUS_RETURN(CodecAv1DefaultCdfTable::Init(data, 0, mvJointType, interintra));
         ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(cdfTrackedBuf));
 
         m_resetMvProbs            = false;
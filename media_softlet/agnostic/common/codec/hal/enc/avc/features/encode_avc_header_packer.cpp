@@ -137,6 +137,12 @@ static void PutVLCCode(BSBuffer *bsbuffer, uint32_t code)
     {
         PutBit(bsbuffer, 1);
     }
+    else if (bitcount <= 16)
+    {
+        // Prefix and suffix fit in one write
+        leadingZeroBits = bitcount - 1;
+        PutBits(bsbuffer, code + 1, 2 * leadingZeroBits + 1);
+    }
     else
     {
         leadingZeroBits = bitcount - 1;
@@ -187,6 +187,7 @@ MOS_STATUS AvcVdencPipeline::Execute()
 MOS_STATUS AvcVdencPipeline::GetStatusReport(void *status, uint16_t numStatus)
 {
     ENCODE_FUNC_CALL();
+    ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
     ENCODE_CHK_STATUS_RETURN(m_statusReport->GetReport(numStatus, status));
 
     return MOS_STATUS_SUCCESS;
@@ -165,6 +165,85 @@ void HevcHeaderPacker::PackSSH(
         bs.PutTrailingBits();
 }
 
+bool HevcHeaderPacker::IsSliceTemplateMatched(const CODEC_HEVC_ENCODE_SLICE_PARAMS &slcParams) const
+{
+    const CODEC_HEVC_ENCODE_SLICE_PARAMS &tmpl = m_sliceTemplate.params;
+
+    return m_sliceTemplate.valid &&
+           !slcParams.dependent_slice_segment_flag &&
+           slcParams.slice_type == tmpl.slice_type &&
+           slcParams.slice_temporal_mvp_enable_flag == tmpl.slice_temporal_mvp_enable_flag &&
+           slcParams.slice_sao_luma_flag == tmpl.slice_sao_luma_flag &&
+           slcParams.slice_sao_chroma_flag == tmpl.slice_sao_chroma_flag &&
+           slcParams.mvd_l1_zero_flag == tmpl.mvd_l1_zero_flag &&
+           slcParams.cabac_init_flag == tmpl.cabac_init_flag &&
+           slcParams.slice_deblocking_filter_disable_flag == tmpl.slice_deblocking_filter_disable_flag &&
+           slcParams.collocated_from_l0_flag == tmpl.collocated_from_l0_flag &&
+           slcParams.num_ref_idx_l0_active_minus1 == tmpl.num_ref_idx_l0_active_minus1 &&
+           slcParams.num_ref_idx_l1_active_minus1 == tmpl.num_ref_idx_l1_active_minus1 &&
+           slcParams.MaxNumMergeCand == tmpl.MaxNumMergeCand &&
+           slcParams.slice_cb_qp_offset == tmpl.slice_cb_qp_offset &&
+           slcParams.slice_cr_qp_offset == tmpl.slice_cr_qp_offset &&
+           slcParams.beta_offset_div2 == tmpl.beta_offset_div2 &&
+           slcParams.tc_offset_div2 == tmpl.tc_offset_div2;
+}
+
+void HevcHeaderPacker::PackSSHWithTemplate(
+    BitstreamWriter                      &bs,
+    HevcNALU const                       &nalu,
+    HevcSPS const                        &sps,
+    HevcPPS const                        &pps,
+    HevcSlice const                      &slice,
+    const CODEC_HEVC_ENCODE_SLICE_PARAMS &slcParams,
+    bool                                  dyn_slice_size,
+    bool                                  useTemplate)
+{
+    ENCODE_ASSERT(!slice.dependent_slice_segment_flag);
+
+    PackNALU(bs, nalu);
+
+    if (!dyn_slice_size)
+        PackSSHPartIdAddr(bs, nalu, sps, pps, slice);
+
+    SliceHeaderTemplate &tmpl       = m_sliceTemplate;
+    mfxU32               indepStart = bs.GetOffset();
+
+    if (useTemplate)
+    {
+        // Only slice_qp_delta is packed, the bits around it are same as the template
+        bs.PutBitsBuffer(tmpl.qpDeltaStart - tmpl.indepStart, tmpl.data, tmpl.indepStart);
+        bs.PutSE(slice.slice_qp_delta);
+        bs.PutBitsBuffer(tmpl.end - tmpl.qpDeltaEnd, tmpl.data, tmpl.qpDeltaEnd);
+    }
+    else
+    {
+        std::map<mfxU32, mfxU32> info;
+        bs.SetInfo(&info);
+        PackSSHPartIndependent(bs, nalu, sps, pps, slice);
+        bs.SetInfo(nullptr);
+
+        if (pps.tiles_enabled_flag || pps.entropy_coding_sync_enabled_flag)
+        {
+            ENCODE_ASSERT(slice.num_entry_point_offsets == 0);
+
+            bs.PutUE(slice.num_entry_point_offsets);
+        }
+
+        tmpl.valid        = true;
+        tmpl.params       = slcParams;
+        tmpl.data         = bs.GetStart();
+        tmpl.indepStart   = indepStart;
+        tmpl.qpDeltaStart = info[PACK_QPDOffset];
+        tmpl.qpDeltaEnd   = info[PACK_QPDOffset] + info[PACK_QPDLength];
+        tmpl.end          = bs.GetOffset();
+    }
+
+    ENCODE_ASSERT(0 == pps.slice_segment_header_extension_present_flag);
+
+    if (!dyn_slice_size)  // no trailing bits for dynamic slice size
+        bs.PutTrailingBits();
+}
+
 void HevcHeaderPacker::PackNALU(BitstreamWriter &bs, NALU const &h)
 {
     bool bLong_SC =
@@ -240,9 +319,11 @@ void HevcHeaderPacker::PackSSHPartIndependent(
     if (slice.type != I)
         PackSSHPartPB(bs, sps, pps, slice);
 
-    bs.AddInfo(PACK_QPDOffset, bs.GetOffset());
+    mfxU32 qpdOffset = bs.GetOffset();
+    bs.AddInfo(PACK_QPDOffset, qpdOffset);
 
     nSE += PutSE(bs, slice.slice_qp_delta);
+    bs.AddInfo(PACK_QPDLength, bs.GetOffset() - qpdOffset);
     nSE += pps.slice_chroma_qp_offsets_present_flag && PutSE(bs, slice.slice_cb_qp_offset);
     nSE += pps.slice_chroma_qp_offsets_present_flag && PutSE(bs, slice.slice_cr_qp_offset);
     nSE += pps.deblocking_filter_override_enabled_flag && PutBit(bs, slice.deblocking_filter_override_flag);
@@ -544,17 +625,33 @@ MOS_STATUS HevcHeaderPacker::SliceHeaderPacker(EncoderParams *encodeParams)
     ENCODE_CHK_STATUS_RETURN(GetPPSParams(static_cast<PCODEC_HEVC_ENCODE_PICTURE_PARAMS>(encodeParams->pPicParams)));
     ENCODE_CHK_STATUS_RETURN(GetNaluParams(nalType, 0, 0, pBSBuffer->pCurrent == pBSBuffer->pBase));
 
+    // Template is only valid in the frame it is packed for
+    m_sliceTemplate.valid = false;
+
     //uint8_t *pCurrent = pBSBuffer->pCurrent;
     //uint32_t
     for (uint32_t startLcu = 0, slcCount = 0; slcCount < encodeParams->dwNumSlices; slcCount++)
     {
         //startLcu += m_hevcSliceParams[slcCount].NumLCUsInSlice;
-        ENCODE_CHK_STATUS_RETURN(GetSliceParams(static_cast<PCODEC_HEVC_ENCODE_SLICE_PARAMS>(encodeParams->pSliceParams)[slcCount]));
-        ENCODE_CHK_STATUS_RETURN(LoadSliceHeaderParams((CodecEncodeHevcSliceHeaderParams*) pCodecHalEncodeParams->pSliceHeaderParams));
-        
+        const CODEC_HEVC_ENCODE_SLICE_PARAMS &slcParams = static_cast<PCODEC_HEVC_ENCODE_SLICE_PARAMS>(encodeParams->pSliceParams)[slcCount];
+        ENCODE_CHK_STATUS_RETURN(GetSliceParams(slcParams));
+
+        bool useTemplate = m_sliceTemplateEnabled && IsSliceTemplateMatched(slcParams);
+        if (!useTemplate)
+        {
+            ENCODE_CHK_STATUS_RETURN(LoadSliceHeaderParams((CodecEncodeHevcSliceHeaderParams*) pCodecHalEncodeParams->pSliceHeaderParams));
+        }
+
         rbsp.Reset(pBegin, mfxU32(pEnd - pBegin));
         m_naluParams.long_start_code = 0/*pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 == pBSBuffer->pBase*/;
-        PackSSH(rbsp, m_naluParams, m_spsParams, m_ppsParams, m_sliceParams, m_bDssEnabled);
+        if (m_sliceTemplateEnabled && !slcParams.dependent_slice_segment_flag)
+        {
+            PackSSHWithTemplate(rbsp, m_naluParams, m_spsParams, m_ppsParams, m_sliceParams, slcParams, m_bDssEnabled, useTemplate);
+        }
+        else
+        {
+            PackSSH(rbsp, m_naluParams, m_spsParams, m_ppsParams, m_sliceParams, m_bDssEnabled);
+        }
         BitLen = rbsp.GetOffset();
         pBegin += CeilDiv(BitLen, 8u);
         pSlcData[slcCount].SliceOffset            = (uint32_t)(pBSBuffer->pCurrent + (BitLenRecorded + 7) / 8 - pBSBuffer->pBase);
@@ -111,6 +111,7 @@ enum ePackInfo
     PACK_VUIOffset,
     PACK_PWTOffset,
     PACK_PWTLength,
+    PACK_QPDLength,
     NUM_PACK_INFO
 };
 
@@ -490,6 +491,23 @@ public:
     uint8_t                 nalType         = 0;
     std::array<mfxU8, 1024> m_rbsp          = {};
     bool                    m_bDssEnabled   = false;
+    bool                    m_sliceTemplateEnabled = true;  //!< Reuse packed header bits of previous slice with same params
+
+    //!
+    //! \brief  Packed slice segment header which following slices of the frame are copied from
+    //!         when they only differ in slice address and QP delta
+    //!
+    struct SliceHeaderTemplate
+    {
+        bool                           valid        = false;
+        CODEC_HEVC_ENCODE_SLICE_PARAMS params       = {};       //!< Slice params of the template slice
+        mfxU8                         *data         = nullptr;  //!< Packed header of the template slice
+        mfxU32                         indepStart   = 0;        //!< Bit offset of the independent part
+        mfxU32                         qpDeltaStart = 0;        //!< Bit offset of slice_qp_delta
+        mfxU32                         qpDeltaEnd   = 0;
+        mfxU32                         end          = 0;        //!< Bit offset of rbsp trailing bits
+    };
+    SliceHeaderTemplate     m_sliceTemplate = {};
 
 public:
     HevcHeaderPacker();
@@ -507,6 +525,29 @@ public:
               HevcSlice const &slice,
               bool             dyn_slice_size);
     void PackNALU(BitstreamWriter &bs, NALU const &h);
+
+    //!
+    //! \brief  Check if the slice can be packed from the slice header template
+    //! \param  [in] slcParams
+    //!         Slice params from app
+    //! \return bool
+    //!         true if only slice address and QP delta differ from the template slice
+    //!
+    bool IsSliceTemplateMatched(const CODEC_HEVC_ENCODE_SLICE_PARAMS &slcParams) const;
+
+    //!
+    //! \brief  Pack independent slice segment header, the independent part is copied from
+    //!         the slice header template if useTemplate, else it is packed and saved as template
+    //!
+    void PackSSHWithTemplate(
+        BitstreamWriter                      &bs,
+        HevcNALU const                       &nalu,
+        HevcSPS const                        &sps,
+        HevcPPS const                        &pps,
+        HevcSlice const                      &slice,
+        const CODEC_HEVC_ENCODE_SLICE_PARAMS &slcParams,
+        bool                                  dyn_slice_size,
+        bool                                  useTemplate);
     void PackSSHPartIdAddr(
         BitstreamWriter &bs,
         NALU const &     nalu,
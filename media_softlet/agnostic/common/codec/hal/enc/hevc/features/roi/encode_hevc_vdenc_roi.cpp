@@ -49,18 +49,28 @@ HevcVdencRoi::HevcVdencRoi(
     m_basicFeature = dynamic_cast<EncodeBasicFeature *>(m_featureManager->GetFeature(FeatureIDs::basicFeature));
     ENCODE_CHK_NULL_NO_STATUS_RETURN(m_basicFeature);
 }
-MOS_STATUS HevcVdencRoi::ClearStreaminBuffer(uint32_t lucNumber)
-{
-    // Clear streamin
-    ENCODE_CHK_NULL_RETURN(m_streamInTemp);
 
-    uint8_t *data = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(data);
+HevcVdencRoi::~HevcVdencRoi()
+{
+    MOS_SafeFreeMemory(m_streamInShadow);
+    m_streamInShadow = nullptr;
+}
 
-    MOS_ZeroMemory(m_streamInTemp, lucNumber * 64);
-    MOS_SecureMemcpy(data, m_streamInSize, m_streamInTemp, m_streamInSize);
+MOS_STATUS HevcVdencRoi::ClearStreaminBuffer()
+{
+    // Clear streamin
+    if (m_streamInShadow == nullptr)
+    {
+        m_streamInShadow = (uint8_t *)MOS_AllocMemory(m_streamInSize);
+        ENCODE_CHK_NULL_RETURN(m_streamInShadow);
+    }
+    MOS_ZeroMemory(m_streamInShadow, m_streamInSize);
 
-    ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(m_streamIn));
+    // All recycled buffers need to be fully written again
+    uint32_t blockSize = RoiOverlap::m_lcuNumberPerBlock * RoiOverlap::m_streaminRecordSize;
+    m_streamInVersion++;
+    m_blockVersion.assign((m_streamInSize + blockSize - 1) / blockSize, m_streamInVersion);
+    m_bufferVersion.clear();
 
     return MOS_STATUS_SUCCESS;
 }
@@ -159,12 +169,18 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
     if (!m_isArbRoi || (hevcPicParams->CodingType == I_TYPE && !IFrameIsSet) || ((hevcPicParams->CodingType == P_TYPE || hevcPicParams->CodingType == B_TYPE) && !PBFrameIsSet))
     {
-        m_streamInTemp = (uint8_t *)MOS_AllocMemory(m_streamInSize);
-        ENCODE_CHK_NULL_RETURN(m_streamInTemp);
-
         uint32_t lcuNumber = GetLCUNumber();
+        ENCODE_CHK_COND_RETURN(lcuNumber * RoiOverlap::m_streaminRecordSize > m_streamInSize,
+            "Frame size exceeds the streamin buffer size!");
 
-        ENCODE_CHK_STATUS_RETURN(ClearStreaminBuffer(lcuNumber));
+        // The streamin shadow is kept across frames, so only the data changed
+        // from last frame is rewritten and copied to the streamin buffer
+        if (m_streamInShadow == nullptr || m_streamInLcuNumber != lcuNumber)
+        {
+            ENCODE_CHK_STATUS_RETURN(ClearStreaminBuffer());
+        }
+        // Shadow is invalid until the streamin data of this frame is written
+        m_streamInLcuNumber = 0;
 
         m_roiOverlap.Update(lcuNumber);
 
@@ -185,8 +201,7 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
         }
 
         ENCODE_CHK_STATUS_RETURN(WriteStreaminData());
-
-        MOS_SafeFreeMemory(m_streamInTemp);
+        m_streamInLcuNumber = lcuNumber;
 
 #if (_DEBUG || _RELEASE_INTERNAL)
         ENCODE_CHK_NULL_RETURN(m_hwInterface);
@@ -214,19 +229,66 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 MOS_STATUS HevcVdencRoi::WriteStreaminData()
 {
     ENCODE_CHK_NULL_RETURN(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(m_streamInTemp);
+    ENCODE_CHK_NULL_RETURN(m_streamInShadow);
+
+    ENCODE_CHK_STATUS_RETURN(m_roiOverlap.UpdateStreaminData(
+        m_strategyFactory.GetRoi(),
+        m_strategyFactory.GetDirtyRoi(),
+        m_streamInShadow,
+        m_changedBlocks));
+
+    if (!m_changedBlocks.empty())
+    {
+        m_streamInVersion++;
+        for (auto block : m_changedBlocks)
+        {
+            if (block < m_blockVersion.size())
+            {
+                m_blockVersion[block] = m_streamInVersion;
+            }
+        }
+    }
+
+    // Streamin buffers are recycled, the buffer only needs the blocks
+    // changed since the last time it was written
+    auto     iter          = m_bufferVersion.find(m_streamIn);
+    uint32_t bufferVersion = (iter == m_bufferVersion.end()) ? 0 : iter->second;
+    if (bufferVersion == m_streamInVersion)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
 
     uint8_t *streaminBuffer = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
     ENCODE_CHK_NULL_RETURN(streaminBuffer);
 
-    m_roiOverlap.WriteStreaminData(
-        m_strategyFactory.GetRoi(), 
-        m_strategyFactory.GetDirtyRoi(),
-        m_streamInTemp);
+    uint32_t blockSize = RoiOverlap::m_lcuNumberPerBlock * RoiOverlap::m_streaminRecordSize;
+    uint32_t numBlocks = (uint32_t)m_blockVersion.size();
+    uint32_t start     = 0;
+    while (start < numBlocks)
+    {
+        if (m_blockVersion[start] <= bufferVersion)
+        {
+            start++;
+            continue;
+        }
+
+        // Copy continuous changed blocks at once
+        uint32_t end = start + 1;
+        while (end < numBlocks && m_blockVersion[end] > bufferVersion)
+        {
+            end++;
+        }
+
+        uint32_t offset = start * blockSize;
+        uint32_t size   = MOS_MIN(end * blockSize, m_streamInSize) - offset;
+        MOS_SecureMemcpy(streaminBuffer + offset, m_streamInSize - offset, m_streamInShadow + offset, size);
 
-    MOS_SecureMemcpy(streaminBuffer, m_streamInSize, m_streamInTemp, m_streamInSize);
+        start = end;
+    }
 
     m_allocator->UnLock(m_streamIn);
+    m_bufferVersion[m_streamIn] = m_streamInVersion;
+
     return MOS_STATUS_SUCCESS;
 }
 
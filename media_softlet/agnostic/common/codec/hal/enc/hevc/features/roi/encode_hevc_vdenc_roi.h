@@ -27,6 +27,7 @@
 #ifndef __CODECHAL_HEVC_VDENC_ROI_H__
 #define __CODECHAL_HEVC_VDENC_ROI_H__
 
+#include <map>
 #include "media_feature.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
 #include "encode_hevc_vdenc_roi_strategy.h"
@@ -60,7 +61,7 @@ public:
         CodechalHwInterfaceNext *hwInterface,
         void *constSettings);
 
-    virtual ~HevcVdencRoi() {}
+    virtual ~HevcVdencRoi();
 
     //!
     //! \brief  Init encode parameter
@@ -205,11 +206,11 @@ protected:
     }
 
     //!
-    //! \brief    ClearStreaminBuffer
+    //! \brief    Clear the streamin shadow and mark all blocks as changed
     //! \return   MOS_STATUS
     //!           MOS_STATUS_SUCCESS if success, else fail reason
     //!
-    MOS_STATUS ClearStreaminBuffer(uint32_t lucNumber);
+    MOS_STATUS ClearStreaminBuffer();
 
     //!
     //! \brief    Get strategy for setting command parameters
@@ -244,8 +245,13 @@ protected:
     bool m_isArbRoiSupported = true;     //!< Whether is Adaptive Region Boost ROI Supported
 
     PMOS_RESOURCE      m_streamIn = nullptr; //!< Stream in buffer
-    uint8_t *          m_streamInTemp = nullptr;
+    uint8_t *          m_streamInShadow = nullptr;  //!< CPU copy of streamin data written for last frame
     uint32_t           m_streamInSize = 0;
+    uint32_t           m_streamInLcuNumber = 0;     //!< LCU number of streamin shadow, 0 if shadow is invalid
+    uint32_t           m_streamInVersion   = 0;     //!< Increased each time streamin shadow is changed
+    std::vector<uint32_t>          m_blockVersion;   //!< Version of last change for each 64x64 CU block
+    std::map<PMOS_RESOURCE, uint32_t> m_bufferVersion;  //!< Version of streamin shadow copied to each recycled buffer
+    UintVector         m_changedBlocks;              //!< Blocks changed in current frame
     RoiStrategyFactory m_strategyFactory;    //!< Factory of strategy
     RoiOverlap         m_roiOverlap;         //!< ROI and dirty ROI overlap
 
@@ -33,6 +33,8 @@ RoiOverlap::~RoiOverlap()
 {
     MOS_FreeMemory(m_overlapMap);
     m_overlapMap = nullptr;
+    MOS_FreeMemory(m_prevOverlapMap);
+    m_prevOverlapMap = nullptr;
 }
 
 void RoiOverlap::Update(uint32_t lcuNumber)
@@ -41,13 +43,26 @@ void RoiOverlap::Update(uint32_t lcuNumber)
     {
         MOS_FreeMemory(m_overlapMap);
         m_overlapMap = nullptr;
+        MOS_FreeMemory(m_prevOverlapMap);
+        m_prevOverlapMap = nullptr;
         m_lcuNumber  = lcuNumber;
     }
 
+    // Keep the map of previous frame for incremental streamin update
+    uint16_t *prevOverlapMap = m_overlapMap;
+    m_overlapMap             = m_prevOverlapMap;
+    m_prevOverlapMap         = prevOverlapMap;
+
     if (m_overlapMap == nullptr)
     {
         m_overlapMap = (uint16_t *)
-            MOS_AllocMemory(lcuNumber * sizeof(uint16_t));
+            MOS_AllocMemory(m_lcuNumber * sizeof(uint16_t));
+    }
+
+    if (m_prevOverlapMap == nullptr)
+    {
+        m_prevOverlapMap = (uint16_t *)
+            MOS_AllocAndZeroMemory(m_lcuNumber * sizeof(uint16_t));
     }
 
     MOS_ZeroMemory(m_overlapMap, m_lcuNumber * sizeof(uint16_t));
@@ -102,6 +117,32 @@ void RoiOverlap::MarkLcu(uint32_t lcu, OverlapMarker marker)
     }
 }
 
+MOS_STATUS RoiOverlap::WriteLcu(
+    RoiStrategy *roi,
+    RoiStrategy *dirtyRoi,
+    uint32_t lcu,
+    uint8_t *streaminBuffer)
+{
+    OverlapMarker marker = GetMarker(m_overlapMap[lcu]);
+    uint32_t      roiRegionIndex = GetRoiRegionIndex(m_overlapMap[lcu]);
+
+    if (IsRoiMarker(marker))
+    {
+        ENCODE_CHK_NULL_RETURN(roi);
+
+        roi->WriteStreaminData(
+            lcu, marker, roiRegionIndex, streaminBuffer);
+
+    }
+    else if (IsDirtyRoiMarker(marker))
+    {
+        ENCODE_CHK_NULL_RETURN(dirtyRoi);
+        dirtyRoi->WriteStreaminData(
+            lcu, marker, roiRegionIndex, streaminBuffer);
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS RoiOverlap::WriteStreaminData(
     RoiStrategy *roi,
     RoiStrategy *dirtyRoi,
@@ -112,22 +153,61 @@ MOS_STATUS RoiOverlap::WriteStreaminData(
 
     for (uint32_t i = 0; i < m_lcuNumber; i++)
     {
-        OverlapMarker marker = GetMarker(m_overlapMap[i]);
-        uint32_t      roiRegionIndex = GetRoiRegionIndex(m_overlapMap[i]);
+        ENCODE_CHK_STATUS_RETURN(WriteLcu(roi, dirtyRoi, i, streaminBuffer));
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS RoiOverlap::UpdateStreaminData(
+    RoiStrategy *roi,
+    RoiStrategy *dirtyRoi,
+    uint8_t *streaminBuffer,
+    UintVector &changedBlocks)
+{
+    ENCODE_CHK_NULL_RETURN(streaminBuffer);
+    ENCODE_CHK_NULL_RETURN(m_overlapMap);
+    ENCODE_CHK_NULL_RETURN(m_prevOverlapMap);
+
+    changedBlocks.clear();
+
+    uint8_t prevBlockData[m_lcuNumberPerBlock * m_streaminRecordSize];
 
-        if (IsRoiMarker(marker))
+    for (uint32_t first = 0; first < m_lcuNumber; first += m_lcuNumberPerBlock)
+    {
+        uint32_t last = MOS_MIN(first + m_lcuNumberPerBlock, m_lcuNumber);
+
+        bool marked = false;
+        for (uint32_t i = first; i < last; i++)
         {
-            ENCODE_CHK_NULL_RETURN(roi);
+            if (m_overlapMap[i] || m_prevOverlapMap[i])
+            {
+                marked = true;
+                break;
+            }
+        }
 
-            roi->WriteStreaminData(
-                i, marker, roiRegionIndex, streaminBuffer);
+        // Block not marked in both frames is still zero
+        if (!marked)
+        {
+            continue;
+        }
 
+        // Rewrite the whole block since QP map ROI sets the TU params of
+        // a 64x64 CU when writing the last LCU of it
+        uint8_t *blockData = streaminBuffer + first * m_streaminRecordSize;
+        uint32_t blockSize = (last - first) * m_streaminRecordSize;
+
+        MOS_SecureMemcpy(prevBlockData, sizeof(prevBlockData), blockData, blockSize);
+        MOS_ZeroMemory(blockData, blockSize);
+
+        for (uint32_t i = first; i < last; i++)
+        {
+            ENCODE_CHK_STATUS_RETURN(WriteLcu(roi, dirtyRoi, i, streaminBuffer));
         }
-        else if (IsDirtyRoiMarker(marker))
+
+        if (memcmp(prevBlockData, blockData, blockSize) != 0)
         {
-            ENCODE_CHK_NULL_RETURN(dirtyRoi);
-            dirtyRoi->WriteStreaminData(
-                i, marker, roiRegionIndex, streaminBuffer);
+            changedBlocks.push_back(first / m_lcuNumberPerBlock);
         }
     }
     return MOS_STATUS_SUCCESS;
@@ -124,7 +124,54 @@ public:
         RoiStrategy *dirtyRoi,
         uint8_t *streaminBuffer);
 
+    //!
+    //! \brief  Update streamin data which is written for previous frame
+    //!
+    //! \detail  Only the blocks with LCUs marked in current or previous frame
+    //!          are rewritten, the other blocks are kept as zero. A block is
+    //!          the 4 streamin records of one 64x64 CU.
+    //!
+    //! \param  [in] roi
+    //!         ROI strategy
+    //! \param  [in] dirtyRoi
+    //!         Dirty ROI strategy
+    //! \param  [in, out] streaminBuffer
+    //!         streamin buffer holding the data of previous frame
+    //! \param  [out] changedBlocks
+    //!         index of blocks which data is changed from previous frame
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS UpdateStreaminData(
+        RoiStrategy *roi,
+        RoiStrategy *dirtyRoi,
+        uint8_t *streaminBuffer,
+        UintVector &changedBlocks);
+
+    static const uint32_t m_streaminRecordSize = 64;  //<! Size of streamin data per LCU
+    static const uint32_t m_lcuNumberPerBlock  = 4;   //<! Number of LCU per 64x64 CU
+
 private:
+    //!
+    //! \brief  Write streamin data of one LCU according to its marker
+    //!
+    //! \param  [in] roi
+    //!         ROI strategy
+    //! \param  [in] dirtyRoi
+    //!         Dirty ROI strategy
+    //! \param  [in] lcu
+    //!         Index of LCU
+    //! \param  [in, out] streaminBuffer
+    //!         streamin buffer
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS WriteLcu(
+        RoiStrategy *roi,
+        RoiStrategy *dirtyRoi,
+        uint32_t lcu,
+        uint8_t *streaminBuffer);
+
     //!
     //! \brief  mark the specific LCU with provided marker and region index
     //!
@@ -214,6 +261,7 @@ protected:
     //! index marker from description
     //!
     uint16_t *m_overlapMap = nullptr;  //<! Overlap map buffer
+    uint16_t *m_prevOverlapMap = nullptr;  //<! Overlap map of previous frame
 
     //!
     //! \brief  Get the marker from the overlap map data.
@@ -22,6 +22,7 @@
 
 #include "bitstream_writer.h"
 #include <assert.h>
+#include <string.h>
 
 BitstreamWriter::BitstreamWriter(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
     : m_bsStart(bs), m_bsEnd(bs + size), m_bs(bs), m_bitStart(bitOffset & 7), m_bitOffset(bitOffset & 7), m_codILow(0)  // cabac variables
@@ -65,41 +66,67 @@ void BitstreamWriter::Reset(mfxU8 *bs, mfxU32 size, mfxU8 bitOffset)
 }
 
 void BitstreamWriter::PutBitsBuffer(mfxU32 n, void *bb, mfxU32 o)
-{}
-
-void BitstreamWriter::PutBits(mfxU32 n, mfxU32 b)
 {
-    assert(n <= sizeof(b) * 8);
-    while (n > 24)
+    mfxU8 *b = (mfxU8 *)bb + (o >> 3);
+    o &= 7;
+
+    // Leading bits till the source is byte aligned
+    if (o && n)
     {
-        n -= 16;
-        PutBits(16, (b >> n));
+        mfxU32 len = (8 - o) < n ? (8 - o) : n;
+        PutBits(len, (*b >> (8 - o - len)));
+        b++;
+        n -= len;
     }
 
-    b <<= (32 - n);
-
     if (!m_bitOffset)
     {
-        m_bs[0] = (mfxU8)(b >> 24);
-        m_bs[1] = (mfxU8)(b >> 16);
+        memcpy(m_bs, b, n >> 3);
+        m_bs += (n >> 3);
+        b += (n >> 3);
+        n &= 7;
     }
     else
     {
-        b >>= m_bitOffset;
-        n += m_bitOffset;
+        for (; n >= 24; n -= 24, b += 3)
+        {
+            PutBits(24, (b[0] << 16) | (b[1] << 8) | b[2]);
+        }
+        for (; n >= 8; n -= 8, b++)
+        {
+            PutBits(8, b[0]);
+        }
+    }
+
+    if (n)
+    {
+        PutBits(n, (*b >> (8 - n)));
+    }
+}
 
-        m_bs[0] |= (mfxU8)(b >> 24);
-        m_bs[1] = (mfxU8)(b >> 16);
+void BitstreamWriter::PutBits(mfxU32 n, mfxU32 b)
+{
+    assert(n <= sizeof(b) * 8);
+    if (!n)
+    {
+        return;
     }
 
-    if (n > 16)
+    // Merge the bits pending in current byte and the new bits in a 64-bit
+    // accumulator aligned to msb, then store all the touched bytes at once
+    mfxU32   len = m_bitOffset + n;
+    uint64_t acc = m_bitOffset ? (m_bs[0] >> (8 - m_bitOffset)) : 0;
+
+    acc = (acc << n) | (b & (uint64_t(0xFFFFFFFF) >> (32 - n)));
+    acc <<= (64 - len);
+
+    for (mfxU32 i = 0; i < ((len + 7) >> 3); i++)
     {
-        m_bs[2] = (mfxU8)(b >> 8);
-        m_bs[3] = (mfxU8)b;
+        m_bs[i] = (mfxU8)(acc >> (56 - (i << 3)));
     }
 
-    m_bs += (n >> 3);
-    m_bitOffset = (n & 7);
+    m_bs += (len >> 3);
+    m_bitOffset = (len & 7);
 }
 
 void BitstreamWriter::PutBit(mfxU32 b)
@@ -138,8 +165,16 @@ void BitstreamWriter::PutGolomb(mfxU32 b)
         while (b >> n)
             n++;
 
-        PutBits(n - 1, 0);
-        PutBits(n, b);
+        // Leading zeros and the code fit in one write for values below 2^16
+        if (n <= 16)
+        {
+            PutBits(2 * n - 1, b);
+        }
+        else
+        {
+            PutBits(n - 1, 0);
+            PutBits(n, b);
+        }
     }
 }
 
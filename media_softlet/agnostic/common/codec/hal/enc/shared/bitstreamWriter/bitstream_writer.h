@@ -29,6 +29,7 @@
 
 #include "media_class_trace.h"
 #include <map>
+#include <stdint.h>
 
 typedef unsigned char  mfxU8;
 typedef char           mfxI8;
@@ -134,7 +135,11 @@ public:
 MEDIA_CLASS_DEFINE_END(IBsWriter)
 };
 
-class BitstreamWriter
+//!
+//! \brief  Bit writer for header packing, declared final so that calls through
+//!         BitstreamWriter are not dispatched virtually
+//!
+class BitstreamWriter final
     : public IBsWriter
 {
 public:
@@ -142,6 +147,7 @@ public:
     ~BitstreamWriter();
 
     virtual void PutBits(mfxU32 n, mfxU32 b) override;
+    //! \brief  Put n bits of buffer b starting from bit offset
     void         PutBitsBuffer(mfxU32 n, void *b, mfxU32 offset = 0);
     virtual void PutBit(mfxU32 b) override;
     void         PutGolomb(mfxU32 b);
@@ -38,6 +38,18 @@ EncodeAllocator::EncodeAllocator(PMOS_INTERFACE osInterface) :
     m_osInterface(osInterface)
 {
     m_allocator = MOS_New(Allocator, m_osInterface);
+
+    // Tracked buffers are returned to the system instead of pooled when over budget
+    if (m_osInterface && m_osInterface->pfnGetUserSettingInstance)
+    {
+        MediaUserSetting::Value outValue;
+        ReadUserSetting(
+            m_osInterface->pfnGetUserSettingInstance(m_osInterface),
+            outValue,
+            "Media Memory Budget",
+            MediaUserSetting::Group::Sequence);
+        Allocator::SetMemoryBudget((uint64_t)outValue.Get<uint32_t>() << 20);
+    }
 }
 
 EncodeAllocator::~EncodeAllocator()
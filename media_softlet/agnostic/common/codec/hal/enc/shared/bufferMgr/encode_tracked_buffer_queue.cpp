@@ -28,6 +28,7 @@
 #include <algorithm>
 #include "encode_allocator.h"
 #include "encode_utils.h"
+#include "media_allocator.h"
 #include "mos_os_hw.h"
 #include "mos_os_specific.h"
 #include "mos_utilities.h"
@@ -98,6 +99,14 @@ MOS_STATUS BufferQueue::ReleaseResource(void *resource)
             ENCODE_VERBOSEMESSAGE("resource already returned");
             return MOS_STATUS_INVALID_PARAMETER;
         }
+        if (Allocator::IsOverBudget())
+        {
+            // Over the media memory budget, give the resource back instead of keeping it
+            // for reuse, AcquireResource allocates again when it is needed
+            m_resources.erase(std::find(m_resources.begin(), m_resources.end(), resource));
+            m_allocCount--;
+            return DestoryResource(resource);
+        }
         m_resourcePool.push_back(resource);
     }
     return MOS_STATUS_SUCCESS;
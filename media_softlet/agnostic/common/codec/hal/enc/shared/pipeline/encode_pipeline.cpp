@@ -121,6 +121,46 @@ MOS_STATUS EncodePipeline::Initialize(void *settings)
 
     m_encodecp->setStatusReport(m_statusReport);
 
+    // Small resolution AVC/HEVC streams can share one submission with other streams on the device
+    ReadUserSetting(
+        m_userSettingPtr,
+        outValue,
+        "Encode Submit Batching Enable",
+        MediaUserSetting::Group::Sequence);
+    bool submitBatchingEnabled = outValue.Get<bool>();
+
+    if (submitBatchingEnabled && !cpenable &&
+        (m_standard == CODECHAL_AVC || m_standard == CODECHAL_HEVC))
+    {
+        ReadUserSetting(
+            m_userSettingPtr,
+            outValue,
+            "Encode Submit Batching Max Frame Size",
+            MediaUserSetting::Group::Sequence);
+        uint32_t maxFrameSize = outValue.Get<uint32_t>();
+
+        ReadUserSetting(
+            m_userSettingPtr,
+            outValue,
+            "Encode Submit Batching Max Frames",
+            MediaUserSetting::Group::Sequence);
+        uint32_t maxBatchFrames = outValue.Get<uint32_t>();
+
+        // Time in us a frame may wait for the frames of other streams
+        ReadUserSetting(
+            m_userSettingPtr,
+            outValue,
+            "Encode Submit Batching Max Delay",
+            MediaUserSetting::Group::Sequence);
+        uint32_t maxDelayUs = outValue.Get<uint32_t>();
+
+        if (codecSettings->width * codecSettings->height <= maxFrameSize && maxBatchFrames > 1)
+        {
+            m_submitBatcher = MediaSubmitBatcher::Attach(m_osInterface, MOS_GPU_NODE_VIDEO, maxBatchFrames, maxDelayUs);
+            ENCODE_NORMALMESSAGE("Submit batching %s", m_submitBatcher ? "enabled" : "disabled");
+        }
+    }
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -128,6 +168,10 @@ MOS_STATUS EncodePipeline::Uninitialize()
 {
     ENCODE_FUNC_CALL();
 
+    // Pending frames are flushed with the scalability of this stream, detach before media context is deleted
+    MediaSubmitBatcher::Detach(m_submitBatcher, m_osInterface, m_scalability);
+    m_submitBatcher = nullptr;
+
     MOS_Delete(m_mediaContext);
 
     MOS_Delete(m_encodecp);
@@ -268,6 +312,9 @@ MOS_STATUS EncodePipeline::WaitForBatchBufferComplete()
     {
         uint32_t waitMs;
 
+        // The frame to wait for may still be pending in submit batcher
+        ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
+
         // Wait for Batch Buffer complete event OR timeout
         for (waitMs = MHW_TIMEOUT_MS_DEFAULT; waitMs > 0; waitMs -= MHW_EVENT_TIMEOUT_MS)
         {
@@ -298,21 +345,55 @@ MOS_STATUS EncodePipeline::WaitForBatchBufferComplete()
     return MOS_STATUS_SUCCESS;
 }
 
+bool EncodePipeline::IsSubmitBatchingActive()
+{
+    if (m_submitBatcher == nullptr || m_scalability == nullptr)
+    {
+        return false;
+    }
+
+    // Multi-pass frames use conditional batch buffer end which would terminate the frames batched
+    // after them, and frame completion must be reported by the status update commands in the frame.
+    return GetPipeNum() == 1 && GetPassNum() == 1 && m_osInterface->bInlineCodecStatusUpdate;
+}
+
+MOS_STATUS EncodePipeline::FlushSubmitBatch()
+{
+    if (m_submitBatcher == nullptr || m_scalability == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    return m_submitBatcher->Flush(m_osInterface, m_scalability);
+}
+
 MOS_STATUS EncodePipeline::ExecuteActivePackets()
 {
     ENCODE_FUNC_CALL();
     MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_START, nullptr, 0, nullptr, 0);
 
+    bool submitBatched = IsSubmitBatchingActive();
+    if (!submitBatched)
+    {
+        // Keep frame order of this stream when it leaves the batcher
+        ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
+    }
+
     for (auto prop : m_activePacketList)
     {
         prop.stateProperty.singleTaskPhaseSupported = m_singleTaskPhaseSupported;
         prop.stateProperty.statusReport = m_statusReport;
+        if (submitBatched)
+        {
+            prop.frameTrackingRequested = false;
+        }
         MOS_TraceEventExt(EVENT_PIPE_EXE, EVENT_TYPE_INFO, &prop.packetId, sizeof(uint32_t), nullptr, 0);
 
         MediaTask *task = prop.packet->GetActiveTask();
         ENCODE_CHK_STATUS_RETURN(task->AddPacket(&prop));
         if (prop.immediateSubmit)
         {
+            task->SetSubmitBatcher(submitBatched ? m_submitBatcher : nullptr);
             ENCODE_CHK_STATUS_RETURN(task->Submit(true, m_scalability, m_debugInterface));
         }
     }
@@ -329,6 +410,7 @@ MOS_STATUS EncodePipeline::ExecuteResolveMetaData(PMOS_RESOURCE pInput, PMOS_RES
     MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
 
     ENCODE_CHK_NULL_RETURN(m_scalability);
+    ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
     ENCODE_CHK_STATUS_RETURN(m_scalability->GetCmdBuffer(&cmdBuffer));
 
     auto basicFeature = dynamic_cast<EncodeBasicFeature *>(m_featureManager->GetFeature(FeatureIDs::basicFeature));
@@ -350,6 +432,7 @@ MOS_STATUS EncodePipeline::ReportErrorFlag(PMOS_RESOURCE pMetadataBuffer,
     MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
 
     ENCODE_CHK_NULL_RETURN(m_scalability);
+    ENCODE_CHK_STATUS_RETURN(FlushSubmitBatch());
     ENCODE_CHK_STATUS_RETURN(m_scalability->GetCmdBuffer(&cmdBuffer));
 
     auto basicFeature = dynamic_cast<EncodeBasicFeature *>(m_featureManager->GetFeature(FeatureIDs::basicFeature));
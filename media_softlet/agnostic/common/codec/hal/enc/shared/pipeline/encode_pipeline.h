@@ -41,6 +41,7 @@
 #include "encodecp.h"
 #include "encode_packet_utilities.h"
 #include "encode_scalability_defs.h"
+#include "media_submit_batcher.h"
 
 #define CONSTRUCTPACKETID(_componentId, _subComponentId, _packetId) \
     (_componentId << 24 | _subComponentId << 16 | _packetId)
@@ -178,6 +179,21 @@ protected:
 
     MOS_STATUS WaitForBatchBufferComplete();
 
+    //!
+    //! \brief  Check if the frames of current pipeline can go through submit batcher
+    //! \return bool
+    //!         true if submit batching is active, else false
+    //!
+    bool IsSubmitBatchingActive();
+
+    //!
+    //! \brief  Submit the frames pending in submit batcher
+    //!         Must be called before waiting for the frames or submitting outside of the batcher
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS FlushSubmitBatch();
+
     //!
     //! \brief  Finish the active packets execution
     //! \return MOS_STATUS
@@ -350,6 +366,8 @@ protected:
 
     std::shared_ptr<EncodeScalabilityPars> m_scalPars = nullptr;
 
+    MediaSubmitBatcher *m_submitBatcher = nullptr;  //!< Submit batcher shared with other small resolution streams
+
 MEDIA_CLASS_DEFINE_END(encode__EncodePipeline)
 };
 
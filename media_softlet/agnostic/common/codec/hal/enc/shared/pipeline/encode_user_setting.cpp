@@ -107,6 +107,34 @@ MOS_STATUS EncodePipeline::InitUserSetting(MediaUserSettingSharedPtr userSetting
         int32_t(1),
         false);
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Encode Submit Batching Enable",
+        MediaUserSetting::Group::Sequence,
+        int32_t(0),
+        false);
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Encode Submit Batching Max Frames",
+        MediaUserSetting::Group::Sequence,
+        int32_t(4),
+        false);
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Encode Submit Batching Max Frame Size",
+        MediaUserSetting::Group::Sequence,
+        int32_t(640 * 480),
+        false);
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Encode Submit Batching Max Delay",
+        MediaUserSetting::Group::Sequence,
+        int32_t(2000),
+        false);
+
     DeclareUserSettingKey(
         userSettingPtr,
         "Disable Media Encode Scalability",
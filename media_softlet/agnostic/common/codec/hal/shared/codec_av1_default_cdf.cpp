@@ -0,0 +1,347 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     codec_av1_default_cdf.cpp
+//! \brief    Implements the default AV1 CDF tables shared by decode and encode
+//!
+
+#include "codec_av1_default_cdf.h"
+#include "media_utils.h"
+#include "mos_utilities.h"
+
+uint16_t       CodecAv1DefaultCdfTable::m_tables[m_tableNum][m_tableBytes / sizeof(uint16_t)] = {};
+MOS_STATUS     CodecAv1DefaultCdfTable::m_tablesStatus = MOS_STATUS_SUCCESS;
+std::once_flag CodecAv1DefaultCdfTable::m_tablesOnce;
+
+std::map<CodecAv1DefaultCdfCache::Key, CodecAv1DefaultCdfCache::Entry> CodecAv1DefaultCdfCache::m_entries;
+std::mutex                                                             CodecAv1DefaultCdfCache::m_entriesMutex;
+
+MOS_STATUS CodecAv1DefaultCdfTable::Init(
+    uint16_t                 *ctxBuffer,
+    uint8_t                  index,
+    Av1CdfTableSyntaxElement begin,
+    Av1CdfTableSyntaxElement end)
+{
+    MEDIA_CHK_NULL_RETURN(ctxBuffer);
+    if (index >= m_tableNum || begin > end || end > syntaxElementMax)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    //initialize the layout and default table info for each syntax element
+    struct SyntaxElementCdfTableLayout syntaxElementsLayout[syntaxElementMax] =
+    {
+    //m_entryCountPerCL, m_entryCountTotal, m_startCL, *m_srcInitBuffer
+    //PartI: Intra
+    { 30,    12  ,    0  ,    (uint16_t *)&defaultPartitionCdf8x8[0][0] },        //    partition_8x8
+    { 27,    108 ,    1  ,    (uint16_t *)&defaultPartitionCdfNxN[0][0] },        //    partition
+    { 28,    28  ,    5  ,    (uint16_t *)&defaultPartitionCdf128x128[0][0] },    //    partition_128x128
+    { 32,    3   ,    6  ,    (uint16_t *)&defaultSkipCdfs[0][0] },               //    skip
+    { 30,    3   ,    7  ,    (uint16_t *)&defaultDeltaQCdf[0] },                 //    delta_q
+    { 30,    3   ,    8  ,    (uint16_t *)&defaultDeltaLfCdf[0] },                //    delta_lf
+    { 30,    12  ,    9  ,    (uint16_t *)&defaultDeltaLfMultiCdf[0][0] },        //    delta_lf_multi
+    { 28,    21  ,    10 ,   (uint16_t *)&defaultSpatialPredSegTreeCdf[0][0] },   //    segment_id
+    { 24,    300 ,    11 ,    (uint16_t *)&defaultKfYModeCdf[0][0][0] },          //    intra_y_mode
+    { 24,    156 ,    24 ,    (uint16_t *)&defaultUvModeCdf0[0][0] },             //    uv_mode_0
+    { 26,    169 ,    31 ,    (uint16_t *)&defaultUvModeCdf1[0][0] },             //    uv_mode_1
+    { 32,    21  ,    38 ,    (uint16_t *)&defaultPaletteYModeCdf[0][0][0] },     //    palette_y_mode
+    { 32,    2   ,    39 ,    (uint16_t *)&defaultPaletteUvModeCdf[0][0] },       //    palette_uv_mode
+    { 30,    42  ,    40 ,    (uint16_t *)&defaultPaletteYSizeCdf[0][0] },        //    palette_y_size
+    { 30,    42  ,    42 ,    (uint16_t *)&defaultPaletteUvSizeCdf[0][0] },       //    palette_uv_size
+    { 30,    312 ,    44 ,    (uint16_t *)&defaultIntraExtTxCdf1[0][0][0] },      //    intra_tx_type_1
+    { 32,    208 ,    55 ,    (uint16_t *)&defaultIntraExtTxCdf2[0][0][0] },      //    intra_tx_type_2
+    { 32,    3   ,    62 ,    (uint16_t *)&defaultTxSizeCdf0[0][0] },             //    depth_0
+    { 32,    18  ,    63 ,    (uint16_t *)&defaultTxSizeCdf[0][0][0] },           //    depth
+    { 28,    7   ,    64 ,    (uint16_t *)&defaultCflSignCdf[0] },                //    cfl_joint_sign
+    { 30,    90  ,    65 ,    (uint16_t *)&defaultCflAlphaCdf[0][0] },            //    cdf_alpha
+    { 30,    48  ,    68 ,    (uint16_t *)&defaultAngleDeltaCdf[0][0] },          //    angle_delta
+    { 32,    5   ,    70 ,    (uint16_t *)&defaultPaletteYColorIndexCdf0[0][0] }, //    palette_y_color_idx_0
+    { 32,    10  ,    71 ,    (uint16_t *)&defaultPaletteYColorIndexCdf1[0][0] }, //    palette_y_color_idx_1
+    { 30,    15  ,    72 ,    (uint16_t *)&defaultPaletteYColorIndexCdf2[0][0] }, //    palette_y_color_idx_2
+    { 32,    20  ,    73 ,    (uint16_t *)&defaultPaletteYColorIndexCdf3[0][0] }, //    palette_y_color_idx_3
+    { 30,    25  ,    74 ,    (uint16_t *)&defaultPaletteYColorIndexCdf4[0][0] }, //    palette_y_color_idx_4
+    { 30,    30  ,    75 ,    (uint16_t *)&defaultPaletteYColorIndexCdf5[0][0] }, //    palette_y_color_idx_5
+    { 28,    35  ,    76 ,    (uint16_t *)&defaultPaletteYColorIndexCdf6[0][0] }, //    palette_y_color_idx_6
+    { 32,    5   ,    78 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf0[0][0] }, //   palette_uv_color_idx_0
+    { 32,    10  ,    79 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf1[0][0] }, //   palette_uv_color_idx_1
+    { 30,    15  ,    80 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf2[0][0] }, //   palette_uv_color_idx_2
+    { 32,    20  ,    81 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf3[0][0] }, //   palette_uv_color_idx_3
+    { 30,    25  ,    82 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf4[0][0] }, //   palette_uv_color_idx_4
+    { 30,    30  ,    83 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf5[0][0] }, //   palette_uv_color_idx_5
+    { 28,    35  ,    84 ,    (uint16_t *)&defaultPaletteUvColorIndexCdf6[0][0] }, //   palette_uv_color_idx_6
+    //coeff cdfs addressed by index
+    { 32,    65  ,    86 ,    (uint16_t *)&av1DefaultTxbSkipCdfs[index][0][0][0] },               //    txb_skip
+    { 32,    16  ,    89 ,    (uint16_t *)&av1DefaultEobMulti16Cdfs[index][0][0][0] },            //    eob_pt_0
+    { 30,    20  ,    90 ,    (uint16_t *)&av1DefaultEobMulti32Cdfs[index][0][0][0] },            //    eob_pt_1
+    { 30,    24  ,    91 ,    (uint16_t *)&av1DefaultEobMulti64Cdfs[index][0][0][0] },            //    eob_pt_2
+    { 28,    28  ,    92 ,    (uint16_t *)&av1DefaultEobMulti128Cdfs[index][0][0][0] },           //    eob_pt_3
+    { 32,    32  ,    93 ,    (uint16_t *)&av1DefaultEobMulti256Cdfs[index][0][0][0] },           //    eob_pt_4
+    { 27,    36  ,    94 ,    (uint16_t *)&av1DefaultEobMulti512Cdfs[index][0][0][0] },           //    eob_pt_5
+    { 30,    40  ,    96 ,    (uint16_t *)&av1DefaultEobMulti1024Cdfs[index][0][0][0] },          //    eob_pt_6
+    { 32,    90  ,    98 ,    (uint16_t *)&av1DefaultEobExtraCdfs[index][0][0][0][0] },           //    eob_extra
+    { 32,    80  ,    101,    (uint16_t *)&av1DefaultCoeffBaseEobMultiCdfs[index][0][0][0][0] },  //    coeff_base_eob
+    { 30,    1260,    104,    (uint16_t *)&av1DefaultCoeffBaseMultiCdfs[index][0][0][0][0] },     //    coeff_base
+    { 32,    6   ,    146,    (uint16_t *)&av1DefaultDcSignCdfs[index][0][0][0] },                //    dc_sign
+    { 30,    630 ,    147,    (uint16_t *)&av1DefaultCoeffLpsMultiCdfs[index][0][0][0][0] },      //    coeff_br
+    { 32,    2   ,    168,    (uint16_t *)&defaultSwitchableRestoreCdf[0] },  //    switchable_restore
+    { 32,    1   ,    169,    (uint16_t *)&defaultWienerRestoreCdf[0] },      //    wiener_restore
+    { 32,    1   ,    170,    (uint16_t *)&defaultSgrprojRestoreCdf[0] },     //    sgrproj_restore
+    { 32,    1   ,    171,    (uint16_t *)&defaultIntrabcCdf[0] },            //    use_intrabc
+    { 32,    22  ,    172,    (uint16_t *)&default_filter_intra_cdfs[0][0] }, //    use_filter_intra
+    { 32,    4   ,    173,    (uint16_t *)&defaultFilterIntraModeCdf[0] },    //    filter_intra_mode
+    { 30,    3   ,    174,    (uint16_t *)&defaultJointCdf[0] },              //    dv_joint_type
+    { 32,    2   ,    175,    (uint16_t *)&defaultSignCdf[0][0] },            //    dv_sign
+    { 32,    20  ,    176,    (uint16_t *)&defaultBitsCdf[0][0][0] },         //    dv_sbits
+    { 30,    20  ,    177,    (uint16_t *)&defaultClassesCdf[0][0] },         //    dv_class
+    { 32,    2   ,    178,    (uint16_t *)&defaultClass0Cdf[0][0] },          //    dv_class0
+    { 30,    6   ,    179,    (uint16_t *)&defaultFpCdf[0][0] },              //    dv_fr
+    { 30,    12  ,    180,    (uint16_t *)&defaultClass0FpCdf[0][0][0] },     //    dv_class0_fr
+    { 32,    2   ,    181,    (uint16_t *)&defaultHpCdf[0][0] },              //    dv_hp
+    { 32,    2   ,    182,    (uint16_t *)&defaultClass0HpCdf[0][0] },        //    dv_class0_hp
+    //PartII: Inter
+    { 32,    3   ,    183,    (uint16_t *)&defaultSkipModeCdfs[0][0] },           //    skip_mode
+    { 32,    3   ,    184,    (uint16_t *)&defaultSegmentPredCdf[0][0] },         //    pred_seg_id
+    { 24,    48  ,    185,    (uint16_t *)&defaultIfYModeCdf[0][0] },             //    y_mode
+    { 30,    60  ,    187,    (uint16_t *)&defaultInterExtTxCdf1[0][0] },         //    inter_tx_type_1
+    { 22,    44  ,    189,    (uint16_t *)&defaultInterExtTxCdf2[0][0] },         //    inter_tx_type_2
+    { 32,    4   ,    191,    (uint16_t *)&defaultInterExtTxCdf3[0][0] },         //    inter_tx_type_3
+    { 32,    4   ,    192,    (uint16_t *)&defaultIntraInterCdf[0][0] },          //    is_inter
+    { 32,    21  ,    193,    (uint16_t *)&defaultTxfmPartitionCdf[0][0] },       //    tx_split
+    { 32,    5   ,    194,    (uint16_t *)&defaultCompInterCdf[0][0] },           //    ref_mode
+    { 32,    5   ,    195,    (uint16_t *)&defaultCompRefTypeCdf[0][0] },         //    comp_ref_type
+    { 32,    9   ,    196,    (uint16_t *)&defaultUniCompRefCdf[0][0][0] },       //    unidir_comp_ref
+    { 32,    9   ,    197,    (uint16_t *)&defaultCompRefCdf[0][0][0] },          //    ref_bit
+    { 32,    6   ,    198,    (uint16_t *)&defaultCompBwdrefCdf[0][0][0] },       //    ref_bit_bwd
+    { 32,    18  ,    199,    (uint16_t *)&defaultSingleRefCdf[0][0][0] },        //    single_ref_bit
+    { 28,    56  ,    200,    (uint16_t *)&defaultInterCompoundModeCdf[0][0] },   //    inter_compound_mode
+    { 32,    6   ,    202,    (uint16_t *)&defaultNewmvCdf[0][0] },               //    is_newmv
+    { 32,    2   ,    203,    (uint16_t *)&defaultZeromvCdf[0][0] },              //    is_zeromv
+    { 32,    6   ,    204,    (uint16_t *)&defaultRefmvCdf[0][0] },               //    is_refmv
+    { 30,    3   ,    205,    (uint16_t *)&defaultJointCdf[0] },                  //    mv_joint_type
+    { 32,    2   ,    206,    (uint16_t *)&defaultSignCdf[0][0] },                //    mv_sign
+    { 32,    20  ,    207,    (uint16_t *)&defaultBitsCdf[0][0][0] },             //    mv_sbits
+    { 30,    20  ,    208,    (uint16_t *)&defaultClassesCdf[0][0] },             //    mv_class
+    { 32,    2   ,    209,    (uint16_t *)&defaultClass0Cdf[0][0] },              //    mv_class0
+    { 30,    6   ,    210,    (uint16_t *)&defaultFpCdf[0][0] },                  //    mv_fr
+    { 30,    12  ,    211,    (uint16_t *)&defaultClass0FpCdf[0][0][0] },         //    mv_class0_fr
+    { 32,    2   ,    212,    (uint16_t *)&defaultHpCdf[0][0] },                  //    mv_hp
+    { 32,    2   ,    213,    (uint16_t *)&defaultClass0HpCdf[0][0] },            //    mv_class0_hp
+    { 32,    4   ,    214,    (uint16_t *)&defaultInterintraCdf[0][0] },          //    interintra
+    { 30,    12  ,    215,    (uint16_t *)&defaultInterintraModeCdf[0][0] },      //    interintra_mode
+    { 32,    22  ,    216,    (uint16_t *)&defaultWedgeInterintraCdf[0][0] },     //    use_wedge_interintra
+    { 30,    330 ,    217,    (uint16_t *)&defaultWedgeIdxCdf[0][0] },            //    wedge_index
+    { 32,    3   ,    228,    (uint16_t *)&defaultDrlCdf[0][0] },                 //    drl_idx
+    { 32,    22  ,    229,    (uint16_t *)&defaultObmcCdf[0][0] },                //    obmc_motion_mode
+    { 32,    44  ,    230,    (uint16_t *)&defaultMotionModeCdf[0][0] },          //    non_obmc_motion_mode
+    { 32,    6   ,    232,    (uint16_t *)&defaultCompGroupIdxCdfs[0][0] },       //    comp_group_idx
+    { 32,    6   ,    233,    (uint16_t *)&defaultCompoundIdxCdfs[0][0] },        //    compound_idx
+    { 32,    22  ,    234,    (uint16_t *)&defaultCompoundTypeCdf[0][0] },        //    interinter_compound_type
+    { 32,    32  ,    235,    (uint16_t *)&defaultSwitchableInterpCdf[0][0] },    //    switchable_interp
+    };
+
+    for (auto idx = (uint32_t)begin; idx < (uint32_t)end; idx++)
+    {
+        MEDIA_CHK_STATUS_RETURN(InitSyntaxElement(
+            ctxBuffer,
+            syntaxElementsLayout[idx]));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS CodecAv1DefaultCdfTable::InitSyntaxElement(
+    uint16_t                          *ctxBuffer,
+    const SyntaxElementCdfTableLayout &syntaxElement)
+{
+    MEDIA_CHK_NULL_RETURN(ctxBuffer);
+    MEDIA_CHK_NULL_RETURN(syntaxElement.m_srcInitBuffer);
+
+    uint16_t    entryCountPerCL = syntaxElement.m_entryCountPerCL;  //one entry means one uint16_t value
+    uint16_t    entryCountTotal = syntaxElement.m_entryCountTotal;  //total number of entrie for this Syntax element's CDF tables
+    uint16_t    startCL         = syntaxElement.m_startCL;
+
+    uint16_t *src = syntaxElement.m_srcInitBuffer;
+    uint16_t *dst = ctxBuffer + startCL * 32;   //one CL equals to 32 uint16_t
+    uint16_t entryCountLeft = entryCountTotal;
+    while (entryCountLeft >= entryCountPerCL)
+    {
+        //copy one CL
+        MOS_SecureMemcpy(dst, entryCountPerCL * sizeof(uint16_t), src, entryCountPerCL * sizeof(uint16_t));
+        entryCountLeft -= entryCountPerCL;
+
+        //go to next CL
+        src += entryCountPerCL;
+        dst += 32;
+    };
+    //copy the remaining which are less than a CL
+    if (entryCountLeft > 0)
+    {
+        MOS_SecureMemcpy(dst, entryCountLeft * sizeof(uint16_t), src, entryCountLeft * sizeof(uint16_t));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS CodecAv1DefaultCdfTable::Copy(uint16_t *ctxBuffer, uint8_t index)
+{
+    MEDIA_CHK_NULL_RETURN(ctxBuffer);
+    if (index >= m_tableNum)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    // Tables only depend on the spec, so they are laid out once for all contexts of the process
+    std::call_once(m_tablesOnce, []() {
+        for (uint8_t i = 0; i < m_tableNum && m_tablesStatus == MOS_STATUS_SUCCESS; i++)
+        {
+            m_tablesStatus = Init(m_tables[i], i);
+        }
+    });
+    MEDIA_CHK_STATUS_RETURN(m_tablesStatus);
+
+    return MOS_SecureMemcpy(ctxBuffer, m_tableBytes, m_tables[index], m_tableBytes);
+}
+
+bool CodecAv1DefaultCdfCache::Key::operator<(const Key &other) const
+{
+    if (device != other.device)
+    {
+        return device < other.device;
+    }
+    if (firstIndex != other.firstIndex)
+    {
+        return firstIndex < other.firstIndex;
+    }
+    if (tableNum != other.tableNum)
+    {
+        return tableNum < other.tableNum;
+    }
+    if (tableStride != other.tableStride)
+    {
+        return tableStride < other.tableStride;
+    }
+    return resUsageType < other.resUsageType;
+}
+
+CodecAv1DefaultCdfCache::Key CodecAv1DefaultCdfCache::GetKey(PMOS_INTERFACE osInterface, const Params &params)
+{
+    Key key = {};
+    // Buffer objects can only be shared within the device they are created on, os interface
+    // without device context still works but does not share with other contexts.
+    key.device = (osInterface->osStreamState && osInterface->osStreamState->osDeviceContext) ?
+                 (void *)osInterface->osStreamState->osDeviceContext : (void *)osInterface;
+    key.firstIndex   = params.firstIndex;
+    key.tableNum     = params.tableNum;
+    key.tableStride  = params.tableStride;
+    key.resUsageType = params.resUsageType;
+    return key;
+}
+
+MOS_STATUS CodecAv1DefaultCdfCache::Acquire(PMOS_INTERFACE osInterface, const Params &params, MOS_RESOURCE &resource)
+{
+    MEDIA_CHK_NULL_RETURN(osInterface);
+    if (params.tableNum == 0 || params.firstIndex + params.tableNum > CodecAv1DefaultCdfTable::m_tableNum ||
+        params.tableStride < CodecAv1DefaultCdfTable::m_tableBytes || params.tableStride % sizeof(uint16_t) != 0)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    Key key = GetKey(osInterface, params);
+
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end())
+    {
+        it->second.refCount++;
+        resource = it->second.resource;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    Entry entry = {};
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    MOS_ZeroMemory(&allocParams, sizeof(allocParams));
+    allocParams.Type         = MOS_GFXRES_BUFFER;
+    allocParams.TileType     = MOS_TILE_LINEAR;
+    allocParams.Format       = Format_Buffer;
+    allocParams.dwBytes      = params.tableStride * params.tableNum;
+    allocParams.pBufName     = params.bufName;
+    allocParams.ResUsageType = params.resUsageType;
+    MEDIA_CHK_STATUS_RETURN(osInterface->pfnAllocateResource(osInterface, &allocParams, &entry.resource));
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(lockFlags));
+    lockFlags.WriteOnly = 1;
+    uint8_t   *data     = (uint8_t *)osInterface->pfnLockResource(osInterface, &entry.resource, &lockFlags);
+    MOS_STATUS status   = MOS_STATUS_NULL_POINTER;
+    if (data != nullptr)
+    {
+        for (uint8_t i = 0; i < params.tableNum; i++)
+        {
+            status = CodecAv1DefaultCdfTable::Copy((uint16_t *)(data + params.tableStride * i), params.firstIndex + i);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                break;
+            }
+        }
+        osInterface->pfnUnlockResource(osInterface, &entry.resource);
+    }
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        osInterface->pfnFreeResource(osInterface, &entry.resource);
+        return status;
+    }
+
+    entry.refCount = 1;
+    m_entries[key] = entry;
+    resource       = entry.resource;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void CodecAv1DefaultCdfCache::Release(PMOS_INTERFACE osInterface, const Params &params)
+{
+    if (osInterface == nullptr)
+    {
+        return;
+    }
+
+    Key key = GetKey(osInterface, params);
+
+    std::lock_guard<std::mutex> lock(m_entriesMutex);
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        MEDIA_ASSERTMESSAGE("Release default cdf buffer which is not acquired!");
+        return;
+    }
+
+    if (--it->second.refCount > 0)
+    {
+        return;
+    }
+
+    osInterface->pfnFreeResource(osInterface, &it->second.resource);
+    m_entries.erase(it);
+}
@@ -0,0 +1,162 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     codec_av1_default_cdf.h
+//! \brief    Defines the default AV1 CDF tables shared by decode and encode
+//! \details  The 4 default tables (one per coeff cdf q context) are laid out for AVP
+//!           once per process. Read-only GPU copies are reference counted and shared
+//!           by all codec contexts created on the same device.
+//!
+
+#ifndef __CODEC_AV1_DEFAULT_CDF_H__
+#define __CODEC_AV1_DEFAULT_CDF_H__
+
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include "codec_def_common_av1.h"
+#include "media_class_trace.h"
+
+class CodecAv1DefaultCdfTable
+{
+public:
+    static const uint32_t m_tableNum   = 4;      //!< One default table per coeff cdf q context
+    static const uint32_t m_tableBytes = 15104;  //!< Bytes of one table, which equals to 236*64 (236 Cache Lines)
+
+    //!
+    //! \brief  Get coeff cdf q context, which is the index of default table
+    //! \param  [in] baseQindex
+    //!         base_qindex of the frame
+    //! \return uint8_t
+    //!         Index in [0, m_tableNum)
+    //!
+    static uint8_t GetCoeffCdfQCtx(uint32_t baseQindex)
+    {
+        if (baseQindex <= 20)       return 0;
+        else if (baseQindex <= 60)  return 1;
+        else if (baseQindex <= 120) return 2;
+        else                        return 3;
+    }
+
+    //!
+    //! \brief  Lay out default CDF of syntax elements in [begin, end) into AVP table
+    //! \param  [out] ctxBuffer
+    //!         Table of m_tableBytes
+    //! \param  [in] index
+    //!         Coeff cdf q context
+    //! \param  [in] begin
+    //!         First syntax element
+    //! \param  [in] end
+    //!         Syntax element after the last one
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS Init(
+        uint16_t                 *ctxBuffer,
+        uint8_t                  index,
+        Av1CdfTableSyntaxElement begin = partition8x8,
+        Av1CdfTableSyntaxElement end   = syntaxElementMax);
+
+    //!
+    //! \brief  Copy default table of all syntax elements, which is laid out once per process
+    //! \param  [out] ctxBuffer
+    //!         Table of m_tableBytes
+    //! \param  [in] index
+    //!         Coeff cdf q context
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS Copy(uint16_t *ctxBuffer, uint8_t index);
+
+protected:
+    static MOS_STATUS InitSyntaxElement(
+        uint16_t                          *ctxBuffer,
+        const SyntaxElementCdfTableLayout &syntaxElement);
+
+    static uint16_t       m_tables[m_tableNum][m_tableBytes / sizeof(uint16_t)];  //!< Tables laid out by first Copy()
+    static MOS_STATUS     m_tablesStatus;
+    static std::once_flag m_tablesOnce;
+
+MEDIA_CLASS_DEFINE_END(CodecAv1DefaultCdfTable)
+};
+
+class CodecAv1DefaultCdfCache
+{
+public:
+    struct Params
+    {
+        uint8_t             firstIndex;    //!< Coeff cdf q context of the first table
+        uint8_t             tableNum;      //!< Tables packed into the buffer
+        uint32_t            tableStride;   //!< Bytes from one table to the next, not less than m_tableBytes
+        MOS_HW_RESOURCE_DEF resUsageType;  //!< Cache policy of the buffer
+        const char         *bufName;
+    };
+
+    //!
+    //! \brief  Get read-only buffer of default tables, allocated by the first user on the device
+    //! \param  [in] osInterface
+    //!         Os interface of the codec context
+    //! \param  [in] params
+    //!         Layout of the buffer, users with different layout do not share
+    //! \param  [out] resource
+    //!         Copy of the shared resource, which must not be written or freed by caller
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS Acquire(PMOS_INTERFACE osInterface, const Params &params, MOS_RESOURCE &resource);
+
+    //!
+    //! \brief  Drop reference got by Acquire(), the last user frees the buffer
+    //! \param  [in] osInterface
+    //!         Os interface of the codec context
+    //! \param  [in] params
+    //!         Same params passed to Acquire()
+    //!
+    static void Release(PMOS_INTERFACE osInterface, const Params &params);
+
+protected:
+    struct Key
+    {
+        void               *device;
+        uint32_t            firstIndex;
+        uint32_t            tableNum;
+        uint32_t            tableStride;
+        MOS_HW_RESOURCE_DEF resUsageType;
+
+        bool operator<(const Key &other) const;
+    };
+
+    struct Entry
+    {
+        MOS_RESOURCE resource;
+        uint32_t     refCount;
+    };
+
+    static Key GetKey(PMOS_INTERFACE osInterface, const Params &params);
+
+    static std::map<Key, Entry> m_entries;
+    static std::mutex           m_entriesMutex;
+
+MEDIA_CLASS_DEFINE_END(CodecAv1DefaultCdfCache)
+};
+
+#endif  // !__CODEC_AV1_DEFAULT_CDF_H__
@@ -24,11 +24,13 @@ set(TMP_HEADERS_ "")
 
 set(TMP_SOURCES_
     ${TMP_SOURCES_}
+    ${CMAKE_CURRENT_LIST_DIR}/codec_av1_default_cdf.cpp
     ${CMAKE_CURRENT_LIST_DIR}/codec_hw_next.cpp
 )
 
 set(TMP_HEADERS_
     ${TMP_HEADERS_}
+    ${CMAKE_CURRENT_LIST_DIR}/codec_av1_default_cdf.h
     ${CMAKE_CURRENT_LIST_DIR}/codec_hw_next.h
     ${CMAKE_CURRENT_LIST_DIR}/codec_utilities_next.h
 )
@@ -38,6 +38,8 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_rtlog_mgr_base.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_cache_manager.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_worker_pool.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_tile_row_shadow.cpp
 )
 
 set(TMP_HEADERS_
@@ -60,6 +62,8 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/memory_policy_manager.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_oca_rtlog_mgr_base.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_cache_manager.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_worker_pool.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_tile_row_shadow.h
 )
 
 set(TMP_MOS_HAL_SHARED_SOURCES_
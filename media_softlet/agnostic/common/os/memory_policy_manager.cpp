@@ -24,6 +24,9 @@
 //! \brief    Defines interfaces for media memory policy manager.
 
 #include "memory_policy_manager.h"
+#include "mos_util_user_feature_keys.h"
+
+std::once_flag MemoryPolicyManager::m_cpuPolicyInitOnce;
 
 int MemoryPolicyManager::UpdateMemoryPolicy(
     MemoryPolicyParameter* memPolicyPar)
@@ -99,3 +102,40 @@ int MemoryPolicyManager::UpdateMemoryPolicy(
 
     return mem_type;
 }
+
+void MemoryPolicyManager::InitCpuMemoryPolicy(MediaUserSettingSharedPtr userSettingPtr)
+{
+    std::call_once(m_cpuPolicyInitOnce, [&userSettingPtr]() {
+        CpuMemoryPolicy policy;
+        uint32_t        value = 0;
+
+        ReadUserSetting(
+            userSettingPtr,
+            value,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_HUGE_PAGE_ENABLE,
+            MediaUserSetting::Group::Device);
+        policy.hugePageEnabled = (value != 0);
+
+        value = 0;
+        ReadUserSetting(
+            userSettingPtr,
+            value,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_NUMA_LOCAL_ENABLE,
+            MediaUserSetting::Group::Device);
+        policy.numaLocalEnabled = (value != 0);
+
+        value = 0;
+        ReadUserSetting(
+            userSettingPtr,
+            value,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_MIN_SIZE,
+            MediaUserSetting::Group::Device);
+        // Policy works on whole pages, smaller allocations would share pages with heap
+        policy.minSize = MOS_MAX(value, MOS_PAGE_SIZE);
+
+        SetCpuMemoryPolicy(policy);
+
+        MOS_OS_NORMALMESSAGE("CPU memory policy: huge page %d, NUMA local %d, min size %zu",
+            policy.hugePageEnabled, policy.numaLocalEnabled, policy.minSize);
+    });
+}
@@ -27,6 +27,8 @@
 #ifndef __MEMORY_POLICY_MANAGER_H__
 #define __MEMORY_POLICY_MANAGER_H__
 
+#include <atomic>
+#include <mutex>
 #include "mos_os.h"
 
 //! \param   [in] skuTable
@@ -52,6 +54,30 @@ struct MemoryPolicyParameter
     bool isServer;
 };
 
+//! \brief   Placement policy of CPU visible memory, read from user settings
+//! \param   hugePageEnabled
+//!          Back allocations not smaller than minSize by transparent huge pages
+//! \param   numaLocalEnabled
+//!          Prefer NUMA node of the allocating thread for allocations not smaller than minSize
+//! \param   minSize
+//!          Min size in bytes of allocations placed by the policy
+struct CpuMemoryPolicy
+{
+    bool   hugePageEnabled  = false;
+    bool   numaLocalEnabled = false;
+    size_t minSize          = 0x200000;
+};
+
+//! \brief   Counters of CPU memory policy
+struct CpuMemoryPolicyCounters
+{
+    uint64_t allocCount;       //!< Allocations placed by the policy
+    uint64_t hugePageCount;    //!< Allocations and mappings advised to use huge pages
+    uint64_t numaLocalCount;   //!< Allocations and mappings bound to local NUMA node
+    uint64_t fallbackCount;    //!< Allocations or advices the kernel refused
+    uint64_t mapCount;         //!< Buffer object mappings placed by the policy
+};
+
 class MemoryPolicyManager
 {
 
@@ -66,6 +92,68 @@ public:
     //! \return  new memory policy
     static int UpdateMemoryPolicy(MemoryPolicyParameter* memPolicyPar);
 
+    //! \brief   Initializes CPU memory policy
+    //!
+    //! \details Reads huge page and NUMA placement settings. Policy is process wide, settings are
+    //!          read once by the first device and kept for following devices.
+    //! \param   [in] userSettingPtr
+    //!          User setting instance of the device
+    //!
+    //! \return  void
+    static void InitCpuMemoryPolicy(MediaUserSettingSharedPtr userSettingPtr);
+
+    //! \brief   Sets CPU memory policy
+    //!
+    //! \details Memory allocated before keeps its placement and is still released by FreeCpuMemory.
+    //! \param   [in] policy
+    //!          New policy
+    //!
+    //! \return  void
+    static void SetCpuMemoryPolicy(const CpuMemoryPolicy &policy);
+
+    //! \brief   Gets CPU memory policy
+    //!
+    //! \return  snapshot of current policy
+    static CpuMemoryPolicy GetCpuMemoryPolicy();
+
+    //! \brief   Allocates CPU memory following CPU memory policy
+    //!
+    //! \details Allocations smaller than policy min size, or with policy disabled, come from heap.
+    //! \param   [in] size
+    //!          Size in bytes
+    //! \param   [in] zero
+    //!          Fill memory with 0
+    //!
+    //! \return  pointer to memory, nullptr if failed. Must be released by FreeCpuMemory
+    static void *AllocCpuMemory(size_t size, bool zero = false);
+
+    //! \brief   Frees memory allocated by AllocCpuMemory
+    //!
+    //! \param   [in] ptr
+    //!          Pointer returned by AllocCpuMemory, could be nullptr
+    //!
+    //! \return  void
+    static void FreeCpuMemory(void *ptr);
+
+    //! \brief   Applies CPU memory policy to CPU mapping of a buffer object
+    //!
+    //! \details Advice only, kernel decides if pages backing the buffer object follow it.
+    //! \param   [in] addr
+    //!          Start of the mapping
+    //! \param   [in] size
+    //!          Size of the mapping
+    //!
+    //! \return  void
+    static void ApplyCpuMappingPolicy(void *addr, size_t size);
+
+    //! \brief   Gets counters of CPU memory policy
+    //!
+    //! \param   [out] counters
+    //!          Counters since process start
+    //!
+    //! \return  void
+    static void GetCpuMemoryPolicyCounters(CpuMemoryPolicyCounters &counters);
+
 private:
 
     //! \brief   Updates resource memory policy with WA
@@ -80,6 +168,22 @@ private:
     //! \return  new memory policy
     static int UpdateMemoryPolicyWithWA(MemoryPolicyParameter* memPolicyPar, int& mem_type);
 
+    //! \brief   Advises huge pages and local NUMA node for a range not touched yet
+    //!
+    //! \return  void
+    static void AdviseCpuMemory(const CpuMemoryPolicy &policy, void *addr, size_t size);
+
+    // Read by allocating threads of all devices, so kept in atomic fields
+    static std::atomic<bool>     m_hugePageEnabled;
+    static std::atomic<bool>     m_numaLocalEnabled;
+    static std::atomic<size_t>   m_minSize;
+    static std::once_flag        m_cpuPolicyInitOnce;
+    static std::atomic<uint64_t> m_allocCount;
+    static std::atomic<uint64_t> m_hugePageCount;
+    static std::atomic<uint64_t> m_numaLocalCount;
+    static std::atomic<uint64_t> m_fallbackCount;
+    static std::atomic<uint64_t> m_mapCount;
+
 MEDIA_CLASS_DEFINE_END(MemoryPolicyManager)
 };
 
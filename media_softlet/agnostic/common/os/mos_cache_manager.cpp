@@ -36,7 +36,7 @@ public:
 
     static bool GetCacheSetting(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf);
 
-    static bool Register(CACHE_COMPONENTS id, std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheTablesPtr)
+    static bool Register(CACHE_COMPONENTS id, const MOS_CACHE_TABLE *cacheTablesPtr)
     {
         if (GetInst().m_dataSet[id] == nullptr)
         {
@@ -52,7 +52,7 @@ private:
         return inst;
     }
 
-    std::map<uint64_t, MOS_CACHE_ELEMENT> *m_dataSet[MAX_CACHE_COMPONENTS] = {};
+    const MOS_CACHE_TABLE *m_dataSet[MAX_CACHE_COMPONENTS] = {};
 
     MEDIA_CLASS_DEFINE_END(MosCacheManager)
 };
@@ -67,17 +67,30 @@ MosCacheManager::~MosCacheManager()
 
 bool MosCacheManager::GetCacheSetting(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf)
 {
-    auto &inst = GetInst();
-    uint64_t usage = MOS_CACHE_OBJECT(id, feature, isHeapSurf, bOut, engineType).value;
-    for (int i = 0; i < MAX_CACHE_COMPONENTS; i++)
+    auto    &inst       = GetInst();
+    uint64_t surfaceKey = static_cast<uint64_t>(feature) + !isHeapSurf * HEAP_MAX;
+    if (static_cast<uint32_t>(engineType) < MOS_CACHE_ENGINE_TYPE_NUM)
     {
-        if (inst.m_dataSet[i])
+        for (int i = 0; i < MAX_CACHE_COMPONENTS; i++)
         {
-            std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheMap = static_cast<std::map<uint64_t, MOS_CACHE_ELEMENT> *>(GetInst().m_dataSet[i]);
-            auto                        it       = cacheMap->find(usage);
-            if (it != cacheMap->end())
+            const MOS_CACHE_TABLE *table = inst.m_dataSet[i];
+            if (table == nullptr ||
+                static_cast<uint32_t>(id) < table->firstComponent ||
+                static_cast<uint32_t>(id) - table->firstComponent >= table->componentCount ||
+                surfaceKey >= table->surfaceKeyCount)
             {
-                element = it->second;
+                continue;
+            }
+
+            const MOS_CACHE_ELEMENT &entry = table->elements[MosCacheTableIndex(
+                static_cast<uint32_t>(id) - table->firstComponent,
+                static_cast<uint32_t>(surfaceKey),
+                bOut ? 1 : 0,
+                static_cast<uint32_t>(engineType),
+                table->surfaceKeyCount)];
+            if (entry.mocsUsageType != MOS_HW_RESOURCE_DEF_MAX)
+            {
+                element = entry;
                 return true;
             }
         }
@@ -86,7 +99,7 @@ bool MosCacheManager::GetCacheSetting(MOS_COMPONENT id, uint32_t feature, bool b
     return false;
 }
 
-bool RegisterCacheSettings(CACHE_COMPONENTS id, std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheTablesPtr)
+bool RegisterCacheSettings(CACHE_COMPONENTS id, const MOS_CACHE_TABLE *cacheTablesPtr)
 {
     return MosCacheManager::Register(id, cacheTablesPtr);
 }
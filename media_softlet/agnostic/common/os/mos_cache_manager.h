@@ -54,11 +54,17 @@ enum CACHE_COMPONENTS
     MAX_CACHE_COMPONENTS
 };
 
+#define MOS_CACHE_ENGINE_TYPE_NUM (VDBOX_ENGINE + 1)
+
 struct MOS_CACHE_ELEMENT
 {
     MOS_HW_RESOURCE_DEF mocsUsageType;
     MOS_HW_RESOURCE_DEF patIndex;
-    MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_DEF _mocsUsageType, MOS_HW_RESOURCE_DEF _patIndex) : 
+    constexpr MOS_CACHE_ELEMENT() :
+        mocsUsageType(MOS_HW_RESOURCE_DEF_MAX), patIndex(MOS_HW_RESOURCE_DEF_MAX)
+    {
+    }
+    constexpr MOS_CACHE_ELEMENT(MOS_HW_RESOURCE_DEF _mocsUsageType, MOS_HW_RESOURCE_DEF _patIndex) : 
         mocsUsageType(_mocsUsageType), patIndex(_patIndex)
     {
     }
@@ -67,14 +73,109 @@ struct MOS_CACHE_ELEMENT
 struct MOS_CACHE_OBJECT
 {
     uint64_t value;
-    MOS_CACHE_OBJECT(MOS_COMPONENT _componentId, uint32_t _surfaceType, bool _isHeap, bool _isOutput, ENGINE_TYPE _engineType) :
+    constexpr MOS_CACHE_OBJECT(MOS_COMPONENT _componentId, uint32_t _surfaceType, bool _isHeap, bool _isOutput, ENGINE_TYPE _engineType) :
         value( (static_cast<uint64_t>(_componentId) << 60) | (static_cast<uint64_t>(_surfaceType + !_isHeap * HEAP_MAX ) << 28) | \
             (static_cast<uint64_t>(_isOutput) << 27) | (static_cast<uint64_t>(_engineType) << 23))
     {
     }
+
+    static constexpr uint32_t Component(uint64_t value)  { return static_cast<uint32_t>(value >> 60); }
+    static constexpr uint32_t SurfaceKey(uint64_t value) { return static_cast<uint32_t>(value >> 28) & 0xffffffff; }
+    static constexpr uint32_t IsOutput(uint64_t value)   { return static_cast<uint32_t>(value >> 27) & 1; }
+    static constexpr uint32_t EngineType(uint64_t value) { return static_cast<uint32_t>(value >> 23) & 0xf; }
 } ;
 
-bool RegisterCacheSettings(CACHE_COMPONENTS id, std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheTablesPtr);
+//!
+//! \brief  Cache setting of one cache object, row of cache setting lists
+//!
+struct MOS_CACHE_SETTING
+{
+    uint64_t          cacheObject;  //!< MOS_CACHE_OBJECT::value
+    MOS_CACHE_ELEMENT element;
+};
+
+//!
+//! \brief  Dense cache setting table, which is registered to cache manager
+//! \details Elements are indexed by component, surface key, isOutput and engine type,
+//!          where surface key is surface type + !isHeap * HEAP_MAX as in MOS_CACHE_OBJECT.
+//!          mocsUsageType of absent element is MOS_HW_RESOURCE_DEF_MAX.
+//!
+struct MOS_CACHE_TABLE
+{
+    uint32_t                 firstComponent;
+    uint32_t                 componentCount;
+    uint32_t                 surfaceKeyCount;
+    const MOS_CACHE_ELEMENT *elements;
+};
+
+template <uint32_t componentCount, uint32_t surfaceKeyCount>
+struct MosCacheTableData
+{
+    MOS_CACHE_ELEMENT elements[componentCount * surfaceKeyCount * 2 * MOS_CACHE_ENGINE_TYPE_NUM];
+};
+
+constexpr uint32_t MosCacheTableIndex(uint32_t component, uint32_t surfaceKey, uint32_t isOutput, uint32_t engineType, uint32_t surfaceKeyCount)
+{
+    return ((component * surfaceKeyCount + surfaceKey) * 2 + isOutput) * MOS_CACHE_ENGINE_TYPE_NUM + engineType;
+}
+
+//!
+//! \brief    Validate cache setting list at compile time
+//! \return   bool
+//!           true if all rows are in table range, and the same cache object is not set differently
+//!
+template <size_t settingCount>
+constexpr bool MosValidateCacheSettings(const MOS_CACHE_SETTING (&settings)[settingCount], uint32_t firstComponent, uint32_t componentCount, uint32_t surfaceKeyCount)
+{
+    for (size_t i = 0; i < settingCount; i++)
+    {
+        uint64_t object = settings[i].cacheObject;
+        if (MOS_CACHE_OBJECT::Component(object) < firstComponent ||
+            MOS_CACHE_OBJECT::Component(object) - firstComponent >= componentCount ||
+            MOS_CACHE_OBJECT::SurfaceKey(object) >= surfaceKeyCount ||
+            MOS_CACHE_OBJECT::EngineType(object) >= MOS_CACHE_ENGINE_TYPE_NUM ||
+            (object & ((1ULL << 23) - 1)) != 0 ||
+            settings[i].element.mocsUsageType >= MOS_HW_RESOURCE_DEF_MAX ||
+            settings[i].element.patIndex >= MOS_HW_RESOURCE_DEF_MAX)
+        {
+            return false;
+        }
+        for (size_t j = 0; j < i; j++)
+        {
+            if (settings[j].cacheObject == object &&
+                (settings[j].element.mocsUsageType != settings[i].element.mocsUsageType ||
+                 settings[j].element.patIndex != settings[i].element.patIndex))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//!
+//! \brief    Build dense cache setting table from cache setting list at compile time
+//! \details  The list is expected to pass MosValidateCacheSettings().
+//!
+template <uint32_t componentCount, uint32_t surfaceKeyCount, size_t settingCount>
+constexpr MosCacheTableData<componentCount, surfaceKeyCount> MosBuildCacheTable(const MOS_CACHE_SETTING (&settings)[settingCount], uint32_t firstComponent)
+{
+    MosCacheTableData<componentCount, surfaceKeyCount> data = {};
+    for (size_t i = 0; i < settingCount; i++)
+    {
+        uint64_t object = settings[i].cacheObject;
+        uint32_t index  = MosCacheTableIndex(
+            MOS_CACHE_OBJECT::Component(object) - firstComponent,
+            MOS_CACHE_OBJECT::SurfaceKey(object),
+            MOS_CACHE_OBJECT::IsOutput(object),
+            MOS_CACHE_OBJECT::EngineType(object),
+            surfaceKeyCount);
+        data.elements[index] = settings[i].element;
+    }
+    return data;
+}
+
+bool RegisterCacheSettings(CACHE_COMPONENTS id, const MOS_CACHE_TABLE *cacheTablesPtr);
 
 bool LoadCacheSettings(MOS_COMPONENT id, uint32_t feature, bool bOut, ENGINE_TYPE engineType, MOS_CACHE_ELEMENT &element, bool isHeapSurf);
 
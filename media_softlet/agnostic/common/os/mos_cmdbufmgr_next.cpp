@@ -31,7 +31,14 @@ CmdBufMgrNext::CmdBufMgrNext()
     MOS_OS_FUNCTION_ENTER;
 
     m_availableCmdBufPool.clear();
-    m_inUseCmdBufPool.clear();
+    m_cmdBufList.clear();
+    for (auto &sizeClass : m_sizeClasses)
+    {
+        for (auto &slot : sizeClass.slots)
+        {
+            slot.store(nullptr);
+        }
+    }
     m_initialized = false;
 }
 
@@ -48,8 +55,6 @@ CmdBufMgrNext* CmdBufMgrNext::GetObject()
 
 MOS_STATUS CmdBufMgrNext::Initialize(OsContextNext *osContext, uint32_t cmdBufSize)
 {
-    MOS_STATUS eStatus = MOS_STATUS_SUCCESS;
-
     MOS_OS_FUNCTION_ENTER;
     MOS_OS_CHK_NULL_RETURN(osContext);
 
@@ -57,35 +62,27 @@ MOS_STATUS CmdBufMgrNext::Initialize(OsContextNext *osContext, uint32_t cmdBufSi
     {
         m_osContext          = osContext;
 
-        m_inUsePoolMutex     = MosUtilities::MosCreateMutex();
-        MOS_OS_CHK_NULL_RETURN(m_inUsePoolMutex);
+        m_cmdBufListMutex    = MosUtilities::MosCreateMutex();
+        MOS_OS_CHK_NULL_RETURN(m_cmdBufListMutex);
 
         m_availablePoolMutex = MosUtilities::MosCreateMutex();
         MOS_OS_CHK_NULL_RETURN(m_availablePoolMutex);
 
         for (uint32_t i = 0; i < m_initBufNum; i++)
         {
-            auto cmdBuf = CommandBufferNext::CreateCmdBuf(this);
+            auto cmdBuf = AllocateCmdBuf(cmdBufSize);
             if (cmdBuf == nullptr)
             {
-                MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
+                MOS_OS_ASSERTMESSAGE("Allocate CmdBuf#%d failed", i);
                 return MOS_STATUS_INVALID_HANDLE;
             }
 
-            eStatus = cmdBuf->Allocate(m_osContext, cmdBufSize);
-            if (eStatus != MOS_STATUS_SUCCESS)
+            if (!ReleaseToSizeClass(cmdBuf))
             {
-                cmdBuf->Free();
-                MOS_Delete(cmdBuf);
-                MOS_OS_ASSERTMESSAGE("Allocate CmdBuf#%d failed", i);
-                return MOS_STATUS_INVALID_HANDLE;
+                MosUtilities::MosLockMutex(m_availablePoolMutex);
+                UpperInsert(cmdBuf);
+                MosUtilities::MosUnlockMutex(m_availablePoolMutex);
             }
-
-            MosUtilities::MosLockMutex(m_availablePoolMutex);
-            m_availableCmdBufPool.push_back(cmdBuf);
-            MosUtilities::MosUnlockMutex(m_availablePoolMutex);
-
-            m_cmdBufTotalNum++;
         }
 
         m_initialized = true;
@@ -98,35 +95,30 @@ MOS_STATUS CmdBufMgrNext::Reset()
 {
     MOS_OS_FUNCTION_ENTER;
 
-    CommandBufferNext *cmdBuf = nullptr;
     auto gpuContextMgr      = m_osContext->GetGpuContextMgr();
     MOS_OS_CHK_NULL_RETURN(gpuContextMgr);
-    std::vector<CommandBufferNext *> tmpInUseCmdBufPool = {};
-
-    MosUtilities::MosLockMutex(m_inUsePoolMutex);
 
-    if (!m_inUseCmdBufPool.empty())
+    // drain size classes and available pool, all command buffers are recycled below
+    for (auto &sizeClass : m_sizeClasses)
     {
-        tmpInUseCmdBufPool = std::move(m_inUseCmdBufPool);
-    }
-
-    // clear in-use command buffer pool
-    m_inUseCmdBufPool.clear();
-    MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
-
-    MosUtilities::MosLockMutex(m_availablePoolMutex);
-    if (!tmpInUseCmdBufPool.empty())
-    {
-        for (auto& cmdBuf : tmpInUseCmdBufPool)
+        for (auto &slot : sizeClass.slots)
         {
-            UpperInsert(cmdBuf);
+            slot.store(nullptr);
         }
     }
 
-    for (auto& cmdBuf : m_availableCmdBufPool)
+    MosUtilities::MosLockMutex(m_availablePoolMutex);
+    m_availableCmdBufPool.clear();
+    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+
+    MosUtilities::MosLockMutex(m_cmdBufListMutex);
+
+    for (auto& cmdBuf : m_cmdBufList)
     {
         if (cmdBuf != nullptr)
         {
+            cmdBuf->ExchangeInUse(false);
+
             auto nativeGpuContext         = cmdBuf->GetLastNativeGpuContext();
             auto nativeGpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
             if (nativeGpuContext != nullptr && nativeGpuContext == gpuContextMgr->GetGpuContext(nativeGpuContextHandle))
@@ -144,14 +136,21 @@ MOS_STATUS CmdBufMgrNext::Reset()
                 gpuContext->ResetCmdBuffer();
             }
             cmdBuf->ResetGpuContext();
+
+            if (!ReleaseToSizeClass(cmdBuf))
+            {
+                MosUtilities::MosLockMutex(m_availablePoolMutex);
+                UpperInsert(cmdBuf);
+                MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+            }
         }
         else
         {
             MOS_OS_ASSERTMESSAGE("Unexpected, found null command buffer!");
         }
     }
-    m_cmdBufTotalNum = m_availableCmdBufPool.size();
-    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+    m_cmdBufTotalNum = m_cmdBufList.size();
+    MosUtilities::MosUnlockMutex(m_cmdBufListMutex);
     return MOS_STATUS_SUCCESS;
 }
 
@@ -159,19 +158,35 @@ void CmdBufMgrNext::CleanUp()
 {
     MOS_OS_FUNCTION_ENTER;
 
-    CommandBufferNext *cmdBuf = nullptr;
+    for (auto &sizeClass : m_sizeClasses)
+    {
+        for (auto &slot : sizeClass.slots)
+        {
+            slot.store(nullptr);
+        }
+    }
+
     MosUtilities::MosLockMutex(m_availablePoolMutex);
+    // clear available command buffer pool
+    m_availableCmdBufPool.clear();
+    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
 
-    for (auto& cmdBuf : m_availableCmdBufPool)
+    MosUtilities::MosLockMutex(m_cmdBufListMutex);
+
+    for (auto& cmdBuf : m_cmdBufList)
     {
         if (cmdBuf != nullptr)
         {
-            auto gpuContext         = cmdBuf->GetLastNativeGpuContext();
-            auto gpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
-            auto gpuContextMgr      = m_osContext->GetGpuContextMgr();
-            if (gpuContext != nullptr && gpuContextMgr && gpuContext == gpuContextMgr->GetGpuContext(gpuContextHandle))
+            // in use command buffer is directly freed
+            if (!cmdBuf->ExchangeInUse(false))
             {
-                cmdBuf->UnBindToGpuContext(true);
+                auto gpuContext         = cmdBuf->GetLastNativeGpuContext();
+                auto gpuContextHandle   = cmdBuf->GetLastNativeGpuContextHandle();
+                auto gpuContextMgr      = m_osContext->GetGpuContextMgr();
+                if (gpuContext != nullptr && gpuContextMgr && gpuContext == gpuContextMgr->GetGpuContext(gpuContextHandle))
+                {
+                    cmdBuf->UnBindToGpuContext(true);
+                }
             }
             cmdBuf->Free();
             MOS_Delete(cmdBuf);
@@ -182,154 +197,220 @@ void CmdBufMgrNext::CleanUp()
         }
     }
 
-    // clear available command buffer pool
-    m_availableCmdBufPool.clear();
-    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
-    MosUtilities::MosLockMutex(m_inUsePoolMutex);
+    // clear command buffer list
+    m_cmdBufList.clear();
+    MosUtilities::MosUnlockMutex(m_cmdBufListMutex);
+
+    m_cmdBufTotalNum = 0;
+    m_initialized    = false;
+    MosUtilities::MosDestroyMutex(m_cmdBufListMutex);
+    m_cmdBufListMutex = nullptr;
+    MosUtilities::MosDestroyMutex(m_availablePoolMutex);
+    m_availablePoolMutex = nullptr;
+}
 
-    if (!m_inUseCmdBufPool.empty())
+uint32_t CmdBufMgrNext::GetSizeClass(uint32_t size)
+{
+    for (uint32_t i = 0; i < m_sizeClassNum; i++)
     {
-        for (auto& cmdBuf : m_inUseCmdBufPool)
+        if (size <= GetSizeClassSize(i))
         {
-            if (cmdBuf != nullptr)
-            {
-                cmdBuf->Free();
-                MOS_Delete(cmdBuf);
-            }
+            return i;
         }
     }
 
-    // clear in-use command buffer pool
-    m_inUseCmdBufPool.clear();
-    MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
-
-    m_cmdBufTotalNum = 0;
-    m_initialized    = false;
-    MosUtilities::MosDestroyMutex(m_inUsePoolMutex);
-    m_inUsePoolMutex = nullptr;
-    MosUtilities::MosDestroyMutex(m_availablePoolMutex);
-    m_availablePoolMutex = nullptr;
+    return m_sizeClassNum;
 }
 
-CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
+uint32_t CmdBufMgrNext::GetSizeClassSize(uint32_t sizeClass)
 {
-    MOS_OS_FUNCTION_ENTER;
+    // size classes go as base, 1.5 * base, 2 * base, 3 * base, 4 * base ...
+    uint32_t size = m_sizeClassBaseSize << (sizeClass >> 1);
+    return (sizeClass & 1) ? (size + (size >> 1)) : size;
+}
 
-    if (!m_initialized)
+CommandBufferNext *CmdBufMgrNext::AcquireFromSizeClass(uint32_t sizeClass)
+{
+    if (sizeClass >= m_sizeClassNum)
     {
-        MOS_OS_ASSERTMESSAGE("cmd buf pool need be initialized before buffer picking up!");
         return nullptr;
     }
 
-    // lock for both in-use and available command buffer pool before pick up
-    MosUtilities::MosLockMutex(m_inUsePoolMutex);
-    MosUtilities::MosLockMutex(m_availablePoolMutex);
-
-    CommandBufferNext* cmdBuf = nullptr;
-    CommandBufferNext* retbuf  = nullptr;
-    MOS_STATUS     eStatus = MOS_STATUS_SUCCESS;
-
-    if (!m_availableCmdBufPool.empty())
+    auto &slots = m_sizeClasses[sizeClass].slots;
+    for (uint32_t i = 0; i < m_sizeClassSlotNum; i++)
     {
-        cmdBuf = *(m_availableCmdBufPool.begin());
+        if (slots[i].load(std::memory_order_relaxed) == nullptr)
+        {
+            continue;
+        }
+
+        CommandBufferNext *cmdBuf = slots[i].exchange(nullptr, std::memory_order_acquire);
         if (cmdBuf == nullptr)
         {
-            MOS_OS_ASSERTMESSAGE("available command buf pool is null.");
-            MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
-            MosUtilities::MosUnlockMutex(m_availablePoolMutex);
-            return nullptr;
+            continue;
         }
 
-        // find available buf
-        if (size <= cmdBuf->GetCmdBufSize() && !cmdBuf->IsUsedByHw() && !cmdBuf->IsInCmdList())
+        // reclaim the command buffer only after HW completes it
+        if (!cmdBuf->IsUsedByHw() && !cmdBuf->IsInCmdList())
         {
-            m_inUseCmdBufPool.push_back(cmdBuf);
+            return cmdBuf;
+        }
 
-            m_availableCmdBufPool.erase(m_availableCmdBufPool.begin());
+        // put back busy command buffer, to available pool if the slot is taken meanwhile
+        CommandBufferNext *expected = nullptr;
+        if (!slots[i].compare_exchange_strong(expected, cmdBuf, std::memory_order_release))
+        {
+            MosUtilities::MosLockMutex(m_availablePoolMutex);
+            UpperInsert(cmdBuf);
+            MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+        }
+    }
+
+    return nullptr;
+}
+
+bool CmdBufMgrNext::ReleaseToSizeClass(CommandBufferNext *cmdBuf)
+{
+    uint32_t size      = cmdBuf->GetCmdBufSize();
+    uint32_t sizeClass = GetSizeClass(size);
 
-            MOS_OS_VERBOSEMESSAGE("successfully get available buf from pool");
+    // command buffer serves the biggest size class not bigger than itself
+    if (sizeClass < m_sizeClassNum && GetSizeClassSize(sizeClass) > size)
+    {
+        if (sizeClass == 0)
+        {
+            return false;
         }
-        // available buf  is not large enough, need reallocate
-        else
+        sizeClass--;
+    }
+
+    if (sizeClass >= m_sizeClassNum)
+    {
+        return false;
+    }
+
+    auto &slots = m_sizeClasses[sizeClass].slots;
+    for (uint32_t i = 0; i < m_sizeClassSlotNum; i++)
+    {
+        CommandBufferNext *expected = nullptr;
+        if (slots[i].load(std::memory_order_relaxed) == nullptr &&
+            slots[i].compare_exchange_strong(expected, cmdBuf, std::memory_order_release))
         {
-            MOS_OS_VERBOSEMESSAGE("find available buf, but is not large enough or it is still used by HW");
+            return true;
+        }
+    }
 
-            cmdBuf = CommandBufferNext::CreateCmdBuf(this);
-            if (cmdBuf == nullptr)
-            {
-                MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
-            }
-            else
-            {
-                eStatus = cmdBuf->Allocate(m_osContext, size);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    MOS_OS_ASSERTMESSAGE("Allocate CmdBuf failed");
-                }
+    return false;
+}
 
-                // directly push into inuse pool
-                m_inUseCmdBufPool.push_back(cmdBuf);
-                m_cmdBufTotalNum++;
+CommandBufferNext *CmdBufMgrNext::AllocateCmdBuf(uint32_t size)
+{
+    // allocate as size class so that the command buffer can be recycled in its size class
+    uint32_t sizeClass = GetSizeClass(size);
+    uint32_t allocSize = (sizeClass < m_sizeClassNum) ? GetSizeClassSize(sizeClass) : size;
 
-            }
-        }
+    auto cmdBuf = CommandBufferNext::CreateCmdBuf(this);
+    if (cmdBuf == nullptr)
+    {
+        MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
+        return nullptr;
+    }
 
-        retbuf = cmdBuf;
+    if (cmdBuf->Allocate(m_osContext, allocSize) != MOS_STATUS_SUCCESS)
+    {
+        MOS_OS_ASSERTMESSAGE("Allocate CmdBuf failed");
+        cmdBuf->Free();
+        MOS_Delete(cmdBuf);
+        return nullptr;
     }
-    // no available buf in the pool, will allocate in batch
-    else
+
+    MosUtilities::MosLockMutex(m_cmdBufListMutex);
+    m_cmdBufList.push_back(cmdBuf);
+    m_cmdBufTotalNum++;
+    MosUtilities::MosUnlockMutex(m_cmdBufListMutex);
+
+    return cmdBuf;
+}
+
+CommandBufferNext *CmdBufMgrNext::PickupOneCmdBuf(uint32_t size)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    if (!m_initialized)
     {
-        MOS_OS_VERBOSEMESSAGE("No more cmd buf in the pool");
+        MOS_OS_ASSERTMESSAGE("cmd buf pool need be initialized before buffer picking up!");
+        return nullptr;
+    }
 
-        if (m_cmdBufTotalNum < m_maxPoolSize)
+    uint32_t           sizeClass = GetSizeClass(size);
+    CommandBufferNext *cmdBuf    = AcquireFromSizeClass(sizeClass);
+
+    if (cmdBuf != nullptr)
+    {
+        MOS_OS_VERBOSEMESSAGE("successfully get available buf from size class %d", sizeClass);
+    }
+    else
+    {
+        // look up the smallest available buf large enough
+        MosUtilities::MosLockMutex(m_availablePoolMutex);
+        for (auto it = m_availableCmdBufPool.rbegin(); it != m_availableCmdBufPool.rend(); it++)
         {
-            MOS_OS_VERBOSEMESSAGE("Increase the cmd buf pool size by %d", m_bufIncStepSize);
-            for (uint32_t i = 0; i < m_bufIncStepSize; i++)
+            if (size <= (*it)->GetCmdBufSize() && !(*it)->IsUsedByHw() && !(*it)->IsInCmdList())
             {
-                cmdBuf = CommandBufferNext::CreateCmdBuf(this);
-                if (cmdBuf == nullptr)
-                {
-                    MOS_OS_ASSERTMESSAGE("input nullptr returned by CommandBuffer::CreateCmdBuf.");
-                    continue;
-                }
+                cmdBuf = *it;
+                m_availableCmdBufPool.erase(std::next(it).base());
+                MOS_OS_VERBOSEMESSAGE("successfully get available buf from pool");
+                break;
+            }
+        }
+        MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+    }
 
-                eStatus = cmdBuf->Allocate(m_osContext, size);
-                if (eStatus != MOS_STATUS_SUCCESS)
-                {
-                    MOS_OS_ASSERTMESSAGE("Allocate CmdBuf#%d failed", i);
-                    cmdBuf->Free();
-                    MOS_Delete(cmdBuf);
-                    continue;
-                }
+    // no available buf large enough, will allocate in batch for the size class
+    if (cmdBuf == nullptr)
+    {
+        MOS_OS_VERBOSEMESSAGE("No more cmd buf in the pool");
 
-                if (i == 0)
-                {
-                    // directly push into inuse pool
-                    m_inUseCmdBufPool.push_back(cmdBuf);
-                    retbuf = cmdBuf;
-                }
-                else
-                {
-                    m_availableCmdBufPool.insert(m_availableCmdBufPool.begin(), cmdBuf);
-                }
-                m_cmdBufTotalNum++;
+        if (m_cmdBufTotalNum >= m_maxPoolSize)
+        {
+            MOS_OS_ASSERTMESSAGE("No availabe cmd buf in pool and the total buf num hit the ceiling, may need wait for a while.");
+            return nullptr;
+        }
+
+        uint32_t bufNum = (sizeClass < m_sizeClassNum) ? m_bufIncStepSize : 1;
+        MOS_OS_VERBOSEMESSAGE("Increase the cmd buf pool size by %d", bufNum);
+        for (uint32_t i = 0; i < bufNum; i++)
+        {
+            auto newCmdBuf = AllocateCmdBuf(size);
+            if (newCmdBuf == nullptr)
+            {
+                continue;
             }
 
-            // sort by decent order
-            std::sort(m_availableCmdBufPool.begin(), m_availableCmdBufPool.end(), &CmdBufMgrNext::GreaterSizeSort);
+            if (cmdBuf == nullptr)
+            {
+                cmdBuf = newCmdBuf;
+            }
+            else if (!ReleaseToSizeClass(newCmdBuf))
+            {
+                MosUtilities::MosLockMutex(m_availablePoolMutex);
+                UpperInsert(newCmdBuf);
+                MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+            }
         }
-        else
+
+        if (cmdBuf == nullptr)
         {
-            MOS_OS_ASSERTMESSAGE("No availabe cmd buf in pool and the total buf num hit the ceiling, may need wait for a while.");
-            retbuf = nullptr;
+            return nullptr;
         }
     }
 
-    // unlock after got return buffer
-    MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
-    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+    if (cmdBuf->ExchangeInUse(true))
+    {
+        MOS_OS_ASSERTMESSAGE("Picked up cmdbuf is already in use, sth must be wrong!");
+    }
 
-    return retbuf;
+    return cmdBuf;
 }
 
 void CmdBufMgrNext::UpperInsert(CommandBufferNext *cmdBuf)
@@ -342,8 +423,6 @@ MOS_STATUS CmdBufMgrNext::ReleaseCmdBuf(CommandBufferNext *cmdBuf)
 {
     MOS_OS_FUNCTION_ENTER;
 
-    MOS_STATUS     eStatus = MOS_STATUS_SUCCESS;
-
     if (!m_initialized)
     {
         MOS_OS_ASSERTMESSAGE("cmd buf pool need be initialized before buffer release!");
@@ -352,36 +431,63 @@ MOS_STATUS CmdBufMgrNext::ReleaseCmdBuf(CommandBufferNext *cmdBuf)
 
     MOS_OS_CHK_NULL_RETURN(cmdBuf);
 
-    // lock for both in-use and available command buffer pool before release
-    MosUtilities::MosLockMutex(m_inUsePoolMutex);
-    MosUtilities::MosLockMutex(m_availablePoolMutex);
+    if (!cmdBuf->ExchangeInUse(false))
+    {
+        MOS_OS_ASSERTMESSAGE("The specified cmdbuf is not in use, sth must be wrong!");
+        return MOS_STATUS_UNKNOWN;
+    }
 
-    bool           found = false;
-    for (auto iter = m_inUseCmdBufPool.begin(); iter != m_inUseCmdBufPool.end(); iter++)
+    if (!ReleaseToSizeClass(cmdBuf))
     {
-        if (cmdBuf == *iter)
-        {
-            found = true;
-            m_inUseCmdBufPool.erase(iter);
-            break;
-        }
+        MosUtilities::MosLockMutex(m_availablePoolMutex);
+        UpperInsert(cmdBuf);
+        MosUtilities::MosUnlockMutex(m_availablePoolMutex);
     }
 
-    if (!found)
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS CmdBufMgrNext::PrewarmCmdBuf(uint32_t size, uint32_t bufNum)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    if (!m_initialized)
     {
-        MOS_OS_ASSERTMESSAGE("Cannot find the specified cmdbuf in inusepool, sth must be wrong!");
-        eStatus = MOS_STATUS_UNKNOWN;
+        MOS_OS_ASSERTMESSAGE("cmd buf pool need be initialized before buffer prewarm!");
+        return MOS_STATUS_UNKNOWN;
     }
-    else
+
+    // command buffer bigger than all size classes is allocated on demand
+    uint32_t sizeClass = GetSizeClass(size);
+    if (sizeClass >= m_sizeClassNum)
     {
-        UpperInsert(cmdBuf);
+        return MOS_STATUS_SUCCESS;
     }
 
-    // unlock after release buffer
-    MosUtilities::MosUnlockMutex(m_availablePoolMutex);
-    MosUtilities::MosUnlockMutex(m_inUsePoolMutex);
+    uint32_t idleNum = 0;
+    for (auto &slot : m_sizeClasses[sizeClass].slots)
+    {
+        idleNum += (slot.load(std::memory_order_relaxed) != nullptr) ? 1 : 0;
+    }
 
-    return eStatus;
+    bufNum = MOS_MIN(bufNum, m_sizeClassSlotNum);
+    for (; idleNum < bufNum && m_cmdBufTotalNum < m_maxPoolSize; idleNum++)
+    {
+        auto cmdBuf = AllocateCmdBuf(size);
+        MOS_OS_CHK_NULL_RETURN(cmdBuf);
+
+        if (!ReleaseToSizeClass(cmdBuf))
+        {
+            MosUtilities::MosLockMutex(m_availablePoolMutex);
+            UpperInsert(cmdBuf);
+            MosUtilities::MosUnlockMutex(m_availablePoolMutex);
+            break;
+        }
+    }
+
+    MOS_OS_VERBOSEMESSAGE("Prewarm size class %d with %d cmd bufs", sizeClass, idleNum);
+
+    return MOS_STATUS_SUCCESS;
 }
 
 MOS_STATUS CmdBufMgrNext::ResizeOneCmdBuf(CommandBufferNext *cmdBufToResize, uint32_t newSize)
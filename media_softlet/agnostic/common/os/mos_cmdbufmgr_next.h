@@ -27,6 +27,7 @@
 #ifndef __COMMAND_BUFFER_MANAGER_NEXT_H__
 #define __COMMAND_BUFFER_MANAGER_NEXT_H__
 
+#include <atomic>
 #include "mos_commandbuffer_next.h"
 #include "mos_gpucontextmgr_next.h"
 
@@ -73,18 +74,17 @@ public:
     void CleanUp();
 
     //!
-    //! \brief    Clean up the command buffer manager
-    //! \details  This function will pick up one proper command buffer from 
-    //!           available pool, internal logic in below 3 conditions:
-    //!           1: if available pool has command buffer and its size bigger than
-    //!              required, directly put it into in use pool and return;
-    //!           2: if available pool has command buffer but size smaller than
-    //!              required, only create one command buffer as reqired and put
-    //!              it to in  use pool directly;
-    //!           3: if available pool is empty, will re-allocate bunch of command
-    //!              buffers, buffer number base on m_initBufNum, buffer size
-    //!              base on input required size. After re-allocate, put first buf
-    //!              into inuse pool, remains push to available pool.
+    //! \brief    Pick up one command buffer
+    //! \details  This function will pick up one proper command buffer, internal
+    //!           logic in below 3 conditions:
+    //!           1: if the size class of required size has idle command buffer,
+    //!              take it from the size class without lock and return;
+    //!           2: if available pool has command buffer bigger than required,
+    //!              take it from available pool and return;
+    //!           3: otherwise re-allocate bunch of command buffers, buffer number
+    //!              base on m_bufIncStepSize, buffer size base on the size class
+    //!              of required size. After re-allocate, return first buf and put
+    //!              remains to the size class.
     //! \param    [in] size
     //!           Required command buffer size
     //! \return   CommandBuffer*
@@ -104,10 +104,10 @@ public:
     //!
     //! \brief    Release command buffer from in-use status to standby status
     //! \details  This function designed for situations which need retire or 
-    //!           discard in use command buffer, it directly erase command buf
-    //!           from in use pool and push it to available pool. If the command
-    //!           buffer cannot be found inside in-use pool, some thing must be 
-    //!           wrong.
+    //!           discard in use command buffer, it puts the command buffer back
+    //!           to its size class without lock, or to available pool if the
+    //!           size class is full. If the command buffer is not in use, some
+    //!           thing must be wrong.
     //! \param    [in] cmdBuf
     //!           Command buffer need to be released
     //! \return   MOS_STATUS
@@ -136,6 +136,19 @@ public:
     //!
     MOS_STATUS ResizeOneCmdBuf(CommandBufferNext *cmdBufToResize, uint32_t newSize);
 
+    //!
+    //! \brief    Pre-allocate command buffers for the size class of required size
+    //! \details  Called when the command buffer size of gpu context changes, so
+    //!           that the following pick up is served without allocation.
+    //! \param    [in] size
+    //!           Required command buffer size
+    //! \param    [in] bufNum
+    //!           Number of idle command buffers needed in the size class
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, other wise fail reason
+    //!
+    MOS_STATUS PrewarmCmdBuf(uint32_t size, uint32_t bufNum);
+
     //!
     //! \brief    Get the validity flag
     //! \return   bool
@@ -183,6 +196,67 @@ public:
     //!
     static bool GreaterSizeSort(CommandBufferNext *a, CommandBufferNext *b);
 
+    //!
+    //! \brief    Get size class of command buffer size
+    //! \param    [in] size
+    //!           Command buffer size
+    //! \return   uint32_t
+    //!           Size class index, m_sizeClassNum if bigger than all size classes
+    //!
+    static uint32_t GetSizeClass(uint32_t size);
+
+    //!
+    //! \brief    Get command buffer size of size class
+    //! \param    [in] sizeClass
+    //!           Size class index
+    //! \return   uint32_t
+    //!           Command buffer size allocated for the size class
+    //!
+    static uint32_t GetSizeClassSize(uint32_t sizeClass);
+
+    //!
+    //! \brief    Take one idle command buffer from size class without lock
+    //! \param    [in] sizeClass
+    //!           Size class index
+    //! \return   CommandBufferNext*
+    //!           Command buffer if found, otherwise nullptr
+    //!
+    CommandBufferNext *AcquireFromSizeClass(uint32_t sizeClass);
+
+    //!
+    //! \brief    Put one idle command buffer to its size class without lock
+    //! \param    [in] cmdBuf
+    //!           Command buffer to put
+    //! \return   bool
+    //!           true if success, false if the size class is full
+    //!
+    bool ReleaseToSizeClass(CommandBufferNext *cmdBuf);
+
+    //!
+    //! \brief    Allocate one command buffer and add it to command buffer list
+    //! \param    [in] size
+    //!           Command buffer size
+    //! \return   CommandBufferNext*
+    //!           Command buffer if success, otherwise nullptr
+    //!
+    CommandBufferNext *AllocateCmdBuf(uint32_t size);
+
+    //! \brief   Size of the smallest size class, size classes are half octave apart
+    constexpr static uint32_t m_sizeClassBaseSize = 32768;
+
+    //! \brief   Number of size classes
+    constexpr static uint32_t m_sizeClassNum = 16;
+
+    //! \brief   Max idle command buffer number in one size class
+    constexpr static uint32_t m_sizeClassSlotNum = 64;
+
+    //! \brief   Idle command buffers of one size class, slots are taken and put
+    //!          by atomic exchange so that pick up and release need no lock
+    struct SizeClass
+    {
+        std::atomic<CommandBufferNext *> slots[m_sizeClassSlotNum];
+    };
+
     //! \brief   Max comamnd buffer number for per manager, including all
     //!          command buffer in availble pool and in-use pool
     constexpr static uint32_t m_maxPoolSize = 1098304;
@@ -196,17 +270,21 @@ public:
     //! \brief   Initial command buffer number
     constexpr static uint32_t m_initBufNum = 32;
 
-    //! \brief   Sorted List of available command buffer pool
+    //! \brief   Idle command buffers indexed by size class
+    SizeClass m_sizeClasses[m_sizeClassNum];
+
+    //! \brief   Sorted List of available command buffer pool, holds the command
+    //!          buffers bigger than all size classes or overflowed from size class
     std::vector<CommandBufferNext *> m_availableCmdBufPool;
 
     //! \brief   Mutex for available command buffer pool
     PMOS_MUTEX m_availablePoolMutex = nullptr;
 
-    //! \brief   List of in used command buffer pool
-    std::vector<CommandBufferNext *> m_inUseCmdBufPool;
+    //! \brief   List of all allocated command buffers
+    std::vector<CommandBufferNext *> m_cmdBufList;
 
-    //! \brief   Mutex for in-use command buffer pool
-    PMOS_MUTEX m_inUsePoolMutex = nullptr;
+    //! \brief   Mutex for command buffer list
+    PMOS_MUTEX m_cmdBufListMutex = nullptr;
 
     //! \brief   Flag to indicate cmd buf mgr initialized or not
     bool m_initialized = false;
@@ -27,6 +27,7 @@
 #ifndef __MOS_COMMANDBUFFER_NEXT_H__
 #define __MOS_COMMANDBUFFER_NEXT_H__
 
+#include <atomic>
 #include "mos_graphicsresource_next.h"
 #include "mos_gpucontext_next.h"
 
@@ -218,6 +219,15 @@ public:
         return m_cmdBufMgr;
     }
 
+    //!
+    //! \brief    Set in-use flag when picked up from or released to cmd buffer manager
+    //! \params   [in] inUse
+    //!           New in-use flag
+    //! \return   bool
+    //!           Previous in-use flag
+    //!
+    bool ExchangeInUse(bool inUse) { return m_inUse.exchange(inUse); }
+
 protected:
     //!
     //! \brief    Set ready to use
@@ -254,6 +264,9 @@ protected:
 
     //! \brief    Command buffer size
     uint32_t          m_size             = 0;
+
+    //! \brief    Indicate if picked up from cmd buffer manager
+    std::atomic<bool> m_inUse            = {false};
 MEDIA_CLASS_DEFINE_END(CommandBufferNext)
 };
 #endif // __MOS_COMMANDBUFFERNext_NEXT_H__
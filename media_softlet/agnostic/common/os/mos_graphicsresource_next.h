@@ -186,6 +186,29 @@ public:
         };
     };
 
+    //!
+    //! \brief  Plane mask of rectangle lock
+    //!
+    enum LockPlaneMask
+    {
+        lockPlaneY   = 1 << 0,
+        lockPlaneU   = 1 << 1,  //!< U or interleaved UV plane
+        lockPlaneV   = 1 << 2,
+        lockPlaneAll = lockPlaneY | lockPlaneU | lockPlaneV
+    };
+
+    //!
+    //! \brief  Structure to rectangle lock parameters, the rectangle is in pixels of Y plane
+    //!
+    struct LockRectParams
+    {
+        uint32_t m_x         = 0;
+        uint32_t m_y         = 0;
+        uint32_t m_width     = 0;
+        uint32_t m_height    = 0;
+        uint32_t m_planeMask = lockPlaneAll;  //!< Planes accessed by the caller
+    };
+
     //!
     //! \brief Structure to OS sync parameters
     //!
@@ -331,6 +354,24 @@ public:
     //!
     virtual void* Lock(OsContextNext* osContextPtr, LockParams& params) = 0;
 
+    //!
+    //! \brief  Locks a rectangle of a resource and returns a mapped system memory pointer
+    //!         of the whole resource. Only the data covered by the rectangle is guaranteed
+    //!         to be valid, the other data may be stale until locked.
+    //! \param  [in] osContextPtr
+    //!         Pointer to the osContext handle
+    //! \param  [in] params
+    //!         Resource lock Params
+    //! \param  [in] rect
+    //!         Rectangle and planes accessed by the caller
+    //! \return CPU side lock address in success case, nullptr in fail cases
+    //!
+    virtual void* LockRect(OsContextNext* osContextPtr, LockParams& params, const LockRectParams& rect)
+    {
+        MOS_UNUSED(rect);
+        return Lock(osContextPtr, params);
+    }
+
     //!
     //! \brief  Unlocks a resource that has already been locked, if no lock has
     //!         occurred, this function does nothing
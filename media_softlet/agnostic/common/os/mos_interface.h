@@ -1548,6 +1548,25 @@ public:
         MOS_STREAM_HANDLE streamState,
         MOS_RESOURCE_HANDLE resource);
 
+    //!
+    //! \brief    Decompress resources with one submission
+    //! \details  Resources which are not compressed are skipped, the others are decompressed
+    //!           by one MemoryDecompressBatch call
+    //!
+    //! \param    [in] streamState
+    //!           Handle of Os Stream State
+    //! \param    [in] resources
+    //!           MOS Resource handles of the resources to decompress.
+    //! \param    [in] count
+    //!           Number of resources
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    static MOS_STATUS DecompResourceBatch(
+        MOS_STREAM_HANDLE    streamState,
+        MOS_RESOURCE_HANDLE *resources,
+        uint32_t             count);
+
     //!
     //! \brief    Decompress resource
     //!
@@ -1576,6 +1595,27 @@ public:
         MOS_STREAM_HANDLE   streamState,
         MOS_RESOURCE_HANDLE syncResource);
 
+    //!
+    //! \brief    Check whether resource is not written since its last in place decompression
+    //!
+    //! \param    [in] resource
+    //!           MOS Resource handle of the resource.
+    //! \return   bool
+    //!           Return true if decompression of the resource can be skipped
+    //!
+    static bool IsResourceDecompressed(
+        MOS_RESOURCE_HANDLE resource);
+
+    //!
+    //! \brief    Record in place decompression of resource
+    //!
+    //! \param    [in] resource
+    //!           MOS Resource handle of the resource.
+    //! \return   void
+    //!
+    static void SetResourceDecompressed(
+        MOS_RESOURCE_HANDLE resource);
+
     //!
     //! \brief  Set Memory Compression Mode
     //!
@@ -1207,7 +1207,7 @@ void Mos_ResetMosResource(
     return MosInterface::MosResetResource(resource);
 }
 
-bool Mos_InsertCacheSetting(CACHE_COMPONENTS id, std::map<uint64_t, MOS_CACHE_ELEMENT> *cacheTablesPtr)
+bool Mos_InsertCacheSetting(CACHE_COMPONENTS id, const MOS_CACHE_TABLE *cacheTablesPtr)
 {
     return RegisterCacheSettings(id, cacheTablesPtr);
 }
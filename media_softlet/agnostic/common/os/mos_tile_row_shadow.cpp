@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     mos_tile_row_shadow.cpp
+//! \brief    Linear shadow of a Tile-Y surface which is detiled by tile rows
+//!
+
+#include <string.h>
+#include "mos_tile_row_shadow.h"
+
+bool MosTileRowShadow::Init(size_t size, uint32_t pitch)
+{
+    size_t tileRowSize = (size_t)pitch * m_tileRowHeight;
+    // Tiled surfaces are allocated in whole tiles, anything else is not Tile-Y
+    if (pitch == 0 || (pitch % m_oWordSize) != 0 || size == 0 || (size % tileRowSize) != 0)
+    {
+        Reset();
+        return false;
+    }
+
+    m_states.assign(size / tileRowSize, 0);
+    m_pitch = pitch;
+    return true;
+}
+
+void MosTileRowShadow::ConvertTileRow(const uint8_t *src, uint8_t *dst, uint32_t pitch, bool toLinear)
+{
+    // Tile-Y stores the 16 bytes wide columns of 32 rows one after another
+    uint32_t columnNum  = pitch / m_oWordSize;
+    uint32_t columnSize = m_oWordSize * m_tileRowHeight;
+
+    for (uint32_t col = 0; col < columnNum; col++)
+    {
+        size_t tiledOffset  = (size_t)col * columnSize;
+        size_t linearOffset = (size_t)col * m_oWordSize;
+        for (uint32_t row = 0; row < m_tileRowHeight; row++)
+        {
+            if (toLinear)
+            {
+                memcpy(dst + linearOffset, src + tiledOffset, m_oWordSize);
+            }
+            else
+            {
+                memcpy(dst + tiledOffset, src + linearOffset, m_oWordSize);
+            }
+            tiledOffset += m_oWordSize;
+            linearOffset += pitch;
+        }
+    }
+}
+
+uint32_t MosTileRowShadow::Detile(const uint8_t *tiled, uint8_t *linear, uint32_t startRow, uint32_t endRow, bool dirty)
+{
+    if (tiled == nullptr || linear == nullptr || m_states.empty())
+    {
+        return 0;
+    }
+
+    size_t   tileRowSize  = (size_t)m_pitch * m_tileRowHeight;
+    uint32_t startTileRow = startRow / m_tileRowHeight;
+    uint32_t endTileRow   = (uint32_t)((endRow + (uint64_t)m_tileRowHeight - 1) / m_tileRowHeight);
+    uint32_t detiledNum   = 0;
+
+    endTileRow = (endTileRow < m_states.size()) ? endTileRow : (uint32_t)m_states.size();
+    for (uint32_t i = startTileRow; i < endTileRow; i++)
+    {
+        if ((m_states[i] & m_tileRowValid) == 0)
+        {
+            size_t offset = i * tileRowSize;
+            ConvertTileRow(tiled + offset, linear + offset, m_pitch, true);
+            m_states[i] |= m_tileRowValid;
+            detiledNum++;
+        }
+        if (dirty)
+        {
+            m_states[i] |= m_tileRowDirty;
+        }
+    }
+
+    return detiledNum;
+}
+
+uint32_t MosTileRowShadow::WriteBack(const uint8_t *linear, uint8_t *tiled)
+{
+    if (tiled == nullptr || linear == nullptr)
+    {
+        return 0;
+    }
+
+    size_t   tileRowSize = (size_t)m_pitch * m_tileRowHeight;
+    uint32_t writtenNum  = 0;
+    for (uint32_t i = 0; i < m_states.size(); i++)
+    {
+        if (m_states[i] & m_tileRowDirty)
+        {
+            size_t offset = i * tileRowSize;
+            ConvertTileRow(linear + offset, tiled + offset, m_pitch, false);
+            m_states[i] &= ~m_tileRowDirty;
+            writtenNum++;
+        }
+    }
+
+    return writtenNum;
+}
@@ -0,0 +1,129 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     mos_tile_row_shadow.h
+//! \brief    Linear shadow of a Tile-Y surface which is detiled by tile rows
+//! \details  A Tile-Y tile row is one contiguous pitch * 32 bytes span in both tiled and
+//!           linear layout, so the shadow can be filled and written back one tile row at
+//!           a time. Rows which are detiled and rows which are modified are tracked, so
+//!           a lock of a small rectangle only converts the tile rows covering it.
+//!
+#ifndef __MOS_TILE_ROW_SHADOW_H__
+#define __MOS_TILE_ROW_SHADOW_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+class MosTileRowShadow
+{
+public:
+    //!
+    //! \brief    Start tracking a surface, all tile rows are invalid
+    //! \param    [in] size
+    //!           Size in bytes of the tiled surface and its shadow, multiple of tile rows
+    //! \param    [in] pitch
+    //!           Pitch in bytes, multiple of 16
+    //! \return   bool
+    //!           false if pitch or size cannot be handled by tile rows
+    //!
+    bool Init(size_t size, uint32_t pitch);
+
+    //!
+    //! \brief    Stop tracking, the shadow is considered fully detiled afterwards
+    //!
+    void Reset()
+    {
+        m_states.clear();
+        m_pitch = 0;
+    }
+
+    //!
+    //! \brief    Check whether a surface is tracked by tile rows
+    //!
+    bool IsActive() const
+    {
+        return !m_states.empty();
+    }
+
+    //!
+    //! \brief    Get number of rows in pitch units covered by tile rows
+    //!
+    uint32_t GetRowNum() const
+    {
+        return (uint32_t)m_states.size() * m_tileRowHeight;
+    }
+
+    //!
+    //! \brief    Detile the tile rows covering rows [startRow, endRow) which are not detiled yet
+    //! \param    [in] tiled
+    //!           Tiled surface
+    //! \param    [out] linear
+    //!           Linear shadow
+    //! \param    [in] startRow
+    //!           First row in pitch units
+    //! \param    [in] endRow
+    //!           Row after the last row in pitch units, clamped to the surface
+    //! \param    [in] dirty
+    //!           Mark the tile rows to be written back
+    //! \return   uint32_t
+    //!           Number of tile rows detiled by this call
+    //!
+    uint32_t Detile(const uint8_t *tiled, uint8_t *linear, uint32_t startRow, uint32_t endRow, bool dirty);
+
+    //!
+    //! \brief    Tile the dirty tile rows of the shadow back into the surface
+    //! \param    [in] linear
+    //!           Linear shadow
+    //! \param    [out] tiled
+    //!           Tiled surface
+    //! \return   uint32_t
+    //!           Number of tile rows written back
+    //!
+    uint32_t WriteBack(const uint8_t *linear, uint8_t *tiled);
+
+    //!
+    //! \brief    Convert one tile row between Tile-Y and linear layout
+    //! \param    [in] src
+    //!           Source tile row
+    //! \param    [out] dst
+    //!           Destination tile row
+    //! \param    [in] pitch
+    //!           Pitch in bytes, multiple of 16
+    //! \param    [in] toLinear
+    //!           true to detile, false to tile
+    //!
+    static void ConvertTileRow(const uint8_t *src, uint8_t *dst, uint32_t pitch, bool toLinear);
+
+    static const uint32_t m_tileRowHeight = 32;  //!< Rows of a Tile-Y tile
+    static const uint32_t m_oWordSize     = 16;  //!< Bytes of a Tile-Y column in one row
+
+private:
+    static const uint8_t m_tileRowValid = 1 << 0;  //!< Tile row is detiled into shadow
+    static const uint8_t m_tileRowDirty = 1 << 1;  //!< Tile row is written back
+
+    std::vector<uint8_t> m_states;      //!< Per tile row states, empty if not tracked
+    uint32_t             m_pitch = 0;
+};
+
+#endif  // __MOS_TILE_ROW_SHADOW_H__
@@ -0,0 +1,122 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     mos_worker_pool.cpp
+//! \brief    Small CPU worker pool for splitting one job into parallel parts
+//!
+
+#include "mos_worker_pool.h"
+
+MosWorkerPool::MosWorkerPool(uint32_t maxThreadNum)
+{
+    uint32_t threadNum = std::thread::hardware_concurrency();
+    threadNum          = (threadNum < maxThreadNum) ? threadNum : maxThreadNum;
+
+    for (uint32_t i = 1; i < threadNum; i++)
+    {
+        m_workers.emplace_back(&MosWorkerPool::WorkerLoop, this, i);
+    }
+}
+
+MosWorkerPool::~MosWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_exit = true;
+    }
+    m_startCond.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+bool MosWorkerPool::TryRun(uint32_t jobNum, const Job &job)
+{
+    std::unique_lock<std::mutex> runLock(m_runMutex, std::try_to_lock);
+    if (!runLock.owns_lock() || jobNum == 0 || jobNum > GetThreadNum())
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job     = &job;
+        m_jobNum  = jobNum;
+        m_pending = jobNum - 1;
+        m_generation++;
+    }
+    m_startCond.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCond.wait(lock, [this] { return m_pending == 0; });
+    m_job = nullptr;
+    return true;
+}
+
+void MosWorkerPool::Run(uint32_t jobNum, const Job &job)
+{
+    if (TryRun(jobNum, job))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < jobNum; i++)
+    {
+        job(i);
+    }
+}
+
+void MosWorkerPool::WorkerLoop(uint32_t jobIdx)
+{
+    uint64_t generation = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_startCond.wait(lock, [&] { return m_exit || m_generation != generation; });
+        if (m_exit)
+        {
+            return;
+        }
+        generation = m_generation;
+
+        if (jobIdx >= m_jobNum)
+        {
+            continue;
+        }
+
+        const Job *job = m_job;
+        lock.unlock();
+        (*job)(jobIdx);
+        lock.lock();
+
+        if (--m_pending == 0)
+        {
+            m_doneCond.notify_one();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file     mos_worker_pool.h
+//! \brief    Small CPU worker pool for splitting one job into parallel parts
+//! \details  Only one job is split at a time. A caller which finds the workers
+//!           busy is told so and runs its job on its own thread instead.
+//!
+#ifndef __MOS_WORKER_POOL_H__
+#define __MOS_WORKER_POOL_H__
+
+#include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MosWorkerPool
+{
+public:
+    typedef std::function<void(uint32_t jobIdx)> Job;
+
+    //!
+    //! \brief    Constructor
+    //! \param    [in] maxThreadNum
+    //!           Max threads of one job including calling thread, also limited by CPU count
+    //!
+    MosWorkerPool(uint32_t maxThreadNum);
+
+    ~MosWorkerPool();
+
+    MosWorkerPool(const MosWorkerPool &) = delete;
+    MosWorkerPool &operator=(const MosWorkerPool &) = delete;
+
+    //!
+    //! \brief    Get number of threads one job can be split to, including calling thread
+    //!
+    uint32_t GetThreadNum() const
+    {
+        return (uint32_t)m_workers.size() + 1;
+    }
+
+    //!
+    //! \brief    Run job(0) ~ job(jobNum - 1), job(0) runs on calling thread
+    //! \details  Returns when all parts are done
+    //! \return   bool
+    //!           false if workers are busy or jobNum exceeds thread number, and nothing is run
+    //!
+    bool TryRun(uint32_t jobNum, const Job &job);
+
+    //!
+    //! \brief    Run job(0) ~ job(jobNum - 1), on calling thread only if workers are not available
+    //!
+    void Run(uint32_t jobNum, const Job &job);
+
+private:
+    void WorkerLoop(uint32_t jobIdx);
+
+    std::vector<std::thread>  m_workers;
+    std::mutex                m_runMutex;              //!< Held by the job which is split
+    std::mutex                m_mutex;
+    std::condition_variable   m_startCond;
+    std::condition_variable   m_doneCond;
+    const Job                *m_job        = nullptr;
+    uint32_t                  m_jobNum     = 0;
+    uint32_t                  m_pending    = 0;
+    uint64_t                  m_generation = 0;
+    bool                      m_exit       = false;
+};
+
+#endif  // __MOS_WORKER_POOL_H__
@@ -28,6 +28,12 @@
 #include <algorithm>
 #include "media_allocator.h"
 
+std::atomic<uint64_t> Allocator::m_committedBytes(0);
+std::atomic<uint64_t> Allocator::m_peakCommittedBytes(0);
+std::atomic<uint64_t> Allocator::m_commitCount(0);
+std::atomic<uint64_t> Allocator::m_uncommitCount(0);
+std::atomic<uint64_t> Allocator::m_budgetBytes(0);
+
 Allocator::Allocator(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
 {
 
@@ -44,6 +50,7 @@ MOS_STATUS Allocator::DestroyAllResources()
     for (auto it : m_resourcePool)
     {
         MOS_RESOURCE *resource = const_cast<MOS_RESOURCE *>(it.first);
+        OnUncommit(resource);
         m_osInterface->pfnFreeResource(m_osInterface, resource);
         MOS_Delete(resource);
         MOS_Delete(it.second);
@@ -56,6 +63,7 @@ MOS_STATUS Allocator::DestroyAllResources()
         MOS_SURFACE *surface = const_cast<MOS_SURFACE *>(it.first);
         if (surface)
         {
+            OnUncommit(&surface->OsResource);
             m_osInterface->pfnFreeResource(m_osInterface, &(surface->OsResource));
         }
         MOS_Delete(surface);
@@ -67,6 +75,7 @@ MOS_STATUS Allocator::DestroyAllResources()
 
     for (auto it : m_resourcePool)
     {
+        OnUncommit(it);
         m_osInterface->pfnFreeResource(m_osInterface, it);
         MOS_Delete(it);
     }
@@ -74,6 +83,7 @@ MOS_STATUS Allocator::DestroyAllResources()
 
     for (auto it : m_surfacePool)
     {
+        OnUncommit(&it->OsResource);
         m_osInterface->pfnFreeResource(m_osInterface, &it->OsResource);
         MOS_Delete(it);
     }
@@ -119,6 +129,7 @@ MOS_RESOURCE *Allocator::AllocateResource(MOS_ALLOC_GFXRES_PARAMS &param, bool z
 #else
     m_resourcePool.push_back(resource);
 #endif
+    OnCommit(resource);
 
     if (zeroOnAllocate)
     {
@@ -169,6 +180,7 @@ PMOS_BUFFER Allocator::AllocateBuffer(MOS_ALLOC_GFXRES_PARAMS &param, bool zeroO
 #else
     m_resourcePool.push_back(&buffer->OsResource);
 #endif
+    OnCommit(&buffer->OsResource);
 
     if (zeroOnAllocate)
     {
@@ -203,6 +215,10 @@ MOS_SURFACE *Allocator::AllocateSurface(MOS_ALLOC_GFXRES_PARAMS &param, bool zer
 #else
     m_surfacePool.push_back(surface);
 #endif
+    if (status == MOS_STATUS_SUCCESS)
+    {
+        OnCommit(&surface->OsResource);
+    }
 
     if (zeroOnAllocate)
     {
@@ -234,6 +250,7 @@ MOS_STATUS Allocator::DestroyResource(MOS_RESOURCE *resource)
 #endif
 
     m_resourcePool.erase(it);
+    OnUncommit(resource);
     m_osInterface->pfnFreeResource(m_osInterface, resource);
     MOS_Delete(resource);
 
@@ -263,6 +280,7 @@ MOS_STATUS Allocator::DestroyBuffer(MOS_BUFFER *buffer)
 #endif
 
     m_resourcePool.erase(it);
+    OnUncommit(&buffer->OsResource);
     m_osInterface->pfnFreeResource(m_osInterface, &buffer->OsResource);
     MOS_Delete(buffer);
 
@@ -292,6 +310,7 @@ MOS_STATUS Allocator::DestroySurface(MOS_SURFACE *surface, MOS_GFXRES_FREE_FLAGS
 #endif
 
     m_surfacePool.erase(it);
+    OnUncommit(&surface->OsResource);
     m_osInterface->pfnFreeResourceWithFlag(m_osInterface, &surface->OsResource, flags.Value);
     MOS_Delete(surface);
 
@@ -439,3 +458,68 @@ bool Allocator::isSyncFreeNeededForMMCSurface(PMOS_SURFACE pOsSurface)
 
     return false;
 }
+
+void Allocator::OnCommit(MOS_RESOURCE *resource)
+{
+    if (nullptr == resource || nullptr == resource->pGmmResInfo)
+    {
+        return;
+    }
+
+    uint64_t size      = resource->pGmmResInfo->GetSizeAllocation();
+    uint64_t committed = m_committedBytes.fetch_add(size) + size;
+    m_commitCount++;
+
+    uint64_t peak = m_peakCommittedBytes.load();
+    while (committed > peak && !m_peakCommittedBytes.compare_exchange_weak(peak, committed))
+    {
+    }
+
+    uint64_t budget = m_budgetBytes.load();
+    if (budget != 0 && committed > budget && committed - size <= budget)
+    {
+        MOS_OS_NORMALMESSAGE("Media memory budget %llu exceeded, committed %llu bytes",
+            (unsigned long long)budget, (unsigned long long)committed);
+    }
+}
+
+void Allocator::OnUncommit(MOS_RESOURCE *resource)
+{
+    if (nullptr == resource || nullptr == resource->pGmmResInfo)
+    {
+        return;
+    }
+
+    m_committedBytes -= resource->pGmmResInfo->GetSizeAllocation();
+    m_uncommitCount++;
+}
+
+Allocator::MemoryStatistics Allocator::GetMemoryStatistics()
+{
+    MemoryStatistics stats;
+    stats.committedBytes     = m_committedBytes.load();
+    stats.peakCommittedBytes = m_peakCommittedBytes.load();
+    stats.commitCount        = m_commitCount.load();
+    stats.uncommitCount      = m_uncommitCount.load();
+    stats.budgetBytes        = m_budgetBytes.load();
+    return stats;
+}
+
+void Allocator::SetMemoryBudget(uint64_t budgetBytes)
+{
+    if (budgetBytes == 0)
+    {
+        return;
+    }
+
+    uint64_t budget = m_budgetBytes.load();
+    while (budget < budgetBytes && !m_budgetBytes.compare_exchange_weak(budget, budgetBytes))
+    {
+    }
+}
+
+bool Allocator::IsOverBudget()
+{
+    uint64_t budget = m_budgetBytes.load();
+    return budget != 0 && m_committedBytes.load() > budget;
+}
@@ -30,6 +30,7 @@
 #define __MEDIA_ALLOCATOR_H__
 
 #include <stdint.h>
+#include <atomic>
 #include <vector>
 #include "mos_defs.h"
 #include "mos_os_hw.h"
@@ -250,8 +251,58 @@ public:
     //!
     bool isSyncFreeNeededForMMCSurface(PMOS_SURFACE pOsSurface);
 
+    //!
+    //! \brief  Memory statistics of all allocators in the process
+    //!
+    struct MemoryStatistics
+    {
+        uint64_t committedBytes     = 0;  //!< Size of resources currently backed by memory
+        uint64_t peakCommittedBytes = 0;  //!< High-water mark of committedBytes
+        uint64_t commitCount        = 0;  //!< Number of resources committed
+        uint64_t uncommitCount      = 0;  //!< Number of resources released
+        uint64_t budgetBytes        = 0;  //!< Memory budget of process, 0 means no limit
+    };
+
+    //!
+    //! \brief  Get memory statistics of all allocators in the process
+    //! \return MemoryStatistics
+    //!
+    static MemoryStatistics GetMemoryStatistics();
+
+    //!
+    //! \brief  Set memory budget of the process
+    //! \details The budget is process wide and each device may set its own, the largest
+    //!         non-zero budget is kept so no device works under a tighter budget than it
+    //!         asked for. The process has no limit until a device sets a budget.
+    //! \param  [in] budgetBytes
+    //!         Budget in bytes, 0 means no limit for this device and is ignored
+    //!
+    static void SetMemoryBudget(uint64_t budgetBytes);
+
+    //!
+    //! \brief  Check if committed memory of the process exceeds the budget,
+    //!         owners of idle resources are expected to release them when true
+    //! \return bool
+    //!         true if over budget, otherwise false
+    //!
+    static bool IsOverBudget();
+
 protected:
 
+    //!
+    //! \brief  Account resource which is backed by memory
+    //! \param  [in] resource
+    //!         pointer to MOS_RESOURCE
+    //!
+    void OnCommit(MOS_RESOURCE *resource);
+
+    //!
+    //! \brief  Account resource which is going to be released
+    //! \param  [in] resource
+    //!         pointer to MOS_RESOURCE
+    //!
+    void OnUncommit(MOS_RESOURCE *resource);
+
     //!
     //! \brief  Clear Resource
     //! \param  [in] resource
@@ -278,6 +329,12 @@ protected:
 #endif
 
     PMOS_INTERFACE m_osInterface = nullptr;  //!< PMOS_INTERFACE
+
+    static std::atomic<uint64_t> m_committedBytes;
+    static std::atomic<uint64_t> m_peakCommittedBytes;
+    static std::atomic<uint64_t> m_commitCount;
+    static std::atomic<uint64_t> m_uncommitCount;
+    static std::atomic<uint64_t> m_budgetBytes;
 MEDIA_CLASS_DEFINE_END(Allocator)
 };
 #endif  // !__MEDIA_ALLOCATOR_H__
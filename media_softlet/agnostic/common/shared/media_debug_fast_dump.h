@@ -92,8 +92,12 @@ public:
 
         // file/trace writing configurations
         RangedUint8<0, 2> writeDst      = 0;     // 0: file; 1: trace; 2: no write, for debug purpose
-        RangedUint8<0, 2> writeMode     = 2;     // 0: binary; 1: text, valid when writeDst is 0; 2: adaptive
+        RangedUint8<0, 3> writeMode     = 2;     // 0: binary; 1: text, valid when writeDst is 0; 2: adaptive; 3: compressed
+                                                 // container, valid when writeDst is 0, see media_debug_fast_dump_compress.h
         size_t            bufferSize    = 0;     // buffer size in MB for buffered writing, valid when writeDst and writeMode are both 0
+        RangedUint8<1, 16> compressThreads = 2;     // number of compression threads, valid when writeMode is 3
+        bool               deltaCompress   = true;  // XOR with the previous dump of the same surface before compression, valid
+                                                    // when writeMode is 3
         bool              informOnError = true;  // dump 1 byte filename.error_info file instead of nothing when error occurs, valid when
                                                  // writeDst is 0
     };
@@ -0,0 +1,454 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_debug_fast_dump_compress.h
+//! \brief    Compressed dump container of MediaDebugFastDump
+//! \details  Self contained, shared by the driver and the offline decoder tool.
+//!           A container holds one dump split into blocks, each block is compressed
+//!           by an LZ77 byte codec, optionally after XOR with the previous dump of
+//!           the same surface, which is stored in another container.
+//!
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class MediaDebugFastDumpLz
+{
+public:
+    //!
+    //! \brief  Get max compressed size of data
+    //!
+    static size_t CompressBound(size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    //!
+    //! \brief  Compress data
+    //! \return size_t
+    //!         Compressed size, 0 if the compressed data does not fit into dst
+    //!
+    static size_t Compress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstCapacity)
+    {
+        const uint8_t *ip     = src;
+        const uint8_t *anchor = src;
+        const uint8_t *end    = src + srcSize;
+        uint8_t       *op     = dst;
+        uint8_t       *opEnd  = dst + dstCapacity;
+
+        if (srcSize > m_mfLimit)
+        {
+            std::vector<uint32_t> table(1 << m_hashLog, 0);
+            const uint8_t        *limit      = end - m_mfLimit;
+            const uint8_t        *matchLimit = end - m_lastLiterals;
+
+            while (ip < limit)
+            {
+                uint32_t       seq = Read32(ip);
+                uint32_t      &pos = table[Hash(seq)];
+                const uint8_t *ref = src + pos;
+                pos                = (uint32_t)(ip - src);
+
+                if (ref >= ip || (size_t)(ip - ref) > m_maxOffset || Read32(ref) != seq)
+                {
+                    // Skip faster in data without matches
+                    ip += 1 + ((ip - anchor) >> 6);
+                    continue;
+                }
+
+                size_t matchLen = m_minMatch + MatchLength(ip + m_minMatch, ref + m_minMatch, matchLimit);
+                op              = WriteSequence(op, opEnd, anchor, ip - anchor, (uint16_t)(ip - ref), matchLen);
+                if (op == nullptr)
+                {
+                    return 0;
+                }
+                ip += matchLen;
+                anchor = ip;
+            }
+        }
+
+        op = WriteSequence(op, opEnd, anchor, end - anchor, 0, 0);
+        return op ? op - dst : 0;
+    }
+
+    //!
+    //! \brief  Decompress data
+    //! \return bool
+    //!         true if dstSize bytes are decompressed
+    //!
+    static bool Decompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize)
+    {
+        const uint8_t *ip  = src;
+        const uint8_t *end = src + srcSize;
+        uint8_t       *op  = dst;
+
+        while (ip < end)
+        {
+            uint8_t token  = *ip++;
+            size_t  litLen = token >> 4;
+            if (!ReadLength(ip, end, litLen) ||
+                litLen > (size_t)(end - ip) || litLen > dstSize - (op - dst))
+            {
+                return false;
+            }
+            memcpy(op, ip, litLen);
+            ip += litLen;
+            op += litLen;
+
+            if (ip == end)
+            {
+                break;  // last sequence has literals only
+            }
+
+            if (end - ip < 2)
+            {
+                return false;
+            }
+            size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+            size_t matchLen = token & 0xf;
+            if (offset == 0 || offset > (size_t)(op - dst) || !ReadLength(ip, end, matchLen))
+            {
+                return false;
+            }
+            matchLen += m_minMatch;
+            if (matchLen > dstSize - (op - dst))
+            {
+                return false;
+            }
+
+            const uint8_t *ref = op - offset;
+            if (offset >= matchLen)
+            {
+                memcpy(op, ref, matchLen);
+                op += matchLen;
+            }
+            else
+            {
+                // Overlapped copy repeats the last offset bytes
+                for (size_t i = 0; i < matchLen; i++)
+                {
+                    *op++ = *ref++;
+                }
+            }
+        }
+
+        return (size_t)(op - dst) == dstSize;
+    }
+
+protected:
+    static uint32_t Read32(const uint8_t *p)
+    {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint64_t Read64(const uint8_t *p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static uint32_t Hash(uint32_t seq)
+    {
+        return (seq * 2654435761u) >> (32 - m_hashLog);
+    }
+
+    static size_t MatchLength(const uint8_t *ip, const uint8_t *ref, const uint8_t *limit)
+    {
+        const uint8_t *start = ip;
+        while (ip + 8 <= limit && Read64(ip) == Read64(ref))
+        {
+            ip += 8;
+            ref += 8;
+        }
+        while (ip < limit && *ip == *ref)
+        {
+            ip++;
+            ref++;
+        }
+        return ip - start;
+    }
+
+    static uint8_t *WriteLength(uint8_t *op, uint8_t *opEnd, size_t len)
+    {
+        for (; len >= 255; len -= 255)
+        {
+            if (op >= opEnd)
+            {
+                return nullptr;
+            }
+            *op++ = 255;
+        }
+        if (op >= opEnd)
+        {
+            return nullptr;
+        }
+        *op++ = (uint8_t)len;
+        return op;
+    }
+
+    static bool ReadLength(const uint8_t *&ip, const uint8_t *end, size_t &len)
+    {
+        if (len != 15)
+        {
+            return true;
+        }
+        uint8_t b = 0;
+        do
+        {
+            if (ip >= end)
+            {
+                return false;
+            }
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return true;
+    }
+
+    //!
+    //! \brief  Write token, literals and match, match length 0 means literals only
+    //!
+    static uint8_t *WriteSequence(
+        uint8_t       *op,
+        uint8_t       *opEnd,
+        const uint8_t *literals,
+        size_t         litLen,
+        uint16_t       offset,
+        size_t         matchLen)
+    {
+        size_t matchCode = matchLen ? matchLen - m_minMatch : 0;
+        if (op >= opEnd)
+        {
+            return nullptr;
+        }
+        uint8_t *token = op++;
+        *token         = (uint8_t)(((litLen < 15 ? litLen : 15) << 4) | (matchCode < 15 ? matchCode : 15));
+
+        if (litLen >= 15 && (op = WriteLength(op, opEnd, litLen - 15)) == nullptr)
+        {
+            return nullptr;
+        }
+        if (litLen > (size_t)(opEnd - op))
+        {
+            return nullptr;
+        }
+        memcpy(op, literals, litLen);
+        op += litLen;
+
+        if (matchLen == 0)
+        {
+            return op;
+        }
+        if (opEnd - op < 2)
+        {
+            return nullptr;
+        }
+        *op++ = (uint8_t)offset;
+        *op++ = (uint8_t)(offset >> 8);
+        if (matchCode >= 15)
+        {
+            op = WriteLength(op, opEnd, matchCode - 15);
+        }
+        return op;
+    }
+
+    static const uint32_t m_hashLog      = 16;
+    static const uint32_t m_minMatch     = 4;
+    static const size_t   m_maxOffset    = 65535;
+    static const size_t   m_lastLiterals = 5;   //!< last bytes are always literals, so matches never read past the end
+    static const size_t   m_mfLimit      = 12;  //!< no match starts in the last bytes
+};
+
+class MediaDebugFastDumpContainer
+{
+public:
+    static const uint32_t m_magic        = 0x5a44464d;  //!< "MFDZ"
+    static const uint32_t m_version      = 1;
+    static const uint32_t m_flagDelta    = 0x1;         //!< blocks are XOR of the dump and the reference dump
+    static const uint32_t m_rawBlockFlag = 0x80000000;  //!< block is stored without compression
+    static const uint32_t m_blockSize    = 1 << 20;
+
+    //!
+    //! \brief  Container layout: Header, reference file name, compressed size of each block, blocks
+    //!
+    struct Header
+    {
+        uint32_t magic      = m_magic;
+        uint32_t version    = m_version;
+        uint64_t rawSize    = 0;
+        uint32_t blockSize  = m_blockSize;
+        uint32_t blockCount = 0;
+        uint32_t flags      = 0;
+        uint32_t refNameLen = 0;  //!< reference file name in the same directory, only for delta dump
+    };
+
+    //!
+    //! \brief  Compress one block, the block is stored raw if it does not shrink
+    //! \param  [in] src
+    //!         Data of the block
+    //! \param  [in] size
+    //!         Size of the block
+    //! \param  [in] ref
+    //!         Same block of the reference dump, nullptr if not delta
+    //! \param  [out] out
+    //!         Compressed block
+    //! \return uint32_t
+    //!         Block size to record in the container
+    //!
+    static uint32_t CompressBlock(const uint8_t *src, uint32_t size, const uint8_t *ref, std::vector<uint8_t> &out)
+    {
+        std::vector<uint8_t> delta;
+        if (ref)
+        {
+            delta.resize(size);
+            for (uint32_t i = 0; i < size; i++)
+            {
+                delta[i] = src[i] ^ ref[i];
+            }
+            src = delta.data();
+        }
+
+        out.resize(MediaDebugFastDumpLz::CompressBound(size));
+        size_t compressed = MediaDebugFastDumpLz::Compress(src, size, out.data(), size - 1);
+        if (compressed == 0)
+        {
+            out.assign(src, src + size);
+            return size | m_rawBlockFlag;
+        }
+        out.resize(compressed);
+        return (uint32_t)compressed;
+    }
+
+    //!
+    //! \brief  Load a container and restore the dump, reference dumps are loaded recursively
+    //! \param  [in] path
+    //!         Path of the container
+    //! \param  [out] data
+    //!         Restored dump
+    //! \param  [out] error
+    //!         Error message if failed
+    //! \return bool
+    //!         true if success
+    //!
+    static bool Load(const std::string &path, std::vector<uint8_t> &data, std::string &error, uint32_t depth = 0)
+    {
+        std::ifstream ifs(path, std::ios_base::in | std::ios_base::binary);
+        if (!ifs)
+        {
+            error = "cannot open " + path;
+            return false;
+        }
+
+        Header header;
+        ifs.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!ifs || header.magic != m_magic || header.version != m_version || header.blockSize == 0 ||
+            header.blockCount != (header.rawSize + header.blockSize - 1) / header.blockSize)
+        {
+            error = "invalid header in " + path;
+            return false;
+        }
+
+        std::string refName(header.refNameLen, '\0');
+        ifs.read(&refName[0], header.refNameLen);
+        std::vector<uint32_t> blockSizes(header.blockCount);
+        ifs.read(reinterpret_cast<char *>(blockSizes.data()), blockSizes.size() * sizeof(uint32_t));
+        if (!ifs)
+        {
+            error = "truncated header in " + path;
+            return false;
+        }
+
+        std::vector<uint8_t> ref;
+        if (header.flags & m_flagDelta)
+        {
+            if (depth > 1024)
+            {
+                error = "reference chain is too long at " + path;
+                return false;
+            }
+            size_t      dirEnd  = path.find_last_of('/');
+            std::string refPath = (dirEnd == std::string::npos ? "" : path.substr(0, dirEnd + 1)) + refName;
+            if (!Load(refPath, ref, error, depth + 1))
+            {
+                return false;
+            }
+            if (ref.size() != header.rawSize)
+            {
+                error = "size of reference " + refPath + " mismatches";
+                return false;
+            }
+        }
+
+        data.resize(header.rawSize);
+        std::vector<uint8_t> block;
+        for (uint32_t i = 0; i < header.blockCount; i++)
+        {
+            uint64_t offset  = (uint64_t)i * header.blockSize;
+            uint32_t rawSize = (uint32_t)std::min<uint64_t>(header.blockSize, header.rawSize - offset);
+            uint32_t size    = blockSizes[i] & ~m_rawBlockFlag;
+            uint8_t *dst     = data.data() + offset;
+
+            block.resize(size);
+            ifs.read(reinterpret_cast<char *>(block.data()), size);
+            if (!ifs)
+            {
+                error = "truncated block " + std::to_string(i) + " in " + path;
+                return false;
+            }
+
+            if (blockSizes[i] & m_rawBlockFlag)
+            {
+                if (size != rawSize)
+                {
+                    error = "invalid raw block " + std::to_string(i) + " in " + path;
+                    return false;
+                }
+                memcpy(dst, block.data(), size);
+            }
+            else if (!MediaDebugFastDumpLz::Decompress(block.data(), size, dst, rawSize))
+            {
+                error = "corrupted block " + std::to_string(i) + " in " + path;
+                return false;
+            }
+
+            if (!ref.empty())
+            {
+                for (uint32_t j = 0; j < rawSize; j++)
+                {
+                    dst[j] ^= ref[offset + j];
+                }
+            }
+        }
+
+        return true;
+    }
+};
@@ -26,6 +26,7 @@
 #pragma once
 
 #include "media_debug_fast_dump.h"
+#include "media_debug_fast_dump_compress.h"
 
 #if USE_MEDIA_DEBUG_TOOL
 
@@ -214,6 +215,210 @@ protected:
         std::vector<File> m_files;
     };
 
+    class CompressedWriter final
+    {
+    private:
+        struct File
+        {
+            std::string          name;
+            std::vector<uint8_t> data;
+        };
+
+        struct Reference
+        {
+            std::string          name;  // file name without directory
+            std::vector<uint8_t> data;
+            uint32_t             dumps = 0;
+        };
+
+    public:
+        CompressedWriter(size_t threadNum, bool delta) : m_delta(delta)
+        {
+            for (size_t i = 0; i < threadNum; i++)
+            {
+                m_workers.emplace_back([this] { CompressTasks(); });
+            }
+            m_writer = std::thread([this] { WriteFiles(); });
+        }
+
+        ~CompressedWriter()
+        {
+            {
+                std::lock_guard<std::mutex> lk(m_taskMutex);
+                m_stop = true;
+            }
+            m_taskCond.notify_all();
+            {
+                std::lock_guard<std::mutex> lk(m_fileMutex);
+                m_fileStop = true;
+            }
+            m_fileCond.notify_all();
+
+            for (auto &w : m_workers)
+            {
+                w.join();
+            }
+            m_writer.join();
+        }
+
+        CompressedWriter(const CompressedWriter &) = delete;
+
+        CompressedWriter &operator=(const CompressedWriter &) = delete;
+
+        void operator()(std::string &&name, const void *data, size_t size)
+        {
+            using Container = MediaDebugFastDumpContainer;
+
+            std::lock_guard<std::mutex> lk(m_mutex);
+
+            auto src       = static_cast<const uint8_t *>(data);
+            auto dirEnd    = name.find_last_of('/');
+            auto dir       = dirEnd == std::string::npos ? std::string() : name.substr(0, dirEnd + 1);
+            auto baseName  = name.substr(dir.size());
+            auto key       = dir + std::regex_replace(baseName, std::regex("[0-9]+"), "#");
+            auto &ref      = m_refs[key];
+            bool  useDelta = m_delta && !ref.name.empty() && ref.data.size() == size &&
+                            ref.dumps % m_keyFrameInterval != 0;
+
+            Container::Header header;
+            header.rawSize    = size;
+            header.blockCount = static_cast<uint32_t>((size + header.blockSize - 1) / header.blockSize);
+            header.flags      = useDelta ? Container::m_flagDelta : 0;
+            header.refNameLen = useDelta ? static_cast<uint32_t>(ref.name.size()) : 0;
+
+            // compress blocks in parallel
+            std::vector<std::vector<uint8_t>> blocks(header.blockCount);
+            std::vector<uint32_t>             blockSizes(header.blockCount);
+            std::vector<std::future<void>>    results;
+            for (uint32_t i = 0; i < header.blockCount; i++)
+            {
+                size_t offset    = static_cast<size_t>(i) * header.blockSize;
+                auto   blockSize = static_cast<uint32_t>(std::min<size_t>(header.blockSize, size - offset));
+                auto   blockRef  = useDelta ? ref.data.data() + offset : nullptr;
+                auto   task      = std::make_shared<std::packaged_task<void()>>(
+                    [&blocks, &blockSizes, i, src, offset, blockSize, blockRef] {
+                        blockSizes[i] = Container::CompressBlock(src + offset, blockSize, blockRef, blocks[i]);
+                    });
+                results.emplace_back(task->get_future());
+                {
+                    std::lock_guard<std::mutex> taskLk(m_taskMutex);
+                    m_tasks.emplace([task] { (*task)(); });
+                }
+                m_taskCond.notify_one();
+            }
+            for (auto &r : results)
+            {
+                r.wait();
+            }
+
+            File file;
+            file.name      = std::move(name);
+            size_t fileSize = sizeof(header) + header.refNameLen + blockSizes.size() * sizeof(uint32_t);
+            for (const auto &b : blocks)
+            {
+                fileSize += b.size();
+            }
+            file.data.resize(fileSize);
+            auto dst = file.data.data();
+            memcpy(dst, &header, sizeof(header));
+            dst += sizeof(header);
+            memcpy(dst, ref.name.data(), header.refNameLen);
+            dst += header.refNameLen;
+            memcpy(dst, blockSizes.data(), blockSizes.size() * sizeof(uint32_t));
+            dst += blockSizes.size() * sizeof(uint32_t);
+            for (const auto &b : blocks)
+            {
+                memcpy(dst, b.data(), b.size());
+                dst += b.size();
+            }
+
+            // keep current dump as the reference of the next dump of the same surface
+            if (m_delta)
+            {
+                ref.name = std::move(baseName);
+                ref.data.assign(src, src + size);
+                ref.dumps = useDelta ? ref.dumps + 1 : 1;
+            }
+
+            std::unique_lock<std::mutex> fileLk(m_fileMutex);
+            m_fileCond.wait(fileLk, [this] { return m_files.size() < m_maxPendingFiles; });
+            m_files.emplace(std::move(file));
+            fileLk.unlock();
+            m_fileCond.notify_all();
+        }
+
+        void operator()(
+            std::string &&name,
+            const void   *data,
+            size_t        size,
+            std::function<void(std::ostream &, const void *, size_t)> &&)
+        {
+            (*this)(std::move(name), data, size);
+        }
+
+    private:
+        void CompressTasks()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lk(m_taskMutex);
+                    m_taskCond.wait(lk, [this] { return m_stop || !m_tasks.empty(); });
+                    if (m_tasks.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop();
+                }
+                task();
+            }
+        }
+
+        void WriteFiles()
+        {
+            while (true)
+            {
+                File file;
+                {
+                    std::unique_lock<std::mutex> lk(m_fileMutex);
+                    m_fileCond.wait(lk, [this] { return m_fileStop || !m_files.empty(); });
+                    if (m_files.empty())
+                    {
+                        return;
+                    }
+                    file = std::move(m_files.front());
+                    m_files.pop();
+                }
+                m_fileCond.notify_all();
+
+                std::ofstream ofs(file.name, std::ios_base::out | std::ios_base::binary);
+                ofs.write(reinterpret_cast<const char *>(file.data.data()), file.data.size());
+            }
+        }
+
+    private:
+        static constexpr uint32_t m_keyFrameInterval = 16;  // max length of the delta chain
+        static constexpr size_t   m_maxPendingFiles  = 8;
+
+        const bool                       m_delta;
+        std::mutex                       m_mutex;  // serializes dumps, compression of one dump runs on all workers
+        std::map<std::string, Reference> m_refs;
+
+        std::vector<std::thread>          m_workers;
+        std::queue<std::function<void()>> m_tasks;
+        std::mutex                        m_taskMutex;
+        std::condition_variable           m_taskCond;
+        bool                              m_stop = false;
+
+        std::thread             m_writer;
+        std::queue<File>        m_files;
+        std::mutex              m_fileMutex;
+        std::condition_variable m_fileCond;
+        bool                    m_fileStop = false;
+    };
+
 protected:
     static size_t GetResSizeAndFixName(PGMM_RESOURCE_INFO pGmmResInfo, std::string &name)
     {
@@ -664,6 +869,17 @@ protected:
                     ofs.write(static_cast<const char *>(data), size);
                 };
             }
+            else if (cfg.writeMode == 3)
+            {
+                auto writer = std::make_shared<CompressedWriter>(cfg.compressThreads, cfg.deltaCompress);
+                m_write     = [writer](
+                              std::string &&name,
+                              const void   *data,
+                              size_t        size,
+                              std::function<void(std::ostream &, const void *, size_t)> &&) {
+                    (*writer)(std::move(name), data, size);
+                };
+            }
             else if (cfg.writeMode == 1)
             {
                 m_write = [](std::string &&name,
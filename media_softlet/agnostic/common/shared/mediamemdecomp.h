@@ -73,6 +73,36 @@ public:
     virtual MOS_STATUS MemoryDecompress(
         PMOS_RESOURCE targetResource) = 0;
 
+    //!
+    //! \brief    Media memory decompression of several resources
+    //! \details  Entry point to decompress all resources needed by one frame together
+    //! \param    targetResources
+    //!           [in] Array of the surfaces will be decompressed
+    //! \param    count
+    //!           [in] Number of surfaces
+    //!
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS MemoryDecompressBatch(
+        PMOS_RESOURCE *targetResources,
+        uint32_t       count)
+    {
+        if (targetResources == nullptr)
+        {
+            return MOS_STATUS_NULL_POINTER;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            MOS_STATUS status = MemoryDecompress(targetResources[i]);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                return status;
+            }
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
     //!
     //! \brief    Media memory decompression
     //! \details  Entry point to decompress media memory and copy
@@ -24,10 +24,12 @@
 //! \brief    Defines data structures and interfaces for media memory decompression.
 //! \details
 //!
+#include <algorithm>
 #include "media_mem_decompression_next.h"
 #include "vp_utils.h"
 #include "renderhal.h"
 #include "mos_os_cp_interface_specific.h"
+#include "mos_interface.h"
 
 MediaMemDeCompNext::MediaMemDeCompNext():
     m_osInterface(nullptr),
@@ -79,12 +81,21 @@ MediaMemDeCompNext::~MediaMemDeCompNext()
 
 MOS_STATUS MediaMemDeCompNext::MemoryDecompress(PMOS_RESOURCE targetResource)
 {
-    MOS_STATUS              eStatus = MOS_STATUS_SUCCESS;
-    MOS_SURFACE             targetSurface = {};
+    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(targetResource);
+
+    return MemoryDecompressBatch(&targetResource, 1);
+}
+
+MOS_STATUS MediaMemDeCompNext::MemoryDecompressBatch(PMOS_RESOURCE *targetResources, uint32_t count)
+{
+    MOS_STATUS                 eStatus = MOS_STATUS_SUCCESS;
+    std::vector<MOS_SURFACE>   targetSurfaces;
+    std::vector<PMOS_RESOURCE> decompResources;
 
     MHW_FUNCTION_ENTER;
 
-    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(targetResource);
+    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(targetResources);
+    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_osInterface);
     MOS_TraceEventExt(EVENT_MEDIA_COPY, EVENT_TYPE_START, nullptr, 0, nullptr, 0);
 #if MOS_MEDIASOLO_SUPPORTED
     if (m_osInterface->bSoloInUse)
@@ -96,50 +107,103 @@ MOS_STATUS MediaMemDeCompNext::MemoryDecompress(PMOS_RESOURCE targetResource)
     {
         if (m_veboxMMCResolveEnabled)
         {
-            MOS_ZeroMemory(&targetSurface, sizeof(MOS_SURFACE));
-
-            targetSurface.Format = Format_Invalid;
-            targetSurface.OsResource = *targetResource;
-            VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(GetResourceInfo(&targetSurface));
+            VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_renderMutex);
+            uint32_t skipped = 0;
 
-            //Get context before proceeding
-            auto gpuContext = m_osInterface->CurrentGpuContextOrdinal;
-
-            if (targetSurface.bCompressible)
+            for (uint32_t i = 0; i < count; i++)
             {
-                VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(m_renderMutex);
-                MosUtilities::MosLockMutex(m_renderMutex);
+                PMOS_RESOURCE targetResource = targetResources[i];
+                VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(targetResource);
+
+                // Not written since last decompression, or already in this batch
+                if (MosInterface::IsResourceDecompressed(targetResource) ||
+                    std::any_of(decompResources.begin(), decompResources.end(), [targetResource](PMOS_RESOURCE res) {
+                        return res->pGmmResInfo == targetResource->pGmmResInfo;
+                    }))
+                {
+                    skipped++;
+                    continue;
+                }
 
+                MOS_SURFACE targetSurface = {};
+                targetSurface.Format      = Format_Invalid;
+                targetSurface.OsResource  = *targetResource;
+                VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(GetResourceInfo(&targetSurface));
+
+                if (targetSurface.bCompressible)
+                {
 #if (_DEBUG || _RELEASE_INTERNAL) && !defined(LINUX)
-                TRACEDATA_MEDIA_MEM_DECOMP eventData = {0};
-                TRACEDATA_MEDIA_MEM_DECOMP_INIT(
-                    eventData,
-                    targetResource->AllocationInfo.m_AllocationHandle,
-                    targetSurface.dwWidth,
-                    targetSurface.dwHeight,
-                    targetSurface.Format,
-                    *((int64_t *)&targetResource->pGmmResInfo->GetResFlags().Gpu),
-                    *((int64_t *)&targetResource->pGmmResInfo->GetResFlags().Info)
-                );
-                MOS_TraceEventExt(EVENT_DDI_MEDIA_MEM_DECOMP_CALLBACK, EVENT_TYPE_INFO, &eventData, sizeof(eventData), nullptr, 0);
+                    TRACEDATA_MEDIA_MEM_DECOMP eventData = {0};
+                    TRACEDATA_MEDIA_MEM_DECOMP_INIT(
+                        eventData,
+                        targetResource->AllocationInfo.m_AllocationHandle,
+                        targetSurface.dwWidth,
+                        targetSurface.dwHeight,
+                        targetSurface.Format,
+                        *((int64_t *)&targetResource->pGmmResInfo->GetResFlags().Gpu),
+                        *((int64_t *)&targetResource->pGmmResInfo->GetResFlags().Info)
+                    );
+                    MOS_TraceEventExt(EVENT_DDI_MEDIA_MEM_DECOMP_CALLBACK, EVENT_TYPE_INFO, &eventData, sizeof(eventData), nullptr, 0);
 #endif
-                eStatus = RenderDecompCMD(&targetSurface);
+                    targetSurfaces.push_back(targetSurface);
+                    decompResources.push_back(targetResource);
+                }
+            }
+
+            MosUtilities::MosLockMutex(m_renderMutex);
+
+            for (uint32_t start = 0; start < targetSurfaces.size(); start += m_maxDecompBatchSize)
+            {
+                uint32_t num = (uint32_t)targetSurfaces.size() - start;
+                if (num > m_maxDecompBatchSize)
+                {
+                    num = m_maxDecompBatchSize;
+                }
+
+                eStatus = RenderDecompBatchCMD(&targetSurfaces[start], num);
                 if (eStatus != MOS_STATUS_SUCCESS)
                 {
-                    MosUtilities::MosUnlockMutex(m_renderMutex);
-                    VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(eStatus);
+                    break;
                 }
-                else
+
+                // Epoch is recorded after the submission which increases the write epoch of the resources
+                for (uint32_t i = start; i < start + num; i++)
                 {
-                    MosUtilities::MosUnlockMutex(m_renderMutex);
+                    MosInterface::SetResourceDecompressed(decompResources[i]);
                 }
+                m_decompSubmitted += num;
             }
+            m_decompSkipped += skipped;
+
+            uint64_t counters[2] = {m_decompSubmitted, m_decompSkipped};
+            MosUtilities::MosUnlockMutex(m_renderMutex);
+
+            VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(eStatus);
+
+            if (skipped)
+            {
+                VPHAL_MEMORY_DECOMP_VERBOSEMESSAGE("%u redundant decompressions avoided, total %llu decompressed and %llu avoided",
+                    skipped, (unsigned long long)counters[0], (unsigned long long)counters[1]);
+            }
+            MOS_TraceEventExt(EVENT_MEDIA_COPY, EVENT_TYPE_INFO2, counters, sizeof(counters), nullptr, 0);
         }
     }
     MOS_TraceEventExt(EVENT_MEDIA_COPY, EVENT_TYPE_END, nullptr, 0, nullptr, 0);
     return eStatus;
 }
 
+MOS_STATUS MediaMemDeCompNext::RenderDecompBatchCMD(PMOS_SURFACE surfaces, uint32_t count)
+{
+    VPHAL_MEMORY_DECOMP_CHK_NULL_RETURN(surfaces);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        VPHAL_MEMORY_DECOMP_CHK_STATUS_RETURN(RenderDecompCMD(&surfaces[i]));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS MediaMemDeCompNext::MediaMemoryCopy(PMOS_RESOURCE inputResource, PMOS_RESOURCE outputResource, bool outputCompressed)
 {
     MOS_STATUS eStatus             = MOS_STATUS_SUCCESS;
@@ -105,6 +105,21 @@ public:
     virtual MOS_STATUS RenderDecompCMD(
         PMOS_SURFACE surface) = 0;
 
+    //!
+    //! \brief    Media memory decompression render of several surfaces
+    //! \details  Decompress surfaces in place, platforms supporting it put all surfaces
+    //!           into one submission, otherwise each surface is submitted separately
+    //! \param    [in] surfaces
+    //!           Array of input surfaces will be decompressed
+    //! \param    [in] count
+    //!           Number of surfaces
+    //!
+    //! \return   MOS_STATUS_SUCCESS if succeeded, else error code.
+    //!
+    virtual MOS_STATUS RenderDecompBatchCMD(
+        PMOS_SURFACE surfaces,
+        uint32_t     count);
+
     //!
     //! \brief    Media memory double buffer decompression render
     //! \details  Entry point to decompress media memory
@@ -130,6 +145,21 @@ public:
     virtual MOS_STATUS MemoryDecompress(
         PMOS_RESOURCE targetResource);
 
+    //!
+    //! \brief    Media memory decompression of several resources
+    //! \details  Resources not written since their last decompression are skipped,
+    //!           the others are decompressed with one submission
+    //! \param    [in] targetResources
+    //!            Array of the surfaces will be decompressed
+    //! \param    [in] count
+    //!            Number of surfaces
+    //!
+    //! \return   MOS_STATUS_SUCCESS if succeeded, else error code.
+    //!
+    virtual MOS_STATUS MemoryDecompressBatch(
+        PMOS_RESOURCE *targetResources,
+        uint32_t       count);
+
     //!
     //! \brief    Media memory decompression Enabled or not
     //! \details  Media memory decompression Enabled or not
@@ -336,6 +366,10 @@ protected:
     bool                                    m_veboxMMCResolveEnabled;
     PMOS_MUTEX                              m_renderMutex = nullptr;
 
+    static const uint32_t m_maxDecompBatchSize = 16;  //!< Max number of surfaces decompressed in one submission
+    uint64_t              m_decompSubmitted    = 0;   //!< Number of surfaces decompressed, protected by m_renderMutex
+    uint64_t              m_decompSkipped      = 0;   //!< Number of redundant decompressions avoided, protected by m_renderMutex
+
     MediaUserSettingSharedPtr m_userSettingPtr = nullptr;  //!< UserSettingInstance
 MEDIA_CLASS_DEFINE_END(MediaMemDeCompNext)
 };
@@ -41,6 +41,7 @@
 #include "mhw_cmdpar.h"
 #include "mhw_mi_itf.h"
 class MediaStatusReport;
+class MediaPacketLatency;
 class MhwMiInterface;
 namespace mhw{namespace mi{class Itf;}}  // namespace mhw
 
@@ -193,6 +194,31 @@ public:
         return "";
     }
 
+    //!
+    //! \brief  Get MI interface of the packet
+    //! \return std::shared_ptr<mhw::mi::Itf>
+    //!         MI interface, nullptr if the packet does not use it
+    //!
+    std::shared_ptr<mhw::mi::Itf> GetMiItf()
+    {
+        return m_miItf;
+    }
+
+    //!
+    //! \brief  Set latency recorder for the next Submit()
+    //! \details Timestamps are written by StartStatusReportNext() and EndStatusReportNext(),
+    //!         so that they are inside the batch buffer of the packet
+    //! \param  [in] packetLatency
+    //!         Latency recorder of the task, nullptr to stop recording
+    //! \param  [in] packetId
+    //!         Packet id the latency is recorded for
+    //!
+    void SetPacketLatency(MediaPacketLatency *packetLatency, uint32_t packetId)
+    {
+        m_packetLatency   = packetLatency;
+        m_latencyPacketId = packetId;
+    }
+
 protected:
 
     //!
@@ -347,6 +373,8 @@ protected:
     MediaStatusReport             *m_statusReport = nullptr;
     std::shared_ptr<mhw::mi::Itf> m_miItf         = nullptr;
     MediaUserSettingSharedPtr     m_userSettingPtr = nullptr;  //!< usersettingInstance
+    MediaPacketLatency            *m_packetLatency   = nullptr;  //!< Latency recorder of the task, nullptr if disabled
+    uint32_t                      m_latencyPacketId = 0;
 MEDIA_CLASS_DEFINE_END(MediaPacket)
 };
  
@@ -31,6 +31,7 @@
 #include "media_utils.h"
 #include "codec_def_common.h"
 #include "media_status_report.h"
+#include "media_packet_latency.h"
 #include "mhw_mi.h"
 #include "mhw_mi_cmdpar.h"
 #include "mhw_mi_itf.h"
@@ -54,6 +55,11 @@ MOS_STATUS MediaPacket::StartStatusReportNext(
 
     result = SetStartTagNext(osResource, offset, srType, cmdBuffer);
 
+    if (m_packetLatency != nullptr)
+    {
+        MEDIA_CHK_STATUS_RETURN(m_packetLatency->AddBeginCmd(m_miItf, m_latencyPacketId, cmdBuffer));
+    }
+
     MEDIA_CHK_STATUS_RETURN(NullHW::StartPredicateNext(m_osInterface, m_miItf, cmdBuffer));
 
     return result;
@@ -104,6 +110,11 @@ MOS_STATUS MediaPacket::EndStatusReportNext(
 
     MEDIA_CHK_STATUS_RETURN(NullHW::StopPredicateNext(m_osInterface, m_miItf, cmdBuffer));
 
+    if (m_packetLatency != nullptr)
+    {
+        MEDIA_CHK_STATUS_RETURN(m_packetLatency->AddEndCmd(m_miItf, cmdBuffer));
+    }
+
     result = m_statusReport->GetAddress(srType, osResource, offset);
 
     result = SetEndTagNext(osResource, offset, srType, cmdBuffer);
@@ -38,6 +38,18 @@ MOS_STATUS MediaPipeline::InitUserSetting(MediaUserSettingSharedPtr userSettingP
         MediaUserSetting::Group::Sequence,
         int32_t(1),
         false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Media Memory Budget",
+        MediaUserSetting::Group::Sequence,
+        uint32_t(0),
+        false);
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Enable Packet Latency Histogram",
+        MediaUserSetting::Group::Sequence,
+        false,
+        false);
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
@@ -0,0 +1,244 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_packet_latency.cpp
+//! \brief    Implements the GPU latency histograms of media packets
+//!
+
+#include <stddef.h>
+#include "media_packet_latency.h"
+#include "mhw_mi_itf.h"
+#include "mhw_mi_cmdpar.h"
+#include "media_utils.h"
+#include "mos_utilities.h"
+
+std::map<uint32_t, MediaPacketLatency::Histogram> MediaPacketLatency::m_histograms;
+std::mutex                                        MediaPacketLatency::m_histogramsMutex;
+
+MediaPacketLatency::MediaPacketLatency(PMOS_INTERFACE osInterface) : m_osInterface(osInterface)
+{
+}
+
+MediaPacketLatency::~MediaPacketLatency()
+{
+    if (m_initialized)
+    {
+        Collect();
+        m_osInterface->pfnUnlockResource(m_osInterface, &m_resource);
+        m_osInterface->pfnFreeResource(m_osInterface, &m_resource);
+    }
+}
+
+MOS_STATUS MediaPacketLatency::Initialize()
+{
+    MEDIA_CHK_NULL_RETURN(m_osInterface);
+
+    m_tsFrequency = m_osInterface->pfnGetTsFrequency(m_osInterface);
+    if (m_tsFrequency == 0)
+    {
+        // Timestamps cannot be converted to time without frequency
+        return MOS_STATUS_UNIMPLEMENTED;
+    }
+
+    MOS_ALLOC_GFXRES_PARAMS allocParams;
+    MOS_ZeroMemory(&allocParams, sizeof(allocParams));
+    allocParams.Type     = MOS_GFXRES_BUFFER;
+    allocParams.TileType = MOS_TILE_LINEAR;
+    allocParams.Format   = Format_Buffer;
+    allocParams.dwBytes  = m_entryNum * sizeof(Entry);
+    allocParams.pBufName = "PacketLatencyBuffer";
+    MEDIA_CHK_STATUS_RETURN(m_osInterface->pfnAllocateResource(m_osInterface, &allocParams, &m_resource));
+
+    MOS_LOCK_PARAMS lockFlags;
+    MOS_ZeroMemory(&lockFlags, sizeof(lockFlags));
+    m_entries = (Entry *)m_osInterface->pfnLockResource(m_osInterface, &m_resource, &lockFlags);
+    if (m_entries == nullptr)
+    {
+        m_osInterface->pfnFreeResource(m_osInterface, &m_resource);
+        return MOS_STATUS_NULL_POINTER;
+    }
+    MOS_ZeroMemory(m_entries, m_entryNum * sizeof(Entry));
+
+    m_initialized = true;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaPacketLatency::StoreTimestamp(std::shared_ptr<mhw::mi::Itf> miItf, PMOS_COMMAND_BUFFER cmdBuffer, uint32_t offset)
+{
+    MEDIA_CHK_NULL_RETURN(miItf);
+
+    MOS_GPU_CONTEXT gpuContext = m_osInterface->pfnGetGpuContext(m_osInterface);
+    if (MOS_RCS_ENGINE_USED(gpuContext))
+    {
+        auto &params            = miItf->MHW_GETPAR_F(PIPE_CONTROL)();
+        params                  = {};
+        params.dwResourceOffset = offset;
+        params.dwPostSyncOp     = MHW_FLUSH_WRITE_TIMESTAMP_REG;
+        params.dwFlushMode      = MHW_FLUSH_READ_CACHE;
+        params.presDest         = &m_resource;
+        MEDIA_CHK_STATUS_RETURN(miItf->MHW_ADDCMD_F(PIPE_CONTROL)(cmdBuffer));
+    }
+    else
+    {
+        auto &params             = miItf->MHW_GETPAR_F(MI_FLUSH_DW)();
+        params                   = {};
+        params.postSyncOperation = MHW_FLUSH_WRITE_TIMESTAMP_REG;
+        params.dwResourceOffset  = offset;
+        params.pOsResource       = &m_resource;
+        MEDIA_CHK_STATUS_RETURN(miItf->MHW_ADDCMD_F(MI_FLUSH_DW)(cmdBuffer));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaPacketLatency::AddBeginCmd(std::shared_ptr<mhw::mi::Itf> miItf, uint32_t packetId, PMOS_COMMAND_BUFFER cmdBuffer)
+{
+    MEDIA_CHK_NULL_RETURN(cmdBuffer);
+
+    m_packetStarted = false;
+    if (miItf == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    if (!m_initialized)
+    {
+        if (Initialize() != MOS_STATUS_SUCCESS)
+        {
+            return MOS_STATUS_SUCCESS;
+        }
+    }
+
+    MEDIA_CHK_STATUS_RETURN(Collect());
+    if (m_writeIndex - m_readIndex >= m_entryNum)
+    {
+        // The oldest entry is left by a frame which was never submitted, GPU cannot be
+        // that many packets behind, so drop it instead of stalling the ring.
+        m_readIndex++;
+    }
+
+    uint32_t index     = m_writeIndex % m_entryNum;
+    m_entries[index]   = {};
+    m_packetIds[index] = packetId;
+    MEDIA_CHK_STATUS_RETURN(StoreTimestamp(miItf, cmdBuffer, index * sizeof(Entry) + offsetof(Entry, beginTimestamp)));
+    m_packetStarted = true;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaPacketLatency::AddEndCmd(std::shared_ptr<mhw::mi::Itf> miItf, PMOS_COMMAND_BUFFER cmdBuffer)
+{
+    MEDIA_CHK_NULL_RETURN(cmdBuffer);
+
+    if (!m_packetStarted)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+    m_packetStarted = false;
+
+    uint32_t index = m_writeIndex % m_entryNum;
+    MEDIA_CHK_STATUS_RETURN(StoreTimestamp(miItf, cmdBuffer, index * sizeof(Entry) + offsetof(Entry, endTimestamp)));
+    m_writeIndex++;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaPacketLatency::Collect()
+{
+    if (!m_initialized)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    while (m_readIndex < m_writeIndex)
+    {
+        uint32_t index = m_readIndex % m_entryNum;
+        uint64_t begin = m_entries[index].beginTimestamp;
+        uint64_t end   = m_entries[index].endTimestamp;
+        if (begin == 0 || end == 0)
+        {
+            // Entries complete in order, stop at the first one still in flight
+            break;
+        }
+
+        if (end >= begin)
+        {
+            AddLatency(m_packetIds[index], (end - begin) * 1000000000ull / m_tsFrequency);
+        }
+        m_readIndex++;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MediaPacketLatency::AddLatency(uint32_t packetId, uint64_t latencyNs)
+{
+    std::lock_guard<std::mutex> lock(m_histogramsMutex);
+
+    Histogram &histogram = m_histograms[packetId];
+    histogram.count++;
+    histogram.totalNs += latencyNs;
+    histogram.buckets[GetBucket(latencyNs)]++;
+
+    if (histogram.count % m_traceInterval == 0)
+    {
+        uint64_t data[] = {histogram.count, histogram.totalNs / histogram.count, GetPercentile(histogram, 50), GetPercentile(histogram, 99)};
+        MOS_TraceEventExt(EVENT_PIPE_PACKET, EVENT_TYPE_INFO2, &packetId, sizeof(packetId), data, sizeof(data));
+    }
+}
+
+void MediaPacketLatency::GetHistograms(std::map<uint32_t, Histogram> &histograms)
+{
+    std::lock_guard<std::mutex> lock(m_histogramsMutex);
+    histograms = m_histograms;
+}
+
+uint64_t MediaPacketLatency::GetPercentile(const Histogram &histogram, uint32_t percent)
+{
+    if (histogram.count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank  = (histogram.count * MOS_MIN(percent, 100) + 99) / 100;
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < m_bucketNum; i++)
+    {
+        total += histogram.buckets[i];
+        if (total >= rank)
+        {
+            return (2ull << i) - 1;
+        }
+    }
+
+    return (2ull << (m_bucketNum - 1)) - 1;
+}
+
+uint32_t MediaPacketLatency::GetBucket(uint64_t latencyNs)
+{
+    uint32_t bucket = 0;
+    while (latencyNs > 1 && bucket < m_bucketNum - 1)
+    {
+        latencyNs >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
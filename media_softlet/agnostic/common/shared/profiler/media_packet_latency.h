@@ -0,0 +1,164 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_packet_latency.h
+//! \brief    Defines the GPU latency histograms of media packets
+//! \details  Packets of each command task write GPU timestamps at start and end of
+//!           their status report, inside their own batch buffer, into a small ring
+//!           buffer of the task. Packets without status report are not recorded. Completed entries are folded into log-scale
+//!           histograms per packet id, which are shared by all tasks of the process.
+//!
+
+#ifndef __MEDIA_PACKET_LATENCY_H__
+#define __MEDIA_PACKET_LATENCY_H__
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include "mos_defs.h"
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+namespace mhw
+{
+    namespace mi
+    {
+        class Itf;
+    }
+}  // namespace mhw
+
+class MediaPacketLatency
+{
+public:
+    static const uint32_t m_bucketNum = 32;  //!< Bucket i counts latency in [2^i, 2^(i+1)) ns
+
+    struct Histogram
+    {
+        uint64_t count                = 0;
+        uint64_t totalNs              = 0;
+        uint64_t buckets[m_bucketNum] = {};
+    };
+
+    //!
+    //! \brief  MediaPacketLatency constructor
+    //! \param  [in] osInterface
+    //!         Os interface of the task
+    //!
+    MediaPacketLatency(PMOS_INTERFACE osInterface);
+
+    //!
+    //! \brief  MediaPacketLatency deconstructor
+    //!
+    virtual ~MediaPacketLatency();
+
+    //!
+    //! \brief  Write begin timestamp of one packet, the oldest entry is dropped if the ring is full
+    //! \param  [in] miItf
+    //!         MI interface of the packet
+    //! \param  [in] packetId
+    //!         Packet id
+    //! \param  [in] cmdBuffer
+    //!         Command buffer
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AddBeginCmd(std::shared_ptr<mhw::mi::Itf> miItf, uint32_t packetId, PMOS_COMMAND_BUFFER cmdBuffer);
+
+    //!
+    //! \brief  Write end timestamp of the packet started by AddBeginCmd()
+    //! \param  [in] miItf
+    //!         MI interface of the packet
+    //! \param  [in] cmdBuffer
+    //!         Command buffer
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS AddEndCmd(std::shared_ptr<mhw::mi::Itf> miItf, PMOS_COMMAND_BUFFER cmdBuffer);
+
+    //!
+    //! \brief  Fold the entries completed by GPU into the histograms, never waits for GPU
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Collect();
+
+    //!
+    //! \brief  Get histograms of all packets executed in the process
+    //! \param  [out] histograms
+    //!         Histograms indexed by packet id
+    //!
+    static void GetHistograms(std::map<uint32_t, Histogram> &histograms);
+
+    //!
+    //! \brief  Get latency percentile from histogram
+    //! \param  [in] histogram
+    //!         Histogram of one packet
+    //! \param  [in] percent
+    //!         Percentile in [1, 100]
+    //! \return uint64_t
+    //!         Upper bound of the bucket holding the percentile in ns, 0 if histogram is empty
+    //!
+    static uint64_t GetPercentile(const Histogram &histogram, uint32_t percent);
+
+    //!
+    //! \brief  Get bucket index of latency
+    //! \param  [in] latencyNs
+    //!         Latency in ns
+    //! \return uint32_t
+    //!
+    static uint32_t GetBucket(uint64_t latencyNs);
+
+    static const uint32_t m_cmdSizePerPacket   = 128;  //!< Command buffer size of the two timestamp writes
+    static const uint32_t m_patchListPerPacket = 2;
+
+protected:
+    struct Entry
+    {
+        uint64_t beginTimestamp;
+        uint64_t endTimestamp;
+    };
+
+    MOS_STATUS Initialize();
+    MOS_STATUS StoreTimestamp(std::shared_ptr<mhw::mi::Itf> miItf, PMOS_COMMAND_BUFFER cmdBuffer, uint32_t offset);
+    void       AddLatency(uint32_t packetId, uint64_t latencyNs);
+
+    static const uint32_t m_entryNum      = 256;
+    static const uint32_t m_traceInterval = 1024;  //!< Trace p50/p99 every this number of samples of one packet
+
+    static std::map<uint32_t, Histogram> m_histograms;  //!< Histograms of the process indexed by packet id
+    static std::mutex                    m_histogramsMutex;
+
+    PMOS_INTERFACE m_osInterface             = nullptr;
+    MOS_RESOURCE   m_resource                = {};       //!< Ring of entries written by GPU
+    Entry         *m_entries                 = nullptr;  //!< Ring of entries locked for CPU
+    uint32_t       m_packetIds[m_entryNum]   = {};       //!< Packet id of each entry
+    uint64_t       m_writeIndex              = 0;        //!< Next entry to write
+    uint64_t       m_readIndex               = 0;        //!< Next entry to fold into histograms
+    bool           m_packetStarted           = false;
+    bool           m_initialized             = false;
+    uint32_t       m_tsFrequency             = 0;        //!< GPU timestamp frequency in Hz
+
+MEDIA_CLASS_DEFINE_END(MediaPacketLatency)
+};
+
+#endif  // !__MEDIA_PACKET_LATENCY_H__
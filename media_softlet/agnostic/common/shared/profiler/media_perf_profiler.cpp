@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include "media_perf_profiler.h"
 #include "media_skuwa_specific.h"
+#include "memory_policy_manager.h"
 #include "mhw_itf.h"
 #include "mhw_mi.h"
 #include "mhw_mi_cmdpar.h"
@@ -826,7 +827,7 @@ MOS_STATUS MediaPerfProfiler::SavePerfData(MOS_INTERFACE *osInterface)
                 return status;
             }
 
-            m_perfDataCombined = (uint32_t *)MOS_AllocAndZeroMemory(m_perfDataCombinedSize);
+            m_perfDataCombined = (uint32_t *)MemoryPolicyManager::AllocCpuMemory(m_perfDataCombinedSize, true);
             CHK_NULL_RETURN(m_perfDataCombined);
 
             m_perfDataCombined[0] = 0x8086;
@@ -857,7 +858,7 @@ MOS_STATUS MediaPerfProfiler::SavePerfData(MOS_INTERFACE *osInterface)
             if (m_perfDataCombinedOffset == m_perfDataCombinedSize)
             {
                 MosUtilities::MosWriteFileFromPtr(m_outputFileName.c_str(), m_perfDataCombined, m_perfDataCombinedSize);
-                MOS_SafeFreeMemory(m_perfDataCombined);
+                MemoryPolicyManager::FreeCpuMemory(m_perfDataCombined);
                 m_perfDataCombined = nullptr;
                 m_perfDataCombinedIndex = 0;
                 m_perfDataCombinedOffset = 0;
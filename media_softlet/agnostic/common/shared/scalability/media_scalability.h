@@ -296,6 +296,13 @@ public:
     //!
     virtual MOS_STATUS SendAttrWithFrameTracking(MOS_COMMAND_BUFFER &cmdBuffer, bool frameTrackingRequested) = 0;
 
+    //!
+    //! \brief  Get MI interface used by scalability
+    //! \return std::shared_ptr<mhw::mi::Itf>
+    //!         MI interface, nullptr if not initialized
+    //!
+    std::shared_ptr<mhw::mi::Itf> GetMiInterfaceNext() { return m_miItf; }
+
     //!
     //! \brief  Get if frame tracking is enabled from scalability
     //! \return bool
@@ -32,13 +32,32 @@
 #include "media_scalability_defs.h"
 #include "mos_utilities.h"
 #include "media_cmd_task.h"
+#include "media_submit_batcher.h"
 #include "media_packet.h"
+#include "media_packet_latency.h"
 #include "media_utils.h"
 
 CmdTask::CmdTask(PMOS_INTERFACE osInterface)
     : m_osInterface(osInterface)
 {
+    if (m_osInterface != nullptr)
+    {
+        bool latencyEnabled = false;
+        ReadUserSetting(
+            m_osInterface->pfnGetUserSettingInstance(m_osInterface),
+            latencyEnabled,
+            "Enable Packet Latency Histogram",
+            MediaUserSetting::Group::Sequence);
+        if (latencyEnabled)
+        {
+            m_packetLatency = MOS_New(MediaPacketLatency, m_osInterface);
+        }
+    }
+}
 
+CmdTask::~CmdTask()
+{
+    MOS_Delete(m_packetLatency);
 }
 
 MOS_STATUS CmdTask::CalculateCmdBufferSizeFromActivePackets()
@@ -64,39 +83,22 @@ MOS_STATUS CmdTask::CalculateCmdBufferSizeFromActivePackets()
             packet->CalculateCommandSize(curCommandBufferSize, curRequestedPatchListSize);
             m_cmdBufSize += curCommandBufferSize;
             m_patchListSize += curRequestedPatchListSize;
+
+            if (m_packetLatency != nullptr)
+            {
+                m_cmdBufSize += MediaPacketLatency::m_cmdSizePerPacket;
+                m_patchListSize += MediaPacketLatency::m_patchListPerPacket;
+            }
         }
     }
 
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability, CodechalDebugInterface *debugInterface)
+MOS_STATUS CmdTask::ComposePackets(MediaScalability *scalability, MOS_COMMAND_BUFFER &cmdBuffer)
 {
     MEDIA_CHK_NULL_RETURN(scalability);
 
-    // Algin this variable in pipeline, packet and scalability.
-    bool singleTaskPhaseSupportedInPak = false;
-    MEDIA_CHK_STATUS_RETURN(CalculateCmdBufferSizeFromActivePackets());
-
-    // prepare cmd buffer
-    MOS_COMMAND_BUFFER cmdBuffer;
-    // initialize the command buffer struct
-    MOS_ZeroMemory(&cmdBuffer, sizeof(MOS_COMMAND_BUFFER));
-
-    if (m_packets.size() > 0)
-    {
-        MEDIA_CHK_STATUS_RETURN(scalability->UpdateState(&m_packets[0].stateProperty));
-
-        // VerifyCmdBuffer could be called for duplicated times for singleTaskPhase mult-pass cases
-        // Each task submit verify only once
-        MEDIA_CHK_STATUS_RETURN(scalability->VerifyCmdBuffer(m_cmdBufSize, m_patchListSize, singleTaskPhaseSupportedInPak));
-    }
-    else
-    {
-        SCALABILITY_ASSERTMESSAGE("No packets to execute in the task!");
-        return MOS_STATUS_INVALID_PARAMETER;
-    }
-
     int8_t curPipe = -1;
 
     for (auto& prop : m_packets)
@@ -124,17 +126,84 @@ MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability,
 
         curPipe = scalability->GetCurrentPipe();
 
-        MEDIA_CHK_STATUS_RETURN(packet->Submit(&cmdBuffer, packetPhase));
+        // Timestamps are written by the status report of the packet, before its batch buffer end
+        packet->SetPacketLatency(m_packetLatency, prop.packetId);
+        MOS_STATUS status = packet->Submit(&cmdBuffer, packetPhase);
+        packet->SetPacketLatency(nullptr, 0);
+        MEDIA_CHK_STATUS_RETURN(status);
 
         MEDIA_CHK_STATUS_RETURN(scalability->ReturnCmdBuffer(&cmdBuffer));
     }
 
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS CmdTask::Submit(bool immediateSubmit, MediaScalability *scalability, CodechalDebugInterface *debugInterface)
+{
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    // Algin this variable in pipeline, packet and scalability.
+    bool singleTaskPhaseSupportedInPak = false;
+    MEDIA_CHK_STATUS_RETURN(CalculateCmdBufferSizeFromActivePackets());
+
+    // prepare cmd buffer
+    MOS_COMMAND_BUFFER cmdBuffer;
+    // initialize the command buffer struct
+    MOS_ZeroMemory(&cmdBuffer, sizeof(MOS_COMMAND_BUFFER));
+
+    if (m_packets.size() == 0)
+    {
+        SCALABILITY_ASSERTMESSAGE("No packets to execute in the task!");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    if (m_submitBatcher != nullptr)
+    {
+        // Frame is composed into the command buffer shared by batched streams,
+        // the batcher decides when the command buffer is submitted.
+        uint32_t cmdBufSize    = m_cmdBufSize;
+        uint32_t patchListSize = m_patchListSize;
+        MEDIA_CHK_STATUS_RETURN(m_submitBatcher->BeginFrame(m_osInterface, scalability, cmdBufSize, patchListSize));
+
+        MOS_STATUS status = scalability->UpdateState(&m_packets[0].stateProperty);
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = scalability->VerifyCmdBuffer(cmdBufSize, patchListSize, singleTaskPhaseSupportedInPak);
+        }
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = m_submitBatcher->ReserveSpace(m_osInterface, scalability, m_cmdBufSize);
+        }
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = ComposePackets(scalability, cmdBuffer);
+        }
+#if (_DEBUG || _RELEASE_INTERNAL) && !EMUL
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = DumpCmdBufferAllPipes(&cmdBuffer, debugInterface, scalability);
+        }
+#endif  // _DEBUG || _RELEASE_INTERNAL
+
+        MEDIA_CHK_STATUS_RETURN(m_submitBatcher->EndFrame(m_osInterface, scalability, status, m_closeSubmitBatch));
+    }
+    else
+    {
+        MEDIA_CHK_STATUS_RETURN(scalability->UpdateState(&m_packets[0].stateProperty));
+
+        // VerifyCmdBuffer could be called for duplicated times for singleTaskPhase mult-pass cases
+        // Each task submit verify only once
+        MEDIA_CHK_STATUS_RETURN(scalability->VerifyCmdBuffer(m_cmdBufSize, m_patchListSize, singleTaskPhaseSupportedInPak));
+
+        MEDIA_CHK_STATUS_RETURN(ComposePackets(scalability, cmdBuffer));
+
 #if (_DEBUG || _RELEASE_INTERNAL) && !EMUL
-    MEDIA_CHK_STATUS_RETURN(DumpCmdBufferAllPipes(&cmdBuffer, debugInterface, scalability));
+        MEDIA_CHK_STATUS_RETURN(DumpCmdBufferAllPipes(&cmdBuffer, debugInterface, scalability));
 #endif  // _DEBUG || _RELEASE_INTERNAL
 
-    // submit cmd buffer
-    MEDIA_CHK_STATUS_RETURN(scalability->SubmitCmdBuffer(&cmdBuffer));
+        // submit cmd buffer
+        MEDIA_CHK_STATUS_RETURN(scalability->SubmitCmdBuffer(&cmdBuffer));
+    }
 
 #if (_DEBUG || _RELEASE_INTERNAL)
     for (auto prop : m_packets)
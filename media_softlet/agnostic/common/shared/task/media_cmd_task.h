@@ -35,6 +35,7 @@
 #include "codechal_debug.h"
 #endif
 class MediaScalability;
+class MediaPacketLatency;
 class CmdTask : public MediaTask
 {
 public:
@@ -45,7 +46,7 @@ public:
     //!
     CmdTask(PMOS_INTERFACE osInterface);
 
-    virtual ~CmdTask() { }
+    virtual ~CmdTask();
 
     virtual MOS_STATUS Submit(bool immediateSubmit, MediaScalability *scalability, CodechalDebugInterface *debugInterface) override;
 
@@ -55,6 +56,16 @@ protected:
     virtual MOS_STATUS DumpCmdBufferAllPipes(PMOS_COMMAND_BUFFER cmdBuffer, CodechalDebugInterface *debugInterface, MediaScalability *scalability);
 #endif // _DEBUG || _RELEASE_INTERNAL
 
+    //! \brief  Compose all packets in packets list into command buffer
+    //! \param  [in] scalability
+    //!         Media scalability state instance for task submit
+    //! \param  [in, out] cmdBuffer
+    //!         Command buffer to compose
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ComposePackets(MediaScalability *scalability, MOS_COMMAND_BUFFER &cmdBuffer);
+
     //! \brief  Calculate Command Size for all packets in packets list
     //!
     //! \return uint32_t
@@ -62,7 +73,8 @@ protected:
     //!
     MOS_STATUS CalculateCmdBufferSizeFromActivePackets();
 
-    PMOS_INTERFACE m_osInterface = nullptr;        //!< PMOS_INTERFACE
+    PMOS_INTERFACE      m_osInterface   = nullptr;  //!< PMOS_INTERFACE
+    MediaPacketLatency *m_packetLatency = nullptr;  //!< GPU latency of packets, nullptr if disabled
 
 MEDIA_CLASS_DEFINE_END(CmdTask)
 };
@@ -0,0 +1,369 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_submit_batcher.cpp
+//! \brief    Implements the submission batcher shared by media streams on one device
+//!
+#include "media_submit_batcher.h"
+#include "media_scalability.h"
+#include "media_utils.h"
+#include "mos_interface.h"
+
+std::map<void *, MediaSubmitBatcher *> MediaSubmitBatcher::m_batchers;
+std::mutex                             MediaSubmitBatcher::m_batchersMutex;
+
+MediaSubmitBatcher::MediaSubmitBatcher(MOS_GPU_NODE gpuNode, uint32_t maxBatchFrames, uint32_t maxDelayUs)
+    : m_gpuNode(gpuNode), m_maxBatchFrames(maxBatchFrames > 0 ? maxBatchFrames : 1), m_maxDelayUs(maxDelayUs)
+{
+}
+
+MediaSubmitBatcher *MediaSubmitBatcher::Attach(
+    PMOS_INTERFACE osInterface,
+    MOS_GPU_NODE   gpuNode,
+    uint32_t       maxBatchFrames,
+    uint32_t       maxDelayUs)
+{
+    if (osInterface == nullptr || osInterface->osStreamState == nullptr ||
+        osInterface->osStreamState->osDeviceContext == nullptr)
+    {
+        MEDIA_ASSERTMESSAGE("Invalid os interface for submit batcher!");
+        return nullptr;
+    }
+
+    void *deviceContext = osInterface->osStreamState->osDeviceContext;
+
+    std::lock_guard<std::mutex> lock(m_batchersMutex);
+
+    MediaSubmitBatcher *batcher = nullptr;
+    auto it = m_batchers.find(deviceContext);
+    if (it != m_batchers.end())
+    {
+        batcher = it->second;
+        if (batcher->m_gpuNode != gpuNode)
+        {
+            MEDIA_NORMALMESSAGE("Submit batcher is on gpu node %d, cannot attach stream on node %d", batcher->m_gpuNode, gpuNode);
+            return nullptr;
+        }
+    }
+    else
+    {
+        batcher = MOS_New(MediaSubmitBatcher, gpuNode, maxBatchFrames, maxDelayUs);
+        if (batcher == nullptr)
+        {
+            return nullptr;
+        }
+        batcher->m_deviceContext = deviceContext;
+        m_batchers[deviceContext] = batcher;
+    }
+
+    batcher->m_refCount++;
+    return batcher;
+}
+
+void MediaSubmitBatcher::Detach(MediaSubmitBatcher *batcher, PMOS_INTERFACE osInterface, MediaScalability *scalability)
+{
+    if (batcher == nullptr || osInterface == nullptr)
+    {
+        return;
+    }
+
+    if (scalability != nullptr)
+    {
+        MOS_STATUS status = batcher->Flush(osInterface, scalability);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            MEDIA_ASSERTMESSAGE("Failed to flush submit batcher on detach!");
+        }
+    }
+
+    {
+        // Stream is only compared, but its address may be reused by a stream attached later
+        std::lock_guard<std::mutex> frameLock(batcher->m_mutex);
+        if (batcher->m_lastFrameStream == osInterface)
+        {
+            batcher->m_lastFrameStream      = nullptr;
+            batcher->m_lastFrameScalability = nullptr;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_batchersMutex);
+
+    if (--batcher->m_refCount > 0)
+    {
+        return;
+    }
+
+    if (batcher->m_pendingFrames > 0)
+    {
+        MEDIA_ASSERTMESSAGE("%d frames are dropped from submit batcher!", batcher->m_pendingFrames);
+    }
+
+    if (batcher->m_gpuContextHandle != MOS_GPU_CONTEXT_INVALID_HANDLE)
+    {
+        MosInterface::DestroyGpuContext(osInterface->osStreamState, batcher->m_gpuContextHandle);
+    }
+
+    m_batchers.erase(batcher->m_deviceContext);
+    MOS_Delete(batcher);
+}
+
+MOS_STATUS MediaSubmitBatcher::SwitchToSharedContext(PMOS_INTERFACE osInterface, MediaScalability *scalability)
+{
+    MEDIA_CHK_NULL_RETURN(osInterface);
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    if (m_gpuContextHandle == MOS_GPU_CONTEXT_INVALID_HANDLE)
+    {
+        // The shared context is created with the options of the first stream and is owned
+        // by the batcher, so it outlives the stream which creates it.
+        MOS_GPUCTX_CREATOPTIONS_ENHANCED createOption;
+        MEDIA_CHK_STATUS_RETURN(scalability->GetGpuCtxCreationOption(&createOption));
+        createOption.gpuNode = m_gpuNode;
+
+        MEDIA_CHK_STATUS_RETURN(MosInterface::CreateGpuContext(
+            osInterface->osStreamState, createOption, m_gpuContextHandle));
+        MEDIA_NORMALMESSAGE("Created shared gpu context 0x%x for submit batcher", m_gpuContextHandle);
+    }
+
+    m_streamGpuContextHandle = osInterface->CurrentGpuContextHandle;
+    return osInterface->pfnSetGpuContextFromHandle(osInterface, osInterface->CurrentGpuContextOrdinal, m_gpuContextHandle);
+}
+
+MOS_STATUS MediaSubmitBatcher::SwitchBackContext(PMOS_INTERFACE osInterface)
+{
+    MEDIA_CHK_NULL_RETURN(osInterface);
+
+    if (m_streamGpuContextHandle == MOS_GPU_CONTEXT_INVALID_HANDLE)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS status = osInterface->pfnSetGpuContextFromHandle(
+        osInterface, osInterface->CurrentGpuContextOrdinal, m_streamGpuContextHandle);
+    m_streamGpuContextHandle = MOS_GPU_CONTEXT_INVALID_HANDLE;
+    return status;
+}
+
+MOS_STATUS MediaSubmitBatcher::SubmitPending(PMOS_INTERFACE osInterface, MediaScalability *scalability)
+{
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    if (m_pendingFrames == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_COMMAND_BUFFER cmdBuffer;
+    MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
+
+    // Media frame tracking can only carry the tag of one stream per submission, batched frames
+    // report completion by the status report commands inside each frame instead.
+    MEDIA_CHK_STATUS_RETURN(scalability->GetCmdBuffer(&cmdBuffer, false));
+    MEDIA_CHK_STATUS_RETURN(scalability->ReturnCmdBuffer(&cmdBuffer));
+
+    MEDIA_VERBOSEMESSAGE("Submit batcher submits %d frames", m_pendingFrames);
+    m_pendingFrames        = 0;
+    m_lastFrameStream      = nullptr;
+    m_lastFrameScalability = nullptr;
+    m_submitCount++;
+
+    return scalability->SubmitCmdBuffer(&cmdBuffer);
+}
+
+bool MediaSubmitBatcher::IsDelayExpired()
+{
+    if (m_maxDelayUs == 0 || m_pendingFrames == 0)
+    {
+        return false;
+    }
+
+    return MosUtilities::MosGetCurTime() - m_firstPendingTime >= m_maxDelayUs;
+}
+
+uint32_t MediaSubmitBatcher::GetStreamSyncSize(MediaScalability *scalability)
+{
+    auto miItf = scalability->GetMiInterfaceNext();
+    return (miItf != nullptr) ? miItf->MHW_GETSIZE_F(MI_FLUSH_DW)() : 0;
+}
+
+MOS_STATUS MediaSubmitBatcher::AddStreamSync(MediaScalability *scalability, MOS_COMMAND_BUFFER &cmdBuffer)
+{
+    auto miItf = scalability->GetMiInterfaceNext();
+    MEDIA_CHK_NULL_RETURN(miItf);
+
+    // Frames in one batch run back to back on the same engine, MI_FLUSH_DW waits for the
+    // previous frame and flushes its output before the frame of another stream reads it.
+    auto &flushDwParams = miItf->MHW_GETPAR_F(MI_FLUSH_DW)();
+    flushDwParams       = {};
+    return miItf->MHW_ADDCMD_F(MI_FLUSH_DW)(&cmdBuffer);
+}
+
+MOS_STATUS MediaSubmitBatcher::BeginFrame(
+    PMOS_INTERFACE    osInterface,
+    MediaScalability *scalability,
+    uint32_t         &cmdBufSize,
+    uint32_t         &patchListSize)
+{
+    MEDIA_CHK_NULL_RETURN(osInterface);
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    m_mutex.lock();
+
+    // Offset is recorded by ReserveSpace(), nothing to rewind if the frame fails before it
+    m_frameStartOffset = -1;
+
+    MOS_STATUS status = SwitchToSharedContext(osInterface, scalability);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        m_mutex.unlock();
+        return status;
+    }
+
+    // Command buffer of shared context is allocated for the whole batch
+    cmdBufSize *= m_maxBatchFrames;
+    patchListSize *= m_maxBatchFrames;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaSubmitBatcher::ReserveSpace(PMOS_INTERFACE osInterface, MediaScalability *scalability, uint32_t cmdBufSize)
+{
+    MEDIA_CHK_NULL_RETURN(osInterface);
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    MOS_COMMAND_BUFFER cmdBuffer;
+    MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
+    MEDIA_CHK_STATUS_RETURN(osInterface->pfnGetCommandBuffer(osInterface, &cmdBuffer, 0));
+
+    uint32_t syncSize = GetStreamSyncSize(scalability);
+    if (m_pendingFrames > 0 && cmdBuffer.iRemaining < (int32_t)(cmdBufSize + syncSize))
+    {
+        MEDIA_CHK_STATUS_RETURN(SubmitPending(osInterface, scalability));
+
+        MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
+        MEDIA_CHK_STATUS_RETURN(osInterface->pfnGetCommandBuffer(osInterface, &cmdBuffer, 0));
+    }
+
+    if (m_pendingFrames > 0 && m_lastFrameStream != osInterface)
+    {
+        MEDIA_CHK_STATUS_RETURN(AddStreamSync(scalability, cmdBuffer));
+        osInterface->pfnReturnCommandBuffer(osInterface, &cmdBuffer, 0);
+    }
+
+    m_frameStartOffset = cmdBuffer.iOffset;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MediaSubmitBatcher::EndFrame(PMOS_INTERFACE osInterface, MediaScalability *scalability, MOS_STATUS composeStatus, bool closeBatch)
+{
+    MOS_STATUS status = composeStatus;
+
+    if (osInterface == nullptr || scalability == nullptr)
+    {
+        status = MOS_STATUS_NULL_POINTER;
+    }
+    else if (composeStatus != MOS_STATUS_SUCCESS)
+    {
+        // Rewind the partial frame so that the frames of other streams can still be submitted
+        MOS_COMMAND_BUFFER cmdBuffer;
+        MOS_ZeroMemory(&cmdBuffer, sizeof(cmdBuffer));
+        if (m_frameStartOffset >= 0 &&
+            osInterface->pfnGetCommandBuffer(osInterface, &cmdBuffer, 0) == MOS_STATUS_SUCCESS &&
+            cmdBuffer.iOffset >= m_frameStartOffset)
+        {
+            int32_t frameSize = cmdBuffer.iOffset - m_frameStartOffset;
+            cmdBuffer.iOffset -= frameSize;
+            cmdBuffer.iRemaining += frameSize;
+            cmdBuffer.pCmdPtr = (uint32_t *)((uint8_t *)cmdBuffer.pCmdBase + cmdBuffer.iOffset);
+            osInterface->pfnReturnCommandBuffer(osInterface, &cmdBuffer, 0);
+        }
+    }
+    else
+    {
+        if (m_pendingFrames == 0)
+        {
+            m_firstPendingTime = MosUtilities::MosGetCurTime();
+        }
+        m_lastFrameStream      = osInterface;
+        m_lastFrameScalability = scalability;
+        if (++m_pendingFrames >= m_maxBatchFrames || closeBatch || IsDelayExpired())
+        {
+            status = SubmitPending(osInterface, scalability);
+        }
+    }
+
+    MOS_STATUS switchStatus = SwitchBackContext(osInterface);
+    m_frameStartOffset      = -1;
+    m_mutex.unlock();
+
+    return (status != MOS_STATUS_SUCCESS) ? status : switchStatus;
+}
+
+MOS_STATUS MediaSubmitBatcher::Flush(PMOS_INTERFACE osInterface, MediaScalability *scalability)
+{
+    MEDIA_CHK_NULL_RETURN(osInterface);
+    MEDIA_CHK_NULL_RETURN(scalability);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_pendingFrames == 0)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MEDIA_CHK_STATUS_RETURN(SwitchToSharedContext(osInterface, scalability));
+
+    MOS_STATUS status       = SubmitPending(osInterface, scalability);
+    MOS_STATUS switchStatus = SwitchBackContext(osInterface);
+
+    return (status != MOS_STATUS_SUCCESS) ? status : switchStatus;
+}
+
+MOS_STATUS MediaSubmitBatcher::FlushDevice(MOS_DEVICE_HANDLE deviceContext)
+{
+    // Batcher list lock keeps the batcher alive, Detach() never holds the frame lock while taking it
+    std::lock_guard<std::mutex> lock(m_batchersMutex);
+
+    auto it = m_batchers.find(deviceContext);
+    if (it == m_batchers.end())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MediaSubmitBatcher         *batcher = it->second;
+    std::lock_guard<std::mutex> frameLock(batcher->m_mutex);
+
+    PMOS_INTERFACE    osInterface = batcher->m_lastFrameStream;
+    MediaScalability *scalability = batcher->m_lastFrameScalability;
+    if (batcher->m_pendingFrames == 0 || osInterface == nullptr || scalability == nullptr)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MEDIA_CHK_STATUS_RETURN(batcher->SwitchToSharedContext(osInterface, scalability));
+
+    MOS_STATUS status       = batcher->SubmitPending(osInterface, scalability);
+    MOS_STATUS switchStatus = batcher->SwitchBackContext(osInterface);
+
+    return (status != MOS_STATUS_SUCCESS) ? status : switchStatus;
+}
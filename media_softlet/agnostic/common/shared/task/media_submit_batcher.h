@@ -0,0 +1,213 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_submit_batcher.h
+//! \brief    Defines the submission batcher shared by media streams on one device
+//! \details  Streams attached to the batcher compose their frames into the primary
+//!           command buffer of one shared GPU context. The command buffer is only
+//!           submitted when the batch is full or when one of the streams flushes it,
+//!           so several small frames from different streams go out in one exec.
+//!           Frames of different streams are separated by a flush, so the output of
+//!           one stream is complete before the next frame of another stream starts.
+//!           Pending frames are also submitted when the oldest of them waits longer than
+//!           the max delay, or when the application waits for a surface of the device.
+//!
+#ifndef __MEDIA_SUBMIT_BATCHER_H__
+#define __MEDIA_SUBMIT_BATCHER_H__
+
+#include <map>
+#include <mutex>
+#include "mos_os.h"
+#include "media_class_trace.h"
+
+class MediaScalability;
+
+class MediaSubmitBatcher
+{
+public:
+    //!
+    //! \brief  MediaSubmitBatcher constructor, use Attach() to get the batcher of a device
+    //! \param  [in] gpuNode
+    //!         Gpu node of the shared GPU context
+    //! \param  [in] maxBatchFrames
+    //!         Max number of frames composed into one submission
+    //! \param  [in] maxDelayUs
+    //!         Max time in us a frame may stay pending, 0 for no limit
+    //!
+    MediaSubmitBatcher(MOS_GPU_NODE gpuNode, uint32_t maxBatchFrames, uint32_t maxDelayUs);
+
+    //!
+    //! \brief  MediaSubmitBatcher deconstructor
+    //!
+    virtual ~MediaSubmitBatcher() {}
+
+    //!
+    //! \brief  Attach one stream to the batcher of its device, the batcher is created on first attach
+    //! \param  [in] osInterface
+    //!         Os interface of the stream
+    //! \param  [in] gpuNode
+    //!         Gpu node of the shared GPU context
+    //! \param  [in] maxBatchFrames
+    //!         Max number of frames composed into one submission
+    //! \param  [in] maxDelayUs
+    //!         Max time in us a frame may stay pending, 0 for no limit.
+    //!         Both limits are taken from the stream which creates the batcher
+    //! \return MediaSubmitBatcher*
+    //!         Pointer to the batcher, nullptr if failed
+    //!
+    static MediaSubmitBatcher *Attach(
+        PMOS_INTERFACE osInterface,
+        MOS_GPU_NODE   gpuNode,
+        uint32_t       maxBatchFrames,
+        uint32_t       maxDelayUs = m_defaultMaxDelayUs);
+
+    //!
+    //! \brief  Detach one stream from the batcher, pending frames are flushed and
+    //!         the batcher is destroyed on last detach
+    //! \param  [in] batcher
+    //!         Batcher returned by Attach()
+    //! \param  [in] osInterface
+    //!         Os interface of the stream
+    //! \param  [in] scalability
+    //!         Scalability of the stream, used to flush pending frames
+    //!
+    static void Detach(MediaSubmitBatcher *batcher, PMOS_INTERFACE osInterface, MediaScalability *scalability);
+
+    //!
+    //! \brief  Start composing one frame, the batcher stays locked until EndFrame()
+    //!         and the stream is switched to the shared GPU context
+    //! \param  [in] osInterface
+    //!         Os interface of the stream
+    //! \param  [in] scalability
+    //!         Scalability of the stream
+    //! \param  [in, out] cmdBufSize
+    //!         Command buffer size of the frame, returns the size to verify for the whole batch
+    //! \param  [in, out] patchListSize
+    //!         Patch list size of the frame, returns the size to verify for the whole batch
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS BeginFrame(
+        PMOS_INTERFACE    osInterface,
+        MediaScalability *scalability,
+        uint32_t         &cmdBufSize,
+        uint32_t         &patchListSize);
+
+    //!
+    //! \brief  Make sure the frame fits into the shared command buffer, flush the pending frames if not
+    //!         If the previous frame is from another stream, waits for it before the frame starts
+    //!         Must be called after the command buffer size is verified
+    //! \param  [in] osInterface
+    //!         Os interface of the stream
+    //! \param  [in] scalability
+    //!         Scalability of the stream
+    //! \param  [in] cmdBufSize
+    //!         Command buffer size of the frame
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReserveSpace(PMOS_INTERFACE osInterface, MediaScalability *scalability, uint32_t cmdBufSize);
+
+    //!
+    //! \brief  Finish composing one frame, submit the batch if it is full, then switch the
+    //!         stream back to its own GPU context and unlock the batcher
+    //! \param  [in] osInterface
+    //!         Os interface of the stream
+    //! \param  [in] scalability
+    //!         Scalability of the stream
+    //! \param  [in] composeStatus
+    //!         Status of frame composing, the frame is dropped from the batch if failed
+    //! \param  [in] closeBatch
+    //!         Submit the batch with this frame, for frames which must not stay pending
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS EndFrame(PMOS_INTERFACE osInterface, MediaScalability *scalability, MOS_STATUS composeStatus, bool closeBatch = false);
+
+    //!
+    //! \brief  Submit the pending frames of all streams
+    //!         Must be called before the stream submits on its own GPU context or waits for its frames
+    //! \param  [in] osInterface
+    //!         Os interface of the stream
+    //! \param  [in] scalability
+    //!         Scalability of the stream
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS Flush(PMOS_INTERFACE osInterface, MediaScalability *scalability);
+
+    //!
+    //! \brief  Submit the pending frames on one device, called before waiting for a surface
+    //!         Frames are submitted with the stream of the last pending frame
+    //! \param  [in] deviceContext
+    //!         Os device context
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success or nothing is pending, else fail reason
+    //!
+    static MOS_STATUS FlushDevice(MOS_DEVICE_HANDLE deviceContext);
+
+    //!
+    //! \brief  Get max number of frames in one submission
+    //! \return uint32_t
+    //!
+    uint32_t GetMaxBatchFrames() const { return m_maxBatchFrames; }
+
+    //!
+    //! \brief  Get number of submissions issued by the batcher
+    //! \return uint32_t
+    //!
+    uint32_t GetSubmitCount() const { return m_submitCount; }
+
+protected:
+    MOS_STATUS SwitchToSharedContext(PMOS_INTERFACE osInterface, MediaScalability *scalability);
+    MOS_STATUS SwitchBackContext(PMOS_INTERFACE osInterface);
+    MOS_STATUS SubmitPending(PMOS_INTERFACE osInterface, MediaScalability *scalability);
+    MOS_STATUS AddStreamSync(MediaScalability *scalability, MOS_COMMAND_BUFFER &cmdBuffer);
+    uint32_t   GetStreamSyncSize(MediaScalability *scalability);
+    bool       IsDelayExpired();
+
+    static const uint32_t m_defaultMaxDelayUs = 2000;  //!< Default max time a frame stays pending
+
+    static std::map<void *, MediaSubmitBatcher *> m_batchers;      //!< Batchers indexed by device context
+    static std::mutex                             m_batchersMutex;
+
+    std::mutex         m_mutex;                                            //!< Held from BeginFrame() to EndFrame()
+    void              *m_deviceContext    = nullptr;
+    MOS_GPU_NODE       m_gpuNode          = MOS_GPU_NODE_VIDEO;
+    GPU_CONTEXT_HANDLE m_gpuContextHandle = MOS_GPU_CONTEXT_INVALID_HANDLE;  //!< Shared GPU context
+    uint32_t           m_refCount         = 0;
+    uint32_t           m_maxBatchFrames   = 1;
+    uint32_t           m_maxDelayUs       = 0;
+    uint32_t           m_pendingFrames    = 0;                              //!< Frames composed but not submitted
+    uint32_t           m_submitCount      = 0;
+    uint64_t           m_firstPendingTime = 0;                              //!< Time in us the oldest pending frame is composed
+    PMOS_INTERFACE     m_lastFrameStream  = nullptr;                        //!< Stream of the last pending frame
+    MediaScalability  *m_lastFrameScalability = nullptr;                    //!< Scalability of the last pending frame
+
+    // Per frame states, only valid between BeginFrame() and EndFrame()
+    GPU_CONTEXT_HANDLE m_streamGpuContextHandle = MOS_GPU_CONTEXT_INVALID_HANDLE;
+    int32_t            m_frameStartOffset       = -1;                   //!< -1 until ReserveSpace() succeeds
+
+MEDIA_CLASS_DEFINE_END(MediaSubmitBatcher)
+};
+
+#endif  // !__MEDIA_SUBMIT_BATCHER_H__
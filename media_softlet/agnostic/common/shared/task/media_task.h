@@ -37,6 +37,7 @@
 
 class CodechalDebugInterface;
 class MediaPacket;
+class MediaSubmitBatcher;
 struct PacketProperty
 {
     MediaPacket       *packet = nullptr;
@@ -85,6 +86,19 @@ public:
         m_patchListSize = patchListSize;
     }
 
+    //!
+    //! \brief  Set the batcher which defers the command buffer submission of following Submit() calls
+    //! \param  [in] batcher
+    //!         Pointer to the submit batcher, nullptr to submit directly
+    //! \param  [in] closeBatch
+    //!         Submit the batch with the frame of each Submit() call
+    //!
+    virtual void SetSubmitBatcher(MediaSubmitBatcher *batcher, bool closeBatch = false)
+    {
+        m_submitBatcher    = batcher;
+        m_closeSubmitBatch = closeBatch;
+    }
+
     enum class TaskType
     {
         cmdTask = 1,
@@ -95,6 +109,8 @@ protected:
     std::vector<PacketProperty> m_packets;            //!< media packets pool for execution
     uint32_t                          m_cmdBufSize = 0;     //!< Cmd buffer size for execution
     uint32_t                          m_patchListSize = 0;  //!< Patch list size for execution
+    MediaSubmitBatcher               *m_submitBatcher = nullptr;  //!< Submit batcher, nullptr if submit directly
+    bool                              m_closeSubmitBatch = false;  //!< Submit batch with the frame of the task
 MEDIA_CLASS_DEFINE_END(MediaTask)
 };
 
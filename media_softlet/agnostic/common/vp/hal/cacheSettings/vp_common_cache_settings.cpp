@@ -28,7 +28,24 @@
 #include "vp_common_cache_settings.h"
 #include "surface_type.h"
 
-std::map<uint64_t, MOS_CACHE_ELEMENT> g_vp_cacheSettings =
+// Surface key is assigned surface type + HEAP_MAX for surfaces, or heap type for heaps
+#define VP_CACHE_SURFACE_KEY_NUM (HEAP_MAX + SUFACE_TYPE_ASSIGNED(vp::NumberOfSurfaceType) + 1)
+
+static constexpr MOS_CACHE_SETTING s_vpCacheSettings[] =
 {
 #include "vp_surface_cache_settings.h"
-};
\ No newline at end of file
+};
+
+static_assert(MosValidateCacheSettings(s_vpCacheSettings, COMPONENT_VPCommon, 1, VP_CACHE_SURFACE_KEY_NUM),
+    "vp cache settings are out of table range or conflict with each other");
+
+static constexpr MosCacheTableData<1, VP_CACHE_SURFACE_KEY_NUM> s_vpCacheTableData =
+    MosBuildCacheTable<1, VP_CACHE_SURFACE_KEY_NUM>(s_vpCacheSettings, COMPONENT_VPCommon);
+
+const MOS_CACHE_TABLE g_vp_cacheSettings =
+{
+    COMPONENT_VPCommon,
+    1,
+    VP_CACHE_SURFACE_KEY_NUM,
+    s_vpCacheTableData.elements
+};
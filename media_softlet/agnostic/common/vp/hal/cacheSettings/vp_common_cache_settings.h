@@ -29,6 +29,6 @@
 
 #include "mos_cache_manager.h"
 
-extern std::map<uint64_t, MOS_CACHE_ELEMENT> g_vp_cacheSettings;
+extern const MOS_CACHE_TABLE g_vp_cacheSettings;
 
 #endif  // __VP_COMMON_CACHE_SETTINGS_H__
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "vp_platform_interface.h"
 #include "vp_debug.h"
 #include "vp_user_feature_control.h"
+#include <algorithm>
 
 VpPipelineAdapter::VpPipelineAdapter(
     vp::VpPlatformInterface     &vpPlatformInterface,
@@ -120,6 +121,142 @@ MOS_STATUS VpPipelineAdapter::Execute(PVP_PIPELINE_PARAMS params, PRENDERHAL_INT
     return m_vpPipeline->Execute();
 }
 
+void VpPipelineAdapter::PlanMultiOutput(
+    PCVPHAL_RENDER_PARAMS pcRenderParams,
+    uint32_t             *order,
+    int32_t              *inputIndex)
+{
+    VP_FUNC_CALL();
+
+    uint32_t dstCount = pcRenderParams->uDstCount;
+    for (uint32_t i = 0; i < dstCount; ++i)
+    {
+        order[i]      = i;
+        inputIndex[i] = -1;
+    }
+
+    VpUserFeatureControl *userFeatureControl = m_vpPipeline->GetUserFeatureControl();
+    if (userFeatureControl == nullptr || !userFeatureControl->IsMultiOutputCascadeEnabled() ||
+        !IsCascadeScalingSupported(pcRenderParams))
+    {
+        return;
+    }
+
+    auto area = [&](uint32_t index) {
+        const RECT &rc = pcRenderParams->pTarget[index]->rcSrc;
+        return (int64_t)(rc.right - rc.left) * (rc.bottom - rc.top);
+    };
+    std::stable_sort(order, order + dstCount, [&](uint32_t a, uint32_t b) { return area(a) > area(b); });
+
+    const RECT &rcInput = pcRenderParams->pSrc[0]->rcSrc;
+    for (uint32_t i = 1; i < dstCount; ++i)
+    {
+        PVPHAL_SURFACE target       = pcRenderParams->pTarget[order[i]];
+        int32_t        targetWidth  = target->rcSrc.right - target->rcSrc.left;
+        int32_t        targetHeight = target->rcSrc.bottom - target->rcSrc.top;
+
+        // Read the smallest output rendered before which is still at least twice this output,
+        // so the second pass always decimates by 2 or more and keeps the quality of direct
+        // downscaling. Fall back to the input if no output qualifies.
+        for (int32_t j = (int32_t)i - 1; j >= 0; --j)
+        {
+            PVPHAL_SURFACE prev       = pcRenderParams->pTarget[order[j]];
+            int32_t        prevWidth  = prev->rcSrc.right - prev->rcSrc.left;
+            int32_t        prevHeight = prev->rcSrc.bottom - prev->rcSrc.top;
+
+            // Previous output must be in the same format and be smaller than the input. The
+            // input is scaled to its rcSrc, which must be its whole rcDst and lie inside the
+            // surface, else the cascade would read background or clipped pixels.
+            if (prev->Format != target->Format || prev->ColorSpace != target->ColorSpace ||
+                prev->Rotation != VPHAL_ROTATION_IDENTITY || target->Rotation != VPHAL_ROTATION_IDENTITY ||
+                memcmp(&prev->rcSrc, &prev->rcDst, sizeof(RECT)) != 0 ||
+                prev->rcDst.left < 0 || prev->rcDst.top < 0 ||
+                prev->rcDst.right > (int32_t)prev->dwWidth || prev->rcDst.bottom > (int32_t)prev->dwHeight ||
+                prevWidth >= rcInput.right - rcInput.left || prevHeight >= rcInput.bottom - rcInput.top ||
+                targetWidth * 2 > prevWidth || targetHeight * 2 > prevHeight)
+            {
+                continue;
+            }
+            inputIndex[order[i]] = (int32_t)order[j];
+            VP_PUBLIC_NORMALMESSAGE("Multi output %d reads output %d", order[i], order[j]);
+            break;
+        }
+    }
+}
+
+bool VpPipelineAdapter::IsCascadeScalingSupported(PCVPHAL_RENDER_PARAMS pcRenderParams)
+{
+    VP_FUNC_CALL();
+
+    PVPHAL_SURFACE src = pcRenderParams->pSrc[0];
+    if (src == nullptr || src->SampleType != SAMPLE_PROGRESSIVE || src->InterlacedScalingType != ISCALING_NONE ||
+        src->Rotation != VPHAL_ROTATION_IDENTITY || src->bIEF || src->pIEFParams ||
+        src->pBlendingParams || src->pLumaKeyParams || src->pProcampParams ||
+        src->pDeinterlaceParams || src->pDenoiseParams || src->pColorPipeParams ||
+        src->pHDRParams || src->p3DLutParams || src->pGamutParams)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pcRenderParams->uDstCount; ++i)
+    {
+        PVPHAL_SURFACE target = pcRenderParams->pTarget[i];
+        if (target == nullptr || target->b16UsrPtr ||
+            (target->Format != Format_NV12 && target->Format != Format_P010))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void VpPipelineAdapter::SetupCascadeInput(
+    PVPHAL_SURFACE src,
+    PVPHAL_SURFACE prevOutput,
+    VPHAL_SURFACE &cascadeSrc)
+{
+    VP_FUNC_CALL();
+
+    // Keep the processing options of the input, take the surface description of the output
+    cascadeSrc = *src;
+
+    cascadeSrc.ColorSpace          = prevOutput->ColorSpace;
+    cascadeSrc.ExtendedGamut       = prevOutput->ExtendedGamut;
+    cascadeSrc.rcSrc               = prevOutput->rcDst;
+    cascadeSrc.rcMaxSrc            = prevOutput->rcDst;
+    cascadeSrc.bMaxRectChanged     = false;
+    cascadeSrc.bVEBOXCroppingUsed  = false;
+    cascadeSrc.dwWidth             = prevOutput->dwWidth;
+    cascadeSrc.dwHeight            = prevOutput->dwHeight;
+    cascadeSrc.dwPitch             = prevOutput->dwPitch;
+    cascadeSrc.dwYPitch            = prevOutput->dwYPitch;
+    cascadeSrc.dwUPitch            = prevOutput->dwUPitch;
+    cascadeSrc.dwVPitch            = prevOutput->dwVPitch;
+    cascadeSrc.TileType            = prevOutput->TileType;
+    cascadeSrc.TileModeGMM         = prevOutput->TileModeGMM;
+    cascadeSrc.bGMMTileEnabled     = prevOutput->bGMMTileEnabled;
+    cascadeSrc.YPlaneOffset        = prevOutput->YPlaneOffset;
+    cascadeSrc.UPlaneOffset        = prevOutput->UPlaneOffset;
+    cascadeSrc.VPlaneOffset        = prevOutput->VPlaneOffset;
+    cascadeSrc.Format              = prevOutput->Format;
+    cascadeSrc.dwDepth             = prevOutput->dwDepth;
+    cascadeSrc.dwOffset            = prevOutput->dwOffset;
+    cascadeSrc.OsResource          = prevOutput->OsResource;
+    cascadeSrc.ChromaSiting        = prevOutput->ChromaSiting;
+    cascadeSrc.bChromaSiting       = prevOutput->bChromaSiting;
+    cascadeSrc.bCompressible       = prevOutput->bCompressible;
+    cascadeSrc.bIsCompressed       = prevOutput->bIsCompressed;
+    cascadeSrc.CompressionMode     = prevOutput->CompressionMode;
+    cascadeSrc.CompressionFormat   = prevOutput->CompressionFormat;
+    cascadeSrc.b16UsrPtr           = false;
+    cascadeSrc.uFwdRefCount        = 0;
+    cascadeSrc.uBwdRefCount        = 0;
+    cascadeSrc.pFwdRef             = nullptr;
+    cascadeSrc.pBwdRef             = nullptr;
+    cascadeSrc.pNext               = nullptr;
+}
+
 void VpPipelineAdapter::Destroy()
 {
     VP_FUNC_CALL();
@@ -142,10 +279,25 @@ MOS_STATUS VpPipelineAdapter::Render(PCVPHAL_RENDER_PARAMS pcRenderParams)
 
     if (1 == pcRenderParams->uSrcCount && pcRenderParams->uDstCount > 1)
     {
-        for (uint32_t dstIndex = 0; dstIndex < pcRenderParams->uDstCount; ++dstIndex)
+        uint32_t      order[VPHAL_MAX_TARGETS]      = {};
+        int32_t       inputIndex[VPHAL_MAX_TARGETS] = {};
+        VPHAL_SURFACE cascadeSrc;
+
+        VP_PUBLIC_CHK_NULL_RETURN(pcRenderParams->pSrc[0]);
+        VP_PUBLIC_CHK_VALUE_RETURN(pcRenderParams->uDstCount <= VPHAL_MAX_TARGETS, true);
+        PlanMultiOutput(pcRenderParams, order, inputIndex);
+
+        for (uint32_t i = 0; i < pcRenderParams->uDstCount; ++i)
         {
+            uint32_t dstIndex = order[i];
             params           = *(PVP_PIPELINE_PARAMS)pcRenderParams;
             params.uDstCount = 1;
+            if (inputIndex[dstIndex] >= 0)
+            {
+                // Read the larger output rendered before instead of the full size input
+                SetupCascadeInput(pcRenderParams->pSrc[0], pcRenderParams->pTarget[inputIndex[dstIndex]], cascadeSrc);
+                params.pSrc[0] = &cascadeSrc;
+            }
             // update the first target point
             params.pTarget[0]            = pcRenderParams->pTarget[dstIndex];
             params.pTarget[0]->b16UsrPtr = pcRenderParams->pTarget[dstIndex]->b16UsrPtr;
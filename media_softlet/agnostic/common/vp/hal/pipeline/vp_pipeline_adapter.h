@@ -132,6 +132,48 @@ protected:
     //!
     virtual MOS_STATUS Execute(PVP_PIPELINE_PARAMS params, PRENDERHAL_INTERFACE renderHal);
 
+    //!
+    //! \brief    Plan the outputs of 1 input multi output rendering
+    //! \details  With cascade scaling enabled, outputs are executed from the largest to the
+    //!           smallest, and an output reads a previous output of at least twice its size
+    //!           instead of the input, so the full size input is read less often
+    //! \param    [in] pcRenderParams
+    //!           Pointer to Render Params
+    //! \param    [out] order
+    //!           Execution order of the outputs
+    //! \param    [out] inputIndex
+    //!           Index of the output used as input of each output, -1 if the input surface is used
+    //! \return   void
+    //!
+    void PlanMultiOutput(
+        PCVPHAL_RENDER_PARAMS pcRenderParams,
+        uint32_t             *order,
+        int32_t              *inputIndex);
+
+    //!
+    //! \brief    Check whether the input of multi output rendering only needs scaling
+    //! \param    [in] pcRenderParams
+    //!           Pointer to Render Params
+    //! \return   bool
+    //!           true if outputs can be cascaded
+    //!
+    bool IsCascadeScalingSupported(PCVPHAL_RENDER_PARAMS pcRenderParams);
+
+    //!
+    //! \brief    Setup input surface which reads a previous output
+    //! \param    [in] src
+    //!           Input surface of rendering, provides the processing options
+    //! \param    [in] prevOutput
+    //!           Previous output to read
+    //! \param    [out] cascadeSrc
+    //!           Input surface to use
+    //! \return   void
+    //!
+    void SetupCascadeInput(
+        PVPHAL_SURFACE src,
+        PVPHAL_SURFACE prevOutput,
+        VPHAL_SURFACE &cascadeSrc);
+
     std::shared_ptr<vp::VpPipeline>    m_vpPipeline = {};
 
     VP_PIPELINE_PARAMS                 m_vpPipelineParams = {};   //!< vp Pipeline params
@@ -118,6 +118,13 @@ MOS_STATUS VpUserSetting::InitVpUserSetting(MediaUserSettingSharedPtr userSettin
             0,
             true);
 
+        DeclareUserSettingKey(
+            userSettingPtr,
+            __MEDIA_USER_FEATURE_VALUE_ENABLE_MULTI_OUTPUT_CASCADE,
+            MediaUserSetting::Group::Sequence,
+            0,
+            true);
+
         DeclareUserSettingKey(
             userSettingPtr,
             __VPHAL_HDR_LUT_MODE,
@@ -183,6 +183,23 @@ VpUserFeatureControl::VpUserFeatureControl(MOS_INTERFACE &osInterface, VpPlatfor
     }
     VP_PUBLIC_NORMALMESSAGE("enablePacketReuseTeamsAlways %d", m_ctrlValDefault.enablePacketReuseTeamsAlways);
 
+    bool enableMultiOutputCascade = false;
+    status = ReadUserSetting(
+        m_userSettingPtr,
+        enableMultiOutputCascade,
+        __MEDIA_USER_FEATURE_VALUE_ENABLE_MULTI_OUTPUT_CASCADE,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(status))
+    {
+        m_ctrlValDefault.enableMultiOutputCascade = enableMultiOutputCascade;
+    }
+    else
+    {
+        // Default value
+        m_ctrlValDefault.enableMultiOutputCascade = false;
+    }
+    VP_PUBLIC_NORMALMESSAGE("enableMultiOutputCascade %d", m_ctrlValDefault.enableMultiOutputCascade);
+
     // bComputeContextEnabled is true only if Gen12+. 
     // Gen12+, compute context(MOS_GPU_NODE_COMPUTE, MOS_GPU_CONTEXT_COMPUTE) can be used for render engine.
     // Before Gen12, we only use MOS_GPU_NODE_3D and MOS_GPU_CONTEXT_RENDER.
@@ -66,6 +66,7 @@ public:
 #endif
         bool disablePacketReuse             = false;
         bool enablePacketReuseTeamsAlways   = false;
+        bool enableMultiOutputCascade       = false;
 
         VPHAL_HDR_LUT_MODE globalLutMode      = VPHAL_HDR_LUT_MODE_NONE;  //!< Global LUT mode control for debugging purpose
         bool               gpuGenerate3DLUT   = false;                        //!< Flag for per frame GPU generation of 3DLUT
@@ -175,6 +176,11 @@ public:
         return m_ctrlVal.enablePacketReuseTeamsAlways;
     }
 
+    bool IsMultiOutputCascadeEnabled()
+    {
+        return m_ctrlVal.enableMultiOutputCascade;
+    }
+
     uint32_t GetGlobalLutMode()
     {
         return m_ctrlVal.globalLutMode;
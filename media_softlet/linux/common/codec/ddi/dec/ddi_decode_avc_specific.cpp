@@ -29,6 +29,7 @@
 #include "media_libva_interface_next.h"
 #include "ddi_decode_avc_specific.h"
 #include "ddi_decode_trace_specific.h"
+#include "ddi_decode_slice_translator.h"
 
 namespace decode
 {
@@ -49,131 +50,177 @@ VAStatus DdiDecodeAvc::ParseSliceParams(
         DDI_CODEC_ASSERTMESSAGE("Invalid Parameter for Parsing AVC Slice parameter\n");
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
-    VASliceParameterBufferH264 *slc;
-    slc = (VASliceParameterBufferH264 *)slcParam;
-
     VASliceParameterBufferBase *slcBase;
     slcBase = (VASliceParameterBufferBase *)slcParam;
 
     PCODEC_AVC_PIC_PARAMS avcPicParams;
     avcPicParams                          = (PCODEC_AVC_PIC_PARAMS)(m_decodeCtx->DecodeParams.m_picParams);
-    avcPicParams->pic_fields.IntraPicFlag = (slc->slice_type == 2) ? 1 : 0;
+    avcPicParams->pic_fields.IntraPicFlag = (slcParam->slice_type == 2) ? 1 : 0;
 
     bool useCABAC = (bool)(avcPicParams->pic_fields.entropy_coding_mode_flag);
 
     uint32_t sliceBaseOffset;
     sliceBaseOffset = GetBsBufOffset(m_groupIndex);
 
-    uint32_t i, slcCount, refCount;
-    for (slcCount = 0; slcCount < numSlices; slcCount++)
-    {
-        if (m_decodeCtx->bShortFormatInUse)
+    bool shortFormat = m_decodeCtx->bShortFormatInUse;
+
+    // Reference surfaces are resolved once per buffer, every lookup takes the surface heap lock
+    VASurfaceID refSurfaceId[CODEC_AVC_NUM_UNCOMPRESSED_SURFACE];
+    uint32_t    refFrameIdx[CODEC_AVC_NUM_UNCOMPRESSED_SURFACE];
+    uint32_t    refSurfaceNum = 0;
+
+    auto findFrameIdx = [&](VASurfaceID surfaceId, uint32_t &frameIdx) -> bool {
+        for (uint32_t i = 0; i < refSurfaceNum; i++)
         {
-            avcSliceParams->slice_data_size   = slcBase->slice_data_size;
-            avcSliceParams->slice_data_offset = sliceBaseOffset +
-                                                slcBase->slice_data_offset;
-            if (slcBase->slice_data_flag)
+            if (refSurfaceId[i] == surfaceId)
             {
-                DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
+                frameIdx = refFrameIdx[i];
+                return true;
             }
-            slcBase++;
         }
-        else
-        {
-            if (useCABAC)
-            {
-                // add the alignment bit
-                slc->slice_data_bit_offset = MOS_ALIGN_CEIL(slc->slice_data_bit_offset, 8);
-            }
+        return false;
+    };
 
-            // remove 1 byte of NAL unit code
-            slc->slice_data_bit_offset = slc->slice_data_bit_offset - 8;
+    auto addRefSurface = [&](VASurfaceID surfaceId) {
+        uint32_t frameIdx = 0;
+        if (refSurfaceNum < CODEC_AVC_NUM_UNCOMPRESSED_SURFACE && !findFrameIdx(surfaceId, frameIdx))
+        {
+            refSurfaceId[refSurfaceNum] = surfaceId;
+            refFrameIdx[refSurfaceNum]  = GetFrameIdx(mediaCtx, &(m_decodeCtx->RTtbl), surfaceId);
+            refSurfaceNum++;
+        }
+    };
 
-            avcSliceParams->slice_data_size   = slc->slice_data_size;
-            avcSliceParams->slice_data_offset = sliceBaseOffset + slc->slice_data_offset;
+    if (!shortFormat)
+    {
+        for (uint32_t slcCount = 0; slcCount < numSlices; slcCount++)
+        {
+            VASliceParameterBufferH264 *slc = slcParam + slcCount;
 
-            if (slc->slice_data_flag)
+            uint32_t refCount = std::min(slc->num_ref_idx_l0_active_minus1 + 1, CODEC_MAX_NUM_REF_FIELD);
+            for (uint32_t i = 0; i < refCount; i++)
             {
-                DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
+                addRefSurface(slc->RefPicList0[i].picture_id);
             }
-
-            avcSliceParams->slice_data_bit_offset        = slc->slice_data_bit_offset;
-            avcSliceParams->first_mb_in_slice            = slc->first_mb_in_slice;
-            avcSliceParams->NumMbsForSlice               = 0;  // not in LibVA slc->NumMbsForSlice;
-            avcSliceParams->slice_type                   = slc->slice_type;
-            avcSliceParams->direct_spatial_mv_pred_flag  = slc->direct_spatial_mv_pred_flag;
-            avcSliceParams->num_ref_idx_l0_active_minus1 = slc->num_ref_idx_l0_active_minus1;
-            avcSliceParams->num_ref_idx_l1_active_minus1 = slc->num_ref_idx_l1_active_minus1;
-
-            if (slcCount == 0)
+            refCount = std::min(slc->num_ref_idx_l1_active_minus1 + 1, CODEC_MAX_NUM_REF_FIELD);
+            for (uint32_t i = 0; i < refCount; i++)
             {
-                avcPicParams->num_ref_idx_l0_active_minus1 = avcSliceParams->num_ref_idx_l0_active_minus1;
-                avcPicParams->num_ref_idx_l1_active_minus1 = avcSliceParams->num_ref_idx_l1_active_minus1;
+                addRefSurface(slc->RefPicList1[i].picture_id);
             }
-            avcSliceParams->cabac_init_idc                = slc->cabac_init_idc;
-            avcSliceParams->slice_qp_delta                = slc->slice_qp_delta;
-            avcSliceParams->disable_deblocking_filter_idc = slc->disable_deblocking_filter_idc;
-            avcSliceParams->slice_alpha_c0_offset_div2    = slc->slice_alpha_c0_offset_div2;
-            avcSliceParams->slice_beta_offset_div2        = slc->slice_beta_offset_div2;
-            // reference list 0
-            refCount = std::min(avcSliceParams->num_ref_idx_l0_active_minus1 + 1, CODEC_MAX_NUM_REF_FIELD);
-            for (i = 0; i < refCount; i++)
+        }
+    }
+
+    // Ranges only read the resolved surfaces, a surface which did not fit is looked up again
+    auto setupSlcRefPicture = [&](CODEC_PICTURE *codecHalPic, VAPictureH264 vaPic) {
+        if (!findFrameIdx(vaPic.picture_id, vaPic.frame_idx))
+        {
+            vaPic.frame_idx = GetFrameIdx(mediaCtx, &(m_decodeCtx->RTtbl), vaPic.picture_id);
+        }
+        SetupCodecPicture(codecHalPic, vaPic, avcPicParams->pic_fields.field_pic_flag, false, true);
+    };
+
+    // Each slice is translated from its own index, so ranges are independent
+    auto translateSlices = [&](uint32_t begin, uint32_t end) -> VAStatus {
+        uint32_t i, slcCount, refCount;
+        for (slcCount = begin; slcCount < end; slcCount++)
+        {
+            PCODEC_AVC_SLICE_PARAMS codecSlc = avcSliceParams + slcCount;
+            if (shortFormat)
             {
-                SetupCodecPicture(
-                    mediaCtx,
-                    &(m_decodeCtx->RTtbl),
-                    &(avcSliceParams->RefPicList[0][i]),
-                    slc->RefPicList0[i],
-                    avcPicParams->pic_fields.field_pic_flag,
-                    false,
-                    true);
-
-                GetSlcRefIdx(&(avcPicParams->RefFrameList[0]), &(avcSliceParams->RefPicList[0][i]));
+                VASliceParameterBufferBase *slcShort = slcBase + slcCount;
+                codecSlc->slice_data_size   = slcShort->slice_data_size;
+                codecSlc->slice_data_offset = sliceBaseOffset +
+                                              slcShort->slice_data_offset;
+                if (slcShort->slice_data_flag)
+                {
+                    DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
+                }
             }
-            // reference list 1
-            refCount = std::min(avcSliceParams->num_ref_idx_l1_active_minus1 + 1, CODEC_MAX_NUM_REF_FIELD);
-            for (i = 0; i < refCount; i++)
+            else
             {
-                SetupCodecPicture(
-                    mediaCtx,
-                    &(m_decodeCtx->RTtbl),
-                    &(avcSliceParams->RefPicList[1][i]),
-                    slc->RefPicList1[i],
-                    avcPicParams->pic_fields.field_pic_flag,
-                    false,
-                    true);
-
-                GetSlcRefIdx(&(avcPicParams->RefFrameList[0]), &(avcSliceParams->RefPicList[1][i]));
+                VASliceParameterBufferH264 *slc = slcParam + slcCount;
+                if (useCABAC)
+                {
+                    // add the alignment bit
+                    slc->slice_data_bit_offset = MOS_ALIGN_CEIL(slc->slice_data_bit_offset, 8);
+                }
+
+                // remove 1 byte of NAL unit code
+                slc->slice_data_bit_offset = slc->slice_data_bit_offset - 8;
+
+                codecSlc->slice_data_size   = slc->slice_data_size;
+                codecSlc->slice_data_offset = sliceBaseOffset + slc->slice_data_offset;
+
+                if (slc->slice_data_flag)
+                {
+                    DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
+                }
+
+                codecSlc->slice_data_bit_offset        = slc->slice_data_bit_offset;
+                codecSlc->first_mb_in_slice            = slc->first_mb_in_slice;
+                codecSlc->NumMbsForSlice               = 0;  // not in LibVA slc->NumMbsForSlice;
+                codecSlc->slice_type                   = slc->slice_type;
+                codecSlc->direct_spatial_mv_pred_flag  = slc->direct_spatial_mv_pred_flag;
+                codecSlc->num_ref_idx_l0_active_minus1 = slc->num_ref_idx_l0_active_minus1;
+                codecSlc->num_ref_idx_l1_active_minus1 = slc->num_ref_idx_l1_active_minus1;
+
+                codecSlc->cabac_init_idc                = slc->cabac_init_idc;
+                codecSlc->slice_qp_delta                = slc->slice_qp_delta;
+                codecSlc->disable_deblocking_filter_idc = slc->disable_deblocking_filter_idc;
+                codecSlc->slice_alpha_c0_offset_div2    = slc->slice_alpha_c0_offset_div2;
+                codecSlc->slice_beta_offset_div2        = slc->slice_beta_offset_div2;
+                // reference list 0
+                refCount = std::min(codecSlc->num_ref_idx_l0_active_minus1 + 1, CODEC_MAX_NUM_REF_FIELD);
+                for (i = 0; i < refCount; i++)
+                {
+                    setupSlcRefPicture(&(codecSlc->RefPicList[0][i]), slc->RefPicList0[i]);
+                    GetSlcRefIdx(&(avcPicParams->RefFrameList[0]), &(codecSlc->RefPicList[0][i]));
+                }
+                // reference list 1
+                refCount = std::min(codecSlc->num_ref_idx_l1_active_minus1 + 1, CODEC_MAX_NUM_REF_FIELD);
+                for (i = 0; i < refCount; i++)
+                {
+                    setupSlcRefPicture(&(codecSlc->RefPicList[1][i]), slc->RefPicList1[i]);
+                    GetSlcRefIdx(&(avcPicParams->RefFrameList[0]), &(codecSlc->RefPicList[1][i]));
+                }
+
+                codecSlc->luma_log2_weight_denom   = slc->luma_log2_weight_denom;
+                codecSlc->chroma_log2_weight_denom = slc->chroma_log2_weight_denom;
+                for (i = 0; i < 32; i++)
+                {
+                    // list 0
+                    codecSlc->Weights[0][i][0][0] = slc->luma_weight_l0[i];  // Y weight
+                    codecSlc->Weights[0][i][0][1] = slc->luma_offset_l0[i];  // Y offset
+
+                    codecSlc->Weights[0][i][1][0] = slc->chroma_weight_l0[i][0];  // Cb weight
+                    codecSlc->Weights[0][i][1][1] = slc->chroma_offset_l0[i][0];  // Cb offset
+
+                    codecSlc->Weights[0][i][2][0] = slc->chroma_weight_l0[i][1];  // Cr weight
+                    codecSlc->Weights[0][i][2][1] = slc->chroma_offset_l0[i][1];  // Cr offset
+
+                    // list 1
+                    codecSlc->Weights[1][i][0][0] = slc->luma_weight_l1[i];  // Y weight
+                    codecSlc->Weights[1][i][0][1] = slc->luma_offset_l1[i];  // Y offset
+
+                    codecSlc->Weights[1][i][1][0] = slc->chroma_weight_l1[i][0];  // Cb weight
+                    codecSlc->Weights[1][i][1][1] = slc->chroma_offset_l1[i][0];  // Cb offset
+
+                    codecSlc->Weights[1][i][2][0] = slc->chroma_weight_l1[i][1];  // Cr weight
+                    codecSlc->Weights[1][i][2][1] = slc->chroma_offset_l1[i][1];  // Cr offset
+                }
             }
+            codecSlc->slice_id = 0;
+        }
+        return VA_STATUS_SUCCESS;
+    };
 
-            avcSliceParams->luma_log2_weight_denom   = slc->luma_log2_weight_denom;
-            avcSliceParams->chroma_log2_weight_denom = slc->chroma_log2_weight_denom;
-            for (i = 0; i < 32; i++)
-            {
-                // list 0
-                avcSliceParams->Weights[0][i][0][0] = slc->luma_weight_l0[i];  // Y weight
-                avcSliceParams->Weights[0][i][0][1] = slc->luma_offset_l0[i];  // Y offset
-
-                avcSliceParams->Weights[0][i][1][0] = slc->chroma_weight_l0[i][0];  // Cb weight
-                avcSliceParams->Weights[0][i][1][1] = slc->chroma_offset_l0[i][0];  // Cb offset
-
-                avcSliceParams->Weights[0][i][2][0] = slc->chroma_weight_l0[i][1];  // Cr weight
-                avcSliceParams->Weights[0][i][2][1] = slc->chroma_offset_l0[i][1];  // Cr offset
-
-                // list 1
-                avcSliceParams->Weights[1][i][0][0] = slc->luma_weight_l1[i];  // Y weight
-                avcSliceParams->Weights[1][i][0][1] = slc->luma_offset_l1[i];  // Y offset
-
-                avcSliceParams->Weights[1][i][1][0] = slc->chroma_weight_l1[i][0];  // Cb weight
-                avcSliceParams->Weights[1][i][1][1] = slc->chroma_offset_l1[i][0];  // Cb offset
+    DDI_CODEC_CHK_RET(DdiDecodeSliceTranslator::Translate(numSlices, translateSlices), "Translate AVC slice parameters failed");
 
-                avcSliceParams->Weights[1][i][2][0] = slc->chroma_weight_l1[i][1];  // Cr weight
-                avcSliceParams->Weights[1][i][2][1] = slc->chroma_offset_l1[i][1];  // Cr offset
-            }
-            slc++;
-        }
-        avcSliceParams->slice_id = 0;
-        avcSliceParams++;
+    // Picture level reference counts come from the first slice of the buffer
+    if (!shortFormat && numSlices > 0)
+    {
+        avcPicParams->num_ref_idx_l0_active_minus1 = avcSliceParams->num_ref_idx_l0_active_minus1;
+        avcPicParams->num_ref_idx_l1_active_minus1 = avcSliceParams->num_ref_idx_l1_active_minus1;
     }
 
     return VA_STATUS_SUCCESS;
@@ -899,6 +946,20 @@ void DdiDecodeAvc::GetSlcRefIdx(CODEC_PICTURE *picReference, CODEC_PICTURE *slcR
     return;
 }
 
+uint32_t DdiDecodeAvc::GetFrameIdx(
+    DDI_MEDIA_CONTEXT             *mediaCtx,
+    DDI_CODEC_RENDER_TARGET_TABLE *rtTbl,
+    VASurfaceID                   surfaceId)
+{
+    if (surfaceId == DDI_CODEC_INVALID_FRAME_INDEX)
+    {
+        return DDI_CODEC_INVALID_FRAME_INDEX;
+    }
+
+    DDI_MEDIA_SURFACE *surface = MediaLibvaCommonNext::GetSurfaceFromVASurfaceID(mediaCtx, surfaceId);
+    return GetRenderTargetID(rtTbl, surface);
+}
+
 void DdiDecodeAvc::SetupCodecPicture(
     DDI_MEDIA_CONTEXT             *mediaCtx,
     DDI_CODEC_RENDER_TARGET_TABLE *rtTbl,
@@ -910,23 +971,24 @@ void DdiDecodeAvc::SetupCodecPicture(
 {
     DDI_CODEC_FUNC_ENTER;
 
-    if (vaPic.picture_id != DDI_CODEC_INVALID_FRAME_INDEX)
+    vaPic.frame_idx = GetFrameIdx(mediaCtx, rtTbl, vaPic.picture_id);
+    SetupCodecPicture(codecHalPic, vaPic, fieldPicFlag, picReference, sliceReference);
+}
+
+void DdiDecodeAvc::SetupCodecPicture(
+    CODEC_PICTURE                 *codecHalPic,
+    const VAPictureH264           &vaPic,
+    bool                          fieldPicFlag,
+    bool                          picReference,
+    bool                          sliceReference)
+{
+    if (vaPic.frame_idx == DDI_CODEC_INVALID_FRAME_INDEX)
     {
-        DDI_MEDIA_SURFACE *surface = MediaLibvaCommonNext::GetSurfaceFromVASurfaceID(mediaCtx, vaPic.picture_id);
-        vaPic.frame_idx = GetRenderTargetID(rtTbl, surface);    
-        if (vaPic.frame_idx == DDI_CODEC_INVALID_FRAME_INDEX)
-        {
-            codecHalPic->FrameIdx = CODEC_AVC_NUM_UNCOMPRESSED_SURFACE - 1;
-        }
-        else
-        {
-            codecHalPic->FrameIdx = (uint8_t)vaPic.frame_idx;
-        }
+        codecHalPic->FrameIdx = CODEC_AVC_NUM_UNCOMPRESSED_SURFACE - 1;
     }
     else
     {
-        vaPic.frame_idx       = DDI_CODEC_INVALID_FRAME_INDEX;
-        codecHalPic->FrameIdx = CODEC_AVC_NUM_UNCOMPRESSED_SURFACE - 1;
+        codecHalPic->FrameIdx = (uint8_t)vaPic.frame_idx;
     }
 
     if (picReference)
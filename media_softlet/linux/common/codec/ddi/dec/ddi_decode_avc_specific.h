@@ -194,6 +194,34 @@ private:
         bool                          picReference,
         bool                          sliceReference);
 
+    //!
+    //! \brief    Setup Codec Picture for AVC from VA picture whose frame_idx is resolved
+    //!
+    void SetupCodecPicture(
+        CODEC_PICTURE                 *codecHalPic,
+        const VAPictureH264           &vaPic,
+        bool                          fieldPicFlag,
+        bool                          picReference,
+        bool                          sliceReference);
+
+    //!
+    //! \brief    Get index of VA surface in render target table
+    //!
+    //! \param    [in] mediaCtx
+    //!           Pointer to DDI_MEDIA_CONTEXT
+    //! \param    [in] rtTbl
+    //!           Pointer to DDI_CODEC_RENDER_TARGET_TABLE
+    //! \param    [in] surfaceId
+    //!           VA surface ID
+    //!
+    //! \return   uint32_t
+    //!           Frame index, DDI_CODEC_INVALID_FRAME_INDEX if surface is invalid or not in table
+    //!
+    uint32_t GetFrameIdx(
+        DDI_MEDIA_CONTEXT             *mediaCtx,
+        DDI_CODEC_RENDER_TARGET_TABLE *rtTbl,
+        VASurfaceID                   surfaceId);
+
     void FreeResource();
 
     MEDIA_CLASS_DEFINE_END(decode__DdiDecodeAvc)
@@ -57,6 +57,23 @@ DdiDecodeBase::DdiDecodeBase()
     m_codechalSettings = CodechalSetting::CreateCodechalSetting();
 }
 
+void DdiDecodeBase::InitUserSetting(DDI_MEDIA_CONTEXT *mediaCtx)
+{
+    DDI_CODEC_FUNC_ENTER;
+
+    if (mediaCtx == nullptr)
+    {
+        return;
+    }
+
+    // Application opts in when it keeps slice data valid until the decoded surface is synced
+    ReadUserSetting(
+        mediaCtx->m_userSettingPtr,
+        m_userptrBitstream,
+        "Decode Userptr Bitstream",
+        MediaUserSetting::Group::Device);
+}
+
 VAStatus DdiDecodeBase::BasicInit(
     ConfigLinux *configItem)
 {
@@ -264,6 +281,9 @@ VAStatus DdiDecodeBase::BeginPicture(
     DDI_CODEC_CHK_NULL(curRT, "nullptr pCurRT", VA_STATUS_ERROR_INVALID_SURFACE);
     curRT->pDecCtx = m_decodeCtx;
 
+    // Userptr buffers of previous frames are only held until HW finished them
+    ReleaseIdleUserptrBsBuffers(&(m_decodeCtx->BufMgr));
+
     DDI_CODEC_RENDER_TARGET_TABLE *RTtbl;
     RTtbl             = &(m_decodeCtx->RTtbl);
     RTtbl->pCurrentRT = curRT;
@@ -316,7 +336,9 @@ VAStatus DdiDecodeBase::DecodeCombineBitstream(DDI_MEDIA_CONTEXT *mediaCtx)
         return VA_STATUS_ERROR_DECODING_ERROR;
     }
 
-    newBitstreamBuffer->iSize     = m_decodeCtx->DecodeParams.m_dataSize;
+    // Allocate with headroom, the buffer stays in the pool for the following frames
+    UpdateMaxBsSize(bufMgr, m_decodeCtx->DecodeParams.m_dataSize);
+    newBitstreamBuffer->iSize     = MOS_MAX(bufMgr->dwMaxBsSize, m_decodeCtx->DecodeParams.m_dataSize);
     newBitstreamBuffer->uiType    = VASliceDataBufferType;
     newBitstreamBuffer->format    = Media_Format_Buffer;
     newBitstreamBuffer->uiOffset  = 0;
@@ -532,7 +554,7 @@ VAStatus DdiDecodeBase::AllocBsBuffer(
 {
     DDI_CODEC_FUNC_ENTER;
 
-    uint32_t         index = 0, i = 0;
+    uint32_t         index = 0;
     VAStatus         vaStatus  = VA_STATUS_SUCCESS;
     uint8_t          *sliceBuf = nullptr;
     DDI_MEDIA_BUFFER *bsBufObj = nullptr;
@@ -550,23 +572,23 @@ VAStatus DdiDecodeBase::AllocBsBuffer(
     /* the pSliceData needs to be reallocated in order to contain more SliceDataBuf */
     if (index >= bufMgr->m_maxNumSliceData)
     {
-        /* In theroy it can resize the m_maxNumSliceData one by one. But in order to
-         * avoid calling realloc frequently, it will try to allocate 10 to  hold more
-         * SliceDataBuf. This is only for the optimized purpose.
+        /* The array is kept across frames, so grow it geometrically to reach the
+         * max slice number of the stream with few reallocs.
          */
-        int32_t reallocSize = bufMgr->m_maxNumSliceData + 10;
+        uint32_t reallocSize = MOS_MAX(bufMgr->m_maxNumSliceData * 2, bufMgr->m_maxNumSliceData + 10);
 
-        bufMgr->pSliceData  = (DDI_CODEC_BITSTREAM_BUFFER_INFO *)realloc(bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]) * reallocSize);
+        DDI_CODEC_BITSTREAM_BUFFER_INFO *sliceData = (DDI_CODEC_BITSTREAM_BUFFER_INFO *)realloc(bufMgr->pSliceData, sizeof(bufMgr->pSliceData[0]) * reallocSize);
 
-        if (bufMgr->pSliceData == nullptr)
+        if (sliceData == nullptr)
         {
             DDI_CODEC_ASSERTMESSAGE("fail to reallocate pSliceData\n.");
             return VA_STATUS_ERROR_ALLOCATION_FAILED;
         }
+        bufMgr->pSliceData = sliceData;
         memset(bufMgr->pSliceData + bufMgr->m_maxNumSliceData, 0,
-               sizeof(bufMgr->pSliceData[0]) * 10);
+               sizeof(bufMgr->pSliceData[0]) * (reallocSize - bufMgr->m_maxNumSliceData));
 
-        bufMgr->m_maxNumSliceData += 10;
+        bufMgr->m_maxNumSliceData = reallocSize;
     }
 
     if (index >= 1)
@@ -581,6 +603,8 @@ VAStatus DdiDecodeBase::AllocBsBuffer(
                 return VA_STATUS_ERROR_ALLOCATION_FAILED;
             }
             bufMgr->bIsSliceOverSize = true;
+            // Buffers selected for the following frames are enlarged to hold the whole frame
+            UpdateMaxBsSize(bufMgr, buf->uiOffset + buf->iSize);
         }
         else
         {
@@ -590,57 +614,40 @@ VAStatus DdiDecodeBase::AllocBsBuffer(
     else
     {
         bufMgr->bIsSliceOverSize = false;
-        for (i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
-        {
-            if (bufMgr->pBitStreamBuffObject[i]->bo != nullptr)
-            {
-                if (!mos_bo_busy(bufMgr->pBitStreamBuffObject[i]->bo))
-                {
-                    // find a bitstream buffer whoes graphic memory is allocated but not used by HW now.
-                    break;
-                }
-            }
-            else
-            {
-                // find a new bitstream buffer whoes graphic memory is not allocated yet
-                break;
-            }
-        }
-
-        if (i == DDI_CODEC_MAX_BITSTREAM_BUFFER)
-        {
-            // find the oldest bistream buffer which is the most possible one to become free in the shortest time.
-            bufMgr->dwBitstreamIndex = (bufMgr->ui64BitstreamOrder >> (DDI_CODEC_BITSTREAM_BUFFER_INDEX_BITS * DDI_CODEC_MAX_BITSTREAM_BUFFER_MINUS1)) & DDI_CODEC_MAX_BITSTREAM_BUFFER_INDEX;
-            // wait until decode complete
-            mos_bo_wait_rendering(bufMgr->pBitStreamBuffObject[bufMgr->dwBitstreamIndex]->bo);
-        }
-        else
-        {
-            bufMgr->dwBitstreamIndex = i;
-        }
-        bufMgr->ui64BitstreamOrder = (bufMgr->ui64BitstreamOrder << 4) + bufMgr->dwBitstreamIndex;
+        SelectBitstreamBuffer(bufMgr);
 
         bsBufObj            = bufMgr->pBitStreamBuffObject[bufMgr->dwBitstreamIndex];
         bsBufObj->pMediaCtx = m_decodeCtx->pMediaCtx;
         bsBufBaseAddr       = bufMgr->pBitStreamBase[bufMgr->dwBitstreamIndex];
 
+        if (bsBufObj->bUserptr)
+        {
+            // The buffer wraps application memory of a previous frame, never write into it
+            MediaLibvaUtilNext::FreeBuffer(bsBufObj);
+            bufMgr->pBitStreamBase[bufMgr->dwBitstreamIndex] = nullptr;
+            bsBufBaseAddr = nullptr;
+        }
+
+        UpdateMaxBsSize(bufMgr, buf->iSize);
+        uint32_t bsSize = bufMgr->dwMaxBsSize;
+
         if (bsBufBaseAddr == nullptr)
         {
             createBsBuffer = true;
-            if (buf->iSize > bsBufObj->iSize)
+            if (bsSize > bsBufObj->iSize)
             {
-                bsBufObj->iSize = buf->iSize;
+                bsBufObj->iSize = bsSize;
             }
         }
-        else if (buf->iSize > bsBufObj->iSize)
+        else if (bsSize > bsBufObj->iSize)
         {
-           // free bo
+           // free bo, buffer is idle and smaller than the largest frame seen
             MediaLibvaUtilNext::UnlockBuffer(bsBufObj);
             MediaLibvaUtilNext::FreeBuffer(bsBufObj);
             bsBufBaseAddr = nullptr;
 
             createBsBuffer  = true;
-            bsBufObj->iSize = buf->iSize;
+            bsBufObj->iSize = bsSize;
         }
 
         if (createBsBuffer)
@@ -690,6 +697,135 @@ VAStatus DdiDecodeBase::AllocBsBuffer(
     return VA_STATUS_SUCCESS;
 }
 
+void DdiDecodeBase::UpdateMaxBsSize(
+    DDI_CODEC_COM_BUFFER_MGR *bufMgr,
+    uint32_t                  frameSize)
+{
+    if (frameSize <= bufMgr->dwMaxBsSize)
+    {
+        return;
+    }
+
+    // 25% headroom to absorb the bitrate fluctuation of following frames
+    bufMgr->dwMaxBsSize = MOS_ALIGN_CEIL(frameSize + (frameSize >> 2), MOS_PAGE_SIZE);
+    DDI_CODEC_NORMALMESSAGE("Bitstream buffer size grows to %d for frame of %d bytes", bufMgr->dwMaxBsSize, frameSize);
+}
+
+void DdiDecodeBase::SelectBitstreamBuffer(DDI_CODEC_COM_BUFFER_MGR *bufMgr)
+{
+    DDI_CODEC_FUNC_ENTER;
+
+    uint32_t i = 0;
+    for (i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
+    {
+        if (bufMgr->pBitStreamBuffObject[i]->bo != nullptr)
+        {
+            if (!mos_bo_busy(bufMgr->pBitStreamBuffObject[i]->bo))
+            {
+                // find a bitstream buffer whoes graphic memory is allocated but not used by HW now.
+                break;
+            }
+        }
+        else
+        {
+            // find a new bitstream buffer whoes graphic memory is not allocated yet
+            break;
+        }
+    }
+
+    if (i == DDI_CODEC_MAX_BITSTREAM_BUFFER)
+    {
+        // find the oldest bistream buffer which is the most possible one to become free in the shortest time.
+        bufMgr->dwBitstreamIndex = (bufMgr->ui64BitstreamOrder >> (DDI_CODEC_BITSTREAM_BUFFER_INDEX_BITS * DDI_CODEC_MAX_BITSTREAM_BUFFER_MINUS1)) & DDI_CODEC_MAX_BITSTREAM_BUFFER_INDEX;
+        // wait until decode complete
+        mos_bo_wait_rendering(bufMgr->pBitStreamBuffObject[bufMgr->dwBitstreamIndex]->bo);
+    }
+    else
+    {
+        bufMgr->dwBitstreamIndex = i;
+    }
+    bufMgr->ui64BitstreamOrder = (bufMgr->ui64BitstreamOrder << 4) + bufMgr->dwBitstreamIndex;
+}
+
+VAStatus DdiDecodeBase::AllocUserptrBsBuffer(
+    DDI_CODEC_COM_BUFFER_MGR *bufMgr,
+    DDI_MEDIA_BUFFER         *buf,
+    void                     *data)
+{
+    DDI_CODEC_FUNC_ENTER;
+
+    DDI_CODEC_CHK_NULL(bufMgr,                   "nullptr bufMgr",     VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CODEC_CHK_NULL(buf,                      "nullptr buf",        VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CODEC_CHK_NULL(data,                     "nullptr data",       VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CODEC_CHK_NULL(bufMgr->pSliceData,       "nullptr pSliceData", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CODEC_CHK_NULL(m_decodeCtx->pMediaCtx,   "nullptr pMediaCtx",  VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    // The bo only covers this buffer, a following slice data buffer would combine the frame into
+    // a new buffer. Import only while frames of the stream come in a single slice data buffer.
+    if (bufMgr->dwNumSliceData != 0 || bufMgr->m_maxNumSliceData == 0 ||
+        m_lastFrameSliceDataNum != 1 || ((uintptr_t)data & (MOS_PAGE_SIZE - 1)))
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+
+    ReleaseIdleUserptrBsBuffers(bufMgr);
+    SelectBitstreamBuffer(bufMgr);
+
+    uint32_t          index    = bufMgr->dwBitstreamIndex;
+    DDI_MEDIA_BUFFER *bsBufObj = bufMgr->pBitStreamBuffObject[index];
+
+    // Release the buffer used by previous frame, the slot holds the userptr bo until it is reused
+    if (bufMgr->pBitStreamBase[index] && !bsBufObj->bUserptr)
+    {
+        MediaLibvaUtilNext::UnlockBuffer(bsBufObj);
+    }
+    bufMgr->pBitStreamBase[index] = nullptr;
+    if (bsBufObj->bo)
+    {
+        MediaLibvaUtilNext::FreeBuffer(bsBufObj);
+    }
+
+    bsBufObj->pMediaCtx = m_decodeCtx->pMediaCtx;
+    bsBufObj->iSize     = buf->iSize;
+    DDI_CHK_RET(MediaLibvaUtilNext::CreateUserptrBuffer(bsBufObj, data, m_decodeCtx->pMediaCtx->pDrmBufMgr), "Failed to wrap slice data!");
+    bufMgr->pBitStreamBase[index] = (uint8_t *)data;
+
+    bufMgr->bIsSliceOverSize           = false;
+    bufMgr->pSliceData[0].uiLength     = buf->iSize;
+    bufMgr->pSliceData[0].uiOffset     = 0;
+    bufMgr->pSliceData[0].bIsUseExtBuf = false;
+    bufMgr->pSliceData[0].pSliceBuf    = nullptr;
+    bufMgr->dwNumSliceData++;
+
+    buf->pData      = (uint8_t *)data;
+    buf->uiOffset   = 0;
+    buf->bCFlushReq = false;
+    buf->bo         = bsBufObj->bo;
+
+    return VA_STATUS_SUCCESS;
+}
+
+void DdiDecodeBase::ReleaseIdleUserptrBsBuffers(
+    DDI_CODEC_COM_BUFFER_MGR *bufMgr)
+{
+    DDI_CODEC_FUNC_ENTER;
+
+    for (uint32_t i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
+    {
+        DDI_MEDIA_BUFFER *bsBufObj = bufMgr->pBitStreamBuffObject[i];
+        if (bsBufObj == nullptr || !bsBufObj->bUserptr || bsBufObj->bo == nullptr)
+        {
+            continue;
+        }
+        // Keep the reference while HW still reads the frame, drop it once the frame is done
+        if (!mos_bo_busy(bsBufObj->bo))
+        {
+            MediaLibvaUtilNext::FreeBuffer(bsBufObj);
+            bufMgr->pBitStreamBase[i] = nullptr;
+        }
+    }
+}
+
 MOS_FORMAT DdiDecodeBase::GetFormat()
 {
     DDI_CODEC_FUNC_ENTER;
@@ -955,6 +1091,9 @@ VAStatus DdiDecodeBase::EndPicture(
         m_decodeCtx->bDecodeModeReported = true;
     }
 
+    // Record before InitDecodeParams resets the count for the next frame
+    m_lastFrameSliceDataNum = m_decodeCtx->BufMgr.dwNumSliceData;
+
     DDI_CHK_RET(InitDecodeParams(ctx,context),"InitDecodeParams failed!");
 
     DDI_CHK_RET(SetDecodeParams(), "SetDecodeParams failed!");
@@ -1018,6 +1157,7 @@ VAStatus DdiDecodeBase::CreateBuffer(
     uint16_t                        segMapHeight = m_picHeightInMB;
     MOS_STATUS                      status = MOS_STATUS_SUCCESS;
     VAStatus                        va = VA_STATUS_SUCCESS;
+    bool                            userptrImported = false;
 
     // only for VASliceParameterBufferType of buffer, the number of elements can be greater than 1
     if (type != VASliceParameterBufferType && numElements > 1)
@@ -1045,6 +1185,14 @@ VAStatus DdiDecodeBase::CreateBuffer(
             break;
         case VASliceDataBufferType:
         case VAProtectedSliceDataBufferType:
+            if (m_userptrBitstream && type == VASliceDataBufferType && data != nullptr &&
+                m_decodeCtx->wMode != CODECHAL_DECODE_MODE_JPEG &&
+                AllocUserptrBsBuffer(&(m_decodeCtx->BufMgr), buf, data) == VA_STATUS_SUCCESS)
+            {
+                userptrImported = true;
+                break;
+            }
+            // Fall back to copy for unaligned memory or when userptr is not supported
             va = AllocBsBuffer(&(m_decodeCtx->BufMgr), buf);
             if (va != VA_STATUS_SUCCESS)
             {
@@ -1152,7 +1300,7 @@ VAStatus DdiDecodeBase::CreateBuffer(
     }
     m_decodeCtx->pMediaCtx->uiNumBufs++;
 
-    if (data == nullptr)
+    if (data == nullptr || userptrImported)
     {
         return va;
     }
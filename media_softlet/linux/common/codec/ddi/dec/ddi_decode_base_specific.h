@@ -183,6 +183,13 @@ public:
     //!           VA_STATUS_SUCCESS if success, else fail reason
 
     VAStatus BasicInit(ConfigLinux *configItem);
+
+    //!
+    //! \brief    Read user settings of decode context
+    //! \param    [in] mediaCtx
+    //!           Pointer to media context
+    //!
+    void InitUserSetting(DDI_MEDIA_CONTEXT *mediaCtx);
     //!
     //! \brief    the second step of Initializing internal structure of DdiDecodeBase
     //! \details  Initialize the internal structure of DdiDecodeBase base on
@@ -252,6 +259,59 @@ public:
         DDI_CODEC_COM_BUFFER_MGR *bufMgr,
         DDI_MEDIA_BUFFER         *buf);
 
+    //!
+    //! \brief    Allocate Bs buffer from application memory
+    //! \details  Wrap page aligned slice data of application as userptr bo, so that
+    //!           it is consumed by HW without copy. Only used while frames come in one
+    //!           slice data buffer. Driver holds the bo until HW finished the frame,
+    //!           application must keep the memory valid until the decoded surface is synced.
+    //!
+    //! \param    [in] bufMgr
+    //!           DDI_CODEC_COM_BUFFER_MGR    *bufMgr
+    //! \param    [in] buf
+    //!           DDI_MEDIA_BUFFER            *buf
+    //! \param    [in] data
+    //!           Slice data of application
+    //! \return   VAStatus
+    //!
+    virtual VAStatus AllocUserptrBsBuffer(
+        DDI_CODEC_COM_BUFFER_MGR *bufMgr,
+        DDI_MEDIA_BUFFER         *buf,
+        void                     *data);
+
+    //!
+    //! \brief    Release userptr bitstream buffers which are no longer used by HW
+    //!
+    //! \param    [in] bufMgr
+    //!           DDI_CODEC_COM_BUFFER_MGR    *bufMgr
+    //!
+    void ReleaseIdleUserptrBsBuffers(
+        DDI_CODEC_COM_BUFFER_MGR *bufMgr);
+
+    //!
+    //! \brief    Raise the bitstream buffer size for a frame of given size
+    //! \details  Keep headroom above the largest frame, so buffers are not
+    //!           reallocated and slices are not combined for every bigger frame
+    //!
+    //! \param    [in] bufMgr
+    //!           DDI_CODEC_COM_BUFFER_MGR    *bufMgr
+    //! \param    [in] frameSize
+    //!           Bitstream size of the frame
+    //!
+    void UpdateMaxBsSize(
+        DDI_CODEC_COM_BUFFER_MGR *bufMgr,
+        uint32_t                  frameSize);
+
+    //!
+    //! \brief    Select bitstream buffer for a new frame
+    //! \details  Pick a bitstream buffer which is not used by HW, or wait for the oldest one
+    //!
+    //! \param    [in] bufMgr
+    //!           DDI_CODEC_COM_BUFFER_MGR    *bufMgr
+    //!
+    void SelectBitstreamBuffer(
+        DDI_CODEC_COM_BUFFER_MGR *bufMgr);
+
     //! 
     //! \brief    Get Picture parameter size 
     //! \details  Get Picture parameter size for each decoder 
@@ -467,6 +527,8 @@ protected:
     uint32_t              m_sliceCtrlBufNum;      //!<Slice control Buffer Number
     uint32_t              m_decProcessingType;    //!<Decode Processing type
     CodechalSetting      *m_codechalSettings = nullptr;    //!<Codechal Settings
+    bool                  m_userptrBitstream = false;      //!<Import page aligned slice data of application without copy
+    uint32_t              m_lastFrameSliceDataNum = 0;     //!<Slice data buffer number of previous frame
     static const uint32_t m_decDefaultMaxWidth = 4096;
     static const uint32_t m_decDefaultMaxHeight = 4096;
 
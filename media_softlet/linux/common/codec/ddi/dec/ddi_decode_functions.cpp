@@ -196,6 +196,7 @@ VAStatus DdiDecodeFunctions::CreateContext(
 
     decCtx->pMediaCtx   = mediaCtx;
     decCtx->m_ddiDecodeNext = ddiDecode;
+    ddiDecode->InitUserSetting(mediaCtx);
 
     MOS_CONTEXT mosCtx = {};
     mosCtx.bufmgr                = mediaCtx->pDrmBufMgr;
@@ -33,6 +33,7 @@
 #include "media_libva_interface_next.h"
 #include "ddi_libva_decoder_specific.h"
 #include "ddi_decode_trace_specific.h"
+#include "ddi_decode_slice_translator.h"
 
 namespace decode
 {
@@ -44,7 +45,6 @@ VAStatus DdiDecodeHevc::ParseSliceParams(
 {
     DDI_CODEC_FUNC_ENTER;
 
-    VASliceParameterBufferHEVC *slc     = slcParam;
     VASliceParameterBufferBase *slcBase = (VASliceParameterBufferBase *)slcParam;
     bool isHevcRext = IsRextProfile();
     bool isHevcScc  = IsSccProfile();
@@ -60,7 +60,6 @@ VAStatus DdiDecodeHevc::ParseSliceParams(
         codecSclParamsRext = (PCODEC_HEVC_EXT_SLICE_PARAMS)(m_decodeCtx->DecodeParams.m_extSliceParams);
         codecSclParamsRext += m_decodeCtx->DecodeParams.m_numSlices;
         slcExtension = (VASliceParameterBufferHEVCExtension *)slcParam;
-        slc     = &slcExtension->base;
         slcRext = &slcExtension->rext;
     }
      
@@ -77,133 +76,140 @@ VAStatus DdiDecodeHevc::ParseSliceParams(
     }
 
     uint32_t sliceBaseOffset = GetBsBufOffset(m_groupIndex);
-    uint32_t i, j, slcCount;
-    for (slcCount = 0; slcCount < numSlices; slcCount++)
-    {
-        if (m_decodeCtx->bShortFormatInUse)
+    bool     shortFormat     = m_decodeCtx->bShortFormatInUse;
+
+    // Each slice is translated from its own index, so ranges are independent
+    auto translateSlices = [&](uint32_t begin, uint32_t end) -> VAStatus {
+        uint32_t i, j, slcCount;
+        if (shortFormat)
         {
-            codecSlcParams->slice_data_size   = slcBase->slice_data_size;
-            codecSlcParams->slice_data_offset = sliceBaseOffset + slcBase->slice_data_offset;
-            if (slcBase->slice_data_flag)
+            for (slcCount = begin; slcCount < end; slcCount++)
             {
-                DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
+                VASliceParameterBufferBase *slcShort  = slcBase + slcCount;
+                PCODEC_HEVC_SLICE_PARAMS    codecSlc  = codecSlcParams + slcCount;
+                codecSlc->slice_data_size   = slcShort->slice_data_size;
+                codecSlc->slice_data_offset = sliceBaseOffset + slcShort->slice_data_offset;
+                if (slcShort->slice_data_flag)
+                {
+                    DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
+                }
             }
-            slcBase++;
+            return VA_STATUS_SUCCESS;
         }
-        else
+
+        for (slcCount = begin; slcCount < end; slcCount++)
         {
-            codecSlcParams->slice_data_size   = slc->slice_data_size;
-            codecSlcParams->slice_data_offset = sliceBaseOffset + slc->slice_data_offset;
-            if (slcBase->slice_data_flag)
+            VASliceParameterBufferHEVC *slc      = isHevcRext ? &slcExtension[slcCount].base : slcParam + slcCount;
+            PCODEC_HEVC_SLICE_PARAMS    codecSlc = codecSlcParams + slcCount;
+
+            codecSlc->slice_data_size   = slc->slice_data_size;
+            codecSlc->slice_data_offset = sliceBaseOffset + slc->slice_data_offset;
+            if (slc->slice_data_flag)
             {
                 DDI_CODEC_NORMALMESSAGE("The whole slice is not in the bitstream buffer for this Execute call");
             }
 
-            codecSlcParams->ByteOffsetToSliceData = slc->slice_data_byte_offset;
-            codecSlcParams->NumEmuPrevnBytesInSliceHdr = slc->slice_data_num_emu_prevn_bytes;
-            codecSlcParams->slice_segment_address = slc->slice_segment_address;
+            codecSlc->ByteOffsetToSliceData = slc->slice_data_byte_offset;
+            codecSlc->NumEmuPrevnBytesInSliceHdr = slc->slice_data_num_emu_prevn_bytes;
+            codecSlc->slice_segment_address = slc->slice_segment_address;
 
             for (i = 0; i < 2; i++)
             {
                 for (j = 0; j < CODEC_MAX_NUM_REF_FRAME_HEVC; j++)
                 {
-                    codecSlcParams->RefPicList[i][j].FrameIdx = (slc->RefPicList[i][j] == 0xff) ? 0x7f : slc->RefPicList[i][j];
+                    codecSlc->RefPicList[i][j].FrameIdx = (slc->RefPicList[i][j] == 0xff) ? 0x7f : slc->RefPicList[i][j];
                 }
             }
 
-            codecSlcParams->LongSliceFlags.value           = slc->LongSliceFlags.value;
-            codecSlcParams->collocated_ref_idx             = slc->collocated_ref_idx;
-            codecSlcParams->num_ref_idx_l0_active_minus1   = slc->num_ref_idx_l0_active_minus1;
-            codecSlcParams->num_ref_idx_l1_active_minus1   = slc->num_ref_idx_l1_active_minus1;
-            codecSlcParams->slice_qp_delta                 = slc->slice_qp_delta;
-            codecSlcParams->slice_cb_qp_offset             = slc->slice_cb_qp_offset;
-            codecSlcParams->slice_cr_qp_offset             = slc->slice_cr_qp_offset;
-            codecSlcParams->slice_beta_offset_div2         = slc->slice_beta_offset_div2;
-            codecSlcParams->slice_tc_offset_div2           = slc->slice_tc_offset_div2;
-            codecSlcParams->luma_log2_weight_denom         = slc->luma_log2_weight_denom;
-            codecSlcParams->delta_chroma_log2_weight_denom = slc->delta_chroma_log2_weight_denom;
-
-            MOS_SecureMemcpy(codecSlcParams->delta_luma_weight_l0,
+            codecSlc->LongSliceFlags.value           = slc->LongSliceFlags.value;
+            codecSlc->collocated_ref_idx             = slc->collocated_ref_idx;
+            codecSlc->num_ref_idx_l0_active_minus1   = slc->num_ref_idx_l0_active_minus1;
+            codecSlc->num_ref_idx_l1_active_minus1   = slc->num_ref_idx_l1_active_minus1;
+            codecSlc->slice_qp_delta                 = slc->slice_qp_delta;
+            codecSlc->slice_cb_qp_offset             = slc->slice_cb_qp_offset;
+            codecSlc->slice_cr_qp_offset             = slc->slice_cr_qp_offset;
+            codecSlc->slice_beta_offset_div2         = slc->slice_beta_offset_div2;
+            codecSlc->slice_tc_offset_div2           = slc->slice_tc_offset_div2;
+            codecSlc->luma_log2_weight_denom         = slc->luma_log2_weight_denom;
+            codecSlc->delta_chroma_log2_weight_denom = slc->delta_chroma_log2_weight_denom;
+
+            MOS_SecureMemcpy(codecSlc->delta_luma_weight_l0,
                 15,
                 slc->delta_luma_weight_l0,
                 15);
-            MOS_SecureMemcpy(codecSlcParams->delta_luma_weight_l1,
+            MOS_SecureMemcpy(codecSlc->delta_luma_weight_l1,
                 15,
                 slc->delta_luma_weight_l1,
                 15);
 
-            MOS_SecureMemcpy(codecSlcParams->delta_chroma_weight_l0,
+            MOS_SecureMemcpy(codecSlc->delta_chroma_weight_l0,
                 15 * 2,
                 slc->delta_chroma_weight_l0,
                 15 * 2);
-            MOS_SecureMemcpy(codecSlcParams->delta_chroma_weight_l1,
+            MOS_SecureMemcpy(codecSlc->delta_chroma_weight_l1,
                 15 * 2,
                 slc->delta_chroma_weight_l1,
                 15 * 2);
-            codecSlcParams->five_minus_max_num_merge_cand = slc->five_minus_max_num_merge_cand;
-            codecSlcParams->num_entry_point_offsets       = slc->num_entry_point_offsets;
-            codecSlcParams->EntryOffsetToSubsetArray      = slc->entry_offset_to_subset_array;
+            codecSlc->five_minus_max_num_merge_cand = slc->five_minus_max_num_merge_cand;
+            codecSlc->num_entry_point_offsets       = slc->num_entry_point_offsets;
+            codecSlc->EntryOffsetToSubsetArray      = slc->entry_offset_to_subset_array;
 
             if (!isHevcRext)
             {
-                MOS_SecureMemcpy(codecSlcParams->luma_offset_l0,
+                MOS_SecureMemcpy(codecSlc->luma_offset_l0,
                     15,
                     slc->luma_offset_l0,
                     15);
-                MOS_SecureMemcpy(codecSlcParams->luma_offset_l1,
+                MOS_SecureMemcpy(codecSlc->luma_offset_l1,
                     15,
                     slc->luma_offset_l1,
                     15);
-                MOS_SecureMemcpy(codecSlcParams->ChromaOffsetL0,
+                MOS_SecureMemcpy(codecSlc->ChromaOffsetL0,
                     15 * 2,
                     slc->ChromaOffsetL0,
                     15 * 2);
-                MOS_SecureMemcpy(codecSlcParams->ChromaOffsetL1,
+                MOS_SecureMemcpy(codecSlc->ChromaOffsetL1,
                     15 * 2,
                     slc->ChromaOffsetL1,
                     15 * 2);
-            
-                slc++;
             }
             else
             {
-                MOS_SecureMemcpy(codecSclParamsRext->luma_offset_l0,
+                VASliceParameterBufferHEVCRext *slcExt   = &slcExtension[slcCount].rext;
+                PCODEC_HEVC_EXT_SLICE_PARAMS    codecExt = codecSclParamsRext + slcCount;
+
+                MOS_SecureMemcpy(codecExt->luma_offset_l0,
                     15 * sizeof(int16_t),
-                    slcRext->luma_offset_l0,
+                    slcExt->luma_offset_l0,
                     15 * sizeof(int16_t));
-                MOS_SecureMemcpy(codecSclParamsRext->luma_offset_l1,
+                MOS_SecureMemcpy(codecExt->luma_offset_l1,
                     15 * sizeof(int16_t),
-                    slcRext->luma_offset_l1,
+                    slcExt->luma_offset_l1,
                     15 * sizeof(int16_t));
-                MOS_SecureMemcpy(codecSclParamsRext->ChromaOffsetL0,
+                MOS_SecureMemcpy(codecExt->ChromaOffsetL0,
                     15 * 2 * sizeof(int16_t),
-                    slcRext->ChromaOffsetL0,
+                    slcExt->ChromaOffsetL0,
                     15 * 2 * sizeof(int16_t));
-                MOS_SecureMemcpy(codecSclParamsRext->ChromaOffsetL1,
+                MOS_SecureMemcpy(codecExt->ChromaOffsetL1,
                     15 * 2 * sizeof(int16_t),
-                    slcRext->ChromaOffsetL1,
+                    slcExt->ChromaOffsetL1,
                     15 * 2 * sizeof(int16_t));
-                    
-                codecSclParamsRext->cu_chroma_qp_offset_enabled_flag = slcRext->slice_ext_flags.bits.cu_chroma_qp_offset_enabled_flag;
+
+                codecExt->cu_chroma_qp_offset_enabled_flag = slcExt->slice_ext_flags.bits.cu_chroma_qp_offset_enabled_flag;
 
                 if (isHevcScc)
                 {
-                    codecSclParamsRext->use_integer_mv_flag    = slcRext->slice_ext_flags.bits.use_integer_mv_flag;
-                    codecSclParamsRext->slice_act_y_qp_offset  = slcRext->slice_act_y_qp_offset;
-                    codecSclParamsRext->slice_act_cb_qp_offset = slcRext->slice_act_cb_qp_offset;
-                    codecSclParamsRext->slice_act_cr_qp_offset = slcRext->slice_act_cr_qp_offset;
+                    codecExt->use_integer_mv_flag    = slcExt->slice_ext_flags.bits.use_integer_mv_flag;
+                    codecExt->slice_act_y_qp_offset  = slcExt->slice_act_y_qp_offset;
+                    codecExt->slice_act_cb_qp_offset = slcExt->slice_act_cb_qp_offset;
+                    codecExt->slice_act_cr_qp_offset = slcExt->slice_act_cr_qp_offset;
                 }
-                
-                codecSclParamsRext++;
-                slcExtension++;
-                slc     = &slcExtension->base;
-                slcRext = &slcExtension->rext;
             }
         }
-        codecSlcParams++;
-    }
+        return VA_STATUS_SUCCESS;
+    };
 
-    return VA_STATUS_SUCCESS;
+    return DdiDecodeSliceTranslator::Translate(numSlices, translateSlices);
 }
 
 VAStatus DdiDecodeHevc::ParsePicParams(
@@ -0,0 +1,93 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     ddi_decode_slice_translator.cpp
+//! \brief    Translation of VA slice parameter arrays for DDI decoders
+//!
+
+#include "ddi_decode_slice_translator.h"
+#include "mos_worker_pool.h"
+
+namespace decode
+{
+constexpr uint32_t DdiDecodeSliceTranslator::m_parallelSliceNum;
+constexpr uint32_t DdiDecodeSliceTranslator::m_minSlicesPerRange;
+constexpr uint32_t DdiDecodeSliceTranslator::m_maxThreadNum;
+
+//!
+//! \brief  Worker pool shared by all decode contexts of the process
+//!
+static MosWorkerPool &GetSliceWorkerPool()
+{
+    static MosWorkerPool pool(DdiDecodeSliceTranslator::m_maxThreadNum);
+    return pool;
+}
+
+uint32_t DdiDecodeSliceTranslator::GetRangeNum(uint32_t numSlices, uint32_t threadNum)
+{
+    if (numSlices <= m_parallelSliceNum || threadNum <= 1)
+    {
+        return 1;
+    }
+
+    uint32_t rangeNum = (numSlices + m_minSlicesPerRange - 1) / m_minSlicesPerRange;
+    return (rangeNum < threadNum) ? rangeNum : threadNum;
+}
+
+VAStatus DdiDecodeSliceTranslator::Translate(uint32_t numSlices, const TranslateRange &translate)
+{
+    if (numSlices <= m_parallelSliceNum)
+    {
+        return translate(0, numSlices);
+    }
+
+    MosWorkerPool &pool = GetSliceWorkerPool();
+
+    uint32_t rangeNum = GetRangeNum(numSlices, pool.GetThreadNum());
+    if (rangeNum <= 1)
+    {
+        return translate(0, numSlices);
+    }
+
+    // Ranges are contiguous so that each thread streams through its own part of both arrays
+    VAStatus           status[m_maxThreadNum];
+    MosWorkerPool::Job job = [&](uint32_t rangeIdx) {
+        uint32_t begin   = (uint32_t)((uint64_t)numSlices * rangeIdx / rangeNum);
+        uint32_t end     = (uint32_t)((uint64_t)numSlices * (rangeIdx + 1) / rangeNum);
+        status[rangeIdx] = translate(begin, end);
+    };
+
+    if (!pool.TryRun(rangeNum, job))
+    {
+        return translate(0, numSlices);
+    }
+
+    for (uint32_t i = 0; i < rangeNum; i++)
+    {
+        if (status[i] != VA_STATUS_SUCCESS)
+        {
+            return status[i];
+        }
+    }
+    return VA_STATUS_SUCCESS;
+}
+}  // namespace decode
@@ -0,0 +1,72 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     ddi_decode_slice_translator.h
+//! \brief    Translation of VA slice parameter arrays for DDI decoders
+//! \details  Slice parameters of one buffer are translated in contiguous ranges.
+//!           Buffers with many slices are split into one range per thread of a
+//!           small worker pool shared by all decode contexts of the process.
+//!
+
+#ifndef __DDI_DECODE_SLICE_TRANSLATOR_H__
+#define __DDI_DECODE_SLICE_TRANSLATOR_H__
+
+#include <stdint.h>
+#include <functional>
+#include <va/va.h>
+
+namespace decode
+{
+class DdiDecodeSliceTranslator
+{
+public:
+    //!
+    //! \brief  Translate slices [begin, end) of the buffer
+    //!         Ranges may run concurrently, so it must only write to its own slices
+    //!
+    typedef std::function<VAStatus(uint32_t begin, uint32_t end)> TranslateRange;
+
+    //!
+    //! \brief    Translate slice 0 ~ numSlices - 1
+    //! \details  Runs on calling thread if slices are no more than m_parallelSliceNum,
+    //!           or another decode context is using the workers
+    //! \param    [in] numSlices
+    //!           Number of slices in buffer
+    //! \param    [in] translate
+    //!           Translation of one range
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if all ranges succeed, else status of first failed range
+    //!
+    static VAStatus Translate(uint32_t numSlices, const TranslateRange &translate);
+
+    //!
+    //! \brief    Get number of ranges the slices are split into
+    //!
+    static uint32_t GetRangeNum(uint32_t numSlices, uint32_t threadNum);
+
+    static constexpr uint32_t m_parallelSliceNum  = 64;  //!< Slices of one buffer above which ranges run in parallel
+    static constexpr uint32_t m_minSlicesPerRange = 32;  //!< Less slices do not pay for waking up a worker
+    static constexpr uint32_t m_maxThreadNum      = 4;   //!< Max threads of one buffer, including calling thread
+};
+}  // namespace decode
+
+#endif  // __DDI_DECODE_SLICE_TRANSLATOR_H__
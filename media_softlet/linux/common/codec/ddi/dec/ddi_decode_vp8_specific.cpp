@@ -286,6 +286,17 @@ VAStatus DdiDecodeVp8::ParseProbabilityData(
     }
 }
 
+VAStatus DdiDecodeVp8::BeginPicture(
+    VADriverContextP ctx,
+    VAContextID      context,
+    VASurfaceID      renderTarget)
+{
+    // Frame head of previous picture must never be parsed for this one
+    m_frameHead.clear();
+
+    return DdiDecodeBase::BeginPicture(ctx, context, renderTarget);
+}
+
 VAStatus DdiDecodeVp8::RenderPicture(
     VADriverContextP ctx,
     VAContextID      context,
@@ -330,6 +341,13 @@ VAStatus DdiDecodeVp8::RenderPicture(
             }
 
             MediaLibvaCommonNext::MediaBufferToMosResource(m_decodeCtx->BufMgr.pBitStreamBuffObject[index], &m_decodeCtx->BufMgr.resBitstreamBuffer);
+
+            // Copy frame head while data is mapped, so HAL parses it without locking the bitstream buffer
+            if (m_decodeCtx->DecodeParams.m_bitstreamLockingInUse && m_decodeCtx->DecodeParams.m_dataSize == 0)
+            {
+                uint32_t headSize = CodecVp8GetFrameHeadSize((uint8_t *)data, dataSize);
+                m_frameHead.assign((uint8_t *)data, (uint8_t *)data + headSize);
+            }
             m_decodeCtx->DecodeParams.m_dataSize += dataSize;
             break;
         }
@@ -656,6 +674,10 @@ VAStatus DdiDecodeVp8::SetDecodeParams()
     DDI_CODEC_CHK_RET(DdiDecodeBase::SetDecodeParams(),"SetDecodeParams failed!");
     DDI_CODEC_COM_BUFFER_MGR *bufMgr = &(m_decodeCtx->BufMgr);
     (&m_decodeCtx->DecodeParams)->m_coefProbBuffer = &(bufMgr->Codec_Param.Codec_Param_VP8.resProbabilityDataBuffer);
+
+    bool hostHead = m_decodeCtx->DecodeParams.m_bitstreamLockingInUse && !m_frameHead.empty();
+    m_decodeCtx->DecodeParams.m_bitstreamHostData = hostHead ? m_frameHead.data() : nullptr;
+    m_decodeCtx->DecodeParams.m_bitstreamHostSize = hostHead ? (uint32_t)m_frameHead.size() : 0;
     return  VA_STATUS_SUCCESS;
 }
 
@@ -27,6 +27,7 @@
 #ifndef __DDI_DECODE_VP8_SPECIFIC_H__
 #define __DDI_DECODE_VP8_SPECIFIC_H__
 
+#include <vector>
 #include "ddi_decode_base_specific.h"
 
 struct _DDI_MEDIA_BUFFER;
@@ -50,6 +51,11 @@ public:
     virtual ~DdiDecodeVp8(){};
 
     // inherited virtual function
+    virtual VAStatus BeginPicture(
+        VADriverContextP ctx,
+        VAContextID      context,
+        VASurfaceID      renderTarget) override;
+
     virtual void DestroyContext (
         VADriverContextP ctx) override;
 
@@ -152,6 +158,11 @@ private:
     MOS_RESOURCE m_resNoneRegGoldenRefFrame;
     MOS_RESOURCE m_resNoneRegAltRefFrame;
 
+    //! Host copy of frame head for HAL parsing, empty if not needed. VA-API passes the bool
+    //! decoder state after the frame head in the picture parameters, so the Linux DDI never
+    //! sets m_bitstreamLockingInUse and the copy is only taken if a caller asks HAL to parse.
+    std::vector<uint8_t> m_frameHead;
+
     MEDIA_CLASS_DEFINE_END(decode__DdiDecodeVp8)
 };
 } //namespace decode
@@ -30,6 +30,7 @@
 #include "mos_solo_generic.h"
 #include "media_libva_interface_next.h"
 #include "codec_def_common_vvc.h"
+#include "ddi_decode_slice_translator.h"
 
 namespace decode
 {
@@ -1214,99 +1215,105 @@ VAStatus DdiDecodeVvc::ParseSliceParams(
     MOS_ZeroMemory(pVvcSliceParams, (numSlices * sizeof(CodecVvcSliceParams)));
 
     uint32_t sliceBaseOffset = GetBsBufOffset(m_groupIndex);
-    for (uint32_t iSlcCount = 0; iSlcCount < numSlices; iSlcCount++)
-    {
-        pVvcSliceParams->m_bSNALunitDataLocation    = sliceBaseOffset + slcParam->slice_data_offset;
-        pVvcSliceParams->m_sliceBytesInBuffer       = slcParam->slice_data_size;
-        pVvcSliceParams->m_shSubpicId               = slcParam->sh_subpic_id;
-        pVvcSliceParams->m_shSliceAddress           = slcParam->sh_slice_address;
-        pVvcSliceParams->m_shNumTilesInSliceMinus1  = slcParam->sh_num_tiles_in_slice_minus1;
-        pVvcSliceParams->m_shSliceType              = slcParam->sh_slice_type;
-        pVvcSliceParams->m_shNumAlfApsIdsLuma       = slcParam->sh_num_alf_aps_ids_luma;
-
-        MOS_SecureMemcpy(pVvcSliceParams->m_shAlfApsIdLuma, 7, slcParam->sh_alf_aps_id_luma, 7);
-
-        pVvcSliceParams->m_shAlfApsIdChroma         = slcParam->sh_alf_aps_id_chroma;
-        pVvcSliceParams->m_shAlfCcCbApsId           = slcParam->sh_alf_cc_cb_aps_id;
-        pVvcSliceParams->m_shAlfCcCrApsId           = slcParam->sh_alf_cc_cr_aps_id;
-
-        MOS_SecureMemcpy(pVvcSliceParams->m_numRefIdxActive, 2, slcParam->NumRefIdxActive, 2);
-
-        pVvcSliceParams->m_shCollocatedRefIdx       = slcParam->sh_collocated_ref_idx;
-        pVvcSliceParams->m_sliceQpY                 = slcParam->SliceQpY;
-        pVvcSliceParams->m_shCbQpOffset             = slcParam->sh_cb_qp_offset;
-        pVvcSliceParams->m_shCrQpOffset             = slcParam->sh_cr_qp_offset;
-        pVvcSliceParams->m_shJointCbcrQpOffset      = slcParam->sh_joint_cbcr_qp_offset;
-        pVvcSliceParams->m_shLumaBetaOffsetDiv2     = slcParam->sh_luma_beta_offset_div2;
-        pVvcSliceParams->m_shLumaTcOffsetDiv2       = slcParam->sh_luma_tc_offset_div2;
-        pVvcSliceParams->m_shCbBetaOffsetDiv2       = slcParam->sh_cb_beta_offset_div2;
-        pVvcSliceParams->m_shCbTcOffsetDiv2         = slcParam->sh_cb_tc_offset_div2;
-        pVvcSliceParams->m_shCrBetaOffsetDiv2       = slcParam->sh_cr_beta_offset_div2;
-        pVvcSliceParams->m_shCrTcOffsetDiv2         = slcParam->sh_cr_tc_offset_div2;
-        pVvcSliceParams->m_byteOffsetToSliceData    = slcParam->slice_data_byte_offset;
-
-        // Set up RefPicList[2][vvcMaxNumRefFrame]
-        for (auto i = 0; i < 2; i++)
+
+    // Each slice is translated from its own index, so ranges are independent
+    auto translateSlices = [&](uint32_t begin, uint32_t end) -> VAStatus {
+        for (uint32_t iSlcCount = begin; iSlcCount < end; iSlcCount++)
         {
-            for (auto j = 0; j < vvcMaxNumRefFrame; j++)
+            VASliceParameterBufferVVC *slc         = slcParam + iSlcCount;
+            CodecVvcSliceParams       *pSliceParam = pVvcSliceParams + iSlcCount;
+
+            pSliceParam->m_bSNALunitDataLocation    = sliceBaseOffset + slc->slice_data_offset;
+            pSliceParam->m_sliceBytesInBuffer       = slc->slice_data_size;
+            pSliceParam->m_shSubpicId               = slc->sh_subpic_id;
+            pSliceParam->m_shSliceAddress           = slc->sh_slice_address;
+            pSliceParam->m_shNumTilesInSliceMinus1  = slc->sh_num_tiles_in_slice_minus1;
+            pSliceParam->m_shSliceType              = slc->sh_slice_type;
+            pSliceParam->m_shNumAlfApsIdsLuma       = slc->sh_num_alf_aps_ids_luma;
+
+            MOS_SecureMemcpy(pSliceParam->m_shAlfApsIdLuma, 7, slc->sh_alf_aps_id_luma, 7);
+
+            pSliceParam->m_shAlfApsIdChroma         = slc->sh_alf_aps_id_chroma;
+            pSliceParam->m_shAlfCcCbApsId           = slc->sh_alf_cc_cb_aps_id;
+            pSliceParam->m_shAlfCcCrApsId           = slc->sh_alf_cc_cr_aps_id;
+
+            MOS_SecureMemcpy(pSliceParam->m_numRefIdxActive, 2, slc->NumRefIdxActive, 2);
+
+            pSliceParam->m_shCollocatedRefIdx       = slc->sh_collocated_ref_idx;
+            pSliceParam->m_sliceQpY                 = slc->SliceQpY;
+            pSliceParam->m_shCbQpOffset             = slc->sh_cb_qp_offset;
+            pSliceParam->m_shCrQpOffset             = slc->sh_cr_qp_offset;
+            pSliceParam->m_shJointCbcrQpOffset      = slc->sh_joint_cbcr_qp_offset;
+            pSliceParam->m_shLumaBetaOffsetDiv2     = slc->sh_luma_beta_offset_div2;
+            pSliceParam->m_shLumaTcOffsetDiv2       = slc->sh_luma_tc_offset_div2;
+            pSliceParam->m_shCbBetaOffsetDiv2       = slc->sh_cb_beta_offset_div2;
+            pSliceParam->m_shCbTcOffsetDiv2         = slc->sh_cb_tc_offset_div2;
+            pSliceParam->m_shCrBetaOffsetDiv2       = slc->sh_cr_beta_offset_div2;
+            pSliceParam->m_shCrTcOffsetDiv2         = slc->sh_cr_tc_offset_div2;
+            pSliceParam->m_byteOffsetToSliceData    = slc->slice_data_byte_offset;
+
+            // Set up RefPicList[2][vvcMaxNumRefFrame]
+            for (auto i = 0; i < 2; i++)
             {
-                PCODEC_PICTURE pCodecHalPic = &pVvcSliceParams->m_refPicList[i][j];
-                pCodecHalPic->FrameIdx = (slcParam->RefPicList[i][j] == 0xff) ? CODEC_MAX_DPB_NUM_VVC : slcParam->RefPicList[i][j];
-                if (pCodecHalPic->FrameIdx >= vvcMaxNumRefFrame)
-                {
-                    pCodecHalPic->PicFlags = PICTURE_INVALID;
-                }
-                else
+                for (auto j = 0; j < vvcMaxNumRefFrame; j++)
                 {
-                    VAPictureVVC vaPic = {};
-                    vaPic.flags = m_refListFlags[pCodecHalPic->FrameIdx];
-                    SetupCodecPicture(mediaCtx,
-                        &m_decodeCtx->RTtbl,
-                        pCodecHalPic,
-                        vaPic,
-                        VvcPicEntryRefPicList);
+                    PCODEC_PICTURE pCodecHalPic = &pSliceParam->m_refPicList[i][j];
+                    pCodecHalPic->FrameIdx = (slc->RefPicList[i][j] == 0xff) ? CODEC_MAX_DPB_NUM_VVC : slc->RefPicList[i][j];
+                    if (pCodecHalPic->FrameIdx >= vvcMaxNumRefFrame)
+                    {
+                        pCodecHalPic->PicFlags = PICTURE_INVALID;
+                    }
+                    else
+                    {
+                        VAPictureVVC vaPic = {};
+                        vaPic.flags = m_refListFlags[pCodecHalPic->FrameIdx];
+                        SetupCodecPicture(mediaCtx,
+                            &m_decodeCtx->RTtbl,
+                            pCodecHalPic,
+                            vaPic,
+                            VvcPicEntryRefPicList);
+                    }
                 }
             }
-        }
-
-        DDI_CODEC_CHK_RET(ParseWeightedPredInfo(pVvcSliceParams,&slcParam->WPInfo), "Parse Weighted Pred Info failed");
-        pVvcSliceParams->m_longSliceFlags.m_value = slcParam->sh_flags.value;
 
-        bool noBackWardPredFlag = true;
-        uint8_t  refIdx = 0;
-        if (pVvcSliceParams->m_shSliceType != vvcSliceI)
-        {
-            for (refIdx = 0; refIdx < pVvcSliceParams->m_numRefIdxActive[0] && noBackWardPredFlag; refIdx++)
-            {
-                uint8_t refPicIdx = pVvcSliceParams->m_refPicList[0][refIdx].FrameIdx;
+            DDI_CODEC_CHK_RET(ParseWeightedPredInfo(pSliceParam,&slc->WPInfo), "Parse Weighted Pred Info failed");
+            pSliceParam->m_longSliceFlags.m_value = slc->sh_flags.value;
 
-                if (refPicIdx < vvcMaxNumRefFrame && pVvcPicParams->m_refFramePocList[refPicIdx] > pVvcPicParams->m_picOrderCntVal)
-                {
-                    noBackWardPredFlag = false;
-                }
-            }
-            if (pVvcSliceParams->m_shSliceType == vvcSliceB)
+            bool noBackWardPredFlag = true;
+            uint8_t  refIdx = 0;
+            if (pSliceParam->m_shSliceType != vvcSliceI)
             {
-                for (refIdx = 0; refIdx < pVvcSliceParams->m_numRefIdxActive[1] && noBackWardPredFlag; refIdx++)
+                for (refIdx = 0; refIdx < pSliceParam->m_numRefIdxActive[0] && noBackWardPredFlag; refIdx++)
                 {
-                    uint8_t refPicIdx = pVvcSliceParams->m_refPicList[1][refIdx].FrameIdx;
+                    uint8_t refPicIdx = pSliceParam->m_refPicList[0][refIdx].FrameIdx;
+
                     if (refPicIdx < vvcMaxNumRefFrame && pVvcPicParams->m_refFramePocList[refPicIdx] > pVvcPicParams->m_picOrderCntVal)
                     {
                         noBackWardPredFlag = false;
                     }
                 }
+                if (pSliceParam->m_shSliceType == vvcSliceB)
+                {
+                    for (refIdx = 0; refIdx < pSliceParam->m_numRefIdxActive[1] && noBackWardPredFlag; refIdx++)
+                    {
+                        uint8_t refPicIdx = pSliceParam->m_refPicList[1][refIdx].FrameIdx;
+                        if (refPicIdx < vvcMaxNumRefFrame && pVvcPicParams->m_refFramePocList[refPicIdx] > pVvcPicParams->m_picOrderCntVal)
+                        {
+                            noBackWardPredFlag = false;
+                        }
+                    }
+                }
             }
+            else
+            {
+                noBackWardPredFlag = false;
+            }
+            pSliceParam->m_longSliceFlags.m_fields.m_noBackwardPredFlag = noBackWardPredFlag;
         }
-        else
-        {
-            noBackWardPredFlag = false;
-        }
-        pVvcSliceParams->m_longSliceFlags.m_fields.m_noBackwardPredFlag = noBackWardPredFlag;
-        slcParam++;
-        pVvcSliceParams++;
-    }
+        return VA_STATUS_SUCCESS;
+    };
 
-    return VA_STATUS_SUCCESS;
+    return DdiDecodeSliceTranslator::Translate(numSlices, translateSlices);
 }
 
 
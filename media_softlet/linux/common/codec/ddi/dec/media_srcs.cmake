@@ -22,12 +22,14 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_functions.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_base_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_trace_specific.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_slice_translator.cpp
 )
 
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_functions.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_base_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_trace_specific.h
+    ${CMAKE_CURRENT_LIST_DIR}/ddi_decode_slice_translator.h
 )
 
 if(${AVC_Decode_Supported} STREQUAL "yes")
@@ -377,11 +377,8 @@ VAStatus DdiEncodeAvc::ParseMiscParamMultiPassFrameSize(void *data)
         {
             return VA_STATUS_ERROR_INVALID_PARAMETER;
         }
-        if (picParams->pDeltaQp != nullptr)
-        {
-            MOS_FreeMemory(picParams->pDeltaQp);
-        }
-        picParams->pDeltaQp = (uint8_t *)MOS_AllocAndZeroMemory(sizeof(uint8_t) * picParams->dwNumPasses);
+        // Released with frame arena at EndPicture
+        picParams->pDeltaQp = m_frameArena.AllocateArray<uint8_t>(picParams->dwNumPasses);
         if (!picParams->pDeltaQp)
         {
             return VA_STATUS_ERROR_INVALID_PARAMETER;
@@ -1934,7 +1931,11 @@ MOS_STATUS DdiEncodeAvc::CheckPackedSlcHeaderData(
     // Force first_mb_in_slice to 0 for AVC VDENC
     uint32_t LeftBitSize = InBitSize - InBits.GetBitOffset();
     OutBitSize = LeftBitSize + HdrBitSize + 1;
-    *ppOutSlcHdr = MOS_AllocAndZeroMemory((OutBitSize + 7) / 8);
+    *ppOutSlcHdr = m_frameArena.Allocate((OutBitSize + 7) / 8);
+    if (nullptr == *ppOutSlcHdr)
+    {
+        return MOS_STATUS_NO_SPACE;
+    }
 
     AvcOutBits OutBits((uint8_t*)(*ppOutSlcHdr), OutBitSize);
 
@@ -2005,12 +2006,9 @@ VAStatus DdiEncodeAvc::ParsePackedHeaderData(void *ptr)
             (uint8_t *)(temp_ptr ? temp_ptr : ptr),
             hdrDataSize);
 
-        if (temp_ptr)
-        {
-            MOS_FreeMemory(temp_ptr);
-            temp_size = 0;
-            temp_ptr = NULL;
-        }
+        // temp_ptr is in frame arena, released at EndPicture
+        temp_size = 0;
+        temp_ptr  = NULL;
 
         if (MOS_STATUS_SUCCESS != status)
         {
@@ -2268,13 +2266,16 @@ uint32_t DdiEncodeAvc::getQMatrixBufferSize()
 
 void DdiEncodeAvc::ClearPicParams()
 {
-    uint8_t ppsIdx = ((PCODEC_AVC_ENCODE_SLICE_PARAMS)(m_encodeCtx->pSliceParams))->pic_parameter_set_id;
-    PCODEC_AVC_ENCODE_PIC_PARAMS  picParams = (PCODEC_AVC_ENCODE_PIC_PARAMS)m_encodeCtx->pPicParams + ppsIdx;
+    PCODEC_AVC_ENCODE_PIC_PARAMS picParams = (PCODEC_AVC_ENCODE_PIC_PARAMS)m_encodeCtx->pPicParams;
+    if (picParams == nullptr)
+    {
+        return;
+    }
 
-    if (picParams != nullptr && picParams->pDeltaQp != nullptr)
+    // Delta QP of any PPS is in frame arena, which is reset after this
+    for (uint32_t i = 0; i < CODEC_AVC_MAX_PPS_NUM; i++)
     {
-        MOS_FreeMemory(picParams->pDeltaQp);
-        picParams->pDeltaQp = nullptr;
+        picParams[i].pDeltaQp = nullptr;
     }
 }
 
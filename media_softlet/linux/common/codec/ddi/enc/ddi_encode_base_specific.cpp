@@ -71,6 +71,9 @@ VAStatus DdiEncodeBase::EndPicture(
 {
     DDI_CODEC_FUNC_ENTER;
 
+    // Frame arena is reset on all returns, after ClearPicParams dropped its pointers
+    DdiEncodeFrameArena::ScopedReset frameArenaReset(m_frameArena);
+
     DDI_CODEC_CHK_NULL(ctx, "nullptr ctx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
     PDDI_MEDIA_CONTEXT mediaCtx = GetMediaContext(ctx);
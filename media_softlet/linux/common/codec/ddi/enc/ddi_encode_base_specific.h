@@ -30,6 +30,7 @@
 #include <va/va.h>
 #include "ddi_codec_base_specific.h"
 #include "ddi_libva_encoder_specific.h"
+#include "ddi_encode_frame_arena.h"
 #include "codechal_setting.h"
 #include "media_libva_caps_next.h"
 namespace encode
@@ -336,6 +337,8 @@ public:
     ChromaFormat m_chromaFormat     = yuv420;  //!< HCP chroma format.
     CodechalSetting    *m_codechalSettings = nullptr;    //!< Codechal Settings
 protected:
+    DdiEncodeFrameArena m_frameArena;                    //!< Parameters living until EndPicture, reset in EndPicture
+
     //!
     //! \brief    Do Encode in codechal
     //! \details  Prepare encode parameters, surfaces and buffers and submit
@@ -0,0 +1,100 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     ddi_encode_frame_arena.cpp
+//! \brief    Implements the per frame memory arena of DDI encode context
+//!
+
+#include "ddi_encode_frame_arena.h"
+#include "mos_utilities.h"
+
+namespace encode
+{
+
+DdiEncodeFrameArena::~DdiEncodeFrameArena()
+{
+    FreeBlocks();
+}
+
+void DdiEncodeFrameArena::FreeBlocks()
+{
+    while (m_blocks != nullptr)
+    {
+        Block *next = m_blocks->next;
+        MOS_FreeMemory(m_blocks);
+        m_blocks = next;
+    }
+    m_blockOffset = 0;
+}
+
+void *DdiEncodeFrameArena::Allocate(size_t size)
+{
+    if (size == 0 || size > SIZE_MAX - m_blockHeaderSize - m_alignment)
+    {
+        return nullptr;
+    }
+    size_t alignedSize = (size + m_alignment - 1) & ~(m_alignment - 1);
+
+    if (m_blocks == nullptr || m_blocks->size - m_blockOffset < alignedSize)
+    {
+        // First block is sized by the high-water mark, following ones of
+        // the same frame at least double the current one.
+        size_t blockSize = MOS_MAX(m_minBlockSize, alignedSize);
+        blockSize        = MOS_MAX(blockSize, (m_blocks == nullptr) ? m_highWaterMark : m_blocks->size * 2);
+        blockSize        = (blockSize + m_alignment - 1) & ~(m_alignment - 1);
+
+        Block *block = (Block *)MOS_AllocMemory(m_blockHeaderSize + blockSize);
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+        m_heapAllocCount++;
+
+        block->next   = m_blocks;
+        block->size   = blockSize;
+        m_blocks      = block;
+        m_blockOffset = 0;
+    }
+
+    uint8_t *data = GetBlockData(m_blocks) + m_blockOffset;
+    m_blockOffset += alignedSize;
+    m_frameSize += alignedSize;
+
+    MOS_ZeroMemory(data, size);
+    return data;
+}
+
+void DdiEncodeFrameArena::Reset()
+{
+    m_highWaterMark = MOS_MAX(m_highWaterMark, m_frameSize);
+    m_frameSize     = 0;
+
+    if (m_blocks != nullptr && m_blocks->next != nullptr)
+    {
+        // Frame did not fit in one block, next frame allocates a single
+        // block of high-water mark instead.
+        FreeBlocks();
+    }
+    m_blockOffset = 0;
+}
+
+}  // namespace encode
@@ -0,0 +1,135 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     ddi_encode_frame_arena.h
+//! \brief    Defines the per frame memory arena of DDI encode context
+//! \details  Parameters which only live from RenderPicture to EndPicture are
+//!           allocated from the arena instead of the heap. The arena is reset
+//!           at EndPicture and keeps one block sized by the largest frame, so
+//!           frames after the first ones do not allocate heap memory.
+//!
+
+#ifndef __DDI_ENCODE_FRAME_ARENA_H__
+#define __DDI_ENCODE_FRAME_ARENA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "media_class_trace.h"
+
+namespace encode
+{
+
+class DdiEncodeFrameArena
+{
+public:
+    //!
+    //! \brief    Reset the arena when leaving the scope
+    //!
+    class ScopedReset
+    {
+    public:
+        ScopedReset(DdiEncodeFrameArena &arena) : m_arena(arena) {}
+        ~ScopedReset() { m_arena.Reset(); }
+
+    private:
+        DdiEncodeFrameArena &m_arena;
+
+    MEDIA_CLASS_DEFINE_END(encode__DdiEncodeFrameArena__ScopedReset)
+    };
+
+    DdiEncodeFrameArena() {}
+
+    ~DdiEncodeFrameArena();
+
+    //!
+    //! \brief    Allocate zeroed memory valid until next Reset()
+    //!
+    //! \param    [in] size
+    //!           Size of memory in bytes
+    //!
+    //! \return   void *
+    //!           Pointer to memory aligned to 16 bytes, nullptr if failed
+    //!
+    void *Allocate(size_t size);
+
+    //!
+    //! \brief    Allocate zeroed array valid until next Reset()
+    //!
+    //! \param    [in] count
+    //!           Number of elements
+    //!
+    //! \return   T *
+    //!           Pointer to array, nullptr if failed
+    //!
+    template <typename T>
+    T *AllocateArray(size_t count)
+    {
+        return (count > SIZE_MAX / sizeof(T)) ? nullptr : (T *)Allocate(count * sizeof(T));
+    }
+
+    //!
+    //! \brief    Release all memory allocated in current frame
+    //! \details  Blocks allocated in the frame are merged into one block sized
+    //!           by the high-water mark, which is kept for following frames.
+    //!
+    void Reset();
+
+    //!
+    //! \brief    Get number of heap allocations made by the arena
+    //!
+    uint32_t GetHeapAllocCount() const { return m_heapAllocCount; }
+
+    //!
+    //! \brief    Get max bytes used by one frame
+    //!
+    size_t GetHighWaterMark() const { return m_highWaterMark; }
+
+protected:
+    struct Block
+    {
+        Block  *next;
+        size_t size;  //!< Size of data following the block header
+    };
+
+    uint8_t *GetBlockData(Block *block) { return (uint8_t *)block + m_blockHeaderSize; }
+    void     FreeBlocks();
+
+    static const size_t m_alignment       = 16;
+    static const size_t m_blockHeaderSize = (sizeof(Block) + m_alignment - 1) & ~(m_alignment - 1);
+    static const size_t m_minBlockSize    = 4096;
+
+    Block   *m_blocks         = nullptr;  //!< Current block first
+    size_t   m_blockOffset    = 0;        //!< Used bytes of current block
+    size_t   m_frameSize      = 0;        //!< Bytes allocated in current frame
+    size_t   m_highWaterMark  = 0;
+    uint32_t m_heapAllocCount = 0;
+
+private:
+    DdiEncodeFrameArena(const DdiEncodeFrameArena &) = delete;
+    DdiEncodeFrameArena &operator=(const DdiEncodeFrameArena &) = delete;
+
+MEDIA_CLASS_DEFINE_END(encode__DdiEncodeFrameArena)
+};
+
+}  // namespace encode
+
+#endif  // __DDI_ENCODE_FRAME_ARENA_H__
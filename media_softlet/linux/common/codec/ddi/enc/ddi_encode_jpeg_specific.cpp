@@ -58,9 +58,6 @@ DdiEncodeJpeg::~DdiEncodeJpeg()
 
     MOS_FreeMemory(m_encodeCtx->pbsBuffer);
     m_encodeCtx->pbsBuffer = nullptr;
-
-    MOS_FreeMemory(m_appData);
-    m_appData = nullptr;
 }
 
 VAStatus DdiEncodeJpeg::ContextInitialize(CodechalSetting *codecHalSettings)
@@ -235,6 +232,7 @@ VAStatus DdiEncodeJpeg::ResetAtFrameLevel()
 
     picParams->m_inputSurfaceFormat = ConvertMediaFormatToInputSurfaceFormat(m_encodeCtx->RTtbl.pCurrentRT->format);
 
+    m_appData = nullptr;  // released with frame arena
     m_appDataSize = 0;
     m_appDataTotalSize = 0;
     m_appDataWholeHeader = false;
@@ -462,39 +460,26 @@ VAStatus DdiEncodeJpeg::ParseAppData(void *ptr, int32_t size)
 
     uint32_t prevAppDataSize = m_appDataTotalSize;
 
-    if (m_appData == nullptr)
-    {
-        m_appData = (void *)MOS_AllocAndZeroMemory(size);
+    // App data is only used by current frame, so it is kept in frame arena
+    void *tempAppData = m_frameArena.Allocate((size_t)size + prevAppDataSize);
 
-        if (!m_appData)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
-
-        MOS_SecureMemcpy(m_appData, size, ptr, size);
-    }
-    else  // app data had been sent before
+    if (nullptr == tempAppData)
     {
-        void *tempAppData = (void *)MOS_AllocAndZeroMemory(size + (int32_t)prevAppDataSize);
-
-        if (nullptr == tempAppData)
-        {
-            return VA_STATUS_ERROR_ALLOCATION_FAILED;
-        }
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
 
+    if (prevAppDataSize > 0)  // app data had been sent before
+    {
         // Copy over previous app data to a new location
         MOS_SecureMemcpy(tempAppData, prevAppDataSize, (uint8_t *)m_appData, prevAppDataSize);
+    }
 
-        uint8_t *newAddress = (uint8_t *)tempAppData + prevAppDataSize;
-
-        // Add new app data buffer to the new location
-        MOS_SecureMemcpy(newAddress, size, (uint8_t *)ptr, size);
+    uint8_t *newAddress = (uint8_t *)tempAppData + prevAppDataSize;
 
-        // Now free the previous location containing app data and overwrite with new app data buffer
-        MOS_FreeMemory(m_appData);
-        m_appData = tempAppData;
+    // Add new app data buffer to the new location
+    MOS_SecureMemcpy(newAddress, size, (uint8_t *)ptr, size);
 
-    }
+    m_appData = tempAppData;
 
     m_appDataTotalSize += size;
 
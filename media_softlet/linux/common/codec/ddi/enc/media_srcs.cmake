@@ -21,6 +21,7 @@
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_functions.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_base_specific.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_frame_arena.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_hevc_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_av1_specific.cpp
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_vp9_specific.cpp
@@ -32,6 +33,7 @@ set(TMP_SOURCES_
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_functions.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_base_specific.h
+    ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_frame_arena.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_hevc_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_av1_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_encode_vp9_specific.h
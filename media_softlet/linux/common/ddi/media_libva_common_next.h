@@ -215,6 +215,7 @@ struct DDI_MEDIA_CONTEXT;
 typedef struct DDI_MEDIA_CONTEXT *PDDI_MEDIA_CONTEXT;
 
 struct _DDI_MEDIA_BUFFER;
+class MosTileRowShadow;
 typedef struct _DDI_MEDIA_SURFACE
 {
     // for hwcomposer, remove this after we have a solution
@@ -253,6 +254,7 @@ typedef struct _DDI_MEDIA_SURFACE
 
     uint8_t                 *pSystemShadow;           // Shadow surface in system memory
     _DDI_MEDIA_BUFFER       *pShadowBuffer;
+    MosTileRowShadow        *pTileRowShadow;          // Tile rows of pSystemShadow detiled so far when locked by rows
 
     uint32_t                uiMapFlag;
 
@@ -286,6 +288,7 @@ typedef struct _DDI_MEDIA_BUFFER
 
     bool                   bCFlushReq        = false; // No LLC between CPU & GPU, requries to call CPU Flush for CPU mapped buffer
     bool                   bUseSysGfxMem     = false;
+    bool                   bUserptr          = false; // bo wraps application memory
     PDDI_MEDIA_SURFACE     pSurface          = nullptr;
     GMM_RESOURCE_INFO     *pGmmResourceInfo  = nullptr; // GMM resource descriptor
     PDDI_MEDIA_CONTEXT     pMediaCtx         = nullptr; // Media driver Context
@@ -0,0 +1,272 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_copy_next.cpp
+//! \brief    Plane copy engine for vaGetImage/vaPutImage
+//!
+
+#include "media_libva_copy_next.h"
+#include "mos_utilities.h"
+#include "mos_worker_pool.h"
+
+//!
+//! \brief  Worker pool shared by all copies of the process
+//!
+static MosWorkerPool &GetCopyWorkerPool()
+{
+    static MosWorkerPool pool(MediaLibvaCopyNext::m_maxThreadNum);
+    return pool;
+}
+
+bool MediaLibvaCopyNext::IsSSE4Supported()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool supported = __builtin_cpu_supports("sse4.1");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void MediaLibvaCopyNext::CopyRows(const MEDIA_COPY_PLANE &plane, uint32_t startRow, uint32_t rowNum, bool srcIsWC)
+{
+    if (srcIsWC && IsSSE4Supported())
+    {
+        CopyRowsFromWC_SSE4(plane, startRow, rowNum);
+        return;
+    }
+
+    uint8_t       *dst = plane.dst + (size_t)plane.dstPitch * startRow;
+    const uint8_t *src = plane.src + (size_t)plane.srcPitch * startRow;
+
+    for (uint32_t y = 0; y < rowNum; y++)
+    {
+        MOS_SecureMemcpy(dst, plane.widthInBytes, src, plane.widthInBytes);
+        dst += plane.dstPitch;
+        src += plane.srcPitch;
+    }
+}
+
+VAStatus MediaLibvaCopyNext::GetImagePlaneLayout(
+    uint32_t fourcc,
+    uint32_t plane,
+    uint32_t *bytesPerPixel,
+    uint32_t *horzShift,
+    uint32_t *vertShift)
+{
+    if (bytesPerPixel == nullptr || horzShift == nullptr || vertShift == nullptr)
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+
+    uint32_t planeNum = 1;
+    *bytesPerPixel    = 1;
+    *horzShift        = 0;
+    *vertShift        = 0;
+
+    switch(fourcc)
+    {
+        case VA_FOURCC_NV12:
+            planeNum       = 2;
+            *bytesPerPixel = (plane == 0) ? 1 : 2;
+            *horzShift     = (plane == 0) ? 0 : 1;
+            *vertShift     = (plane == 0) ? 0 : 1;
+            break;
+        case VA_FOURCC_P010:
+        case VA_FOURCC_P012:
+        case VA_FOURCC_P016:
+            planeNum       = 2;
+            *bytesPerPixel = (plane == 0) ? 2 : 4;
+            *horzShift     = (plane == 0) ? 0 : 1;
+            *vertShift     = (plane == 0) ? 0 : 1;
+            break;
+        case VA_FOURCC_I420:
+        case VA_FOURCC_YV12:
+        case VA_FOURCC_IMC3:
+            planeNum   = 3;
+            *horzShift = (plane == 0) ? 0 : 1;
+            *vertShift = (plane == 0) ? 0 : 1;
+            break;
+        case VA_FOURCC_411P:
+            planeNum   = 3;
+            *horzShift = (plane == 0) ? 0 : 2;
+            break;
+        case VA_FOURCC_422H:
+            planeNum   = 3;
+            *horzShift = (plane == 0) ? 0 : 1;
+            break;
+        case VA_FOURCC_422V:
+            planeNum   = 3;
+            *vertShift = (plane == 0) ? 0 : 1;
+            break;
+        case VA_FOURCC_444P:
+        case VA_FOURCC_RGBP:
+            planeNum = 3;
+            break;
+        case VA_FOURCC_Y800:
+            break;
+        case VA_FOURCC_RGB565:
+            *bytesPerPixel = 2;
+            break;
+        case VA_FOURCC_YUY2:
+        case VA_FOURCC_UYVY:
+        case VA_FOURCC_VYUY:
+        case VA_FOURCC_YVYU:
+            // 2 pixels share one 4 bytes group
+            *bytesPerPixel = 4;
+            *horzShift     = 1;
+            break;
+        case VA_FOURCC_Y210:
+        case VA_FOURCC_Y212:
+        case VA_FOURCC_Y216:
+            // 2 pixels share one 8 bytes group
+            *bytesPerPixel = 8;
+            *horzShift     = 1;
+            break;
+        case VA_FOURCC_ARGB:
+        case VA_FOURCC_ABGR:
+        case VA_FOURCC_XRGB:
+        case VA_FOURCC_XBGR:
+        case VA_FOURCC_RGBA:
+        case VA_FOURCC_BGRA:
+        case VA_FOURCC_RGBX:
+        case VA_FOURCC_BGRX:
+        case VA_FOURCC_A2R10G10B10:
+        case VA_FOURCC_A2B10G10R10:
+        case VA_FOURCC_X2R10G10B10:
+        case VA_FOURCC_X2B10G10R10:
+        case VA_FOURCC_AYUV:
+        case VA_FOURCC_XYUV:
+        case VA_FOURCC_Y410:
+            *bytesPerPixel = 4;
+            break;
+        case VA_FOURCC_Y412:
+        case VA_FOURCC_Y416:
+        case VA_FOURCC_ARGB64:
+        case VA_FOURCC_ABGR64:
+            *bytesPerPixel = 8;
+            break;
+        default:
+            return VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT;
+    }
+
+    return (plane < planeNum) ? VA_STATUS_SUCCESS : VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT;
+}
+
+VAStatus MediaLibvaCopyNext::GetRegionPlanes(
+    uint32_t                 fourcc,
+    uint32_t                 planeNum,
+    const MEDIA_COPY_LAYOUT &surface,
+    const MEDIA_COPY_LAYOUT &image,
+    uint32_t                 surfX,
+    uint32_t                 surfY,
+    uint32_t                 imageX,
+    uint32_t                 imageY,
+    uint32_t                 width,
+    uint32_t                 height,
+    bool                     surfaceToImage,
+    MEDIA_COPY_PLANE        *planes)
+{
+    if (planes == nullptr || planeNum > 3 ||
+        surfX >= surface.width || surfY >= surface.height ||
+        imageX >= image.width || imageY >= image.height)
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+
+    for (uint32_t i = 0; i < planeNum; i++)
+    {
+        uint32_t bytesPerPixel = 0;
+        uint32_t horzShift     = 0;
+        uint32_t vertShift     = 0;
+        VAStatus status        = GetImagePlaneLayout(fourcc, i, &bytesPerPixel, &horzShift, &vertShift);
+        if (status != VA_STATUS_SUCCESS)
+        {
+            return status;
+        }
+
+        // Subsampled plane covers all the samples touched by the region
+        uint32_t horzStep = 1 << horzShift;
+        uint32_t vertStep = 1 << vertShift;
+        uint32_t samples  = ((surfX + width + horzStep - 1) >> horzShift) - (surfX >> horzShift);
+        uint32_t rows     = ((surfY + height + vertStep - 1) >> vertShift) - (surfY >> vertShift);
+
+        // Rounding up at odd start must not run past the last sample of either plane
+        samples = MOS_MIN(samples, ((surface.width + horzStep - 1) >> horzShift) - (surfX >> horzShift));
+        samples = MOS_MIN(samples, ((image.width + horzStep - 1) >> horzShift) - (imageX >> horzShift));
+        rows    = MOS_MIN(rows, ((surface.height + vertStep - 1) >> vertShift) - (surfY >> vertShift));
+        rows    = MOS_MIN(rows, ((image.height + vertStep - 1) >> vertShift) - (imageY >> vertShift));
+
+        uint8_t *surfStart = surface.planes[i] + (size_t)(surfY >> vertShift) * surface.pitches[i] + (surfX >> horzShift) * bytesPerPixel;
+        uint8_t *imgStart  = image.planes[i] + (size_t)(imageY >> vertShift) * image.pitches[i] + (imageX >> horzShift) * bytesPerPixel;
+
+        planes[i].dst          = surfaceToImage ? imgStart : surfStart;
+        planes[i].dstPitch     = surfaceToImage ? image.pitches[i] : surface.pitches[i];
+        planes[i].src          = surfaceToImage ? surfStart : imgStart;
+        planes[i].srcPitch     = surfaceToImage ? surface.pitches[i] : image.pitches[i];
+        planes[i].widthInBytes = samples * bytesPerPixel;
+        planes[i].height       = rows;
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
+void MediaLibvaCopyNext::CopyPlanes(const MEDIA_COPY_PLANE *planes, uint32_t planeNum, bool srcIsWC)
+{
+    if (planes == nullptr || planeNum == 0)
+    {
+        return;
+    }
+
+    size_t totalBytes = 0;
+    for (uint32_t i = 0; i < planeNum; i++)
+    {
+        totalBytes += (size_t)planes[i].widthInBytes * planes[i].height;
+    }
+
+    uint32_t jobNum = (uint32_t)MOS_MIN(totalBytes / m_minBytesPerThread, (size_t)m_maxThreadNum);
+    if (jobNum > 1)
+    {
+        jobNum = MOS_MIN(jobNum, GetCopyWorkerPool().GetThreadNum());
+    }
+
+    if (jobNum <= 1)
+    {
+        for (uint32_t i = 0; i < planeNum; i++)
+        {
+            CopyRows(planes[i], 0, planes[i].height, srcIsWC);
+        }
+        return;
+    }
+
+    // Each job copies one horizontal band of every plane
+    MosWorkerPool::Job job = [&](uint32_t jobIdx) {
+        for (uint32_t i = 0; i < planeNum; i++)
+        {
+            uint32_t startRow = (uint32_t)((uint64_t)planes[i].height * jobIdx / jobNum);
+            uint32_t endRow   = (uint32_t)((uint64_t)planes[i].height * (jobIdx + 1) / jobNum);
+            CopyRows(planes[i], startRow, endRow - startRow, srcIsWC);
+        }
+    };
+
+    GetCopyWorkerPool().Run(jobNum, job);
+}
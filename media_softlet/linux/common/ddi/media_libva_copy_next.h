@@ -0,0 +1,202 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_copy_next.h
+//! \brief    Plane copy engine for vaGetImage/vaPutImage
+//! \details  Copies rectangles of image planes between surfaces and images. Reads from
+//!           surface mappings, which are usually write-combined, use streaming loads
+//!           when supported by CPU, and large copies are split across worker threads.
+//!
+
+#ifndef __MEDIA_LIBVA_COPY_NEXT_H__
+#define __MEDIA_LIBVA_COPY_NEXT_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <va/va.h>
+
+//!
+//! \brief  Rectangle of one plane to copy, in bytes
+//!
+struct MEDIA_COPY_PLANE
+{
+    uint8_t       *dst;
+    uint32_t       dstPitch;
+    const uint8_t *src;
+    uint32_t       srcPitch;
+    uint32_t       widthInBytes;
+    uint32_t       height;
+};
+
+//!
+//! \brief  Planes of one surface or image mapping
+//!
+struct MEDIA_COPY_LAYOUT
+{
+    uint8_t  *planes[3];
+    uint32_t  pitches[3];
+    uint32_t  width;     //!< Width in pixels
+    uint32_t  height;    //!< Height in pixels
+};
+
+class MediaLibvaCopyNext
+{
+public:
+    //!
+    //! \brief  Copy planes row by row, large copies are split across worker threads
+    //!
+    //! \param  [in] planes
+    //!         Rectangles of planes to copy
+    //! \param  [in] planeNum
+    //!         Number of planes
+    //! \param  [in] srcIsWC
+    //!         Source is mapped write-combined, streaming loads are used if supported
+    //!
+    static void CopyPlanes(const MEDIA_COPY_PLANE *planes, uint32_t planeNum, bool srcIsWC);
+
+    //!
+    //! \brief  Copy rows of one plane
+    //!
+    //! \param  [in] plane
+    //!         Rectangle of plane to copy
+    //! \param  [in] startRow
+    //!         First row to copy
+    //! \param  [in] rowNum
+    //!         Number of rows to copy
+    //! \param  [in] srcIsWC
+    //!         Source is mapped write-combined, streaming loads are used if supported
+    //!
+    static void CopyRows(const MEDIA_COPY_PLANE &plane, uint32_t startRow, uint32_t rowNum, bool srcIsWC);
+
+    //!
+    //! \brief  Get plane layout of image format
+    //!
+    //! \param  [in] fourcc
+    //!         Format
+    //! \param  [in] plane
+    //!         Plane index
+    //! \param  [out] bytesPerPixel
+    //!         Bytes of one sample in the plane, or of one pixel group for packed 422 formats
+    //! \param  [out] horzShift
+    //!         Log2 of horizontal subsampling of the plane
+    //! \param  [out] vertShift
+    //!         Log2 of vertical subsampling of the plane
+    //!
+    //! \return VAStatus
+    //!     VA_STATUS_SUCCESS if success, VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT if unknown
+    //!
+    static VAStatus GetImagePlaneLayout(
+        uint32_t fourcc,
+        uint32_t plane,
+        uint32_t *bytesPerPixel,
+        uint32_t *horzShift,
+        uint32_t *vertShift);
+
+    //!
+    //! \brief  Get plane rectangles to copy a region between surface and image planes
+    //!         Subsampled planes cover all samples touched by the region, clipped
+    //!         to the samples of surface and image
+    //!
+    //! \param  [in] fourcc
+    //!         Format of surface and image
+    //! \param  [in] planeNum
+    //!         Number of planes, at most 3
+    //! \param  [in] surface
+    //!         Planes of surface
+    //! \param  [in] image
+    //!         Planes of image
+    //! \param  [in] surfX
+    //!         X of the region in surface
+    //! \param  [in] surfY
+    //!         Y of the region in surface
+    //! \param  [in] imageX
+    //!         X of the region in image
+    //! \param  [in] imageY
+    //!         Y of the region in image
+    //! \param  [in] width
+    //!         Width of the region
+    //! \param  [in] height
+    //!         Height of the region
+    //! \param  [in] surfaceToImage
+    //!         true if copy from surface to image, false if copy from image to surface
+    //! \param  [out] planes
+    //!         Plane rectangles, planeNum elements
+    //!
+    //! \return VAStatus
+    //!     VA_STATUS_SUCCESS if success, VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT if
+    //!     plane layout of the format is unknown, VA_STATUS_ERROR_INVALID_PARAMETER
+    //!     if the region starts outside of surface or image
+    //!
+    static VAStatus GetRegionPlanes(
+        uint32_t                 fourcc,
+        uint32_t                 planeNum,
+        const MEDIA_COPY_LAYOUT &surface,
+        const MEDIA_COPY_LAYOUT &image,
+        uint32_t                 surfX,
+        uint32_t                 surfY,
+        uint32_t                 imageX,
+        uint32_t                 imageY,
+        uint32_t                 width,
+        uint32_t                 height,
+        bool                     surfaceToImage,
+        MEDIA_COPY_PLANE        *planes);
+
+    //!
+    //! \brief  Copy from write-combined memory with streaming loads (MOVNTDQA)
+    //!         Implemented in SSE4.1 source, only called if IsSSE4Supported()
+    //!
+    //! \param  [in] dst
+    //!         Destination
+    //! \param  [in] src
+    //!         Source, write-combined memory
+    //! \param  [in] bytes
+    //!         Bytes to copy
+    //!
+    static void CopyFromWC_SSE4(void *dst, const void *src, size_t bytes);
+
+    //!
+    //! \brief  Copy rows of one plane from write-combined memory with streaming loads
+    //!         Rows are loaded without fencing, one fence completes the whole band
+    //!         Implemented in SSE4.1 source, only called if IsSSE4Supported()
+    //!
+    //! \param  [in] plane
+    //!         Rectangle of plane to copy, source is write-combined memory
+    //! \param  [in] startRow
+    //!         First row to copy
+    //! \param  [in] rowNum
+    //!         Number of rows to copy
+    //!
+    static void CopyRowsFromWC_SSE4(const MEDIA_COPY_PLANE &plane, uint32_t startRow, uint32_t rowNum);
+
+    //!
+    //! \brief  Check if CPU supports SSE4.1 streaming loads
+    //!
+    //! \return bool
+    //!         true if supported, otherwise false
+    //!
+    static bool IsSSE4Supported();
+
+    static constexpr uint32_t m_maxThreadNum       = 4;                //!< Max threads of one copy, including calling thread
+    static constexpr size_t   m_minBytesPerThread  = 1024 * 1024;      //!< Copies smaller than this are not split
+};
+
+#endif  //__MEDIA_LIBVA_COPY_NEXT_H__
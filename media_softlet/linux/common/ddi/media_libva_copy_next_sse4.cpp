@@ -0,0 +1,124 @@
+/*
+* Copyright (c) 2024, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_copy_next_sse4.cpp
+//! \brief    SSE4.1 implementation of plane copy engine, built with -msse4.1
+//!
+
+#include <string.h>
+#include "media_libva_copy_next.h"
+
+#if defined(__SSE4_1__)
+
+#include <smmintrin.h>
+
+//!
+//! \brief  Copy one row with streaming loads, the caller fences after its last row
+//!
+static inline void CopyRowFromWC(void *dst, const void *src, size_t bytes)
+{
+    uint8_t       *tempDst = (uint8_t *)dst;
+    const uint8_t *tempSrc = (const uint8_t *)src;
+
+    // Streaming load must be 16-byte aligned, copy the unaligned head with normal loads
+    size_t alignBytes = (16 - ((uintptr_t)tempSrc & 15)) & 15;
+    alignBytes        = (alignBytes < bytes) ? alignBytes : bytes;
+    if (alignBytes)
+    {
+        memcpy(tempDst, tempSrc, alignBytes);
+        tempDst += alignBytes;
+        tempSrc += alignBytes;
+        bytes -= alignBytes;
+    }
+
+    for (; bytes >= 64; bytes -= 64)
+    {
+        __m128i xmm0 = _mm_stream_load_si128((__m128i *)tempSrc);
+        __m128i xmm1 = _mm_stream_load_si128((__m128i *)(tempSrc + 16));
+        __m128i xmm2 = _mm_stream_load_si128((__m128i *)(tempSrc + 32));
+        __m128i xmm3 = _mm_stream_load_si128((__m128i *)(tempSrc + 48));
+
+        _mm_storeu_si128((__m128i *)tempDst, xmm0);
+        _mm_storeu_si128((__m128i *)(tempDst + 16), xmm1);
+        _mm_storeu_si128((__m128i *)(tempDst + 32), xmm2);
+        _mm_storeu_si128((__m128i *)(tempDst + 48), xmm3);
+
+        tempSrc += 64;
+        tempDst += 64;
+    }
+
+    for (; bytes >= 16; bytes -= 16)
+    {
+        _mm_storeu_si128((__m128i *)tempDst, _mm_stream_load_si128((__m128i *)tempSrc));
+        tempSrc += 16;
+        tempDst += 16;
+    }
+
+    if (bytes)
+    {
+        memcpy(tempDst, tempSrc, bytes);
+    }
+}
+
+void MediaLibvaCopyNext::CopyFromWC_SSE4(void *dst, const void *src, size_t bytes)
+{
+    CopyRowFromWC(dst, src, bytes);
+    _mm_mfence();
+}
+
+void MediaLibvaCopyNext::CopyRowsFromWC_SSE4(const MEDIA_COPY_PLANE &plane, uint32_t startRow, uint32_t rowNum)
+{
+    uint8_t       *dst = plane.dst + (size_t)plane.dstPitch * startRow;
+    const uint8_t *src = plane.src + (size_t)plane.srcPitch * startRow;
+
+    for (uint32_t y = 0; y < rowNum; y++)
+    {
+        CopyRowFromWC(dst, src, plane.widthInBytes);
+        dst += plane.dstPitch;
+        src += plane.srcPitch;
+    }
+
+    // Streaming loads are weakly ordered, one fence for all rows of the band
+    _mm_mfence();
+}
+
+#else
+
+void MediaLibvaCopyNext::CopyFromWC_SSE4(void *dst, const void *src, size_t bytes)
+{
+    memcpy(dst, src, bytes);
+}
+
+void MediaLibvaCopyNext::CopyRowsFromWC_SSE4(const MEDIA_COPY_PLANE &plane, uint32_t startRow, uint32_t rowNum)
+{
+    uint8_t       *dst = plane.dst + (size_t)plane.dstPitch * startRow;
+    const uint8_t *src = plane.src + (size_t)plane.srcPitch * startRow;
+
+    for (uint32_t y = 0; y < rowNum; y++)
+    {
+        memcpy(dst, src, plane.widthInBytes);
+        dst += plane.dstPitch;
+        src += plane.srcPitch;
+    }
+}
+
+#endif  // __SSE4_1__
@@ -45,6 +45,7 @@
 #include "ddi_encode_functions.h"
 #include "ddi_vp_functions.h"
 #include "media_libva_register.h"
+#include "media_submit_batcher.h"
 
 MEDIA_MUTEX_T MediaLibvaInterfaceNext::m_GlobalMutex = MEDIA_MUTEX_INITIALIZER;
 
@@ -158,11 +159,28 @@ void MediaLibvaInterfaceNext::MediaMemoryDecompressInternal(
     DDI_CHK_NULL(mosCtx, "nullptr mosCtx",);
     DDI_CHK_NULL(osResource, "nullptr osResource",);
 
+    if (MediaMemoryDecompressBatchInternal(mosCtx, &osResource, 1) != MOS_STATUS_SUCCESS)
+    {
+        DDI_ASSERTMESSAGE("Media memory decompression failed.");
+    }
+}
+
+MOS_STATUS MediaLibvaInterfaceNext::MediaMemoryDecompressBatchInternal(
+    PMOS_CONTEXT   mosCtx,
+    PMOS_RESOURCE *osResources,
+    uint32_t       count)
+{
+    DDI_FUNC_ENTER;
+
+    DDI_CHK_NULL(mosCtx, "nullptr mosCtx", MOS_STATUS_NULL_POINTER);
+    DDI_CHK_NULL(mosCtx->ppMediaMemDecompState, "nullptr ppMediaMemDecompState", MOS_STATUS_NULL_POINTER);
+    DDI_CHK_NULL(osResources, "nullptr osResources", MOS_STATUS_NULL_POINTER);
+
     MediaMemDecompBaseState *mediaMemDecompState = static_cast<MediaMemDecompBaseState*>(*mosCtx->ppMediaMemDecompState);
 
-    DDI_CHK_NULL(mediaMemDecompState, "nullptr mediaMemDecompState", );
+    DDI_CHK_NULL(mediaMemDecompState, "nullptr mediaMemDecompState", MOS_STATUS_NULL_POINTER);
 
-    mediaMemDecompState->MemoryDecompress(osResource);
+    return mediaMemDecompState->MemoryDecompressBatch(osResources, count);
 }
 
 void MediaLibvaInterfaceNext::MediaMemoryCopyInternal(
@@ -1367,6 +1385,12 @@ VAStatus MediaLibvaInterfaceNext::SyncSurface(
         MediaLibvaUtilNext::PostSemaphore(surface->pCurrentFrameSemaphore);
     }
 
+    // Frame writing the surface may still be pending in the submit batcher of the device
+    if (MediaSubmitBatcher::FlushDevice(mediaCtx->m_osDeviceContext) != MOS_STATUS_SUCCESS)
+    {
+        DDI_NORMALMESSAGE("Failed to flush pending frames of surface %d", renderTarget);
+    }
+
     MOS_TraceEventExt(EVENT_VA_SYNC, EVENT_TYPE_INFO, surface->bo? &surface->bo->handle:nullptr, sizeof(uint32_t), nullptr, 0);
     // check the bo here?
     // zero is a expected return value
@@ -1511,10 +1535,77 @@ void MediaLibvaInterfaceNext::CopyPlane(
     }
 }
 
+VAStatus MediaLibvaInterfaceNext::GetCopyPlanes(
+    DDI_MEDIA_SURFACE *surface,
+    uint8_t           *surfData,
+    VAImage           *image,
+    uint8_t           *imageData,
+    uint32_t          surfX,
+    uint32_t          surfY,
+    uint32_t          imageX,
+    uint32_t          imageY,
+    uint32_t          width,
+    uint32_t          height,
+    bool              surfaceToImage,
+    MEDIA_COPY_PLANE  *planes,
+    uint32_t          &planeNum)
+{
+    DDI_CHK_NULL(surface,   "nullptr surface.",   VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(surfData,  "nullptr surfData.",  VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(image,     "nullptr image.",     VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(imageData, "nullptr imageData.", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(planes,    "nullptr planes.",    VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    planeNum = 0;
+    if (image->num_planes == 0 || image->num_planes > 3)
+    {
+        return VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT;
+    }
+
+    uint32_t chromaPitch  = 0;
+    uint32_t chromaHeight = 0;
+    GetChromaPitchHeight(MediaFormatToOsFormat(surface->format), surface->iPitch, surface->iHeight, &chromaPitch, &chromaHeight);
+    if (image->num_planes > 1 && chromaPitch == 0)
+    {
+        return VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT;
+    }
+
+    // Chroma planes follow the luma plane, the 3rd plane follows the 2nd one
+    MEDIA_COPY_LAYOUT surfLayout  = {};
+    surfLayout.planes[0]  = surfData;
+    surfLayout.planes[1]  = surfData + surface->iPitch * surface->iHeight;
+    surfLayout.planes[2]  = surfLayout.planes[1] + chromaPitch * chromaHeight;
+    surfLayout.pitches[0] = surface->iPitch;
+    surfLayout.pitches[1] = chromaPitch;
+    surfLayout.pitches[2] = chromaPitch;
+    surfLayout.width      = surface->iWidth;
+    surfLayout.height     = surface->iHeight;
+
+    MEDIA_COPY_LAYOUT imageLayout = {};
+    for (uint32_t i = 0; i < image->num_planes; i++)
+    {
+        imageLayout.planes[i]  = imageData + image->offsets[i];
+        imageLayout.pitches[i] = image->pitches[i];
+    }
+    imageLayout.width  = image->width;
+    imageLayout.height = image->height;
+
+    DDI_CHK_RET(MediaLibvaCopyNext::GetRegionPlanes(image->format.fourcc, image->num_planes, surfLayout, imageLayout,
+                    surfX, surfY, imageX, imageY, width, height, surfaceToImage, planes),
+        "Failed to get region planes.");
+
+    planeNum = image->num_planes;
+    return VA_STATUS_SUCCESS;
+}
+
 VAStatus MediaLibvaInterfaceNext::CopySurfaceToImage(
     VADriverContextP  ctx,
     DDI_MEDIA_SURFACE *surface,
-    VAImage           *image)
+    VAImage           *image,
+    int32_t           x,
+    int32_t           y,
+    uint32_t          width,
+    uint32_t          height)
 {
     DDI_FUNC_ENTER;
 
@@ -1536,7 +1627,16 @@ VAStatus MediaLibvaInterfaceNext::CopySurfaceToImage(
         }
     }
 
-    void *surfData = MediaLibvaUtilNext::LockSurface(surface, flag);
+    // Copy the region clipped to the surface and the image
+    uint32_t surfWidth  = (uint32_t)surface->iWidth;
+    uint32_t surfHeight = (uint32_t)surface->iHeight;
+    uint32_t surfX      = (uint32_t)MOS_MAX(x, 0);
+    uint32_t surfY      = (uint32_t)MOS_MAX(y, 0);
+    uint32_t copyWidth  = (surfX < surfWidth) ? MOS_MIN(width, MOS_MIN((uint32_t)image->width, surfWidth - surfX)) : 0;
+    uint32_t copyHeight = (surfY < surfHeight) ? MOS_MIN(height, MOS_MIN((uint32_t)image->height, surfHeight - surfY)) : 0;
+
+    // Only the rows of the region are detiled when the surface is untiled by s/w
+    void *surfData = MediaLibvaUtilNext::LockSurfaceRows(surface, flag, surfY, MOS_MAX(copyHeight, 1));
     if (surfData == nullptr)
     {
         DDI_ASSERTMESSAGE("nullptr surfData.");
@@ -1552,27 +1652,47 @@ VAStatus MediaLibvaInterfaceNext::CopySurfaceToImage(
         return vaStatus;
     }
 
-    uint8_t *ySrc = (uint8_t*)surfData;
-    uint8_t *yDst = (uint8_t*)imageData;
+    MEDIA_COPY_PLANE planes[3] = {};
+    uint32_t         planeNum  = 0;
 
-    CopyPlane(yDst, image->pitches[0], ySrc, surface->iPitch, image->height);
-    if (image->num_planes > 1)
+    if (copyWidth == 0 || copyHeight == 0)
     {
-        uint8_t *uSrc = ySrc + surface->iPitch * surface->iHeight;
-        uint8_t *uDst = yDst + image->offsets[1];
-        uint32_t chromaPitch       = 0;
-        uint32_t chromaHeight      = 0;
-        uint32_t imageChromaPitch  = 0;
-        uint32_t imageChromaHeight = 0;
-        GetChromaPitchHeight(MediaFormatToOsFormat(surface->format), surface->iPitch, surface->iHeight, &chromaPitch, &chromaHeight);
-        GetChromaPitchHeight(image->format.fourcc, image->pitches[0], image->height, &imageChromaPitch, &imageChromaHeight);
-        CopyPlane(uDst, image->pitches[1], uSrc, chromaPitch, imageChromaHeight);
+        DDI_NORMALMESSAGE("Region is out of surface, nothing to copy.");
+    }
+    else if (GetCopyPlanes(surface, (uint8_t *)surfData, image, (uint8_t *)imageData,
+            surfX, surfY, 0, 0, copyWidth, copyHeight, true, planes, planeNum) == VA_STATUS_SUCCESS)
+    {
+        // Surface is usually mapped write-combined, streaming loads are also
+        // as fast as normal loads for cached mappings
+        MediaLibvaCopyNext::CopyPlanes(planes, planeNum, true);
+    }
+    else
+    {
+        // Whole image is copied, so the rest of the surface has to be detiled too
+        uint8_t *ySrc = (uint8_t*)MediaLibvaUtilNext::LockSurface(surface, flag);
+        uint8_t *yDst = (uint8_t*)imageData;
+        MediaLibvaUtilNext::UnlockSurface(surface);
+        ySrc = ySrc ? ySrc : (uint8_t*)surfData;
 
-        if(image->num_planes > 2)
+        CopyPlane(yDst, image->pitches[0], ySrc, surface->iPitch, image->height);
+        if (image->num_planes > 1)
         {
-            uint8_t *vSrc = uSrc + chromaPitch * chromaHeight;
-            uint8_t *vDst = yDst + image->offsets[2];
-            CopyPlane(vDst, image->pitches[2], vSrc, chromaPitch, imageChromaHeight);
+            uint8_t *uSrc = ySrc + surface->iPitch * surface->iHeight;
+            uint8_t *uDst = yDst + image->offsets[1];
+            uint32_t chromaPitch       = 0;
+            uint32_t chromaHeight      = 0;
+            uint32_t imageChromaPitch  = 0;
+            uint32_t imageChromaHeight = 0;
+            GetChromaPitchHeight(MediaFormatToOsFormat(surface->format), surface->iPitch, surface->iHeight, &chromaPitch, &chromaHeight);
+            GetChromaPitchHeight(image->format.fourcc, image->pitches[0], image->height, &imageChromaPitch, &imageChromaHeight);
+            CopyPlane(uDst, image->pitches[1], uSrc, chromaPitch, imageChromaHeight);
+
+            if(image->num_planes > 2)
+            {
+                uint8_t *vSrc = uSrc + chromaPitch * chromaHeight;
+                uint8_t *vDst = yDst + image->offsets[2];
+                CopyPlane(vDst, image->pitches[2], vSrc, chromaPitch, imageChromaHeight);
+            }
         }
     }
 
@@ -1705,7 +1825,15 @@ VAStatus MediaLibvaInterfaceNext::GetImage(
     DDI_CHK_NULL(mediaSurface,     "nullptr mediaSurface.",      VA_STATUS_ERROR_INVALID_SURFACE);
     DDI_CHK_NULL(mediaSurface->bo, "nullptr mediaSurface->bo.",  VA_STATUS_ERROR_INVALID_SURFACE);
 
-    vaStatus = CopySurfaceToImage(ctx, mediaSurface, vaimg);
+    // VP output already holds the requested region at the image origin
+    if (targetSurface != VA_INVALID_SURFACE)
+    {
+        vaStatus = CopySurfaceToImage(ctx, mediaSurface, vaimg, 0, 0, vaimg->width, vaimg->height);
+    }
+    else
+    {
+        vaStatus = CopySurfaceToImage(ctx, mediaSurface, vaimg, x, y, width, height);
+    }
     if (vaStatus != MOS_STATUS_SUCCESS)
     {
         DDI_ASSERTMESSAGE("Failed to copy surface to image buffer data!");
@@ -1722,7 +1850,7 @@ VAStatus MediaLibvaInterfaceNext::GetImage(
         DestroySurfaces(ctx, &targetSurface, 1);
     }
 #else
-    vaStatus = CopySurfaceToImage(ctx, inputSurface, vaimg);
+    vaStatus = CopySurfaceToImage(ctx, inputSurface, vaimg, x, y, width, height);
     DDI_CHK_RET(vaStatus, "Copy surface to image failed.");
 #endif
 
@@ -1781,10 +1909,21 @@ VAStatus MediaLibvaInterfaceNext::PutImage(
     DDI_CHK_RET(vaStatus,   "MapBuffer failed.");
     DDI_CHK_NULL(imageData, "nullptr imageData.", VA_STATUS_ERROR_INVALID_IMAGE);
 
+    // Region without CSC/Scaling is copied on CPU if the plane layout of the image is known
+    uint32_t bytesPerPixel = 0;
+    uint32_t horzShift     = 0;
+    uint32_t vertShift     = 0;
+    bool     regionCopy    = (srcX != 0 || destX != 0 || srcY != 0 || destY != 0) &&
+        srcX >= 0 && srcY >= 0 && destX >= 0 && destY >= 0 &&
+        (uint32_t)srcX + srcWidth <= vaimg->width && (uint32_t)srcY + srcHeight <= vaimg->height &&
+        (uint32_t)destX + destWidth <= (uint32_t)mediaSurface->iWidth &&
+        (uint32_t)destY + destHeight <= (uint32_t)mediaSurface->iHeight &&
+        MediaLibvaCopyNext::GetImagePlaneLayout(vaimg->format.fourcc, 0, &bytesPerPixel, &horzShift, &vertShift) == VA_STATUS_SUCCESS;
+
     // VP Pipeline will be called for CSC/Scaling if the surface format or data size is not consistent with image.
     if (mediaSurface->format != OsFormatToMediaFormat(vaimg->format.fourcc, vaimg->format.alpha_mask) ||
         destWidth != srcWidth || destHeight != srcHeight ||
-        srcX != 0 || destX != 0 || srcY != 0 || destY != 0)
+        ((srcX != 0 || destX != 0 || srcY != 0 || destY != 0) && !regionCopy))
     {
         VAContextID context     = VA_INVALID_ID;
 
@@ -1904,29 +2043,41 @@ VAStatus MediaLibvaInterfaceNext::PutImage(
         }
         else
         {
-            uint8_t *ySrc = (uint8_t *)imageData + vaimg->offsets[0];
-            uint8_t *yDst = (uint8_t *)surfData;
-            CopyPlane(yDst, mediaSurface->iPitch, ySrc, vaimg->pitches[0], srcHeight);
+            MEDIA_COPY_PLANE planes[3] = {};
+            uint32_t         planeNum  = 0;
 
-            if (vaimg->num_planes > 1)
+            if (GetCopyPlanes(mediaSurface, (uint8_t *)surfData, vaimg, (uint8_t *)imageData,
+                    (uint32_t)destX, (uint32_t)destY, (uint32_t)srcX, (uint32_t)srcY, srcWidth, srcHeight,
+                    false, planes, planeNum) == VA_STATUS_SUCCESS)
             {
-                DDI_MEDIA_SURFACE uPlane = *mediaSurface;
-
-                uint32_t chromaHeight      = 0;
-                uint32_t chromaPitch       = 0;
-                GetChromaPitchHeight(MediaFormatToOsFormat(uPlane.format), uPlane.iPitch, uPlane.iHeight, &chromaPitch, &chromaHeight);
+                MediaLibvaCopyNext::CopyPlanes(planes, planeNum, false);
+            }
+            else
+            {
+                uint8_t *ySrc = (uint8_t *)imageData + vaimg->offsets[0];
+                uint8_t *yDst = (uint8_t *)surfData;
+                CopyPlane(yDst, mediaSurface->iPitch, ySrc, vaimg->pitches[0], srcHeight);
 
-                uint8_t *uSrc = (uint8_t *)imageData + vaimg->offsets[1];
-                uint8_t *uDst = yDst + mediaSurface->iPitch * mediaSurface->iHeight;
-                CopyPlane(uDst, chromaPitch, uSrc, vaimg->pitches[1], chromaHeight);
-                if (vaimg->num_planes > 2)
+                if (vaimg->num_planes > 1)
                 {
-                    uint8_t *vSrc = (uint8_t *)imageData + vaimg->offsets[2];
-                    uint8_t *vDst = uDst + chromaPitch * chromaHeight;
-                    CopyPlane(vDst, chromaPitch, vSrc, vaimg->pitches[2], chromaHeight);
+                    DDI_MEDIA_SURFACE uPlane = *mediaSurface;
+
+                    uint32_t chromaHeight      = 0;
+                    uint32_t chromaPitch       = 0;
+                    GetChromaPitchHeight(MediaFormatToOsFormat(uPlane.format), uPlane.iPitch, uPlane.iHeight, &chromaPitch, &chromaHeight);
+
+                    uint8_t *uSrc = (uint8_t *)imageData + vaimg->offsets[1];
+                    uint8_t *uDst = yDst + mediaSurface->iPitch * mediaSurface->iHeight;
+                    CopyPlane(uDst, chromaPitch, uSrc, vaimg->pitches[1], chromaHeight);
+                    if (vaimg->num_planes > 2)
+                    {
+                        uint8_t *vSrc = (uint8_t *)imageData + vaimg->offsets[2];
+                        uint8_t *vDst = uDst + chromaPitch * chromaHeight;
+                        CopyPlane(vDst, chromaPitch, vSrc, vaimg->pitches[2], chromaHeight);
+                    }
                 }
             }
-        } 
+        }
 
         vaStatus = UnmapBuffer(ctx, vaimg->buf);
         if (vaStatus != VA_STATUS_SUCCESS)
@@ -2820,6 +2971,12 @@ VAStatus MediaLibvaInterfaceNext::SyncSurface2 (
         MediaLibvaUtilNext::WaitSemaphore(surface->pCurrentFrameSemaphore);
         MediaLibvaUtilNext::PostSemaphore(surface->pCurrentFrameSemaphore);
     }
+    // Frame writing the surface may still be pending in the submit batcher of the device
+    if (MediaSubmitBatcher::FlushDevice(mediaCtx->m_osDeviceContext) != MOS_STATUS_SUCCESS)
+    {
+        DDI_NORMALMESSAGE("Failed to flush pending frames of surface %d", surfaceId);
+    }
+
     MOS_TraceEventExt(EVENT_VA_SYNC, EVENT_TYPE_INFO, surface->bo? &surface->bo->handle:nullptr, sizeof(uint32_t), nullptr, 0);
 
     if (timeoutNs == VA_TIMEOUT_INFINITE)
@@ -2978,6 +3135,12 @@ VAStatus MediaLibvaInterfaceNext::QuerySurfaceStatus (
         }
     }
 
+    // Frame writing the surface may still be pending in the submit batcher of the device
+    if (MediaSubmitBatcher::FlushDevice(mediaCtx->m_osDeviceContext) != MOS_STATUS_SUCCESS)
+    {
+        DDI_NORMALMESSAGE("Failed to flush pending frames of surface %d", renderTarget);
+    }
+
     // Query the busy state of bo.
     // check the bo here?
     if(mos_bo_busy(surface->bo))
@@ -5295,7 +5458,14 @@ VAStatus MediaLibvaInterfaceNext::MediaMemoryDecompress(
         MosUtilities::MosLockMutex(&mediaCtx->MemDecompMutex);
 
         MediaLibvaCommonNext::MediaSurfaceToMosResource(mediaSurface, &surface);
-        MediaLibvaInterfaceNext::MediaMemoryDecompressInternal(&mosCtx, &surface);
+        // Imported surface may be written out of the driver, never skip its decompression
+        surface.bExternalSurface = (mediaSurface->pSurfDesc != nullptr);
+        PMOS_RESOURCE decompResource = &surface;
+        if (MediaLibvaInterfaceNext::MediaMemoryDecompressBatchInternal(&mosCtx, &decompResource, 1) != MOS_STATUS_SUCCESS)
+        {
+            vaStatus = VA_STATUS_ERROR_OPERATION_FAILED;
+            DDI_ASSERTMESSAGE("Media memory decompression failed! [%d].", vaStatus);
+        }
 
         MosUtilities::MosUnlockMutex(&mediaCtx->MemDecompMutex);
         MosUtilities::MosUnlockMutex(&mediaCtx->SurfaceMutex);
@@ -32,6 +32,7 @@
 #include <va/va_drmcommon.h>
 #include "media_libva_common_next.h"
 #include "ddi_media_functions.h"
+#include "media_libva_copy_next.h"
 
 class MediaLibvaInterfaceNext
 {
@@ -1519,6 +1520,14 @@ private:
     //!         Input surface
     //! \param  [in] image
     //!         Output image
+    //! \param  [in] x
+    //!         X of the region in surface
+    //! \param  [in] y
+    //!         Y of the region in surface
+    //! \param  [in] width
+    //!         Width of the region
+    //! \param  [in] height
+    //!         Height of the region
     //!
     //! \return VAStatus
     //!     VA_STATUS_SUCCESS if success, else fail reason
@@ -1526,7 +1535,60 @@ private:
     static VAStatus CopySurfaceToImage(
         VADriverContextP  ctx,
         DDI_MEDIA_SURFACE *surface,
-        VAImage           *image);
+        VAImage           *image,
+        int32_t           x,
+        int32_t           y,
+        uint32_t          width,
+        uint32_t          height);
+
+    //!
+    //! \brief  Get the plane rectangles to copy between surface and image
+    //!
+    //! \param  [in] surface
+    //!         Media surface
+    //! \param  [in] surfData
+    //!         Locked surface data
+    //! \param  [in] image
+    //!         VA image, has the same format as surface
+    //! \param  [in] imageData
+    //!         Mapped image data
+    //! \param  [in] surfX
+    //!         X of the region in surface
+    //! \param  [in] surfY
+    //!         Y of the region in surface
+    //! \param  [in] imageX
+    //!         X of the region in image
+    //! \param  [in] imageY
+    //!         Y of the region in image
+    //! \param  [in] width
+    //!         Width of the region
+    //! \param  [in] height
+    //!         Height of the region
+    //! \param  [in] surfaceToImage
+    //!         true if copy from surface to image, false if copy from image to surface
+    //! \param  [out] planes
+    //!         Plane rectangles, at least 3 elements
+    //! \param  [out] planeNum
+    //!         Number of planes
+    //!
+    //! \return VAStatus
+    //!     VA_STATUS_SUCCESS if success, VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT if
+    //!     plane layout of the format is unknown
+    //!
+    static VAStatus GetCopyPlanes(
+        DDI_MEDIA_SURFACE *surface,
+        uint8_t           *surfData,
+        VAImage           *image,
+        uint8_t           *imageData,
+        uint32_t          surfX,
+        uint32_t          surfY,
+        uint32_t          imageX,
+        uint32_t          imageY,
+        uint32_t          width,
+        uint32_t          height,
+        bool              surfaceToImage,
+        MEDIA_COPY_PLANE  *planes,
+        uint32_t          &planeNum);
 
     //!
     //! \brief  Copy plane from src to dst row by row when src and dst strides are different
@@ -1673,6 +1735,7 @@ private:
         uint32_t height,
         uint32_t *chromaPitch,
         uint32_t *chromaHeight);
+
     
     //!
     //! \brief  Get VA image from VA image ID
@@ -1712,6 +1775,24 @@ private:
     static void MediaMemoryDecompressInternal(
         PMOS_CONTEXT  mosCtx,
         PMOS_RESOURCE osResource);
+
+    //!
+    //! \brief  Decompress internal media memory of several resources together
+    //!
+    //! \param  [in] mosCtx
+    //!         Pointer to mos context
+    //! \param  [in] osResources
+    //!         Array of mos resources
+    //! \param  [in] count
+    //!         Number of resources
+    //!
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    static MOS_STATUS MediaMemoryDecompressBatchInternal(
+        PMOS_CONTEXT   mosCtx,
+        PMOS_RESOURCE *osResources,
+        uint32_t       count);
     
     //!
     //! \brief  copy internal media surface to another surface 
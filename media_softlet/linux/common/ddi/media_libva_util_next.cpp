@@ -37,6 +37,7 @@
 #include "media_libva_decoder.h"
 #include "media_libva_encoder.h"
 #include "memory_policy_manager.h"
+#include "mos_tile_row_shadow.h"
 #include "drm_fourcc.h"
 
 // will remove when mtl open source
@@ -1251,6 +1252,7 @@ void MediaLibvaUtilNext::FreeSurface(DDI_MEDIA_SURFACE *surface)
         DDI_VERBOSEMESSAGE("DDI: try to free a locked surface.");
     }
     mos_bo_unreference(surface->bo);
+    MOS_Delete(surface->pTileRowShadow);
     // For External Buffer, only needs to destory SurfaceDescriptor
     if (surface->pSurfDesc)
     {
@@ -1284,6 +1286,12 @@ void MediaLibvaUtilNext::FreeBuffer(DDI_MEDIA_BUFFER  *buf)
     {
         mos_bo_unreference(buf->bo);
         buf->bo = nullptr;
+        if (buf->bUserptr)
+        {
+            // Application memory is never freed by driver
+            buf->pData    = nullptr;
+            buf->bUserptr = false;
+        }
     }
 
     if (nullptr != buf->pMediaCtx && nullptr != buf->pMediaCtx->pGmmClientContext && nullptr != buf->pGmmResourceInfo)
@@ -1299,6 +1307,13 @@ void* MediaLibvaUtilNext::LockSurface(DDI_MEDIA_SURFACE *surface, uint32_t flag)
     DDI_CHK_NULL(surface,            "nullptr surface",            nullptr);
     DDI_CHK_NULL(surface->pMediaCtx, "nullptr surface->pMediaCtx", nullptr);
 
+    if (surface->bMapped && surface->pTileRowShadow && surface->pTileRowShadow->IsActive())
+    {
+        // Locked by rows before, detile the rest of the shadow surface
+        surface->pTileRowShadow->Detile((uint8_t *)surface->bo->virt, surface->pSystemShadow,
+            0, surface->pTileRowShadow->GetRowNum(), !(flag & MOS_LOCKFLAG_READONLY));
+    }
+
     if (MEDIA_IS_SKU(&surface->pMediaCtx->SkuTable, FtrLocalMemory))
     {
         if ((MosUtilities::MosAtomicIncrement(&surface->iRefCount) == 1) && (false == surface->bMapped))
@@ -1326,6 +1341,83 @@ void* MediaLibvaUtilNext::LockSurface(DDI_MEDIA_SURFACE *surface, uint32_t flag)
     return surface->pData;
 }
 
+void* MediaLibvaUtilNext::LockSurfaceRows(DDI_MEDIA_SURFACE *surface, uint32_t flag, uint32_t y, uint32_t height)
+{
+    DDI_FUNC_ENTER;
+    DDI_CHK_NULL(surface,            "nullptr surface",            nullptr);
+    DDI_CHK_NULL(surface->bo,        "nullptr surface->bo",        nullptr);
+    DDI_CHK_NULL(surface->pMediaCtx, "nullptr surface->pMediaCtx", nullptr);
+
+    PDDI_MEDIA_CONTEXT mediaCtx = surface->pMediaCtx;
+    bool               planar   = mediaCtx->pGmmClientContext && surface->pGmmResourceInfo &&
+                                  mediaCtx->pGmmClientContext->IsPlanar(surface->pGmmResourceInfo->GetResourceFormat());
+    bool               nv12Like = surface->format == Media_Format_NV12 || surface->format == Media_Format_P010 ||
+                                  surface->format == Media_Format_P012 || surface->format == Media_Format_P016;
+
+    // Only s/w untiling of real Tile-Y benefits from rows, hardware detiled and linear
+    // mappings are as cheap as full lock. Full lock in progress is also reused.
+    if (surface->TileType != TILING_Y || !MEDIA_IS_SKU(&mediaCtx->SkuTable, FtrUseSwSwizzling) ||
+        !mediaCtx->m_tileYFlag || mediaCtx->bIsAtomSOC || surface->pGmmResourceInfo == nullptr ||
+        (planar && !nv12Like) || height == 0 ||
+        (surface->bMapped && !(surface->pTileRowShadow && surface->pTileRowShadow->IsActive())))
+    {
+        return LockSurface(surface, flag);
+    }
+
+    if (false == surface->bMapped)
+    {
+        size_t size = (size_t)surface->pGmmResourceInfo->GetSizeMainSurface();
+        if (surface->pTileRowShadow == nullptr)
+        {
+            surface->pTileRowShadow = MOS_New(MosTileRowShadow);
+        }
+        if (surface->pTileRowShadow == nullptr || size > surface->bo->size ||
+            !surface->pTileRowShadow->Init(size, (uint32_t)surface->iPitch))
+        {
+            return LockSurface(surface, flag);
+        }
+
+        mos_bo_map(surface->bo, flag & MOS_LOCKFLAG_WRITEONLY);
+        surface->pSystemShadow = MOS_NewArray(uint8_t, surface->bo->size);
+        if (surface->bo->virt == nullptr || surface->pSystemShadow == nullptr)
+        {
+            DDI_ASSERTMESSAGE("Failed to map surface by rows.");
+            MOS_DeleteArray(surface->pSystemShadow);
+            surface->pSystemShadow = nullptr;
+            surface->pTileRowShadow->Reset();
+            mos_bo_unmap(surface->bo);
+            return nullptr;
+        }
+
+        surface->pData     = surface->pSystemShadow;
+        surface->uiMapFlag = flag;
+        surface->data_size = surface->bo->size;
+        surface->bMapped   = true;
+    }
+
+    // Chroma of two-plane 4:2:0 follows the luma rows with half of the rows
+    bool     dirty = !(flag & MOS_LOCKFLAG_READONLY);
+    uint32_t endY  = y + height;
+    surface->pTileRowShadow->Detile((uint8_t *)surface->bo->virt, surface->pSystemShadow, y, endY, dirty);
+    if (planar)
+    {
+        uint32_t chromaRow = (uint32_t)surface->iHeight;
+        surface->pTileRowShadow->Detile((uint8_t *)surface->bo->virt, surface->pSystemShadow,
+            chromaRow + y / 2, chromaRow + (endY + 1) / 2, dirty);
+    }
+
+    if (MEDIA_IS_SKU(&mediaCtx->SkuTable, FtrLocalMemory))
+    {
+        MosUtilities::MosAtomicIncrement(&surface->iRefCount);
+    }
+    else
+    {
+        surface->iRefCount++;
+    }
+
+    return surface->pData;
+}
+
 void* MediaLibvaUtilNext::LockSurfaceInternal(DDI_MEDIA_SURFACE  *surface, uint32_t flag)
 {
     int      err      = 0;
@@ -1464,12 +1556,21 @@ void MediaLibvaUtilNext::UnlockSurface(DDI_MEDIA_SURFACE  *surface)
             }
             else if (surface->pSystemShadow)
             {
-                SwizzleSurface(surface->pMediaCtx,
-                               surface->pGmmResourceInfo,
-                               surface->bo->virt,
-                               (MOS_TILE_TYPE)surface->TileType,
-                               (uint8_t *)surface->pSystemShadow,
-                               true);
+                if (surface->pTileRowShadow && surface->pTileRowShadow->IsActive())
+                {
+                    // Locked by rows, only write back the dirty tile rows
+                    surface->pTileRowShadow->WriteBack(surface->pSystemShadow, (uint8_t *)surface->bo->virt);
+                    surface->pTileRowShadow->Reset();
+                }
+                else
+                {
+                    SwizzleSurface(surface->pMediaCtx,
+                                   surface->pGmmResourceInfo,
+                                   surface->bo->virt,
+                                   (MOS_TILE_TYPE)surface->TileType,
+                                   (uint8_t *)surface->pSystemShadow,
+                                   true);
+                }
 
                 MOS_DeleteArray(surface->pSystemShadow);
                 surface->pSystemShadow = nullptr;
@@ -2030,6 +2131,78 @@ VAStatus MediaLibvaUtilNext::AllocateBuffer(
     return hRes;
 }
 
+VAStatus MediaLibvaUtilNext::CreateUserptrBuffer(
+    PDDI_MEDIA_BUFFER    mediaBuffer,
+    void                 *data,
+    MOS_BUFMGR           *bufmgr)
+{
+    DDI_FUNC_ENTER;
+    DDI_CHK_NULL(mediaBuffer,                               "mediaBuffer is nullptr",                               VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_NULL(data,                                      "data is nullptr",                                      VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(mediaBuffer->pMediaCtx,                    "mediaBuffer->pMediaCtx is nullptr",                    VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_NULL(mediaBuffer->pMediaCtx->pGmmClientContext, "mediaBuffer->pMediaCtx->pGmmClientContext is nullptr", VA_STATUS_ERROR_INVALID_BUFFER);
+
+    if (((uintptr_t)data & (MOS_PAGE_SIZE - 1)) || mediaBuffer->iSize == 0)
+    {
+        return VA_STATUS_ERROR_INVALID_PARAMETER;
+    }
+
+    // Userptr bo covers whole pages, the last page is owned by the application as it holds the data end
+    uint32_t size = MOS_ALIGN_CEIL(mediaBuffer->iSize, MOS_PAGE_SIZE);
+
+    // create fake GmmResourceInfo
+    GMM_RESCREATE_PARAMS gmmParams;
+    MOS_ZeroMemory(&gmmParams, sizeof(gmmParams));
+    gmmParams.BaseWidth             = 1;
+    gmmParams.BaseHeight            = 1;
+    gmmParams.ArraySize             = 0;
+    gmmParams.Type                  = RESOURCE_1D;
+    gmmParams.Format                = GMM_FORMAT_GENERIC_8BIT;
+    gmmParams.Flags.Gpu.Video       = true;
+    gmmParams.Flags.Info.Linear     = true;
+    gmmParams.Flags.Info.Cacheable  = true;
+
+    mediaBuffer->pGmmResourceInfo = mediaBuffer->pMediaCtx->pGmmClientContext->CreateResInfoObject(&gmmParams);
+    DDI_CHK_NULL(mediaBuffer->pGmmResourceInfo, "pGmmResourceInfo is nullptr", VA_STATUS_ERROR_INVALID_BUFFER);
+    mediaBuffer->pGmmResourceInfo->OverrideSize(size);
+    mediaBuffer->pGmmResourceInfo->OverrideBaseWidth(size);
+    mediaBuffer->pGmmResourceInfo->OverridePitch(size);
+
+    unsigned int patIndex = MosInterface::GetPATIndexFromGmm(mediaBuffer->pMediaCtx->pGmmClientContext, mediaBuffer->pGmmResourceInfo);
+
+    struct mos_drm_bo_alloc_userptr alloc_uptr;
+    alloc_uptr.name        = "Media Userptr Buffer";
+    alloc_uptr.addr        = data;
+    alloc_uptr.tiling_mode = TILING_NONE;
+    alloc_uptr.stride      = size;
+    alloc_uptr.size        = size;
+    alloc_uptr.pat_index   = patIndex;
+
+    MOS_LINUX_BO *bo = mos_bo_alloc_userptr(bufmgr, &alloc_uptr);
+    if (bo == nullptr)
+    {
+        DDI_NORMALMESSAGE("Fail to wrap %8d bytes application memory.", mediaBuffer->iSize);
+        mediaBuffer->pMediaCtx->pGmmClientContext->DestroyResInfoObject(mediaBuffer->pGmmResourceInfo);
+        mediaBuffer->pGmmResourceInfo = nullptr;
+        return VA_STATUS_ERROR_ALLOCATION_FAILED;
+    }
+
+    mediaBuffer->format          = Media_Format_Buffer;
+    mediaBuffer->bMapped         = false;
+    mediaBuffer->iRefCount       = 0;
+    mediaBuffer->bo              = bo;
+    mediaBuffer->pData           = (uint8_t *)data;
+    mediaBuffer->bUserptr        = true;
+    mediaBuffer->uiLockedBufID   = VA_INVALID_ID;
+    mediaBuffer->uiLockedImageID = VA_INVALID_ID;
+
+    DDI_VERBOSEMESSAGE("Wrap %8d bytes application memory.", mediaBuffer->iSize);
+    uint32_t event[] = {bo->handle, mediaBuffer->format, mediaBuffer->iSize, 1, mediaBuffer->iSize, bo->size, 0, 0};
+    MOS_TraceEventExt(EVENT_VA_BUFFER, EVENT_TYPE_INFO, event, sizeof(event), &mediaBuffer->pGmmResourceInfo->GetResFlags(), sizeof(GMM_RESOURCE_FLAG));
+
+    return VA_STATUS_SUCCESS;
+}
+
 PDDI_MEDIA_BUFFER_HEAP_ELEMENT MediaLibvaUtilNext::AllocPMediaBufferFromHeap(PDDI_MEDIA_HEAP bufferHeap)
 {
     DDI_FUNC_ENTER;
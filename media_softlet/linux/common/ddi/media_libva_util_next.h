@@ -453,6 +453,25 @@ private:
         MOS_BUFMGR            *bufmgr,
         bool                  isShadowBuffer = false);
 
+    //!
+    //! \brief  Create buffer which wraps page aligned application memory as userptr bo
+    //!         The memory must stay valid until the GPU work using the buffer completes
+    //!
+    //! \param  [in, out] mediaBuffer
+    //!         Pointer to ddi media buffer, iSize is the size of the memory
+    //! \param  [in] data
+    //!         Application memory, must be page aligned
+    //! \param  [in] bufmgr
+    //!         Mos buffer manager
+    //!
+    //! \return VAStatus
+    //!     VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    static VAStatus CreateUserptrBuffer(
+        PDDI_MEDIA_BUFFER     mediaBuffer,
+        void                  *data,
+        MOS_BUFMGR            *bufmgr);
+
 public:
     //!
     //! \brief  Allocate pmedia surface from heap
@@ -584,6 +603,27 @@ public:
     //!
     static void* LockSurface(DDI_MEDIA_SURFACE  *surface, uint32_t flag);
 
+    //!
+    //! \brief  Lock rows of surface
+    //! \details Tile-Y surfaces untiled by s/w only detile the tile rows covering the
+    //!          rows in each plane, other surfaces are locked as a whole. The returned
+    //!          pointer has the layout of LockSurface, rows out of range are undefined
+    //!          until the surface is locked as a whole.
+    //!
+    //! \param  [in] surface
+    //!         Ddi media surface
+    //! \param  [in] flag
+    //!         Flag
+    //! \param  [in] y
+    //!         First luma row
+    //! \param  [in] height
+    //!         Number of luma rows
+    //!
+    //! \return void*
+    //!     Pointer to lock surface data
+    //!
+    static void* LockSurfaceRows(DDI_MEDIA_SURFACE *surface, uint32_t flag, uint32_t y, uint32_t height);
+
     //!
     //! \brief  Lock surface
     //!
@@ -25,6 +25,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_interface_next.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common_next.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_copy_next.cpp
 )
 
 set(TMP_HEADERS_
@@ -39,6 +40,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common_next.h
     ${CMAKE_CURRENT_LIST_DIR}/ddi_register_components_specific.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common_next.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_copy_next.h
 )
 
 set(SOFTLET_DDI_SOURCES_
@@ -51,6 +53,11 @@ set(SOFTLET_DDI_HEADERS_
     ${TMP_HEADERS_}
 )
 
+set(SOURCES_SSE4
+    ${SOURCES_SSE4}
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_copy_next_sse4.cpp
+)
+
 set(SOFTLET_DDI_PUBLIC_INCLUDE_DIRS_
     ${SOFTLET_DDI_PUBLIC_INCLUDE_DIRS_}
     ${CMAKE_CURRENT_LIST_DIR}
@@ -29,6 +29,7 @@
 #define MOS_BUFMGR_API_H
 
 #include <stdio.h>
+#include <atomic>
 #include "drm.h"
 #include "libdrm_macros.h"
 #include "media_skuwa_specific.h"
@@ -200,6 +201,24 @@ struct mos_linux_bo {
     bool aux_mapped;
 
     __u32 vm_id;
+
+    /**
+     * Number of submissions which wrote the object, increased after exec.
+     * GPU contexts on other threads submit the object concurrently.
+     */
+    std::atomic<uint32_t> write_epoch{0};
+
+    /**
+     * write_epoch + 1 when the object was last decompressed in place, 0 if never,
+     * the object stays uncompressed until the next write
+     */
+    std::atomic<uint32_t> decomp_epoch{0};
+
+    /**
+     * Object was imported or exported, other devices may write it without
+     * increasing write_epoch
+     */
+    bool shared = false;
 };
 
 #define BO_ALLOC_FOR_RENDER (1<<0)
@@ -349,7 +349,12 @@ mos_bo_flink(struct mos_linux_bo *bo, uint32_t * name)
 
     if (bo->bufmgr && bo->bufmgr->bo_flink)
     {
-        return bo->bufmgr->bo_flink(bo, name);
+        int ret = bo->bufmgr->bo_flink(bo, name);
+        if (ret == 0)
+        {
+            bo->shared = true;
+        }
+        return ret;
     }
     else
     {
@@ -632,7 +637,12 @@ mos_bo_create_from_name(struct mos_bufmgr *bufmgr,
 
     if (bufmgr->bo_create_from_name)
     {
-        return bufmgr->bo_create_from_name(bufmgr, name, handle);
+        struct mos_linux_bo *bo = bufmgr->bo_create_from_name(bufmgr, name, handle);
+        if (bo)
+        {
+            bo->shared = true;
+        }
+        return bo;
     }
     else
     {
@@ -896,7 +906,12 @@ mos_bo_export_to_prime(struct mos_linux_bo *bo, int *prime_fd)
 
     if (bo->bufmgr && bo->bufmgr->bo_export_to_prime)
     {
-        return bo->bufmgr->bo_export_to_prime(bo, prime_fd);
+        int ret = bo->bufmgr->bo_export_to_prime(bo, prime_fd);
+        if (ret == 0)
+        {
+            bo->shared = true;
+        }
+        return ret;
     }
     else
     {
@@ -917,7 +932,12 @@ mos_bo_create_from_prime(struct mos_bufmgr *bufmgr,
 
     if (bufmgr->bo_create_from_prime)
     {
-        return bufmgr->bo_create_from_prime(bufmgr, alloc_prime);
+        struct mos_linux_bo *bo = bufmgr->bo_create_from_prime(bufmgr, alloc_prime);
+        if (bo)
+        {
+            bo->shared = true;
+        }
+        return bo;
     }
     else
     {
@@ -73,6 +73,7 @@
 #include "mos_utilities.h"
 #include "linux_system_info.h"
 #include "mos_os_specific.h"
+#include "memory_policy_manager.h"
 
 #ifdef HAVE_VALGRIND
 #include <valgrind.h>
@@ -1972,6 +1973,9 @@ drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
                     __FILE__, __LINE__,
                     bo_gem->gem_handle, bo_gem->name,
                     strerror(errno));
+            } else if (!bufmgr_gem->has_lmem) {
+                /* Pages of BOs in system memory, apply huge page and NUMA placement hints */
+                MemoryPolicyManager::ApplyCpuMappingPolicy(bo_gem->mem_virtual, bo->size);
             }
         }
 
@@ -2009,6 +2013,7 @@ drm_export int mos_gem_bo_map(struct mos_linux_bo *bo, int write_enable)
             }
             VG(VALGRIND_MALLOCLIKE_BLOCK(mmap_arg.addr_ptr, mmap_arg.size, 0, 1));
             bo_gem->mem_virtual = (void *)(uintptr_t) mmap_arg.addr_ptr;
+            MemoryPolicyManager::ApplyCpuMappingPolicy(bo_gem->mem_virtual, bo->size);
         }
 
         memclear(set_domain);
@@ -48,6 +48,7 @@
 #include "mos_cmdbufmgr_next.h"
 #include "mos_oca_rtlog_mgr.h"
 #include "mos_oca_interface_specific.h"
+#include "memory_policy_manager.h"
 #define BATCH_BUFFER_SIZE 0x80000
 
 OsContextSpecificNext::OsContextSpecificNext()
@@ -100,6 +101,10 @@ MOS_STATUS OsContextSpecificNext::Init(DDI_DEVICE_CONTEXT ddiDriverContext)
         }
         mos_bufmgr_enable_reuse(m_bufmgr);
 
+        // Before any CPU memory of the device is allocated or mapped
+        MemoryPolicyManager::InitCpuMemoryPolicy(userSettingPtr);
+        m_userSettingPtr = userSettingPtr;
+
         osDriverContext->bufmgr                 = m_bufmgr;
 
         //Latency reducation:replace HWGetDeviceID to get device using ioctl from drm.
@@ -358,6 +363,35 @@ void OsContextSpecificNext::Destroy()
         m_skuTable.reset();
         m_waTable.reset();
 
+        CpuMemoryPolicyCounters counters = {};
+        MemoryPolicyManager::GetCpuMemoryPolicyCounters(counters);
+        ReportUserSetting(
+            m_userSettingPtr,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_ALLOC_COUNT,
+            counters.allocCount,
+            MediaUserSetting::Group::Device);
+        ReportUserSetting(
+            m_userSettingPtr,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_MAP_COUNT,
+            counters.mapCount,
+            MediaUserSetting::Group::Device);
+        ReportUserSetting(
+            m_userSettingPtr,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_HUGE_PAGE_COUNT,
+            counters.hugePageCount,
+            MediaUserSetting::Group::Device);
+        ReportUserSetting(
+            m_userSettingPtr,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_NUMA_LOCAL_COUNT,
+            counters.numaLocalCount,
+            MediaUserSetting::Group::Device);
+        ReportUserSetting(
+            m_userSettingPtr,
+            __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_FALLBACK_COUNT,
+            counters.fallbackCount,
+            MediaUserSetting::Group::Device);
+        m_userSettingPtr = nullptr;
+
         mos_bufmgr_destroy(m_bufmgr);
 
         // Delete Gmm context
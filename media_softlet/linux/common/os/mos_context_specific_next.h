@@ -147,6 +147,11 @@ private:
     int                 m_deviceType   = DEVICE_TYPE_COUNT;
     AuxTableMgr         *m_auxTableMgr = nullptr;
     PERF_DATA           *m_perfData =   nullptr;
+
+    //!
+    //! \brief  user setting instance, to report CPU memory policy counters on destroy
+    //!
+    MediaUserSettingSharedPtr m_userSettingPtr = nullptr;
 MEDIA_CLASS_DEFINE_END(OsContextSpecificNext)
 };
 #endif // #ifndef __MOS_CONTEXT_SPECIFIC_NEXT_H__
@@ -49,8 +49,15 @@ MOS_STATUS MosDecompressionBase::MemoryDecompress(
     PMOS_RESOURCE osResource)
 {
     MOS_OS_CHK_NULL_RETURN(m_mediaMemDecompState);
-    m_mediaMemDecompState->MemoryDecompress(osResource);
-    return MOS_STATUS_SUCCESS;
+    return m_mediaMemDecompState->MemoryDecompress(osResource);
+}
+
+MOS_STATUS MosDecompressionBase::MemoryDecompressBatch(
+    PMOS_RESOURCE *osResources,
+    uint32_t       count)
+{
+    MOS_OS_CHK_NULL_RETURN(m_mediaMemDecompState);
+    return m_mediaMemDecompState->MemoryDecompressBatch(osResources, count);
 }
 
 MOS_STATUS MosDecompressionBase::MediaMemoryCopy(
@@ -59,6 +59,21 @@ public:
     MOS_STATUS MemoryDecompress(
         PMOS_RESOURCE osResource);
 
+    //!
+    //! \brief    Media memory decompression of several resources
+    //! \details  Entry point to decompress all resources needed by one frame with one submission,
+    //!           resources not written since their last decompression are skipped
+    //! \param    [in] osResources
+    //!           Array of the surfaces will be decompressed
+    //! \param    [in] count
+    //!           Number of surfaces
+    //!
+    //! \return   MOS_STATUS_SUCCESS if succeeded, else error code.
+    //!
+    MOS_STATUS MemoryDecompressBatch(
+        PMOS_RESOURCE *osResources,
+        uint32_t       count);
+
     //!
     //! \brief    Media memory copy
     //! \details  Entry point to copy media memory, input can support both compressed/uncompressed
@@ -880,6 +880,7 @@ MOS_STATUS GpuContextSpecificNext::GetCommandBuffer(
             MosUtilities::MosUnlockMutex(m_cmdBufPoolMutex);
             return MOS_STATUS_UNKNOWN;
         }
+        m_cmdBufPickupNum++;
         MosUtilities::MosUnlockMutex(m_cmdBufPoolMutex);
 
         // util now, we got new command buffer from CmdBufMgr, next step to fill in the input command buffer
@@ -1070,6 +1071,8 @@ MOS_STATUS GpuContextSpecificNext::ResizeCommandBufferAndPatchList(
 {
     MOS_OS_FUNCTION_ENTER;
 
+    uint32_t prevCommandBufferSize = m_commandBufferSize;
+
     // m_commandBufferSize is used for allocate command buffer and submit command buffer, in this moment, command buffer has not allocated yet.
     // Linux KMD requires command buffer size align to 8 bytes, or it will not execute the commands.
     if (m_ocaLogSectionSupported /*&& !m_ocaSizeIncreaseDone*/)
@@ -1082,6 +1085,11 @@ MOS_STATUS GpuContextSpecificNext::ResizeCommandBufferAndPatchList(
         m_commandBufferSize = MOS_ALIGN_CEIL(requestedCommandBufferSize, 8);
     }
 
+    if (m_commandBufferSize != prevCommandBufferSize)
+    {
+        PrewarmCommandBuffer();
+    }
+
     if (requestedPatchListSize > m_maxPatchLocationsize)
     {
         PPATCHLOCATIONLIST newPatchList = (PPATCHLOCATIONLIST)MOS_ReallocMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * requestedPatchListSize);
@@ -1101,11 +1109,30 @@ MOS_STATUS GpuContextSpecificNext::ResizeCommandBuffer(uint32_t requestedSize)
 {
     MOS_OS_FUNCTION_ENTER;
 
-    m_commandBufferSize = requestedSize;
+    if (m_commandBufferSize != requestedSize)
+    {
+        m_commandBufferSize = requestedSize;
+        PrewarmCommandBuffer();
+    }
 
     return MOS_STATUS_SUCCESS;
 }
 
+void GpuContextSpecificNext::PrewarmCommandBuffer()
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    // Prepare the command buffers of new size for one frame, so that the
+    // following frames pick up command buffers without allocation
+    if (m_cmdBufMgr != nullptr && m_cmdBufHighWaterNum > 0)
+    {
+        if (m_cmdBufMgr->PrewarmCmdBuf(m_commandBufferSize, m_cmdBufHighWaterNum) != MOS_STATUS_SUCCESS)
+        {
+            MOS_OS_NORMALMESSAGE("Failed to prewarm command buffers with size %d", m_commandBufferSize);
+        }
+    }
+}
+
 MOS_VDBOX_NODE_IND GpuContextSpecificNext::GetVdboxNodeId(
     PMOS_COMMAND_BUFFER cmdBuffer)
 {
@@ -1229,6 +1256,18 @@ MOS_STATUS GpuContextSpecificNext::MapResourcesToAuxTable(mos_linux_bo *cmd_bo)
     return MOS_STATUS_SUCCESS;
 }
 
+void GpuContextSpecificNext::UpdateWriteEpochs()
+{
+    for (uint32_t i = 0; i < m_numAllocations; i++)
+    {
+        auto res = (PMOS_RESOURCE)m_allocationList[i].hAllocation;
+        if (m_writeModeList[i] && res && res->bo)
+        {
+            res->bo->write_epoch++;
+        }
+    }
+}
+
 MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
     MOS_STREAM_HANDLE   streamState,
     PMOS_COMMAND_BUFFER cmdBuffer,
@@ -1255,6 +1294,10 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
     m_cmdBufFlushed = true;
     auto cmd_bo     = cmdBuffer->OsResource.bo;
 
+    // Record the command buffers picked up by one frame for prewarm
+    m_cmdBufHighWaterNum = MOS_MAX(m_cmdBufHighWaterNum, m_cmdBufPickupNum);
+    m_cmdBufPickupNum    = 0;
+
     // Map Resource to Aux if needed
     MapResourcesToAuxTable(cmd_bo);
     for(auto it : m_secondaryCmdBufs)
@@ -1618,6 +1661,10 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
     {
         MOS_OS_ASSERTMESSAGE("Command buffer submission failed!");
     }
+    else
+    {
+        UpdateWriteEpochs();
+    }
 
     MosUtilDevUltSpecific::MOS_DEVULT_FuncCall(pfnUltGetCmdBuf, cmdBuffer);
 
@@ -277,6 +277,12 @@ protected:
     //!
     MOS_STATUS MapResourcesToAuxTable(mos_linux_bo *cmd_bo);
 
+    //!
+    //! \brief    Increase write epoch of the resources written by the submitted command buffer
+    //! \details  Resource is decompressed again on CPU access only if its write epoch changed
+    //!
+    void UpdateWriteEpochs();
+
     MOS_VDBOX_NODE_IND GetVdboxNodeId(
         PMOS_COMMAND_BUFFER cmdBuffer);
 
@@ -321,6 +327,13 @@ protected:
     MOS_STATUS ReportMemoryInfo(
         struct mos_bufmgr *bufmgr);
 
+    //!
+    //! \brief    Prewarm command buffers of current size in command buffer manager
+    //!           with the number of command buffers used by one submission
+    //! \return   void
+    //!
+    void PrewarmCommandBuffer();
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     MOS_LINUX_BO* GetNopCommandBuffer(
         MOS_STREAM_HANDLE streamState);
@@ -344,6 +357,12 @@ protected:
     //! \brief    initialized comamnd buffer size
     uint32_t m_commandBufferSize = 0;
 
+    //! \brief    Number of command buffers picked up since last submission
+    uint32_t m_cmdBufPickupNum = 0;
+
+    //! \brief    Max number of command buffers picked up by one submission
+    uint32_t m_cmdBufHighWaterNum = 0;
+
     //! \brief    Flag to indicate current command buffer flused or not, if not
     //!           re-use it
     volatile bool m_cmdBufFlushed = false;
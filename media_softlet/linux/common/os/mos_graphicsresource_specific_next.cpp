@@ -470,24 +470,15 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
     if (boPtr)
     {
         // Do decompression for a compressed surface before lock
-        const auto pGmmResInfo = m_gmmResInfo;
-        MOS_OS_ASSERT(pGmmResInfo);
-        GMM_RESOURCE_FLAG GmmFlags = pGmmResInfo->GetResFlags();
-
-        if (!params.m_noDecompress &&
-            (((GmmFlags.Gpu.MMC || GmmFlags.Gpu.CCS) && GmmFlags.Info.MediaCompressed) ||
-             pGmmResInfo->IsMediaMemoryCompressed(0)))
+        if (DecompressForLock(pOsContextSpecific, params) != MOS_STATUS_SUCCESS)
         {
-            MOS_RESOURCE mosResource = {};
-            ConvertToMosResource(&mosResource);
+            return nullptr;
+        }
 
-            MosDecompression *mosDecompression = pOsContextSpecific->GetMosDecompression();
-            if (nullptr == mosDecompression)
-            {
-                MOS_OS_ASSERTMESSAGE("mosDecompression is NULL.");
-                return nullptr;
-            }
-            mosDecompression->MemoryDecompress(&mosResource);
+        if (m_mapped && m_tileRowShadow.IsActive())
+        {
+            // Locked by rectangle before, detile the rest of the shadow surface
+            m_tileRowShadow.Detile((uint8_t *)boPtr->virt, m_systemShadow, 0, m_tileRowShadow.GetRowNum(), !params.m_readRequest);
         }
 
         if(false == m_mapped)
@@ -506,7 +497,7 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
                         m_mmapOperation = MOS_MMAP_OPERATION_MMAP;
                         if (m_systemShadow == nullptr)
                         {
-                            m_systemShadow = (uint8_t *)MOS_AllocMemory(boPtr->size);
+                            m_systemShadow = (uint8_t *)MemoryPolicyManager::AllocCpuMemory(boPtr->size);
                             MOS_OS_CHECK_CONDITION((m_systemShadow == nullptr), "Failed to allocate shadow surface", nullptr);
                         }
                         if (m_systemShadow)
@@ -548,6 +539,140 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
     return dataPtr;
 }
 
+void* GraphicsResourceSpecificNext::LockRect(OsContextNext* osContextPtr, LockParams& params, const LockRectParams& rect)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    if (osContextPtr == nullptr)
+    {
+        MOS_OS_ASSERTMESSAGE("Unable to get the active OS context.");
+        return nullptr;
+    }
+
+    if (osContextPtr ->GetOsContextValid() == false)
+    {
+        MOS_OS_ASSERTMESSAGE("The OS context got is not valid.");
+        return nullptr;
+    }
+
+    OsContextSpecificNext *pOsContextSpecific = static_cast<OsContextSpecificNext *>(osContextPtr);
+
+    // Only s/w untiling of real Tile-Y benefits from the rectangle, hardware detiled and
+    // linear mappings are as cheap as full lock. Full lock in progress is also reused.
+    if (m_bo == nullptr || m_gmmResInfo == nullptr || m_tileType != MOS_TILE_Y || params.m_tileAsTiled ||
+        pOsContextSpecific->IsAtomSoc() || !pOsContextSpecific->UseSwSwizzling() ||
+        !pOsContextSpecific->GetTileYFlag() || rect.m_width == 0 || rect.m_height == 0 ||
+        (m_mapped && !m_tileRowShadow.IsActive()))
+    {
+        return Lock(osContextPtr, params);
+    }
+
+    MOS_LINUX_BO *boPtr = m_bo;
+
+    if (false == m_mapped)
+    {
+        if (!m_tileRowShadow.Init((size_t)m_gmmResInfo->GetSizeMainSurface(), m_pitch))
+        {
+            return Lock(osContextPtr, params);
+        }
+
+        // Decompression works on the whole resource, it is done once per mapping
+        if (DecompressForLock(pOsContextSpecific, params) != MOS_STATUS_SUCCESS)
+        {
+            m_tileRowShadow.Reset();
+            return nullptr;
+        }
+
+        mos_bo_map(boPtr, ( OSKM_LOCKFLAG_WRITEONLY & params.m_writeRequest ));
+        m_mmapOperation = MOS_MMAP_OPERATION_MMAP;
+        if (m_systemShadow == nullptr)
+        {
+            m_systemShadow = (uint8_t *)MemoryPolicyManager::AllocCpuMemory(boPtr->size);
+            if (m_systemShadow == nullptr)
+            {
+                MOS_OS_ASSERTMESSAGE("Failed to allocate shadow surface");
+                mos_bo_unmap(boPtr);
+                m_mmapOperation = MOS_MMAP_OPERATION_NONE;
+                m_tileRowShadow.Reset();
+                return nullptr;
+            }
+        }
+
+        m_mapped = true;
+        m_pData  = m_systemShadow;
+    }
+
+    // Detile the rows covered by the rectangle in each plane
+    struct
+    {
+        uint32_t      mask;
+        GMM_YUV_PLANE plane;
+    } planes[] = {{lockPlaneY, GMM_PLANE_Y}, {lockPlaneU, GMM_PLANE_U}, {lockPlaneV, GMM_PLANE_V}};
+
+    uint32_t vertShift = 0;
+    switch (m_format)
+    {
+    case Format_NV12:
+    case Format_NV21:
+    case Format_P010:
+    case Format_P016:
+    case Format_YV12:
+    case Format_I420:
+    case Format_IYUV:
+    case Format_IMC3:
+        vertShift = 1;
+        break;
+    default:
+        break;
+    }
+
+    bool     dirty    = !params.m_readRequest;
+    uint32_t planeNum = (m_gmmResInfo->GetPlanarYOffsetL(GMM_PLANE_U) > 0) ? 3 : 1;
+    for (uint32_t i = 0; i < planeNum; i++)
+    {
+        if ((rect.m_planeMask & planes[i].mask) == 0)
+        {
+            continue;
+        }
+
+        uint32_t planeRow = (i == 0) ? 0 : (uint32_t)m_gmmResInfo->GetPlanarYOffsetL(planes[i].plane);
+        uint32_t shift    = (i == 0) ? 0 : vertShift;
+        uint32_t startRow = planeRow + (rect.m_y >> shift);
+        uint32_t endRow   = planeRow + ((rect.m_y + rect.m_height + (1 << shift) - 1) >> shift);
+        m_tileRowShadow.Detile((uint8_t *)boPtr->virt, m_systemShadow, startRow, endRow, dirty);
+    }
+
+    return m_pData;
+}
+
+MOS_STATUS GraphicsResourceSpecificNext::DecompressForLock(OsContextSpecificNext *osContextPtr, LockParams &params)
+{
+    MOS_OS_CHK_NULL_RETURN(osContextPtr);
+
+    const auto pGmmResInfo = m_gmmResInfo;
+    MOS_OS_CHK_NULL_RETURN(pGmmResInfo);
+    GMM_RESOURCE_FLAG GmmFlags = pGmmResInfo->GetResFlags();
+
+    if (!params.m_noDecompress &&
+        (((GmmFlags.Gpu.MMC || GmmFlags.Gpu.CCS) && GmmFlags.Info.MediaCompressed) ||
+         pGmmResInfo->IsMediaMemoryCompressed(0)))
+    {
+        MOS_RESOURCE mosResource = {};
+        ConvertToMosResource(&mosResource);
+
+        MosDecompression *mosDecompression = osContextPtr->GetMosDecompression();
+        if (nullptr == mosDecompression)
+        {
+            MOS_OS_ASSERTMESSAGE("mosDecompression is NULL.");
+            return MOS_STATUS_NULL_POINTER;
+        }
+        PMOS_RESOURCE decompResource = &mosResource;
+        MOS_OS_CHK_STATUS_RETURN(mosDecompression->MemoryDecompressBatch(&decompResource, 1));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
 {
     MOS_OS_FUNCTION_ENTER;
@@ -581,11 +706,20 @@ MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
                if (m_systemShadow)
                {
                    int32_t flags = pOsContextSpecific->GetTileYFlag() ? 0 : 1;
-                   uint64_t surfSize = m_gmmResInfo->GetSizeMainSurface();
-                   MosUtilities::MosSwizzleData(m_systemShadow, (uint8_t*)boPtr->virt,
-                                   MOS_TILE_LINEAR, MOS_TILE_Y,
-                                   (int32_t)(surfSize / m_pitch), m_pitch, flags);
-                   MOS_FreeMemory(m_systemShadow);
+                   if (m_tileRowShadow.IsActive())
+                   {
+                       // Locked by rectangle, only write back the dirty tile rows
+                       m_tileRowShadow.WriteBack(m_systemShadow, (uint8_t*)boPtr->virt);
+                       m_tileRowShadow.Reset();
+                   }
+                   else
+                   {
+                       uint64_t surfSize = m_gmmResInfo->GetSizeMainSurface();
+                       MosUtilities::MosSwizzleData(m_systemShadow, (uint8_t*)boPtr->virt,
+                                       MOS_TILE_LINEAR, MOS_TILE_Y,
+                                       (int32_t)(surfSize / m_pitch), m_pitch, flags);
+                   }
+                   MemoryPolicyManager::FreeCpuMemory(m_systemShadow);
                    m_systemShadow = nullptr;
                }
 
@@ -952,7 +1086,12 @@ void* GraphicsResourceSpecificNext::LockExternalResource(
                 MOS_OS_ASSERTMESSAGE("mosDecompression is NULL.");
                 return nullptr;
             }
-            mosDecompression->MemoryDecompress(resource);
+            status = mosDecompression->MemoryDecompressBatch(&resource, 1);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                MOS_OS_ASSERTMESSAGE("Decompress resource failed, skip lock");
+                return nullptr;
+            }
         }
 
         if (false == resource->bMapped)
@@ -28,6 +28,9 @@
 #define __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
 
 #include "mos_graphicsresource_next.h"
+#include "mos_tile_row_shadow.h"
+
+class OsContextSpecificNext;
 
 class GraphicsResourceSpecificNext : public GraphicsResourceNext
 {
@@ -115,6 +118,20 @@ public:
     //!
     void* Lock(OsContextNext* osContextPtr, LockParams& params);
 
+    //!
+    //! \brief  Locks a rectangle of a resource, only the tile rows covering the rectangle
+    //!         are detiled for s/w swizzling and only the dirty tile rows are written back
+    //!         on unlock
+    //! \param  [in] osContextPtr
+    //!         Pointer to the osContext handle
+    //! \param  [in] params
+    //!         Resource lock Params
+    //! \param  [in] rect
+    //!         Rectangle and planes accessed by the caller
+    //! \return CPU side lock address in success case, nullptr in fail cases
+    //!
+    void* LockRect(OsContextNext* osContextPtr, LockParams& params, const LockRectParams& rect);
+
     //!
     //! \brief  Unlocks a resource that has already been locked, if no lock has
     //!         occurred, this function does nothing
@@ -215,6 +232,12 @@ protected:
     //!
     MOS_STATUS SetTileModebyForce(GMM_RESCREATE_PARAMS &gmmParams, MOS_TILE_MODE_GMM tileMode);
 
+    //!
+    //! \brief  Decompress the resource before lock if it is media compressed
+    //! \return MOS_SUCCESS on success case.
+    //!
+    MOS_STATUS DecompressForLock(OsContextSpecificNext *osContextPtr, LockParams &params);
+
 private:
 
     //!
@@ -243,6 +266,8 @@ private:
     HybridSem m_hybridSem = {};
 
     uint8_t*  m_systemShadow = nullptr;     //!< System shadow surface for s/w untiling
+
+    MosTileRowShadow m_tileRowShadow;        //!< Tile rows of shadow surface locked by rectangle, inactive if fully detiled
 MEDIA_CLASS_DEFINE_END(GraphicsResourceSpecificNext)
 };
 #endif // #ifndef __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
@@ -47,6 +47,7 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <vector>
 #endif
 
 MOS_STATUS MosInterface::InitOsUtilities(DDI_DEVICE_CONTEXT ddiDeviceContext)
@@ -2752,33 +2753,78 @@ MOS_STATUS MosInterface::DecompResource(
     MOS_RESOURCE_HANDLE resource)
 {
     MOS_OS_FUNCTION_ENTER;
-    MOS_STATUS status = MOS_STATUS_SUCCESS;
 
-    MOS_OS_CHK_NULL_RETURN(streamState);
     MOS_OS_CHK_NULL_RETURN(resource);
-    MOS_OS_CHK_NULL_RETURN(resource->bo);
-    MOS_OS_CHK_NULL_RETURN(resource->pGmmResInfo);
+    return DecompResourceBatch(streamState, &resource, 1);
+}
+
+MOS_STATUS MosInterface::DecompResourceBatch(
+    MOS_STREAM_HANDLE    streamState,
+    MOS_RESOURCE_HANDLE *resources,
+    uint32_t             count)
+{
+    MOS_OS_FUNCTION_ENTER;
+
+    MOS_OS_CHK_NULL_RETURN(streamState);
+    MOS_OS_CHK_NULL_RETURN(resources);
 
-    MOS_LINUX_BO *bo = resource->bo;
-    GMM_RESOURCE_FLAG gmmFlags;
-    gmmFlags = resource->pGmmResInfo->GetResFlags();
-    if (((gmmFlags.Gpu.MMC ||
-        gmmFlags.Gpu.CCS) &&
-        gmmFlags.Gpu.UnifiedAuxSurface) ||
-        resource->pGmmResInfo->IsMediaMemoryCompressed(0))
+    std::vector<MOS_RESOURCE_HANDLE> compressed;
+    for (uint32_t i = 0; i < count; i++)
     {
-        MosDecompression   *mosDecompression = nullptr;
-        MOS_OS_CHK_STATUS_RETURN(MosInterface::GetMosDecompressionFromStreamState(streamState, mosDecompression));
+        MOS_RESOURCE_HANDLE resource = resources[i];
+        MOS_OS_CHK_NULL_RETURN(resource);
+        MOS_OS_CHK_NULL_RETURN(resource->bo);
+        MOS_OS_CHK_NULL_RETURN(resource->pGmmResInfo);
 
-        MOS_OS_CHK_NULL_RETURN(mosDecompression);
-        mosDecompression->MemoryDecompress(resource);
+        GMM_RESOURCE_FLAG gmmFlags = resource->pGmmResInfo->GetResFlags();
+        if (((gmmFlags.Gpu.MMC ||
+            gmmFlags.Gpu.CCS) &&
+            gmmFlags.Gpu.UnifiedAuxSurface) ||
+            resource->pGmmResInfo->IsMediaMemoryCompressed(0))
+        {
+            compressed.push_back(resource);
+        }
+    }
 
+    if (compressed.empty())
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MosDecompression *mosDecompression = nullptr;
+    MOS_OS_CHK_STATUS_RETURN(MosInterface::GetMosDecompressionFromStreamState(streamState, mosDecompression));
+    MOS_OS_CHK_NULL_RETURN(mosDecompression);
+    MOS_OS_CHK_STATUS_RETURN(mosDecompression->MemoryDecompressBatch(compressed.data(), (uint32_t)compressed.size()));
+
+    for (auto resource : compressed)
+    {
         MOS_OS_CHK_STATUS_RETURN(MosInterface::SetMemoryCompressionHint(streamState, resource, false));
     }
 
     return MOS_STATUS_SUCCESS;
 }
 
+bool MosInterface::IsResourceDecompressed(
+    MOS_RESOURCE_HANDLE resource)
+{
+    // Imported or exported bos may be written by other devices without increasing write epoch
+    if (resource == nullptr || resource->bo == nullptr || resource->bExternalSurface || resource->bo->shared)
+    {
+        return false;
+    }
+
+    return resource->bo->decomp_epoch == resource->bo->write_epoch + 1;
+}
+
+void MosInterface::SetResourceDecompressed(
+    MOS_RESOURCE_HANDLE resource)
+{
+    if (resource && resource->bo)
+    {
+        resource->bo->decomp_epoch = resource->bo->write_epoch + 1;
+    }
+}
+
 MOS_STATUS MosInterface::GetMosDecompressionFromStreamState(
     MOS_STREAM_HANDLE   streamState,
     MosDecompression* & mosDecompression)
@@ -52,6 +52,62 @@ MOS_STATUS MosUserSetting::InitMosUserSettingSpecific(MediaUserSettingSharedPtr
         0,
         true); //"Enable VM Bind."
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_HUGE_PAGE_ENABLE,
+        MediaUserSetting::Group::Device,
+        0,
+        false); //"Back large CPU visible allocations by transparent huge pages."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_NUMA_LOCAL_ENABLE,
+        MediaUserSetting::Group::Device,
+        0,
+        false); //"Prefer NUMA node of the allocating thread for large CPU visible allocations."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_MIN_SIZE,
+        MediaUserSetting::Group::Device,
+        0x200000,
+        false); //"Min size in bytes of CPU visible allocations placed by huge page and NUMA policy."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_HUGE_PAGE_COUNT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Report allocations and mappings advised to use huge pages."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_NUMA_LOCAL_COUNT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Report allocations and mappings bound to local NUMA node."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_FALLBACK_COUNT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Report huge page and NUMA requests refused by kernel."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_ALLOC_COUNT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Report CPU allocations placed by huge page and NUMA policy."
+
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_CPU_MEM_POLICY_MAP_COUNT,
+        MediaUserSetting::Group::Device,
+        0,
+        true); //"Report buffer object mappings placed by huge page and NUMA policy."
+
     DeclareUserSettingKey(
         userSettingPtr,
         "INTEL MEDIA ALLOC MODE",
@@ -59,6 +115,13 @@ MOS_STATUS MosUserSetting::InitMosUserSettingSpecific(MediaUserSettingSharedPtr
         0,
         false); //
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        "Decode Userptr Bitstream",
+        MediaUserSetting::Group::Device,
+        0,
+        false); //"Import page aligned decode slice data as userptr bo."
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug(
         userSettingPtr,
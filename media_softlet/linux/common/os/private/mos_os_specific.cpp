@@ -1457,6 +1457,27 @@ MOS_STATUS Mos_Specific_DecompResource(
     return MosInterface::DecompResource(osInterface->osStreamState, osResource);
 }
 
+//!
+//! \brief    Decompress Resources
+//! \details  Decompress Resources with one submission
+//! \param    PMOS_INTERFACE osInterface
+//!           [in] pointer to OS Interface structure
+//! \param    PMOS_RESOURCE *osResources
+//!           [in/out] Resource objects
+//! \param    uint32_t count
+//!           [in] Number of resource objects
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS if successful
+//!
+MOS_STATUS Mos_Specific_DecompResourceBatch(
+    PMOS_INTERFACE        osInterface,
+    PMOS_RESOURCE         *osResources,
+    uint32_t              count)
+{
+    MOS_OS_CHK_NULL_RETURN(osInterface);
+    return MosInterface::DecompResourceBatch(osInterface->osStreamState, osResources, count);
+}
+
 //!
 //! \brief    Decompress and Copy Resource to Another Buffer
 //! \details  Decompress and Copy Resource to Another Buffer
@@ -3415,6 +3436,7 @@ MOS_STATUS Mos_Specific_LoadFunction(
     osInterface->pfnLockResource                    = Mos_Specific_LockResource;
     osInterface->pfnUnlockResource                  = Mos_Specific_UnlockResource;
     osInterface->pfnDecompResource                  = Mos_Specific_DecompResource;
+    osInterface->pfnDecompResourceBatch             = Mos_Specific_DecompResourceBatch;
     osInterface->pfnDoubleBufferCopyResource        = Mos_Specific_DoubleBufferCopyResource;
     osInterface->pfnMediaCopyResource2D             = Mos_Specific_MediaCopyResource2D;
     osInterface->pfnGetMosContext                   = Mos_Specific_GetMosContext;
@@ -74,6 +74,7 @@
 #include "mos_bufmgr_xe.h"
 #include "mos_synchronization_xe.h"
 #include "mos_utilities.h"
+#include "memory_policy_manager.h"
 #include "mos_bufmgr_util_debug.h"
 #include "media_user_setting_value.h"
 #include "linux_system_info.h"
@@ -1997,6 +1998,11 @@ mos_bo_map_xe(struct mos_linux_bo *bo, int write_enable)
                 bo_gem->gem_handle, bo_gem->name,
                 strerror(errno));
         }
+        else if (MEMZONE_SYS == bo_gem->mem_region)
+        {
+            // Apply huge page and NUMA placement hints to BOs in system memory
+            MemoryPolicyManager::ApplyCpuMappingPolicy(bo_gem->mem_virtual, bo->size);
+        }
     }
 
 #ifdef __cplusplus
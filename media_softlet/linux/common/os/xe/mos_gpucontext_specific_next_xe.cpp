@@ -491,6 +491,10 @@ MOS_STATUS GpuContextSpecificNextXe::SubmitCommandBuffer(
     {
         MOS_OS_ASSERTMESSAGE("Command buffer submission failed!");
     }
+    else
+    {
+        UpdateWriteEpochs();
+    }
 
     MosUtilDevUltSpecific::MOS_DEVULT_FuncCall(pfnUltGetCmdBuf, cmdBuffer);
 